@@ -11,6 +11,7 @@ extern "C" {
 #endif
 
 #include "bmi.h"
+#include "bmi_vector.h"
 #include "test_bmi_c.h"
 
     /**
@@ -57,6 +58,14 @@ extern "C" {
     */
     Bmi* register_bmi(Bmi *model);
 
+   /**
+    * Register the @ref Bmi_Vector extension, through which one instance of this model can hold several catchments.
+    *
+    * @param extension A pointer to the @ref Bmi_Vector extension instance to register.
+    * @return A pointer to the passed-in @ref Bmi_Vector instance.
+    */
+    Bmi_Vector* register_bmi_vector(Bmi_Vector *extension);
+
 #if defined(__cplusplus)
 }
 #endif
@@ -0,0 +1,46 @@
+// Copy of the ngen include/bmi_vector.h extension header
+//
+// Nextgen extension to the Basic Model Interface (BMI) C specification for
+// models that can hold many catchments in one model instance.
+//
+// A library supports it by exporting, beside its ``register_bmi`` function,
+// a registration function (conventionally named ``register_bmi_vector``) of
+// type
+//
+//     Bmi_Vector* register_bmi_vector(Bmi_Vector *extension);
+//
+// which sets the members of the passed struct, as ``register_bmi`` does for
+// the Bmi struct.  For formulations whose ``vector_registration_function``
+// config names it, Nextgen then creates one model for all the catchments of a
+// layer that use the library and initializes it with
+// ``initialize_catchments`` instead of ``initialize``.
+//
+// Such a model holds its catchments in structure-of-arrays form: every
+// variable, parameters included, is one contiguous array across the
+// catchments, in the order of the config files given to
+// ``initialize_catchments``, with catchment i's items at [i * n, (i + 1) * n)
+// where n is the number of items per catchment.  The standard BMI functions
+// then act on the whole model: ``get_var_nbytes`` reports the size of the
+// whole array, ``get_value``, ``get_value_ptr`` and ``set_value`` move the
+// values of every catchment at once, and ``update`` and ``update_until``
+// advance every catchment.  All catchments share one time axis, so the time
+// functions are unchanged.
+
+#ifndef BMI_VECTOR_H
+#define BMI_VECTOR_H
+
+#include "bmi.h"
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+typedef struct Bmi_Vector {
+    int (*initialize_catchments)(struct Bmi *self, int count, const char *const *config_files);
+} Bmi_Vector;
+
+#if defined(__cplusplus)
+}
+#endif
+
+#endif
@@ -28,12 +28,15 @@ struct test_bmi_c_model {
     double* output_var_1;
     double* output_var_2;
 
-    int param_var_1;
-    double param_var_2;
+    int* param_var_1;
+    double* param_var_2;
     double* param_var_3;
 
-    double mass_stored; // Mass balance variable, for testing purposes
-    double mass_leaked; //Mass balance variable, for testing purposes
+    double* mass_stored; // Mass balance variable, for testing purposes
+    double* mass_leaked; //Mass balance variable, for testing purposes
+
+    // Number of catchments held, each with its own items of every variable (see bmi_vector.h)
+    int catchment_count;
 };
 typedef struct test_bmi_c_model test_bmi_c_model;
 
@@ -55,8 +55,16 @@ static int Finalize (Bmi *self)
             free(model->output_var_1);
         if( model->output_var_2 != NULL )
             free(model->output_var_2);
+        if (model->param_var_1 != NULL )
+            free(model->param_var_1);
+        if (model->param_var_2 != NULL )
+            free(model->param_var_2);
         if (model->param_var_3 != NULL )
             free(model->param_var_3);
+        if (model->mass_stored != NULL )
+            free(model->mass_stored);
+        if (model->mass_leaked != NULL )
+            free(model->mass_leaked);
         free(self->data);
     }
 
@@ -165,7 +173,7 @@ static int Get_grid_shape(Bmi *self, int grid, int *shape)
 static int Get_grid_size(Bmi *self, int grid, int * size)
 {
     if (grid == 0) {
-        *size = 1;
+        *size = ((test_bmi_c_model *) self->data)->catchment_count;
         return BMI_SUCCESS;
     }
     else {
@@ -290,27 +298,22 @@ static int Get_time_units (Bmi *self, char * units)
 static int Get_value (Bmi *self, const char *name, void *dest)
 {
     int i = 0;
-    int item_count = -1;
+    // All the variables other than parameters are scalar
+    int item_count = 1;
     for (i = 0; i < PARAM_VAR_NAME_COUNT; i++) {
             if (strcmp(name, param_var_names[i]) == 0) {
                 item_count = param_var_item_count[i];
                 break;
             }
         }
-    
-    if( item_count < 1 ){
-        // Since all the variables are scalar, use nested call to "by index" version, with just index 0
-        int inds[] = {0};
-        return self->get_value_at_indices(self, name, dest, inds, 1);
-    }
-    else{
-        //All linear indicies
-        int inds[item_count];
-        for(i = 0; i < item_count; i++){
-            inds[i] = i;
-        }
-        return self->get_value_at_indices(self, name, dest, inds, item_count);
+    // Each catchment has its own items of every variable
+    item_count *= ((test_bmi_c_model *) self->data)->catchment_count;
+    //All linear indicies
+    int inds[item_count];
+    for(i = 0; i < item_count; i++){
+        inds[i] = i;
     }
+    return self->get_value_at_indices(self, name, dest, inds, item_count);
 }
 
 
@@ -382,12 +385,12 @@ static int Get_value_ptr (Bmi *self, const char *name, void **dest)
     }
 
     if (strcmp (name, "PARAM_VAR_1") == 0) {
-        *dest = &((test_bmi_c_model *)(self->data))->param_var_1;
+        *dest = ((test_bmi_c_model *)(self->data))->param_var_1;
         return BMI_SUCCESS;
     }
 
     if (strcmp (name, "PARAM_VAR_2") == 0) {
-        *dest = &((test_bmi_c_model *)(self->data))->param_var_2;
+        *dest = ((test_bmi_c_model *)(self->data))->param_var_2;
         return BMI_SUCCESS;
     }
 
@@ -405,11 +408,11 @@ static int Get_value_ptr (Bmi *self, const char *name, void **dest)
         return BMI_SUCCESS;
     }
     if (strcmp (name, NGEN_MASS_STORED) == 0) {
-        *dest = &((test_bmi_c_model *)(self->data))->mass_stored;
+        *dest = ((test_bmi_c_model *)(self->data))->mass_stored;
         return BMI_SUCCESS;
     }
     if (strcmp (name, NGEN_MASS_LEAKED) == 0) {
-        *dest = &((test_bmi_c_model *)(self->data))->mass_leaked;
+        *dest = ((test_bmi_c_model *)(self->data))->mass_leaked;
         return BMI_SUCCESS;
     }
     return BMI_FAILURE;
@@ -501,21 +504,24 @@ static int Get_var_nbytes (Bmi *self, const char *name, int * nbytes)
         }
     }
     if (item_count < 1) {
-        for (i = 0; i < PARAM_VAR_NAME_COUNT; i++) {
-            if (strcmp(name, param_var_names[i]) == 0) {
-                item_count = param_var_item_count[i];
+        for (i = 0; i < MASS_BALANCE_VAR_NAME_COUNT; i++) {
+            if (strcmp(name, mass_balance_var_names[i]) == 0) {
+                item_count = mass_balance_var_item_count[i];
                 break;
             }
         }
     }
     if (item_count < 1) {
-        for (i = 0; i < MASS_BALANCE_VAR_NAME_COUNT; i++) {
-            if (strcmp(name, mass_balance_var_names[i]) == 0) {
-                item_count = mass_balance_var_item_count[i];
+        for (i = 0; i < PARAM_VAR_NAME_COUNT; i++) {
+            if (strcmp(name, param_var_names[i]) == 0) {
+                item_count = param_var_item_count[i];
                 break;
             }
         }
     }
+    // Every catchment has its own items of the variables above
+    if (item_count > 0)
+        item_count *= ((test_bmi_c_model *) self->data)->catchment_count;
     if (item_count < 1)
         item_count = ((test_bmi_c_model *) self->data)->num_time_steps;
 
@@ -592,26 +598,37 @@ static int Get_var_units (Bmi *self, const char *name, char * units)
 
 
 /**
- * Execute model initialization.
+ * Execute model initialization for one or more catchments.
+ *
+ * Each config file is read in turn, so all of them must give the same time settings.
  *
  * @param self The BMI model instance
- * @param file The path to the BMI initialization file.
+ * @param count The number of catchments.
+ * @param files The paths to the BMI initialization file of each catchment.
  * @return The BMI return code indicating success or failure as appropriate.
  */
-static int Initialize (Bmi *self, const char *file)
+static int Initialize_catchments (Bmi *self, int count, const char *const *files)
 {
     test_bmi_c_model *model;
 
-    if (!self || !file)
+    if (!self || !files || count < 1)
         return BMI_FAILURE;
     else
         model = (test_bmi_c_model *) self->data;
 
-    model->mass_stored = 0.0;
-    model->mass_leaked = 0.0;
-
-    if (read_init_config(file, model) == BMI_FAILURE)
-        return BMI_FAILURE;
+    for (int i = 0; i < count; i++) {
+        long epoch_start_time = model->epoch_start_time;
+        int num_time_steps = model->num_time_steps;
+        int time_step_size = model->time_step_size;
+        if (!files[i] || read_init_config(files[i], model) == BMI_FAILURE)
+            return BMI_FAILURE;
+        if (i > 0 && (model->epoch_start_time != epoch_start_time || model->num_time_steps != num_time_steps
+                      || model->time_step_size != time_step_size)) {
+            printf("Config file '%s' has different time settings than the catchments before it\n", files[i]);
+            return BMI_FAILURE;
+        }
+    }
+    model->catchment_count = count;
 
     self->get_start_time(self, &(model->current_model_time));
 
@@ -631,21 +648,35 @@ static int Initialize (Bmi *self, const char *file)
         model->num_time_steps = (int)((model->model_end_time - model->current_model_time) / model->time_step_size);
     }
 
-    model->input_var_1 = malloc(sizeof(double));
-    model->input_var_2 = malloc(sizeof(double));
-    model->output_var_1 = malloc(sizeof(double));
-    model->output_var_2 = malloc(sizeof(double));
+    model->input_var_1 = malloc(count * sizeof(double));
+    model->input_var_2 = malloc(count * sizeof(double));
+    model->output_var_1 = malloc(count * sizeof(double));
+    model->output_var_2 = malloc(count * sizeof(double));
 
-    model->param_var_1 = 0;
-    model->param_var_2 = 0.0;
-    model->param_var_3 = malloc(2*sizeof(double));
-    model->param_var_3[0] = 0.0;
-    model->param_var_3[1] = 0.0;
+    model->mass_stored = calloc(count, sizeof(double));
+    model->mass_leaked = calloc(count, sizeof(double));
+
+    model->param_var_1 = calloc(count, sizeof(int));
+    model->param_var_2 = calloc(count, sizeof(double));
+    model->param_var_3 = calloc(2 * count, sizeof(double));
 
     return BMI_SUCCESS;
 }
 
 
+/**
+ * Execute model initialization.
+ *
+ * @param self The BMI model instance
+ * @param file The path to the BMI initialization file.
+ * @return The BMI return code indicating success or failure as appropriate.
+ */
+static int Initialize (Bmi *self, const char *file)
+{
+    return Initialize_catchments(self, 1, &file);
+}
+
+
 static int Set_value_at_indices (Bmi *self, const char *name, int * inds, int len, void *src)
 {
     if (len < 1)
@@ -755,6 +786,14 @@ test_bmi_c_model *new_bmi_model(void)
     data->input_var_2 = NULL;
     data->output_var_1 = NULL;
     data->output_var_2 = NULL;
+    data->param_var_1 = NULL;
+    data->param_var_2 = NULL;
+    data->param_var_3 = NULL;
+
+    data->mass_stored = NULL;
+    data->mass_leaked = NULL;
+
+    data->catchment_count = 1;
 
     return data;
 }
@@ -961,3 +1000,18 @@ Bmi* register_bmi(Bmi *model) {
 
     return model;
 }
+
+
+/**
+ * Register the @ref Bmi_Vector extension, through which one instance of this model can hold several catchments.
+ *
+ * @param extension A pointer to the @ref Bmi_Vector extension instance to register.
+ * @return A pointer to the passed-in @ref Bmi_Vector instance.
+ */
+Bmi_Vector* register_bmi_vector(Bmi_Vector *extension) {
+    if (extension) {
+        extension->initialize_catchments = Initialize_catchments;
+    }
+
+    return extension;
+}
@@ -9,17 +9,19 @@
  */
 extern int run(test_bmi_c_model* model, long dt)
 {
-    if (dt == model->time_step_size) {
-        *model->output_var_1 = *model->input_var_1;
-        *model->output_var_2 = 2.0 * *model->input_var_2;
-    }
-    else {
-        *model->output_var_1 = *model->input_var_1 * (double) dt / model->time_step_size;
-        *model->output_var_2 = 2.0 * *model->input_var_2 * (double) dt / model->time_step_size;
+    for (int i = 0; i < model->catchment_count; i++) {
+        if (dt == model->time_step_size) {
+            model->output_var_1[i] = model->input_var_1[i];
+            model->output_var_2[i] = 2.0 * model->input_var_2[i];
+        }
+        else {
+            model->output_var_1[i] = model->input_var_1[i] * (double) dt / model->time_step_size;
+            model->output_var_2[i] = 2.0 * model->input_var_2[i] * (double) dt / model->time_step_size;
+        }
+        model->mass_stored[i] = model->output_var_1[i] - model->input_var_1[i];
+        model->mass_leaked[i] = 0;
     }
     model->current_model_time += (double)dt;
 
-    model->mass_stored = *model->output_var_1 - *model->input_var_1;
-    model->mass_leaked = 0;
     return 0;
 }
\ No newline at end of file
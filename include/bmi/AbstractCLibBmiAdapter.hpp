@@ -46,6 +46,17 @@ namespace models {
              */
             void Finalize() override;
 
+            /**
+             * Whether the loaded dynamic model shared library exports the given symbol.
+             *
+             * Unlike @see dynamic_load_symbol, a missing symbol is not an error here, so this can be used to detect
+             * optional extensions a library may implement.  It is ``false`` if no library is loaded yet.
+             *
+             * @param symbol_name The name of the symbol to look for.
+             * @return Whether the loaded library exports the symbol.
+             */
+            bool exports_symbol(const std::string &symbol_name);
+
         protected:
 
             /**
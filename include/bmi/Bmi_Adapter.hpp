@@ -83,6 +83,32 @@ namespace models {
             virtual const std::string get_analogous_cxx_type(const std::string &external_type_name,
                                                              const size_t item_size) = 0;
 
+            /**
+             * Set the values of a variable from a buffer already holding them as the variable's analogous C++ type.
+             *
+             * This is the framework's path for setting model inputs at each time step.  Unlike the BMI ``SetValue``,
+             * it takes the name by reference, so adapters over APIs that take a C string can pass it on without a
+             * copy; by default it delegates to ``SetValue``.
+             *
+             * @param name The name of the variable to set.
+             * @param src Pointer to the values, of the type from @ref get_analogous_cxx_type.
+             */
+            virtual void set_value_from_buffer(const std::string &name, void *src) {
+                SetValue(name, src);
+            }
+
+            /**
+             * Whether ``GetValuePtr`` can return a pointer to the backing model's own storage for a variable.
+             *
+             * When this is ``true``, @ref GetValueView reads values in place instead of copying them out through
+             * ``GetValue``; by default it is ``false``.
+             *
+             * @return Whether ``GetValuePtr`` is supported for the backing model.
+             */
+            virtual bool has_value_ptr() const {
+                return false;
+            }
+
             /**
              * Initialize the wrapped BMI model functionality using the value from the `bmi_init_config` member variable
              * and the API's ``Initialize`` function.
@@ -6,6 +6,7 @@
 #include <string>
 
 #include "bmi.h"
+#include "bmi_vector.h"
 #include "AbstractCLibBmiAdapter.hpp"
 #include "State_Exception.hpp"
 #include "utilities/ExternalIntegrationException.hpp"
@@ -52,6 +53,26 @@ namespace models {
                           bool has_fixed_time_step,
                           std::string registration_func);
 
+            /**
+             * Public constructor for one model instance holding several catchments.
+             *
+             * The backing model struct is registered as usual, then initialized through the ``initialize_catchments``
+             * function of the library's @ref Bmi_Vector extension instead of ``initialize``, so it holds the state of
+             * every catchment in structure-of-arrays form (see bmi_vector.h).
+             *
+             * @param type_name The name of the backing BMI module/model type.
+             * @param library_file_path The string path to the shared library file for external module.
+             * @param catchment_init_configs The BMI initialization config file of each catchment, in catchment order.
+             * @param has_fixed_time_step Whether the model has a fixed time step size.
+             * @param registration_func The name for the @see bmi_registration_function.
+             * @param vector_registration_func The name of the library's function registering its @ref Bmi_Vector
+             *                                 extension.
+             * @throws ::external::ExternalIntegrationException If the library does not export the extension.
+             */
+            Bmi_C_Adapter(const std::string &type_name, std::string library_file_path,
+                          std::vector<std::string> catchment_init_configs, bool has_fixed_time_step,
+                          std::string registration_func, std::string vector_registration_func);
+
         protected:
 
             /**
@@ -234,6 +255,10 @@ namespace models {
                 return dest;
             }
 
+            bool has_value_ptr() const override {
+                return bmi_model != nullptr && bmi_model->get_value_ptr != nullptr;
+            }
+
             /**
              * Get a reference to the value(s) of a given variable.
              *
@@ -365,6 +390,8 @@ namespace models {
 
             void SetValue(std::string name, void *src) override;
 
+            void set_value_from_buffer(const std::string &name, void *src) override;
+
             template<class T>
             void SetValue(std::string name, std::vector<T> src) {
                 size_t item_size;
@@ -555,7 +582,9 @@ namespace models {
                     return;
                 bmi_model = std::make_unique<C_Bmi>(C_Bmi());
                 execModuleRegistration();
-                int init_result = bmi_model->initialize(bmi_model.get(), bmi_init_config.c_str());
+                int init_result = catchment_init_configs.empty()
+                                  ? bmi_model->initialize(bmi_model.get(), bmi_init_config.c_str())
+                                  : initialize_catchments();
                 if (init_result != BMI_SUCCESS) {
                     init_exception_msg = "Failure when attempting to initialize " + model_name;
                     throw models::external::State_Exception(init_exception_msg);
@@ -630,12 +659,25 @@ namespace models {
              */
             std::shared_ptr<std::vector<std::string>> inner_get_variable_names(bool is_input_variables);
 
+            /**
+             * Register the library's @ref Bmi_Vector extension and initialize the backing model with every config in
+             * @ref catchment_init_configs through it.
+             *
+             * @return The status returned by the extension's ``initialize_catchments``.
+             */
+            int initialize_catchments();
+
             // For unit testing
             friend class ::Bmi_C_Adapter_Test;
 
             /** Pointer to backing BMI model instance. */
             std::unique_ptr<C_Bmi> bmi_model = nullptr;
 
+            /** The init config of each catchment of a model holding several; empty for a single-catchment model. */
+            std::vector<std::string> catchment_init_configs;
+            /** Name of the library function registering its @ref Bmi_Vector extension, when holding several. */
+            std::string vector_registration_function;
+
         };
 
     }
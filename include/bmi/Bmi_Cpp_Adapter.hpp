@@ -238,6 +238,10 @@ namespace models {
                 return bmi_model->GetValuePtr(name);
             }
 
+            bool has_value_ptr() const override {
+                return bmi_model != nullptr;
+            }
+
             int GetVarItemsize(std::string name) override;
 
             int GetVarNbytes(std::string name) override;
@@ -344,6 +344,8 @@ namespace models {
 
             void SetValue(std::string name, void *src) override;
 
+            void set_value_from_buffer(const std::string &name, void *src) override;
+
             /**
              * Set the given BMI input variable, sourcing values from the given vector.
              *
@@ -0,0 +1,257 @@
+#ifndef NGEN_BMI_VECTOR_MODEL_HPP
+#define NGEN_BMI_VECTOR_MODEL_HPP
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Bmi_Adapter.hpp"
+
+namespace models {
+    namespace bmi {
+
+        /**
+         * One backing model instance holding several catchments in structure-of-arrays form, as set out in
+         * bmi_vector.h, shared by a @ref Bmi_Vector_Slot_Adapter for each catchment.
+         *
+         * Each slot presents its catchment as an ordinary model.  Values set through a slot are staged in an array
+         * per input variable spanning every catchment, and a slot's ``Update`` only queues its catchment.  Once every
+         * catchment is queued, @ref update sets each staged input with one ``SetValue`` and advances the model with
+         * one ``Update`` (or ``UpdateUntil``), after which the slots read their part of the model's arrays in place.
+         *
+         * The model and its slots are not thread-safe; all catchments sharing one must be advanced on one thread.
+         */
+        class Bmi_Vector_Model {
+
+        public:
+
+            /**
+             * @param model The backing model, already initialized for @p count catchments.
+             * @param count The number of catchments the model holds.
+             * @throws std::invalid_argument If @p model is null or @p count is not positive.
+             */
+            Bmi_Vector_Model(std::shared_ptr<Bmi_Adapter> model, int count);
+
+            /**
+             * Get the number of catchments the model holds.
+             *
+             * @return The number of catchments the model holds.
+             */
+            int get_count() const {
+                return count;
+            }
+
+            /**
+             * Get the backing model, which holds every catchment.
+             *
+             * @return The backing model.
+             */
+            Bmi_Adapter &get_model() {
+                return *model;
+            }
+
+            /**
+             * Set every staged input and advance the backing model once for all catchments.
+             *
+             * @throws std::runtime_error If not every catchment has been queued by its slot's ``Update`` or
+             *                            ``UpdateUntil`` since the last update.
+             */
+            void update();
+
+        private:
+
+            friend class Bmi_Vector_Slot_Adapter;
+
+            /** Layout of one variable's array and its staged and cached values. */
+            struct Variable {
+                /** The size, in bytes, of one catchment's part of the array. */
+                std::size_t slot_nbytes = 0;
+                /** The size, in bytes, of each item. */
+                std::size_t item_size = 0;
+                /** Values set through the slots since the last update, for every catchment. */
+                std::vector<char> staged;
+                /** Whether @ref staged holds values to set at the next update. */
+                bool is_staged = false;
+                /** Copy of the model's values, for models without ``GetValuePtr``. */
+                std::vector<char> cached;
+                /** Whether @ref cached holds the model's current values. */
+                bool is_cached = false;
+            };
+
+            /**
+             * Get the layout of a variable, reading it from the backing model the first time.
+             *
+             * @throws std::runtime_error If the variable's size is not a multiple of the number of catchments.
+             */
+            Variable &variable(const std::string &name);
+
+            /**
+             * Get a pointer to a catchment's current values of a variable.
+             *
+             * Values staged since the last update take precedence; otherwise this points into the model's own
+             * storage, or into a copy of it taken once per update when the model does not support ``GetValuePtr``.
+             */
+            char *slot_values(const std::string &name, int index);
+
+            /**
+             * Stage values of a variable for a catchment, to be set at the next update.
+             *
+             * @param inds Indices, within the catchment's part, of the items to set, or null to set all of them.
+             * @param item_count The number of items in @p inds.
+             */
+            void stage(const std::string &name, int index, const void *src, const int *inds, int item_count);
+
+            /**
+             * Queue a catchment for the next update, with the time to update until if not by a single time step.
+             *
+             * @throws std::runtime_error If the catchment is already queued, or asks for a different update than the
+             *                            catchments queued before it.
+             */
+            void queue_update(int index, std::optional<double> until);
+
+            std::shared_ptr<Bmi_Adapter> model;
+            int count;
+            std::map<std::string, Variable> variables;
+            /** Whether each catchment is queued for the next update. */
+            std::vector<bool> is_queued;
+            int queued_count = 0;
+            /** The time to update until, if the queued catchments asked for ``UpdateUntil``. */
+            std::optional<double> queued_until;
+        };
+
+        /**
+         * Adapter presenting one catchment of a @ref Bmi_Vector_Model as a model of its own.
+         *
+         * Variables are the catchment's part of the shared model's arrays, so their sizes are those of a model
+         * holding just that catchment, and their values are read in place.  Setting values and ``Update`` are deferred
+         * to @ref Bmi_Vector_Model::update.  Time and variable metadata come from the shared model; grid functions
+         * other than ``GetGridSize`` describe the shared model's grids.
+         *
+         * The shared model is finalized when the last slot (and any other owner) releases it, not by ``Finalize``.
+         */
+        class Bmi_Vector_Slot_Adapter : public Bmi_Adapter {
+
+        public:
+
+            /**
+             * @param vector_model The shared model.
+             * @param index The catchment's position in @p vector_model.
+             * @param bmi_init_config The catchment's BMI initialization config file.
+             * @throws std::out_of_range If @p index is not a catchment of @p vector_model.
+             */
+            Bmi_Vector_Slot_Adapter(std::shared_ptr<Bmi_Vector_Model> vector_model, int index,
+                                    std::string bmi_init_config);
+
+            int get_index() const {
+                return index;
+            }
+
+            bool is_model_initialized() override;
+
+            const std::string get_analogous_cxx_type(const std::string &external_type_name,
+                                                     const size_t item_size) override;
+
+            void set_value_from_buffer(const std::string &name, void *src) override;
+
+            bool has_value_ptr() const override {
+                return true;
+            }
+
+            void Update() override;
+
+            void UpdateUntil(double time) override;
+
+            void Finalize() override;
+
+            std::string GetComponentName() override;
+
+            int GetInputItemCount() override;
+
+            int GetOutputItemCount() override;
+
+            std::vector<std::string> GetInputVarNames() override;
+
+            std::vector<std::string> GetOutputVarNames() override;
+
+            int GetVarGrid(std::string name) override;
+
+            std::string GetVarType(std::string name) override;
+
+            std::string GetVarUnits(std::string name) override;
+
+            int GetVarItemsize(std::string name) override;
+
+            int GetVarNbytes(std::string name) override;
+
+            std::string GetVarLocation(std::string name) override;
+
+            double GetCurrentTime() override;
+
+            double GetStartTime() override;
+
+            double GetEndTime() override;
+
+            std::string GetTimeUnits() override;
+
+            double GetTimeStep() override;
+
+            void GetValue(std::string name, void *dest) override;
+
+            void *GetValuePtr(std::string name) override;
+
+            void GetValueAtIndices(std::string name, void *dest, int *inds, int count) override;
+
+            void SetValue(std::string name, void *src) override;
+
+            void SetValueAtIndices(std::string name, int *inds, int count, void *src) override;
+
+            int GetGridRank(const int grid) override;
+
+            int GetGridSize(const int grid) override;
+
+            std::string GetGridType(const int grid) override;
+
+            void GetGridShape(const int grid, int *shape) override;
+
+            void GetGridSpacing(const int grid, double *spacing) override;
+
+            void GetGridOrigin(const int grid, double *origin) override;
+
+            void GetGridX(const int grid, double *x) override;
+
+            void GetGridY(const int grid, double *y) override;
+
+            void GetGridZ(const int grid, double *z) override;
+
+            int GetGridNodeCount(const int grid) override;
+
+            int GetGridEdgeCount(const int grid) override;
+
+            int GetGridFaceCount(const int grid) override;
+
+            void GetGridEdgeNodes(const int grid, int *edge_nodes) override;
+
+            void GetGridFaceEdges(const int grid, int *face_edges) override;
+
+            void GetGridFaceNodes(const int grid, int *face_nodes) override;
+
+            void GetGridNodesPerFace(const int grid, int *nodes_per_face) override;
+
+        protected:
+
+            /** The shared model is initialized before any slot is made, so there is nothing to do here. */
+            void construct_and_init_backing_model() override { }
+
+        private:
+
+            std::shared_ptr<Bmi_Vector_Model> vector_model;
+            int index;
+        };
+
+    }
+}
+
+#endif //NGEN_BMI_VECTOR_MODEL_HPP
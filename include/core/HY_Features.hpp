@@ -2,8 +2,10 @@
 #define HY_FEATURES_H
 
 #include <unordered_map>
+#include <map>
 #include <set>
 #include <memory>
+#include <vector>
 
 #include <HY_Catchment.hpp>
 #include <HY_HydroNexus.hpp>
@@ -122,6 +124,8 @@ namespace hy_features {
         /**
          * @brief An iterator of only the catchment feature ids
          * 
+         * This re-filters the network on every iteration; prefer @ref catchment_ids in repeated loops.
+         * 
          * @return auto 
          */
         inline auto catchments(){return network.filter(hy_features::identifiers::catchment);}
@@ -144,10 +148,38 @@ namespace hy_features {
         /**
          * @brief An iterator of only the nexus feature ids
          * 
+         * This re-filters the network on every iteration; prefer @ref nexus_ids in repeated loops.
+         * 
          * @return auto 
          */
         inline auto nexuses() const { return network.filter(hy_features::identifiers::nexus); }
 
+        /**
+         * @brief The catchment feature ids, in the same order as @ref catchments(), materialized at construction
+         */
+        const std::vector<std::string>& catchment_ids() const { return _catchment_ids; }
+
+        /**
+         * @brief The catchment feature ids of layer @p lyr, in the same order as @ref catchments(long)
+         * 
+         * Empty if no catchment is in @p lyr.
+         */
+        const std::vector<std::string>& catchment_ids(long lyr) const
+        {
+          auto iter = _layer_catchment_ids.find(lyr);
+          return iter != _layer_catchment_ids.end() ? iter->second : empty_ids;
+        }
+
+        /**
+         * @brief The nexus feature ids, in the same order as @ref nexuses(), materialized at construction
+         */
+        const std::vector<std::string>& nexus_ids() const { return _nexus_ids; }
+
+        /**
+         * @brief The nexus pointers, positionally aligned with @ref nexus_ids
+         */
+        const std::vector<HY_HydroNexus*>& nexus_pointers() const { return _nexus_pointers; }
+
         /**
          * @brief Get a vector of destination (downstream) nexus pointers.
          * 
@@ -177,7 +209,7 @@ namespace hy_features {
          */
         void validate_dendritic()
         {
-          for(const auto& id : catchments())
+          for(const auto& id : catchment_ids())
           {
               auto downstream = network.get_destination_ids(id);
               if(downstream.size() > 1)
@@ -207,6 +239,12 @@ namespace hy_features {
 
       private:
 
+        /**
+         * @brief Materialize the per-type and per-layer id and pointer views from the network and feature maps.
+         * 
+         */
+        void index_features();
+
         /**
          * @brief Internal mapping of catchment id -> HY_Catchment pointer.
          * 
@@ -230,6 +268,17 @@ namespace hy_features {
         */
         std::set<long> hf_layers;
 
+        /**
+         * @brief Views built once by index_features(), in network filter order.
+         * 
+         */
+        std::vector<std::string> _catchment_ids;
+        std::map<long, std::vector<std::string>> _layer_catchment_ids;
+        std::vector<std::string> _nexus_ids;
+        std::vector<HY_HydroNexus*> _nexus_pointers;
+
+        static inline const std::vector<std::string> empty_ids{};
+
     };
 }
 
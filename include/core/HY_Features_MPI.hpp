@@ -6,11 +6,14 @@
 #if NGEN_WITH_MPI
 
 #include <unordered_map>
+#include <map>
 #include <set>
 #include <memory>
+#include <vector>
 
 #include <HY_Catchment.hpp>
 #include <HY_PointHydroNexusRemote.hpp>
+#include <HY_RemoteNexusExchange.hpp>
 #include <network.hpp>
 #include <Partition_Parser.hpp>
 
@@ -71,8 +74,41 @@ namespace hy_features {
                 boost::adaptors::filtered([this](std::string const& id){ return !is_remote_sender_nexus(id);});
         }
 
+        /**
+         * @brief The catchment feature ids, in the same order as @ref catchments(), materialized at construction
+         */
+        const std::vector<std::string>& catchment_ids() const { return _catchment_ids; }
+
+        /**
+         * @brief The catchment feature ids of layer @p lyr, in the same order as @ref catchments(long)
+         *
+         * Empty if no catchment is in @p lyr.
+         */
+        const std::vector<std::string>& catchment_ids(long lyr) const {
+            auto iter = _layer_catchment_ids.find(lyr);
+            return iter != _layer_catchment_ids.end() ? iter->second : empty_ids;
+        }
+
+        /**
+         * @brief The local (not remote sender) nexus ids, in the same order as @ref nexuses(), materialized at construction
+         */
+        const std::vector<std::string>& nexus_ids() const { return _nexus_ids; }
+
+        /**
+         * @brief The local nexus pointers, positionally aligned with @ref nexus_ids
+         */
+        const std::vector<HY_HydroNexus*>& nexus_pointers() const { return _nexus_pointers; }
+
+        /**
+         * @brief Move this partition's boundary flows for timestep @p t to and from the neighboring ranks.
+         *
+         * Must be called on every rank once per timestep, after all local catchments have contributed their flow
+         * and before any local nexus flow for @p t is requested.
+         */
+        void exchange_remote_flows(long t) { _exchange->exchange(t); }
+
         void validate_dendritic() {
-            for(const auto& id : catchments()) {
+            for(const auto& id : catchment_ids()) {
                 auto downstream = network.get_destination_ids(id);
                 if(downstream.size() > 1) {
                     std::cerr << "Catchment " << id << " has more than one downstream connection." << std::endl;
@@ -92,7 +128,10 @@ namespace hy_features {
         }
 
       private:
-      
+
+      //! Materialize the per-type and per-layer id and pointer views from the network and feature maps.
+      void index_features();
+
       std::unordered_map<std::string, std::shared_ptr<HY_Catchment>> _catchments;
       std::unordered_map<std::string, std::shared_ptr<HY_PointHydroNexusRemote>> _nexuses;
       network::Network network;
@@ -100,6 +139,17 @@ namespace hy_features {
       int mpi_rank;
       int mpi_num_procs;
 
+      // Views built once by index_features(), in network filter order
+      std::vector<std::string> _catchment_ids;
+      std::map<long, std::vector<std::string>> _layer_catchment_ids;
+      std::vector<std::string> _nexus_ids;
+      std::vector<HY_HydroNexus*> _nexus_pointers;
+
+      //! Batched boundary flow exchange for all remote nexuses of this partition
+      std::unique_ptr<HY_RemoteNexusExchange> _exchange;
+
+      static inline const std::vector<std::string> empty_ids{};
+
     };
 } 
 #endif //NGEN_WITH_MPI
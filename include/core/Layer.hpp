@@ -8,7 +8,9 @@
 #include "State_Exception.hpp"
 #include "geojson/FeatureBuilder.hpp"
 #include <boost/core/span.hpp>
+#include <exception>
 #include <memory>
+#include <vector>
 
 namespace hy_features
 {
@@ -16,7 +18,12 @@ namespace hy_features
     class HY_Features_MPI;
 }
 
-namespace utils { class CatchmentOutputsMgr; }
+namespace utils { class CatchmentOutputsMgr; class WorkerPool; }
+
+namespace realization { class Catchment_Formulation; class Formulation_Group; }
+
+class HY_HydroNexus;
+class HY_DensePointHydroNexus;
 
 namespace ngen
 {
@@ -108,6 +115,18 @@ namespace ngen
         */
         const std::string& get_time_step_units() const { return this->description.time_step_units; }
 
+        /***
+         * @brief Advance this layer's catchments concurrently on @p pool within each timestep
+         *
+         * Only formulations reporting @ref realization::Catchment_Formulation::is_concurrency_safe are run on the
+         * pool; the rest run on the calling thread. Nexus contributions and outputs are still applied in
+         * processing-unit order after all catchments have advanced, so results do not depend on the pool size.
+         * A null pool (the default) keeps the serial loop.
+         *
+         * @param pool Shared worker pool, or null for serial execution
+        */
+        void set_worker_pool(std::shared_ptr<utils::WorkerPool> pool) { worker_pool = std::move(pool); }
+
         /***
          * @brief Run one simulation timestep for each model in this layer
         */
@@ -119,6 +138,75 @@ namespace ngen
 
         protected:
 
+        /***
+         * @brief Per-catchment state resolved once, so the timestep loop does no lookups by id
+        */
+        struct CatchmentPlanEntry {
+            //! Points into @ref processing_units
+            const std::string* id = nullptr;
+            realization::Catchment_Formulation* formulation = nullptr;
+            //! Catchment area (km^2) from the "areasqkm" property, or "area_sqkm" when that is absent
+            double area_sqkm = 0.0;
+            //! First destination nexus; null if the catchment has none
+            HY_HydroNexus* downstream = nullptr;
+            //! @ref downstream when it is a dense nexus, so contributions can go straight to its slot
+            HY_DensePointHydroNexus* dense_downstream = nullptr;
+            std::size_t upstream_index = 0;
+            //! Position in the routing outflow buffer (routing builds only)
+            int outflow_index = -1;
+            //! Whether the formulation may be advanced on the worker pool
+            bool concurrent = false;
+        };
+
+        /***
+         * @brief Catchments whose formulations share one model instance, advanced together each timestep
+        */
+        struct FormulationGroupEntry {
+            std::shared_ptr<realization::Formulation_Group> group;
+            //! Processing-unit indexes of the members, in the order the group was made with
+            std::vector<std::size_t> units;
+        };
+
+        /***
+         * @brief Resolve formulations, areas and downstream nexuses for every processing unit into @ref plan
+         *
+         * Catchments whose formulations report the same @ref realization::Catchment_Formulation::get_group_key are
+         * also bound to one shared model here, into @ref formulation_groups.
+         *
+         * Called once, on the first timestep, after all features and formulations exist.
+        */
+        void compile_plan(std::unordered_map<std::string, int> const& catchment_indexes);
+
+        /***
+         * @brief Run the formulation for @p entry through the current timestep and check its mass balance
+         *
+         * Failures are rethrown with the timestep and feature id appended to the message.
+         *
+         * @return The formulation's response for the timestep
+        */
+        double advance_catchment(const CatchmentPlanEntry& entry, const std::string& current_timestamp);
+
+        /***
+         * @brief Advance the shared model of @p group_entry through the current timestep
+         *
+         * Afterwards, @ref advance_catchment for each member only reads its results.  Failures are rethrown with the
+         * timestep, and the feature id when a single member failed, appended to the message.
+        */
+        void advance_group(const FormulationGroupEntry& group_entry, const std::string& current_timestamp);
+
+        /***
+         * @brief Apply a catchment's response for the current timestep to routing and its destination nexus
+        */
+        void contribute_response(const CatchmentPlanEntry& entry, double response,
+                                 boost::span<double> catchment_outflows);
+
+        /***
+         * @brief Advance every processing unit for the current timestep using @ref worker_pool
+         *
+         * Fills @ref step_responses, @ref step_outputs and @ref step_errors by processing-unit index.
+        */
+        void advance_catchments_concurrently(const std::string& current_timestamp);
+
         const LayerDescription description;
         //TODO is this really required at the top level?
         //See "minimum" constructor above used for DomainLayer impl...
@@ -130,6 +218,24 @@ namespace ngen
         long output_time_index;
         //! Catchment output sink for this layer's per-timestep push; null when output is disabled.
         std::shared_ptr<utils::CatchmentOutputsMgr> catchment_output_mgr = nullptr;
+        //! Pool for concurrent catchment execution; null when running serially.
+        std::shared_ptr<utils::WorkerPool> worker_pool = nullptr;
+
+        //! Resolved per-catchment state, parallel to @ref processing_units; empty until the first timestep.
+        std::vector<CatchmentPlanEntry> plan;
+        bool plan_compiled = false;
+        //! Groups of catchments sharing a model instance, each advanced once per timestep before the catchments.
+        std::vector<FormulationGroupEntry> formulation_groups;
+
+        private:
+
+        //! Processing-unit indexes that may run on the pool, and those that must stay on the calling thread.
+        std::vector<std::size_t> concurrent_units;
+        std::vector<std::size_t> serial_units;
+        //! Per-timestep results of the concurrent pass, by processing-unit index.
+        std::vector<double> step_responses;
+        std::vector<std::vector<double>> step_outputs;
+        std::vector<std::exception_ptr> step_errors;
 
     };
 }
@@ -0,0 +1,325 @@
+#ifndef PARTITION_GENERATOR_H
+#define PARTITION_GENERATOR_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <network.hpp>
+
+// Assignment of a hydrofabric's catchments to partitions, shared by the partitionGenerator tool and its tests.
+
+using PartitionVSet = std::vector<std::unordered_set<std::string> >;
+
+/**
+ * @brief Relative cost of simulating each catchment, keyed by catchment id
+ *
+ * Catchments that are not listed have a weight of 1, except terminal sentinels, which are never simulated and
+ * have a weight of 0.
+ */
+using CatchmentWeights = std::unordered_map<std::string, double>;
+
+/**
+ * @brief Summary of how well a partitioning balances load and limits communication
+ */
+struct PartitionQuality
+{
+    //! Catchment-to-downstream-catchment links whose ends are on different partitions
+    int cut_edges = 0;
+    //! Nexuses with contributing and receiving catchments on different partitions
+    int boundary_nexuses = 0;
+    double max_weight = 0.0;
+    double mean_weight = 0.0;
+
+    //! How much the heaviest partition exceeds the mean, as a fraction
+    double imbalance() const { return mean_weight > 0.0 ? max_weight / mean_weight - 1.0 : 0.0; }
+};
+
+/**
+ * @brief Add the nexuses connected to @p catchment to a partition's @p nexus_set
+ *
+ * Some of these will end up being "remote" but still must be present in the
+ * list of all required nexus the partition needs to worry about
+ */
+inline void add_catchment_nexuses(network::Network& network, const std::string& catchment, std::unordered_set<std::string>& nexus_set)
+{
+    for( auto downstream : network.get_destination_ids(catchment) ){
+        nexus_set.emplace(downstream);
+    }
+    if(nexus_set.size() == 0 && catchment.find("SENTINEL") == std::string::npos){
+        std::cerr<<"Error: Catchment "<<catchment<<" has no destination nexus.\n";
+        exit(1);
+    }
+    for( auto upstream : network.get_origination_ids(catchment) ){
+        nexus_set.emplace(upstream);
+    }
+}
+
+/**
+ * @brief Check that no catchment was assigned to more than one partition, reporting any duplicates
+ */
+inline void validate_partitions(const PartitionVSet& catchment_part)
+{
+    // validating catchment partition
+    std::cout << "Validating catchments..." << std::endl;
+    std::vector<std::string> cat_id_vec;
+    for (int i =0; i < catchment_part.size(); ++i) {
+        const std::unordered_set<std::string>& cat_set = catchment_part[i];
+        // convert unordered_set to vector
+        for (const auto &it: cat_set) {
+            cat_id_vec.push_back(it);
+        }
+    }
+    //sort ids
+    std::sort(cat_id_vec.begin(), cat_id_vec.end());
+    //create set of unique ids
+    std::set<std::string> unique(cat_id_vec.begin(), cat_id_vec.end());
+    std::set<std::string> duplicates;
+    //use set difference to identify all duplicates
+    std::set_difference(cat_id_vec.begin(), cat_id_vec.end(), unique.begin(), unique.end(), std::inserter(duplicates, duplicates.end()));
+    if( duplicates.size() > 0 ){
+        for( auto& id: duplicates){
+            std::cout << "catchment "<<id<<" is duplicated!"<<std::endl;
+        }
+    }
+    std::cout << "\nNumber of catchments is: " << cat_id_vec.size();
+    std::cout << "\nCatchment validation completed" << std::endl;
+}
+
+/**
+ * @brief Weight of @p catchment according to @p weights
+ *
+ * @return The listed weight, 0 for terminal sentinels, otherwise 1
+ */
+inline double catchment_weight(const CatchmentWeights& weights, const std::string& catchment)
+{
+    auto iter = weights.find(catchment);
+    if ( iter != weights.end() ) {
+        return iter->second;
+    }
+    return catchment.find("SENTINEL") == std::string::npos ? 1.0 : 0.0;
+}
+
+/**
+ * @brief Read per-catchment weights from a CSV file of `id,weight` lines
+ *
+ * A first line whose weight column is not numeric is treated as a header. Blank lines are skipped.
+ *
+ * @param path Path to the CSV file
+ * @return CatchmentWeights The weights by catchment id
+ *
+ * @throws runtime_error if the file can not be read, or a line is malformed or has a negative weight
+ */
+inline CatchmentWeights read_catchment_weights(const std::string& path)
+{
+    std::ifstream in(path);
+    if ( !in ) {
+        throw std::runtime_error("read_catchment_weights: could not open weights file "+path);
+    }
+
+    CatchmentWeights weights;
+    std::string line;
+    int line_number = 0;
+    while ( std::getline(in, line) ) {
+        ++line_number;
+        boost::algorithm::trim(line);
+        if ( line.empty() ) {
+            continue;
+        }
+        auto comma = line.find(',');
+        if ( comma == std::string::npos ) {
+            throw std::runtime_error("read_catchment_weights: expected 'id,weight' on line "+std::to_string(line_number)+" of "+path);
+        }
+        std::string id = boost::algorithm::trim_copy(line.substr(0, comma));
+        std::string value = boost::algorithm::trim_copy(line.substr(comma + 1));
+        double weight;
+        try {
+            weight = boost::lexical_cast<double>(value);
+        }
+        catch(boost::bad_lexical_cast &e) {
+            if ( line_number == 1 ) {
+                continue; // header
+            }
+            throw std::runtime_error("read_catchment_weights: invalid weight '"+value+"' on line "+std::to_string(line_number)+" of "+path);
+        }
+        if ( weight < 0.0 || !std::isfinite(weight) ) {
+            throw std::runtime_error("read_catchment_weights: weight of "+id+" must be a non-negative number");
+        }
+        weights[id] = weight;
+    }
+    return weights;
+}
+
+/**
+ * @brief Generate partitions that keep connected catchments together while balancing catchment weights.
+ *
+ * Catchments are laid out in depth first order from the outlets upstream, so each upstream subtree occupies a
+ * contiguous run of the list, and the list is then split into @p num_partitions runs. Each split is placed where
+ * the running weight is within @p imbalance of the remaining mean partition weight and, within that window, where
+ * the fewest catchment-to-downstream-catchment links cross the split. Splits therefore fall between whole subtrees
+ * wherever the weight tolerance allows, which keeps the number of boundary nexuses low.
+ *
+ * @param network
+ * @param num_partitions
+ * @param weights Per-catchment weights; see CatchmentWeights for the defaults
+ * @param imbalance Allowed deviation of a partition's weight from the mean, as a fraction
+ * @param catchment_part  - which catchments will be simulation on each partition
+ * @param nexus_part - which nexuses have contributing catchments on each partition
+ *
+ * @throws invalid_argument if @p num_partitions is not positive or exceeds the number of catchments
+ */
+inline void generate_topology_partitions(network::Network& network, const int& num_partitions, const CatchmentWeights& weights,
+                                         double imbalance, PartitionVSet& catchment_part, PartitionVSet& nexus_part)
+{
+    std::vector<std::string> catchments;
+    for( const auto& catchment : network.filter("cat", network::SortOrder::TransposedDepthFirstPreorder) ){
+        catchments.push_back(catchment);
+    }
+    const std::size_t n = catchments.size();
+
+    // every partition gets at least one catchment, which the split search below relies on
+    if( num_partitions <= 0 || static_cast<std::size_t>(num_partitions) > n ){
+        throw std::invalid_argument("generate_topology_partitions: cannot split " + std::to_string(n) + " catchments into "
+                                    + std::to_string(num_partitions) + " partitions; the number of partitions must be "
+                                    "between 1 and the number of catchments");
+    }
+
+    std::unordered_map<std::string, std::size_t> position;
+    position.reserve(n);
+    for( std::size_t i = 0; i < n; ++i ){
+        position[catchments[i]] = i;
+    }
+
+    // prefix_weight[p] is the total weight of the catchments before position p
+    std::vector<double> prefix_weight(n + 1, 0.0);
+    for( std::size_t i = 0; i < n; ++i ){
+        prefix_weight[i + 1] = prefix_weight[i] + catchment_weight(weights, catchments[i]);
+    }
+
+    // crossing[p] is the number of catchment links cut by splitting the list before position p;
+    // a link between positions a < b is cut by every split in (a, b]
+    std::vector<int> crossing(n + 1, 0);
+    for( std::size_t i = 0; i < n; ++i ){
+        for( const auto& nexus : network.get_destination_ids(catchments[i]) ){
+            for( const auto& downstream : network.get_destination_ids(nexus) ){
+                auto iter = position.find(downstream);
+                if( iter == position.end() ){
+                    continue;
+                }
+                std::size_t a = std::min(i, iter->second);
+                std::size_t b = std::max(i, iter->second);
+                crossing[a + 1] += 1;
+                crossing[b + 1] -= 1;
+            }
+        }
+    }
+    for( std::size_t p = 1; p <= n; ++p ){
+        crossing[p] += crossing[p - 1];
+    }
+
+    const double mean_weight = prefix_weight[n] / num_partitions;
+    std::size_t start = 0;
+    for( int part = 0; part < num_partitions; ++part ){
+        int remaining_parts = num_partitions - part;
+        std::size_t split = n;
+        if( remaining_parts > 1 ){
+            // leave at least one catchment for each remaining partition
+            std::size_t first = start + 1;
+            std::size_t last = n - (remaining_parts - 1);
+            double target = (prefix_weight[n] - prefix_weight[start]) / remaining_parts;
+            double goal = prefix_weight[start] + target;
+            // aim for the mean of what remains, but never let this or a later partition exceed the tolerance over
+            // the overall mean
+            double window_low = std::max(goal - target * imbalance,
+                                         prefix_weight[n] - (remaining_parts - 1) * mean_weight * (1.0 + imbalance));
+            double window_high = std::min(goal + target * imbalance, prefix_weight[start] + mean_weight * (1.0 + imbalance));
+
+            auto lower = std::lower_bound(prefix_weight.begin() + first, prefix_weight.begin() + last + 1, window_low);
+            auto upper = std::upper_bound(prefix_weight.begin() + first, prefix_weight.begin() + last + 1, window_high);
+            std::size_t lo = lower - prefix_weight.begin();
+            std::size_t hi = upper - prefix_weight.begin();
+            if( lo >= hi ){
+                // no split falls in the tolerance window, so take the one closest to the goal
+                lo = std::min<std::size_t>(std::max<std::size_t>(lo, first), last);
+                if( lo > first && goal - prefix_weight[lo - 1] < prefix_weight[lo] - goal ){
+                    --lo;
+                }
+                hi = lo + 1;
+            }
+
+            split = lo;
+            for( std::size_t p = lo; p < hi; ++p ){
+                if( crossing[p] < crossing[split] ||
+                    (crossing[p] == crossing[split] && std::abs(prefix_weight[p] - goal) < std::abs(prefix_weight[split] - goal)) ){
+                    split = p;
+                }
+            }
+        }
+
+        std::unordered_set<std::string> catchment_set, nexus_set;
+        catchment_set.reserve(split - start);
+        for( std::size_t i = start; i < split; ++i ){
+            add_catchment_nexuses(network, catchments[i], nexus_set);
+            catchment_set.emplace(catchments[i]);
+        }
+        catchment_part.push_back(std::move(catchment_set));
+        nexus_part.push_back(std::move(nexus_set));
+        start = split;
+    }
+
+    validate_partitions(catchment_part);
+}
+
+/**
+ * @brief Measure the edge cut and load balance of a partitioning
+ *
+ * @param network
+ * @param catchment_part The catchments on each partition
+ * @param weights Per-catchment weights; see CatchmentWeights for the defaults
+ * @return PartitionQuality
+ */
+inline PartitionQuality evaluate_partitions(network::Network& network, const PartitionVSet& catchment_part, const CatchmentWeights& weights)
+{
+    PartitionQuality quality;
+    std::unordered_map<std::string, int> partition_of;
+    double total_weight = 0.0;
+    for( int i = 0; i < catchment_part.size(); ++i ){
+        double weight = 0.0;
+        for( const auto& catchment : catchment_part[i] ){
+            partition_of[catchment] = i;
+            weight += catchment_weight(weights, catchment);
+        }
+        quality.max_weight = std::max(quality.max_weight, weight);
+        total_weight += weight;
+    }
+    quality.mean_weight = catchment_part.empty() ? 0.0 : total_weight / catchment_part.size();
+
+    std::unordered_set<std::string> boundary_nexuses;
+    for( const auto& entry : partition_of ){
+        for( const auto& nexus : network.get_destination_ids(entry.first) ){
+            for( const auto& downstream : network.get_destination_ids(nexus) ){
+                auto iter = partition_of.find(downstream);
+                if( iter != partition_of.end() && iter->second != entry.second ){
+                    ++quality.cut_edges;
+                    boundary_nexuses.emplace(nexus);
+                }
+            }
+        }
+    }
+    quality.boundary_nexuses = boundary_nexuses.size();
+    return quality;
+}
+
+#endif // PARTITION_GENERATOR_H
@@ -0,0 +1,213 @@
+#ifndef PARTITION_INDEX_H
+#define PARTITION_INDEX_H
+
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <istream>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+
+#include "Partition_Data.hpp"
+
+/**
+ * Reader and writer for the line-indexed partition config format.
+ *
+ * Unlike the JSON partition config, which every rank must parse in full, this format starts with a table of
+ * fixed-width byte offsets, one per partition, so a rank can seek straight to its own section and read only its
+ * own ids and remote connections:
+ *
+ * @code
+ * ngen-partition-index 1
+ * <number of partitions>
+ * <offset of partition 0, 20 digits>
+ * ...
+ * partition <id> <catchment count> <nexus count> <remote connection count>
+ * <catchment id>            (one per line)
+ * <nexus id>                (one per line)
+ * <mpi-rank>\t<nex-id>\t<cat-id>\t<cat-direction>   (one per line)
+ * ...
+ * @endcode
+ */
+class Partition_Index {
+
+    public:
+        //! First line of every partition index file
+        static inline const std::string MAGIC = "ngen-partition-index 1";
+
+        /**
+         * Write @p partitions in the indexed format.
+         *
+         * @param out A seekable output stream; the offset table is filled in after the sections are written
+         * @param partitions The partitions, in partition id order
+         */
+        static void write(std::ostream& out, const std::vector<PartitionData>& partitions)
+        {
+            out << MAGIC << '\n' << partitions.size() << '\n';
+            std::streampos table_start = out.tellp();
+            for (std::size_t i = 0; i < partitions.size(); ++i) {
+                write_offset(out, 0);
+            }
+
+            std::vector<std::streamoff> offsets;
+            offsets.reserve(partitions.size());
+            for (const auto& part : partitions) {
+                offsets.push_back(out.tellp());
+                out << "partition " << part.mpi_world_rank << ' ' << part.catchment_ids.size() << ' '
+                    << part.nexus_ids.size() << ' ' << part.remote_connections.size() << '\n';
+                for (const auto& id : part.catchment_ids) {
+                    out << checked_id(id) << '\n';
+                }
+                for (const auto& id : part.nexus_ids) {
+                    out << checked_id(id) << '\n';
+                }
+                for (const auto& remote : part.remote_connections) {
+                    out << std::get<0>(remote) << '\t' << checked_id(std::get<1>(remote)) << '\t'
+                        << checked_id(std::get<2>(remote)) << '\t' << checked_id(std::get<3>(remote)) << '\n';
+                }
+            }
+            std::streampos end = out.tellp();
+
+            out.seekp(table_start);
+            for (auto offset : offsets) {
+                write_offset(out, offset);
+            }
+            out.seekp(end);
+            if (!out) {
+                throw std::runtime_error("Partition_Index: failed to write partition index");
+            }
+        }
+
+        /**
+         * Read the partition with id @p part_id, skipping over every other partition's data.
+         *
+         * @throws std::runtime_error if the stream is not a partition index, or @p part_id is not in it
+         */
+        static PartitionData read_partition(std::istream& in, int part_id)
+        {
+            std::string line;
+            if (!std::getline(in, line) || line != MAGIC) {
+                throw std::runtime_error("Partition_Index: not a partition index (missing '" + MAGIC + "' header)");
+            }
+            long num_partitions = -1;
+            if (!std::getline(in, line) || !parse_long(line, num_partitions) || num_partitions < 0) {
+                throw std::runtime_error("Partition_Index: invalid partition count '" + line + "'");
+            }
+            if (part_id < 0 || part_id >= num_partitions) {
+                throw std::runtime_error("Partition_Index: partition " + std::to_string(part_id) + " requested but the index holds "
+                                         + std::to_string(num_partitions) + " partitions");
+            }
+
+            in.seekg(in.tellg() + static_cast<std::streamoff>(part_id) * OFFSET_LINE_WIDTH);
+            long offset = -1;
+            if (!std::getline(in, line) || !parse_long(line, offset) || offset <= 0) {
+                throw std::runtime_error("Partition_Index: invalid offset for partition " + std::to_string(part_id));
+            }
+            in.seekg(offset);
+
+            PartitionData part;
+            std::size_t num_catchments, num_nexuses, num_remotes;
+            std::string keyword;
+            if (!std::getline(in, line)) {
+                throw std::runtime_error("Partition_Index: missing section for partition " + std::to_string(part_id));
+            }
+            std::istringstream header(line);
+            if (!(header >> keyword >> part.mpi_world_rank >> num_catchments >> num_nexuses >> num_remotes)
+                || keyword != "partition" || part.mpi_world_rank != part_id) {
+                throw std::runtime_error("Partition_Index: malformed section header '" + line + "' for partition "
+                                         + std::to_string(part_id));
+            }
+
+            part.catchment_ids.reserve(num_catchments);
+            for (std::size_t i = 0; i < num_catchments; ++i) {
+                part.catchment_ids.emplace(read_line(in, part_id));
+            }
+            part.nexus_ids.reserve(num_nexuses);
+            for (std::size_t i = 0; i < num_nexuses; ++i) {
+                part.nexus_ids.emplace(read_line(in, part_id));
+            }
+            part.remote_connections.reserve(num_remotes);
+            for (std::size_t i = 0; i < num_remotes; ++i) {
+                line = read_line(in, part_id);
+                std::istringstream fields(line);
+                std::string rank, nex_id, cat_id, direction;
+                long remote_rank;
+                if (!std::getline(fields, rank, '\t') || !std::getline(fields, nex_id, '\t')
+                    || !std::getline(fields, cat_id, '\t') || !std::getline(fields, direction)
+                    || !parse_long(rank, remote_rank)) {
+                    throw std::runtime_error("Partition_Index: malformed remote connection '" + line + "' in partition "
+                                             + std::to_string(part_id));
+                }
+                part.remote_connections.emplace_back(static_cast<int>(remote_rank), nex_id, cat_id, direction);
+            }
+            return part;
+        }
+
+        /**
+         * Read the partition with id @p part_id from the partition index at @p file_path.
+         */
+        static PartitionData read_partition(const std::string& file_path, int part_id)
+        {
+            std::ifstream in(file_path, std::ios::binary);
+            if (!in) {
+                throw std::runtime_error("Partition_Index: could not open " + file_path);
+            }
+            return read_partition(in, part_id);
+        }
+
+        /**
+         * Test whether @p file_path holds a partition index, as opposed to a JSON partition config.
+         */
+        static bool is_index_file(const std::string& file_path)
+        {
+            std::ifstream in(file_path, std::ios::binary);
+            std::string line;
+            return in && std::getline(in, line) && line == MAGIC;
+        }
+
+    private:
+        //! 20 zero-padded digits plus the newline
+        static constexpr std::streamoff OFFSET_LINE_WIDTH = 21;
+
+        static void write_offset(std::ostream& out, std::streamoff offset)
+        {
+            out << std::setw(OFFSET_LINE_WIDTH - 1) << std::setfill('0') << static_cast<std::int64_t>(offset) << '\n';
+        }
+
+        static const std::string& checked_id(const std::string& id)
+        {
+            if (id.find_first_of("\t\n") != std::string::npos) {
+                throw std::runtime_error("Partition_Index: id '" + id + "' can not contain tabs or newlines");
+            }
+            return id;
+        }
+
+        static bool parse_long(const std::string& s, long& value)
+        {
+            try {
+                std::size_t used;
+                value = std::stol(s, &used);
+                return used == s.size();
+            }
+            catch (std::exception&) {
+                return false;
+            }
+        }
+
+        static std::string read_line(std::istream& in, int part_id)
+        {
+            std::string line;
+            // every line is newline terminated, so reaching the end of the stream means the file was cut short
+            if (!std::getline(in, line) || in.eof()) {
+                throw std::runtime_error("Partition_Index: partition " + std::to_string(part_id) + " is truncated");
+            }
+            return line;
+        }
+};
+
+#endif // PARTITION_INDEX_H
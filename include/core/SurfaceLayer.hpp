@@ -35,7 +35,25 @@ namespace ngen
                            int current_step) override;
 
         private:
+
+        /***
+         * @brief Per-nexus state resolved once, so the nexus output loop does no lookups by id
+        */
+        struct NexusPlanEntry {
+            std::string id;
+            HY_HydroNexus* nexus = nullptr;
+            //! Id of the single receiving catchment, or "terminal" for an outlet
+            std::string requester;
+            //! Position in the routing nexus flow buffer (routing builds only)
+            int flow_index = -1;
+        };
+
+        //! Resolve every nexus in the layer's features into @ref nexus_plan.
+        void compile_nexus_plan(std::unordered_map<std::string, int> const& nexus_indexes);
+
         std::shared_ptr<utils::NexusOutputsMgr> nexus_outputs_mgr;
+        std::vector<NexusPlanEntry> nexus_plan;
+        bool nexus_plan_compiled = false;
     };
 }
 
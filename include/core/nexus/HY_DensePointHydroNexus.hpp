@@ -0,0 +1,108 @@
+#ifndef HY_DENSEPOINTHYDRONEXUS_H
+#define HY_DENSEPOINTHYDRONEXUS_H
+
+#include <HY_HydroNexus.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A point nexus whose flow bookkeeping lives in a fixed-size ring of timestep slots.
+ *
+ * Behaves like @ref HY_PointHydroNexus through the @ref HY_HydroNexus interface, but instead of hash maps
+ * keyed by timestep (and a per-contribution copy of the catchment id), each slot of the ring holds one
+ * pre-sized double per contributing catchment, indexed by that catchment's position in the contributing
+ * list. Slot ``t % window`` is reused once ``t`` moves ``window`` steps past its previous occupant, so
+ * memory is bounded by ``window * (contributing catchments + 1)`` doubles regardless of run length.
+ *
+ * Timesteps that have fallen out of the window are expired: adding to or requesting from them throws
+ * @ref invalid_time_step, just as @ref HY_PointHydroNexus does for timesteps before its minimum time. All
+ * other errors are reported with the same exception types as @ref HY_PointHydroNexus as well.
+ */
+class HY_DensePointHydroNexus : public HY_HydroNexus
+{
+    public:
+        //! Number of timesteps kept when no window is given.
+        static constexpr std::size_t DEFAULT_WINDOW = 4;
+
+        HY_DensePointHydroNexus(std::string nexus_id, Catchments receiving_catchments,
+                                std::size_t window = DEFAULT_WINDOW);
+        HY_DensePointHydroNexus(std::string nexus_id, Catchments receiving_catchments,
+                                Catchments contributing_catchments, std::size_t window = DEFAULT_WINDOW);
+        virtual ~HY_DensePointHydroNexus();
+
+        /** get the request percentage of downstream flow through this nexus at timestep t. */
+        double get_downstream_flow(std::string catchment_id, time_step_t t, double percent_flow) override;
+
+        /** add flow to this nexus for timestep t. */
+        void add_upstream_flow(double val, std::string catchment_id, time_step_t t) override;
+
+        /**
+         * @brief Add flow to this nexus for timestep t from the contributing catchment at @p upstream_index.
+         *
+         * Equivalent to the id-based overload without the id lookup.
+         *
+         * @param val The flow to add
+         * @param upstream_index Position of the contributing catchment, as returned by @ref upstream_index
+         * @param t The timestep the flow applies to
+         */
+        void add_upstream_flow(double val, std::size_t upstream_index, time_step_t t);
+
+        /** inspect a nexus to see what flows are recorded at a time step. */
+        std::pair<double, int> inspect_upstream_flows(time_step_t t) override;
+
+        /** inspect a nexus to see what requests are recorded at a time step. */
+        std::pair<double, int> inspect_downstream_requests(time_step_t t) override;
+
+        /** get the units that flows are represented in. */
+        std::string get_flow_units() override;
+
+        /**
+         * @brief Position of @p catchment_id among this nexus's contributing catchments.
+         *
+         * @return The index, or @ref npos if the catchment is not a listed contributor
+         */
+        std::size_t upstream_index(const std::string& catchment_id) const;
+
+        //! Number of timesteps held by the ring.
+        std::size_t window() const { return slots.size(); }
+
+        static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    private:
+        enum class SlotState : std::uint8_t { empty, open, summed, completed };
+
+        struct Slot {
+            time_step_t t = -1;
+            SlotState state = SlotState::empty;
+            //! Number of upstream contributions received (repeat contributions count separately).
+            int contributions = 0;
+            //! Flow from catchments that are not listed contributors.
+            double unlisted_flow = 0.0;
+            double summed_flow = 0.0;
+            double total_requests = 0.0;
+            int requests = 0;
+        };
+
+        //! Slot for @p t if it currently holds that timestep, else null; throws if @p t has expired.
+        Slot* find_slot(time_step_t t);
+
+        //! Slot for @p t, claiming (and clearing) its ring position if needed; throws if @p t has expired.
+        Slot& claim_slot(time_step_t t);
+
+        //! Contribution row for the slot at ring position @p pos.
+        double* contributions_for(std::size_t pos) { return upstream_flows.data() + pos * n_upstream; }
+
+        void add_to_slot(Slot& slot, double val, std::size_t upstream_index);
+
+        std::size_t n_upstream;
+        std::vector<Slot> slots;
+        //! Flattened window x n_upstream contribution values.
+        std::vector<double> upstream_flows;
+        //! Newest timestep seen; anything at or before newest - window has expired.
+        time_step_t newest_timestep{-1};
+};
+
+#endif // HY_DENSEPOINTHYDRONEXUS_H
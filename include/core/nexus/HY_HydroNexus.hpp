@@ -44,12 +44,12 @@ class HY_HydroNexus
     virtual std::string get_flow_units()=0;
     
     /** Get the catchments that receive flow from this hydro nexus */
-    const Catchments& get_receiving_catchments() {
+    const Catchments& get_receiving_catchments() const {
         return receiving_catchments;
     }
 
     /** Get the catchments that contribute flow to this hydro nexus */
-    const Catchments& get_contributing_catchments() {
+    const Catchments& get_contributing_catchments() const {
     return contributing_catchments;
     }
 
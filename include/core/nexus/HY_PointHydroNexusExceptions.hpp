@@ -0,0 +1,36 @@
+#ifndef HY_POINTHYDRONEXUSEXCEPTIONS_H
+#define HY_POINTHYDRONEXUSEXCEPTIONS_H
+
+#include <exception>
+#include <string>
+
+#include <boost/exception/all.hpp>
+
+typedef boost::error_info<struct tag_errmsg, std::string> errmsg_info;
+
+struct invalid_downstream_request : public boost::exception, public std::exception
+{
+  const char *what() const noexcept override { return "All downstream catchments can not request more than 100% of flux in total"; }
+};
+
+struct add_to_summed_nexus : public boost::exception, public std::exception
+{
+  const char *what() const noexcept override { return "Can not add water to a summed point nexus"; }
+};
+
+struct request_from_empty_nexus : public boost::exception, public std::exception
+{
+  const char *what() const noexcept override { return "Can not release water from an empty nexus"; }
+};
+
+struct completed_time_step : public boost::exception, public std::exception
+{
+  const char *what() const noexcept override { return "Can not operate on a completed time step"; }
+};
+
+struct invalid_time_step : public boost::exception, public std::exception
+{
+  const char *what() const noexcept override { return "Time step before minimum time step requested"; }
+};
+
+#endif // HY_POINTHYDRONEXUSEXCEPTIONS_H
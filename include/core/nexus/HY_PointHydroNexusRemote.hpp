@@ -19,7 +19,15 @@
 *
 *   When attempting to add upstream flows from a remote catchment a MPI_Irecv call will be generated
 *   When attempting to send flows to remote downstream a MPI_Send will be generated
-*   In either case the change in local water amounts for the time step will be recorded when the MPI operation completes */
+*   In either case the change in local water amounts for the time step will be recorded when the MPI operation completes
+*
+*   When the nexus belongs to a @ref HY_RemoteNexusExchange no messages are generated by the nexus itself; flows only
+*   cross ranks when the exchange runs for a time step */
+
+class HY_RemoteNexusExchange;
+
+/** Abort the MPI job if @p status is not MPI_SUCCESS */
+void MPI_Handle_Error(int status);
 
 class HY_PointHydroNexusRemote : public HY_PointHydroNexus
 {
@@ -35,7 +43,7 @@ class HY_PointHydroNexusRemote : public HY_PointHydroNexus
         virtual ~HY_PointHydroNexusRemote();
 
         /** get the request percentage of downstream flow through this nexus at timestep t. If the indicated catchment is not local a async send will be
-            created. Will attempt to process all async receives currently queued before processing flows*/
+            created. Will wait for all async receives currently queued before processing flows*/
         double get_downstream_flow(std::string catchment_id, time_step_t t, double percent_flow) override;
 
         /** add flow to this nexus for timestep t. If the indicated catchment is not local an async receive will be started*/
@@ -70,9 +78,19 @@ class HY_PointHydroNexusRemote : public HY_PointHydroNexus
         /** return the communicator type for this nexus */
 		communication_type get_communicator_type() { return type; }
 
+        /** Test if this nexus exchanges its flows through a @ref HY_RemoteNexusExchange rather than its own messages */
+        bool is_batched() const { return batched; }
+
     private:
+        friend class HY_RemoteNexusExchange;
+
         void post_receives();
         void process_communications();
+        /** block until every posted receive has completed and its flow is recorded */
+        void wait_for_receives();
+
+        /** set by the owning exchange, which then does all communication for this nexus */
+        bool batched = false;
 
         int world_rank;
 
@@ -0,0 +1,109 @@
+#ifndef HY_REMOTENEXUSEXCHANGE_H
+#define HY_REMOTENEXUSEXCHANGE_H
+
+#include <NGenConfig.h>
+#if NGEN_WITH_MPI
+
+#include <HY_PointHydroNexusRemote.hpp>
+#include <mpi.h>
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * @brief Moves the boundary flows of a partition's remote nexuses in at most two messages per neighbor rank per timestep.
+ *
+ * Without an exchange, every @ref HY_PointHydroNexusRemote sends its own message to its downstream rank as soon
+ * as its local contributions are in, and receiving nexuses poll for their messages when flow is requested. With
+ * an exchange, the remote nexuses only do local bookkeeping; once all local catchments have contributed for a
+ * timestep, @ref exchange packs the outgoing flow of the sending nexuses bound for the same rank into shared
+ * buffers, sends them to each downstream neighbor, and blocks until the messages from every upstream neighbor
+ * have arrived and been credited to the receiving nexuses. The number of messages per step therefore depends on
+ * the number of neighboring ranks rather than the number of boundary nexuses.
+ *
+ * A nexus with remote catchments both upstream and downstream of this rank (a sender_receiver) relays: the flows
+ * its upstream ranks send are credited to it first, and then its whole flow, local and relayed, is sent on. Relayed
+ * nexuses therefore travel in a second message per neighbor, sent once the messages carrying their upstream flows
+ * have been credited, while the first message, holding every other nexus, is sent right away. A relay message only
+ * waits on messages that carry the same nexus, so two ranks that relay flows to each other never wait on each
+ * other. Construction tells each receiving rank which of its nexuses arrive in which message.
+ *
+ * Each side orders the nexuses of a message by id, so the position of a flow in a buffer is implied and only the
+ * timestep is sent alongside the flows. Messages use persistent requests on a private duplicate of the
+ * communicator, so they never match the per-nexus messages.
+ *
+ * Construction is collective over the communicator, and every rank must call @ref exchange once per timestep,
+ * in timestep order.
+ */
+class HY_RemoteNexusExchange
+{
+    public:
+        using time_step_t = HY_HydroNexus::time_step_t;
+
+        /**
+         * @brief Set up the exchange for @p nexuses and switch them to batched communication.
+         *
+         * Nexuses that are local to this rank are ignored.
+         *
+         * @param nexuses All nexuses of this rank's partition
+         * @param comm The communicator the nexus ranks refer to
+         */
+        HY_RemoteNexusExchange(const std::vector<HY_PointHydroNexusRemote*>& nexuses, MPI_Comm comm = MPI_COMM_WORLD);
+
+        HY_RemoteNexusExchange(const HY_RemoteNexusExchange&) = delete;
+        HY_RemoteNexusExchange& operator=(const HY_RemoteNexusExchange&) = delete;
+
+        ~HY_RemoteNexusExchange();
+
+        /**
+         * @brief Send this rank's boundary flows for timestep @p t and credit those received from its neighbors.
+         *
+         * Must be called after every local catchment has contributed its flow for @p t, and before flow for
+         * @p t is requested from any receiving nexus.
+         */
+        void exchange(time_step_t t);
+
+        //! Number of ranks this rank sends boundary flows to.
+        std::size_t downstream_neighbor_count() const { return downstream_neighbors; }
+
+        //! Number of ranks this rank receives boundary flows from.
+        std::size_t upstream_neighbor_count() const { return upstream_neighbors; }
+
+    private:
+        //! Tags of the two flow messages a rank may send to each neighbor, and of the message describing their layout
+        enum message_tag { immediate_tag = 0, relay_tag = 1, layout_tag = 2 };
+
+        struct Message
+        {
+            int rank;
+            int tag;
+            //! Nexuses whose flows this message carries, ordered by id
+            std::vector<HY_PointHydroNexusRemote*> nexuses;
+            //! The timestep followed by one flow per nexus
+            std::vector<double> buffer;
+            //! Indexes in @ref receives of the messages that must be credited before this one is sent
+            std::vector<std::size_t> relay_sources;
+        };
+
+        //! Fill @p message's buffer with the full flow of each of its nexuses for timestep @p t.
+        void pack(Message& message, time_step_t t);
+
+        //! Add the flows received in @p message for timestep @p t to its nexuses.
+        void credit(Message& message, MPI_Status& status, time_step_t t);
+
+        std::vector<Message> receives;
+        std::vector<Message> sends;
+        std::size_t upstream_neighbors = 0;
+        std::size_t downstream_neighbors = 0;
+        //! Persistent requests for @ref receives followed by those for @ref sends
+        std::vector<MPI_Request> requests;
+        std::vector<MPI_Status> statuses;
+        //! Per-timestep progress of @ref receives and @ref sends
+        std::vector<bool> credited;
+        std::vector<bool> started;
+
+        MPI_Comm exchange_comm = MPI_COMM_NULL;
+};
+
+#endif // NGEN_WITH_MPI
+#endif // HY_REMOTENEXUSEXCHANGE_H
@@ -40,6 +40,9 @@ struct forcing_params
   std::string provider;
   time_t simulation_start_t;
   time_t simulation_end_t;
+  size_t read_ahead = 0; //number of forcing pages a provider may read ahead of the simulation; 0 disables read-ahead
+  bool node_shared_cache = false; //whether MPI ranks on a node share one cache of forcing pages
+  std::string weights_cache; //file keeping the weights of the grid cells within the catchments, for gridded forcings
   /*
     Constructor for forcing_params
   */
@@ -0,0 +1,152 @@
+#ifndef NGEN_BINARY_FORCING_DATAPROVIDER_HPP
+#define NGEN_BINARY_FORCING_DATAPROVIDER_HPP
+
+#include "GenericDataProvider.hpp"
+#include "DataProviderSelectors.hpp"
+#include "BinaryForcingFile.hpp"
+
+#include <ctime>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <mediator/UnitsHelper.hpp>
+
+namespace data_access
+{
+    /**
+     * @brief A provider of lumped catchment forcings from a memory-mapped @ref BinaryForcingFile.
+     *
+     * The whole file is mapped when the provider is constructed, so a value is a weighted sum over the contiguous
+     * time series of one feature, read straight from the page cache.  Variables may be requested by the names in
+     * the file or, for the names in @ref WellKnownFields, by any of their aliases.  Files are written by
+     * @ref write_binary_forcing, or the forcingConverter tool, from another provider.
+     */
+    class BinaryForcingDataProvider : public GenericDataProvider
+    {
+        public:
+
+        /**
+         * @brief Factory method that creates or returns an existing provider for the provided path.
+         * @param input_path The path to a binary forcing file.
+         * @param sim_start The start of the simulation, as a seconds-based epoch time.
+         * @param sim_end The start of the last time step of the simulation, as a seconds-based epoch time.
+         */
+        static std::shared_ptr<BinaryForcingDataProvider> get_shared_provider(const std::string& input_path, time_t sim_start, time_t sim_end);
+
+        /**
+         * @brief Cleanup the shared providers cache, ensuring that the files get unmapped.
+         */
+        static void cleanup_shared_providers();
+
+        /**
+         * @throws std::runtime_error If the file can not be mapped or is not a valid binary forcing file.
+         */
+        BinaryForcingDataProvider(const std::string& input_path, time_t sim_start, time_t sim_end);
+
+        /** Return the variables that are accessable by this data provider */
+        boost::span<const std::string> get_available_variable_names() const override;
+
+        /** Queries only read the mapped file, so catchments may share this provider across threads. */
+        bool supports_concurrent_access() const override { return true; }
+
+        /** return a list of ids in the current file */
+        const std::vector<std::string>& get_ids() const;
+
+        /** Return the first valid time for which data from the request variable  can be requested */
+        long get_data_start_time() const override;
+
+        /** Return the last valid time for which data from the requested variable can be requested */
+        long get_data_stop_time() const override;
+
+        long record_duration() const override;
+
+        /**
+         * Get the index of the data time step that contains the given point in time.
+         *
+         * @param epoch_time The point in time, as a seconds-based epoch time.
+         * @return The index of the forcing time step that contains the given point in time.
+         * @throws std::out_of_range If the given point is not in any time step.
+         */
+        size_t get_ts_index_for_time(const time_t &epoch_time) const override;
+
+        /**
+         * Get the value of a forcing property for an arbitrary time period, converting units if needed.
+         *
+         * Each time step contributes in proportion to how much of it is in the window.  With @ref SUM, a time
+         * step's value is taken as its total over the step; with any other method the result is the time-weighted
+         * mean of the values in the window.  A window running past the end of the file is cut off at the end.
+         *
+         * @param selector Data required to establish what subset of the stored data should be accessed
+         * @param m How data is to be resampled if there is a mismatch in data alignment or repeat rate
+         * @return The value of the forcing property for the described time period, with units converted if needed.
+         * @throws std::out_of_range If data for the time period is not available, or the id is not in the file.
+         * @throws std::runtime_error If the variable is not in the file.
+         */
+        double get_value(const CatchmentAggrDataSelector& selector, ReSampleMethod m) override;
+
+        std::vector<double> get_values(const CatchmentAggrDataSelector& selector, ReSampleMethod m) override;
+
+        /**
+         * Get the value of a forcing property for an arbitrary time period for many catchments at once.
+         *
+         * The time step weights and the units converter are resolved once for the whole set.
+         *
+         * @see DataProvider::get_values_for_ids
+         * @throws std::out_of_range If data for the time period is not available, or an id is not in the file.
+         */
+        void get_values_for_ids(const CatchmentAggrDataSelector& selector, boost::span<const std::string> ids,
+                                boost::span<double> values, ReSampleMethod m=SUM) override;
+
+        private:
+
+        static std::mutex shared_providers_mutex;
+        static std::map<std::string, std::shared_ptr<BinaryForcingDataProvider>> shared_providers;
+
+        time_t sim_start_date_time_epoch;
+        time_t sim_end_date_time_epoch;
+
+        BinaryForcingFile file;
+        std::string file_path;
+        std::vector<std::string> variable_names;                       // file names first, then aliases
+        std::unordered_map<std::string, std::size_t> variable_index;   // any accepted name to its index in the file
+        std::unordered_map<std::string, std::size_t> id_pos;
+
+        std::size_t get_variable_index(const std::string& name) const;
+
+        /**
+         * @brief Get the values of the window and variable of @p selector for the features at @p rows in the file.
+         *
+         * @param values Storage for the values, the same size as @p rows
+         */
+        void evaluate(const CatchmentAggrDataSelector& selector, boost::span<const std::size_t> rows,
+                      boost::span<double> values, ReSampleMethod m) const;
+    };
+
+    /**
+     * @brief A provider to copy into a binary forcing file, and the ids to copy from it.
+     */
+    struct binary_forcing_source
+    {
+        std::shared_ptr<GenericDataProvider> provider;
+        std::vector<std::string> ids;
+    };
+
+    /**
+     * @brief Write the forcings of one or more providers to a binary forcing file.
+     *
+     * Every variable of @ref WellKnownFields that all of the providers have is written, under its canonical name and
+     * in its well-known units, for the time steps from @p start_time to @p end_time inclusive at the providers' time
+     * step; the value of each is the mean over the time step.  The features of the file are the ids of each source
+     * in turn.
+     *
+     * @throws std::runtime_error If the sources have no variables in common, or their time steps differ.
+     */
+    void write_binary_forcing(const std::string& path, const std::vector<binary_forcing_source>& sources,
+                              time_t start_time, time_t end_time);
+}
+
+#endif // NGEN_BINARY_FORCING_DATAPROVIDER_HPP
@@ -0,0 +1,114 @@
+#ifndef NGEN_BINARY_FORCING_FILE_HPP
+#define NGEN_BINARY_FORCING_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace data_access
+{
+    /**
+     * @brief A memory-mapped file of per-feature forcing values in a simple columnar binary format.
+     *
+     * The file holds a complete (variable, feature, time) array of doubles on a uniform time axis, so each
+     * feature's time series for a variable is contiguous and is read straight from the mapped pages, with no
+     * parsing or decompression.  Processes on a node that map the same file share its pages in the OS page cache.
+     *
+     * Layout, with all integers and values in the byte order of the machine that wrote the file:
+     *
+     * @code
+     * char[8]   magic "NGENFRC1"
+     * uint32    byte order mark 0x01020304
+     * uint32    reserved, 0
+     * uint64    number of variables (V)
+     * uint64    number of features (N)
+     * uint64    number of time steps (T)
+     * int64     start of the first time step, in seconds since the Unix epoch
+     * int64     length of a time step, in seconds
+     * uint64    byte offset of the values, a multiple of 4096
+     * V x (variable name, variable units)   each string a uint32 byte length and the bytes
+     * N x (feature id)
+     * ...       zero padding to the values offset
+     * V x N x T float64 values; variable v, feature i, time step t is at index (v * N + i) * T + t
+     * @endcode
+     */
+    class BinaryForcingFile
+    {
+        public:
+
+        //! First eight bytes of every binary forcing file
+        static constexpr char MAGIC[8] = {'N', 'G', 'E', 'N', 'F', 'R', 'C', '1'};
+
+        /**
+         * @brief Everything in the header of a file: the shape of its values and what they are.
+         */
+        struct Layout
+        {
+            std::vector<std::string> variables;
+            std::vector<std::string> units;     //!< units of each variable, in the same order
+            std::vector<std::string> ids;       //!< feature ids
+            std::time_t start_time = 0;         //!< start of the first time step, as a seconds-based epoch time
+            std::time_t time_step = 0;          //!< length of each time step, in seconds
+            std::size_t time_steps = 0;         //!< number of time steps
+        };
+
+        /**
+         * @brief Map an existing binary forcing file for reading.
+         *
+         * @throws std::runtime_error If the file can not be mapped or is not a valid binary forcing file.
+         */
+        static BinaryForcingFile open(const std::string& path);
+
+        /**
+         * @brief Create a binary forcing file with the given layout, replacing any file at @p path.
+         *
+         * The file is mapped for writing with all values 0; fill it through @ref mutable_series and call @ref sync (or
+         * let the object be destroyed) to write it out.
+         *
+         * @throws std::runtime_error If the layout is empty or inconsistent, or the file can not be created.
+         */
+        static BinaryForcingFile create(const std::string& path, const Layout& layout);
+
+        BinaryForcingFile(const BinaryForcingFile&) = delete;
+        BinaryForcingFile& operator=(const BinaryForcingFile&) = delete;
+        BinaryForcingFile(BinaryForcingFile&& other) noexcept;
+        BinaryForcingFile& operator=(BinaryForcingFile&& other) noexcept;
+        ~BinaryForcingFile();
+
+        const Layout& layout() const { return header; }
+
+        /**
+         * @brief The time series of variable @p var_idx for feature @p feature_idx, @ref Layout::time_steps long.
+         */
+        const double* series(std::size_t var_idx, std::size_t feature_idx) const
+        {
+            return values + (var_idx * header.ids.size() + feature_idx) * header.time_steps;
+        }
+
+        /**
+         * @brief Writable access to a time series of a file opened with @ref create.
+         *
+         * @throws std::logic_error If the file was opened for reading.
+         */
+        double* mutable_series(std::size_t var_idx, std::size_t feature_idx);
+
+        //! Flush written values to the file
+        void sync();
+
+        private:
+
+        BinaryForcingFile() = default;
+
+        void unmap() noexcept;
+
+        Layout header;
+        void* mapping = nullptr;
+        std::size_t mapping_size = 0;
+        double* values = nullptr;
+        bool writable = false;
+    };
+}
+
+#endif // NGEN_BINARY_FORCING_FILE_HPP
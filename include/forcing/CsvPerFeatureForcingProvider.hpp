@@ -5,12 +5,13 @@
 #include <set>
 #include <cmath>
 #include <algorithm>
+#include <charconv>
+#include <string_view>
 #include <string>
 #include <fstream>
 #include <iostream>
 #include <unordered_map>
 #include <boost/algorithm/string.hpp>
-#include <boost/lexical_cast.hpp>
 #include "CSV_Reader.h"
 #include <ctime>
 #include <time.h>
@@ -33,8 +34,7 @@ class CsvPerFeatureForcingProvider : public data_access::GenericDataProvider
 
     CsvPerFeatureForcingProvider(forcing_params forcing_config):start_date_time_epoch(forcing_config.simulation_start_t),
                                            end_date_time_epoch(forcing_config.simulation_end_t),
-                                           current_date_time_epoch(forcing_config.simulation_start_t),
-                                           forcing_vector_index(-1)
+                                           current_date_time_epoch(forcing_config.simulation_start_t)
     {
         read_csv(forcing_config.path);
     }
@@ -67,7 +67,7 @@ class CsvPerFeatureForcingProvider : public data_access::GenericDataProvider
      * @return The duration of one record of this forcing source
      */
     long record_duration() const override {
-        return time_epoch_vector[1] - time_epoch_vector[0];
+        return time_step;
     }
 
     /**
@@ -80,30 +80,22 @@ class CsvPerFeatureForcingProvider : public data_access::GenericDataProvider
      * @throws std::out_of_range If the given point is not in any time step.
      */
     size_t get_ts_index_for_time(const time_t &epoch_time) const override {
-        if (epoch_time < start_date_time_epoch) {
+        if (epoch_time < axis_start_epoch) {
             throw std::out_of_range("Forcing had bad pre-start time for index query: " + std::to_string(epoch_time));
         }
-        size_t i = 0;
-        // 1 hour
-        time_t seconds_in_time_step = 3600;
-        time_t time = start_date_time_epoch;
-        while (epoch_time >= time + seconds_in_time_step && time < end_date_time_epoch) {
-           i++;
-           time += seconds_in_time_step;
-        }
-        // The end_date_time_epoch is the epoch value of the BEGINNING of the last time step, not its end.
-        // I.e., to make sure we cover it, we have to go another time step beyond.
-        if (time >= end_date_time_epoch + 3600) {
+        size_t i = (epoch_time - axis_start_epoch) / time_step;
+        if (i >= time_steps) {
             throw std::out_of_range("Forcing had bad beyond-end time for index query: " + std::to_string(epoch_time));
         }
-        else {
-            return i;
-        }
+        return i;
     }
 
     /**
      * Get the value of a forcing property for an arbitrary time period, converting units if needed.
      *
+     * Each time step counts for the part of it that is in the period.  A period that runs past the end of the data
+     * takes the last value of the data, unweighted.
+     *
      * An @ref std::out_of_range exception should be thrown if the data for the time period is not available.
      *
      * @param selector Object storing information about the data to be queried
@@ -113,59 +105,43 @@ class CsvPerFeatureForcingProvider : public data_access::GenericDataProvider
      */
     double get_value(const CatchmentAggrDataSelector& selector, data_access::ReSampleMethod m) override
     {
-        size_t current_index;
-        long time_remaining = selector.get_duration_secs();
-        auto init_time = selector.get_init_time();
-        auto output_name = selector.get_variable_name();
-        auto output_units = selector.get_output_units();
+        const variable_lookup& lookup = get_variable_lookup(selector.get_variable_name());
+        forcing_variable& variable = variables[lookup.slot];
+        const time_t init_time = selector.get_init_time();
+        const long duration = selector.get_duration_secs();
 
-        try {
-            current_index = get_ts_index_for_time(init_time);
-        }
-        catch (const std::out_of_range &e) {
+        if (time_steps == 0 || init_time < axis_start_epoch) {
             throw std::out_of_range("Forcing had bad init_time " + std::to_string(init_time) + " for value request");
         }
 
-        std::vector<double> involved_time_step_values;
-
-        std::vector<long> involved_time_step_seconds;
-        long ts_involved_s;
-
-        time_t first_time_step_start_epoch = start_date_time_epoch + (current_index * 3600);
-        // Handle the first time step differently, since we need to do more to figure out how many seconds came from it
-        // Total time step size minus the offset of the beginning, before the init time
-        ts_involved_s = 3600 - (init_time - first_time_step_start_epoch);
-
-        involved_time_step_seconds.push_back(ts_involved_s);
-        involved_time_step_values.push_back(get_value_for_param_name(output_name, current_index));
-        time_remaining -= ts_involved_s;
-        current_index++;
-
-        while (time_remaining > 0) {
-            if(current_index >= time_epoch_vector.size())
-                return involved_time_step_values[involved_time_step_values.size()-1]; //TODO: Is this the right answer? Is returning any value off the end of the range valid?
-            ts_involved_s = time_remaining > 3600 ? 3600 : time_remaining;
-            involved_time_step_seconds.push_back(ts_involved_s);
-            involved_time_step_values.push_back(get_value_for_param_name(output_name, current_index));
-            time_remaining -= ts_involved_s;
-            current_index++;
-
+        const size_t first_index = (init_time - axis_start_epoch) / time_step;
+        const time_t data_end = axis_start_epoch + time_step * static_cast<time_t>(time_steps);
+        double value;
+        if (first_index >= time_steps || init_time + duration > data_end) {
+            // Running past the end of the data, as when asked for the step after the end of the simulation
+            value = variable.values.back();
         }
-        double value = 0;
-        for (size_t i = 0; i < involved_time_step_values.size(); ++i) {
-            if (is_param_sum_over_time_step(output_name))
-                value += involved_time_step_values[i] * ((double)involved_time_step_seconds[i] / 3600.0);
-            else
-                value += involved_time_step_values[i] * ((double)involved_time_step_seconds[i] / (double)selector.get_duration_secs());
+        else if (duration <= 0) {
+            value = variable.values[first_index];
+        }
+        else {
+            const time_t end_time = init_time + duration;
+            double weighted = 0.0;
+            time_t ts_start = axis_start_epoch + time_step * static_cast<time_t>(first_index);
+            for (size_t i = first_index; ts_start < end_time; ++i, ts_start += time_step) {
+                weighted += variable.values[i] * (std::min(end_time, ts_start + time_step) - std::max(init_time, ts_start));
+            }
+            value = weighted / (lookup.sum_over_time_step ? time_step : duration);
         }
 
         // Convert units
         try {
-            return UnitsHelper::get_converted_value(available_forcings_units[output_name], value, output_units);
+            return get_converter(variable, selector.get_output_units()).convert(value);
         }
         catch (UnitsHelper::unit_conversion_exception& uce) {
             uce.provider_model_name = "CsvPerFeatureProvider";
-            uce.provider_var_name = output_name;
+            uce.provider_var_name = selector.get_variable_name();
+            uce.unconverted_values.push_back(value);
             throw;
         }
     }
@@ -221,189 +197,293 @@ class CsvPerFeatureForcingProvider : public data_access::GenericDataProvider
         return is_param_sum_over_time_step(name);
     }
 
+    /** Each catchment reads its own instance, so concurrent queries never share state. */
+    bool supports_concurrent_access() const override {
+        return true;
+    }
+
     boost::span<const std::string> get_available_variable_names() const override {
         return available_forcings;
     }
 
     private:
 
+    //! The values of one column of the file, with its units and the last unit conversion asked of it
+    struct forcing_variable {
+        std::vector<double> values;
+        std::string units;
+        std::string converter_units;
+        UnitsHelper::unit_converter converter;
+        bool has_converter = false;
+    };
+
+    //! What a variable name resolves to
+    struct variable_lookup {
+        size_t slot;
+        bool sum_over_time_step;
+    };
+
     /**
-     * @brief Checks forcing vector index bounds and adjusts index if out of vector bounds
-     * /// \todo: Bounds checking is based on precipitation vector. Consider potential for vectors of different sizes and indices.
+     * Get the variable a name resolves to, whether the name of its column or the canonical name of a well-known field.
+     *
+     * @param name The name of the forcing param.
+     * @return The slot of the param's values, and whether values for the name are sums over a time step.
      */
-    inline void check_forcing_vector_index_bounds()
-    {
-        //Check if forcing index is less than zero and if so, set to zero.
-        if (forcing_vector_index < 0)
-        {
-            forcing_vector_index = 0;
-            /// \todo: Return appropriate warning
-            std::cout << "WARNING: Forcing vector index is less than zero. Therefore, setting index to zero." << std::endl;
+    const variable_lookup& get_variable_lookup(const std::string& name) const {
+        auto found = variable_lookups.find(name);
+        if (found == variable_lookups.end()) {
+            throw std::runtime_error("Cannot get forcing value for unrecognized parameter name '" + name + "'.");
         }
+        return found->second;
+    }
 
-        //Check if forcing index is greater than or equal to the size of the size of the time vector and if so, set to zero.
-        else if (forcing_vector_index >= time_epoch_vector.size())
-        {
-            forcing_vector_index = time_epoch_vector.size() - 1;
-            /// \todo: Return appropriate warning
-            std::cout << "WARNING: Reached beyond the size of the forcing vector. Therefore, setting index to last value of the vector." << std::endl;
+    /**
+     * Get the converter from a variable's units to the given units, resolving it only when the units asked for change.
+     */
+    const UnitsHelper::unit_converter& get_converter(forcing_variable& variable, const std::string& output_units) {
+        if (!variable.has_converter || variable.converter_units != output_units) {
+            variable.has_converter = false;
+            variable.converter = UnitsHelper::get_unit_converter(variable.units, output_units);
+            variable.converter_units = output_units;
+            variable.has_converter = true;
         }
-
-        return;
+        return variable.converter;
     }
 
     /**
-     * Get the current value of a forcing param identified by its name.
+     * Get the value of a forcing param identified by its name at a forcing time step.
      *
      * @param name The name of the forcing param for which the current value is desired.
      * @param index The index of the desired forcing time step from which to obtain the value.
      * @return The particular param's value at the given forcing time step.
      */
-    inline double get_value_for_param_name(const std::string& name, int index) {
-        if (index >= time_epoch_vector.size() ) {
+    inline double get_value_for_param_name(const std::string& name, size_t index) const {
+        if (index >= time_steps) {
             throw std::out_of_range("Forcing had bad index " + std::to_string(index) + " for value lookup of " + name);
         }
+        return variables[get_variable_lookup(name).slot].values[index];
+    }
 
-        std::string can_name = name;
-        if(data_access::WellKnownFields.count(can_name) > 0){
-            auto t = data_access::WellKnownFields.find(can_name)->second;
-            can_name = std::get<0>(t);
-        }
+    /**
+     * Parse a time in the "YYYY-MM-DD HH:MM:SS" form the forcing files are written in, as UTC.
+     *
+     * Times in exactly that form are converted directly; anything else is left to strptime, which also accepts
+     * differences like single digit fields.
+     *
+     * @param text The time, with any surrounding whitespace already removed.
+     * @return The time as a seconds-based epoch time.
+     */
+    static time_t parse_date_time(std::string_view text) {
+        auto digits = [&](size_t pos, size_t count, int& value) {
+            value = 0;
+            for (size_t i = pos; i < pos + count; ++i) {
+                if (text[i] < '0' || text[i] > '9') {
+                    return false;
+                }
+                value = value * 10 + (text[i] - '0');
+            }
+            return true;
+        };
 
-        if (forcing_vectors.count(can_name) > 0) {
-            return forcing_vectors[can_name].at(index);
+        int year, month, day, hour, minute, second;
+        if (text.size() == 19 && text[4] == '-' && text[7] == '-' && (text[10] == ' ' || text[10] == 'T')
+            && text[13] == ':' && text[16] == ':' && digits(0, 4, year) && digits(5, 2, month) && digits(8, 2, day)
+            && digits(11, 2, hour) && digits(14, 2, minute) && digits(17, 2, second)
+            && month >= 1 && month <= 12 && day >= 1 && day <= 31 && hour < 24 && minute < 60 && second <= 60)
+        {
+            // Days since the epoch of the civil date, with years starting in March so leap days come last
+            const int y = month <= 2 ? year - 1 : year;
+            const int era = (y >= 0 ? y : y - 399) / 400;
+            const int year_of_era = y - era * 400;
+            const int day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+            const int day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+            const long days = static_cast<long>(era) * 146097 + day_of_era - 719468;
+            return days * 86400 + hour * 3600 + minute * 60 + second;
         }
-        else {
-            throw std::runtime_error("Cannot get forcing value for unrecognized parameter name '" + name + "'.");
+
+        struct tm date_time_utc = tm();
+        //TODO: Support more time string formats? This is basically ISO8601 but not complete, support TZ?
+        strptime(std::string(text).c_str(), "%Y-%m-%d %H:%M:%S", &date_time_utc);
+        return timegm(&date_time_utc);
+    }
+
+    //! The field with spaces and tabs removed from both ends
+    static std::string_view trim_field(std::string_view field) {
+        const size_t first = field.find_first_not_of(" \t");
+        if (first == std::string_view::npos) {
+            return {};
         }
+        return field.substr(first, field.find_last_not_of(" \t") - first + 1);
     }
 
     /**
      * @brief Read Forcing Data from CSV
-     * Reads only data within the specified model start and end date-times.
+     * Reads only the time steps that overlap the specified model start and end date-times, which must be evenly
+     * spaced.  The file is read in one pass, with values parsed straight into the variables' columns.
      * @param file_name Forcing file name
      */
     void read_csv(std::string file_name)
     {
-        int time_col_index = 0;
-        //std::map<std::string, int> col_indices;
-        std::vector<std::vector<double>*> local_valvec_index = {};
+        size_t time_col_index = 0;
+        std::vector<int> column_slots;
+        size_t rows = 0;
+        time_t current_row_date_time_epoch = 0;
+
+        // The step between records is taken from the first two, so the first is kept until the second is read
+        time_t first_row_date_time_epoch = 0;
+        std::vector<std::string> first_row;
+
+        auto parse_value = [&](std::string_view field, std::string_view time_str) {
+            field = trim_field(field);
+            std::string_view number = !field.empty() && field.front() == '+' ? field.substr(1) : field;
+            double value;
+            auto result = std::from_chars(number.data(), number.data() + number.size(), value);
+            if (result.ec != std::errc() || result.ptr != number.data() + number.size() || number.empty()) {
+                throw std::runtime_error("Error: Forcing data " + file_name + " has a value '" + std::string(field)
+                                         + "' that is not a number at " + std::string(time_str));
+            }
+            return value;
+        };
+
+        auto keep_row = [&](time_t row_date_time_epoch, const auto& fields) {
+            // Keep every time step that overlaps the model period
+            if (start_date_time_epoch >= row_date_time_epoch + time_step || row_date_time_epoch > end_date_time_epoch) {
+                return;
+            }
+            if (time_steps == 0) {
+                axis_start_epoch = row_date_time_epoch;
+            }
+            else if (row_date_time_epoch != axis_start_epoch + time_step * static_cast<time_t>(time_steps)) {
+                throw std::runtime_error("Error: Forcing data " + file_name + " is not evenly spaced by "
+                                         + std::to_string(time_step) + " seconds at "
+                                         + std::string(fields[time_col_index]));
+            }
+            time_steps++;
+
+            for (size_t c = 0; c < fields.size(); ++c) {
+                if (c != time_col_index) {
+                    variables[column_slots[c]].values.push_back(parse_value(fields[c], fields[time_col_index]));
+                }
+            }
+        };
 
         //Call CSVReader constuctor
         CSVReader reader(file_name);
 
-        //Get the data from CSV File
-        std::vector<std::vector<std::string> > data_list = reader.getData();
-
-        // Process the header (first) row..
-        int col_num = 0;
-        for (const auto& col_head : data_list[0]){
-            //std::cerr << s << std::endl;
-            if(col_head == "Time" || col_head == "time"){
-                time_col_index = col_num;
-                local_valvec_index.push_back(nullptr); // make sure the column indices line up!
-            } else {
-                std::string var_name = col_head;
-                std::string units = "";
-
-                boost::trim(var_name); // remove leading/trailing ws
-                const auto var_name_close = var_name.back();
-                if (var_name_close == ']' || var_name_close == ')') {
-                    // found closing bracket/parenth
-
-                    const bool is_bracket = var_name_close == ']';
-                    const size_t var_name_open = is_bracket ? var_name.rfind('[') : var_name.rfind('(');
-                    if (var_name_open != std::string::npos) {
-                        // found matching opening bracket/parenth
-
-                        units = var_name.substr(var_name_open + 1);
-                        units.pop_back(); // remove closing bracket
-
-                        var_name = var_name.substr(0, var_name_open);
-                        boost::trim(var_name); // trim again in case of ws between name and units
+        reader.forEachRow([&](const std::vector<std::string_view>& fields) {
+            // Process the header (first) row..
+            if (column_slots.empty()) {
+                for (size_t col_num = 0; col_num < fields.size(); ++col_num) {
+                    const std::string_view col_head = fields[col_num];
+                    if(col_head == "Time" || col_head == "time"){
+                        time_col_index = col_num;
+                        column_slots.push_back(-1); // make sure the column indices line up!
+                        continue;
                     }
-                }
+                    std::string var_name(col_head);
+                    std::string units = "";
 
-                auto wkf = data_access::WellKnownFields.find(var_name);
-                if(wkf != data_access::WellKnownFields.end()){
-                    units = units.empty() ? std::get<1>(wkf->second) : units;
-                    auto wkf_name = std::get<0>(wkf->second);
-                    available_forcings.push_back(var_name); // Allow lookup by non-canonical name
-                    available_forcings_units[var_name] = units; // Allow lookup of units by non-canonical name
-                    var_name = wkf_name; // Use the CSDMS name from here on
-                }
+                    boost::trim(var_name); // remove leading/trailing ws
+                    const auto var_name_close = var_name.back();
+                    if (var_name_close == ']' || var_name_close == ')') {
+                        // found closing bracket/parenth
 
-                forcing_vectors[var_name] = {};
-                local_valvec_index.push_back(&(forcing_vectors[var_name]));
-                available_forcings.push_back(var_name);
-                available_forcings_units[var_name] = units;
-            }
-            col_num++;
-        }
+                        const bool is_bracket = var_name_close == ']';
+                        const size_t var_name_open = is_bracket ? var_name.rfind('[') : var_name.rfind('(');
+                        if (var_name_open != std::string::npos) {
+                            // found matching opening bracket/parenth
 
-        time_t current_row_date_time_epoch;
-        //Iterate through CSV starting on the second row
-        int i = 1;
-        for (i = 1; i < data_list.size(); i++)
-        {
-            //Row vector
-            std::vector<std::string>& vec = data_list[i];
+                            units = var_name.substr(var_name_open + 1);
+                            units.pop_back(); // remove closing bracket
 
-            struct tm current_row_date_time_utc = tm();
-            std::string time_str = vec[time_col_index];
-            //TODO: Support more time string formats? This is basically ISO8601 but not complete, support TZ?
-            strptime(time_str.c_str(), "%Y-%m-%d %H:%M:%S", &current_row_date_time_utc);
+                            var_name = var_name.substr(0, var_name_open);
+                            boost::trim(var_name); // trim again in case of ws between name and units
+                        }
+                    }
+
+                    const size_t slot = variables.size();
+                    variables.emplace_back();
+                    auto wkf = data_access::WellKnownFields.find(var_name);
+                    if(wkf != data_access::WellKnownFields.end()){
+                        units = units.empty() ? std::get<1>(wkf->second) : units;
+                        available_forcings.push_back(var_name); // Allow lookup by non-canonical name
+                        variable_lookups[var_name] = {slot, is_param_sum_over_time_step(var_name)};
+                        var_name = std::get<0>(wkf->second); // Use the CSDMS name from here on
+                    }
+
+                    variables[slot].units = units;
+                    column_slots.push_back(slot);
+                    available_forcings.push_back(var_name);
+                    variable_lookups[var_name] = {slot, is_param_sum_over_time_step(var_name)};
+                }
+                return;
+            }
+
+            if (fields.size() != column_slots.size()) {
+                throw std::runtime_error("Error: Forcing data " + file_name + " has a row with " + std::to_string(fields.size())
+                                         + " fields, where the header has " + std::to_string(column_slots.size()));
+            }
 
             //Convert current row date-time UTC to epoch time
-            current_row_date_time_epoch = timegm(&current_row_date_time_utc);
+            current_row_date_time_epoch = parse_date_time(trim_field(fields[time_col_index]));
+            rows++;
 
             //TODO: I am not sure this is a concern of this object. If forcing is retrieved that doesn't cover the
             //needed time period, isn't that the requester's concern? (Methods exist to check this...)
             //Ensure that forcing data covers the entire model period. Otherwise, throw an error.
-            if (i == 1 && start_date_time_epoch < current_row_date_time_epoch)
-            {
-                struct tm start_date_tm;
-                gmtime_r(&start_date_time_epoch, &start_date_tm);
-                
-                char tm_buff[128];
-                strftime(tm_buff, 128, "%Y-%m-%d %H:%M:%S", &start_date_tm);
-                throw std::runtime_error("Error: Forcing data " + file_name + " begins after the model start time:" + std::string(tm_buff) + " < " + time_str);
-            }
-
-            
-            if (start_date_time_epoch <= current_row_date_time_epoch && current_row_date_time_epoch <= end_date_time_epoch)
+            if (rows == 1)
             {
-                time_epoch_vector.push_back(current_row_date_time_epoch);
+                if (start_date_time_epoch < current_row_date_time_epoch) {
+                    struct tm start_date_tm;
+                    gmtime_r(&start_date_time_epoch, &start_date_tm);
 
-                int c = -1;
-                for (auto& s : vec){
-                    c++;
-                    if(c == time_col_index)
-                        continue;
-                    boost::algorithm::trim(s);
-                    local_valvec_index[c]->push_back(boost::lexical_cast<double>(s)); // This is supposed to update the vector in the map...
+                    char tm_buff[128];
+                    strftime(tm_buff, 128, "%Y-%m-%d %H:%M:%S", &start_date_tm);
+                    throw std::runtime_error("Error: Forcing data " + file_name + " begins after the model start time:" + std::string(tm_buff) + " < " + std::string(fields[time_col_index]));
                 }
-
+                first_row_date_time_epoch = current_row_date_time_epoch;
+                first_row.assign(fields.begin(), fields.end());
+                return;
             }
+            if (rows == 2) {
+                time_step = current_row_date_time_epoch - first_row_date_time_epoch;
+                if (time_step <= 0) {
+                    throw std::runtime_error("Error: Forcing data " + file_name + " does not have increasing times");
+                }
+                keep_row(first_row_date_time_epoch, first_row);
+            }
+            keep_row(current_row_date_time_epoch, fields);
+        });
 
+        if (rows == 1) {
+            keep_row(first_row_date_time_epoch, first_row);
         }
-        if (i <= 1 || current_row_date_time_epoch < end_date_time_epoch)
+        if (rows == 0 || current_row_date_time_epoch < end_date_time_epoch)
         {
             /// \todo TODO: Return appropriate error
             std::cout << "WARNING: Forcing data ends before the model end time." << std::endl;
             //throw std::runtime_error("Error: Forcing data ends before the model end time.");
         }
+
+        // Let well-known fields given by their canonical name also be found by their other names
+        for (const auto& field : data_access::WellKnownFields) {
+            auto canonical = variable_lookups.find(std::get<0>(field.second));
+            if (canonical != variable_lookups.end() && variable_lookups.count(field.first) == 0) {
+                variable_lookups[field.first] = {canonical->second.slot, is_param_sum_over_time_step(field.first)};
+            }
+        }
     }
 
     std::vector<std::string> available_forcings;
-    std::unordered_map<std::string, std::string> available_forcings_units;
 
     /// \todo: Look into aggregation of data, relevant libraries, and storing frequency information
-    std::unordered_map<std::string, std::vector<double>> forcing_vectors;
+    std::vector<forcing_variable> variables;
+    std::unordered_map<std::string, variable_lookup> variable_lookups;
 
-    /// \todo: Consider making epoch time the iterator
-    std::vector<time_t> time_epoch_vector;     
-    int forcing_vector_index;
+    //! The time steps kept from the file, which start at axis_start_epoch and are time_step seconds apart
+    time_t axis_start_epoch = 0;
+    long time_step = 3600;
+    size_t time_steps = 0;
 
     /// \todo: Are these used?
     double precipitation_rate_meters_per_second;
@@ -1,6 +1,7 @@
 #ifndef NGEN_DATAPROVIDER_HPP
 #define NGEN_DATAPROVIDER_HPP
 
+#include <stdexcept>
 #include <string>
 #include <vector>
 #include <boost/core/span.hpp>
@@ -96,8 +97,58 @@ namespace data_access
          */
         virtual std::vector<data_type> get_values(const selection_type& selector, ReSampleMethod m=SUM) = 0;
 
+        /**
+         * Get the value of a forcing property for an arbitrary time period for each of several features at once,
+         * converting units if needed.
+         *
+         * The variable, time period and output units are taken from @p selector, whose own feature id is ignored;
+         * the value for feature @p ids[i] is written to @p values[i].  Only the listed features are read, so an
+         * empty @p ids reads nothing; overrides must keep this contract.  Providers that hold the data of many
+         * features together should override this so the per-query work (time indexing, cache lookups, unit
+         * conversion setup) is done once for the whole set rather than once per feature.  By default, this calls
+         * @ref get_value for each id, which requires a selector type with a `set_id` function.
+         *
+         * An @ref std::out_of_range exception should be thrown if the data for the time period is not available.
+         *
+         * @param selector Data establishing the variable, time period and output units to access
+         * @param ids The ids of the features to get values for
+         * @param values Storage for the values, the same size as @p ids
+         * @param m How data is to be resampled if there is a mismatch in data alignment or repeat rate
+         * @throws std::out_of_range If data for the time period is not available.
+         * @throws std::invalid_argument If @p values is not the same size as @p ids.
+         */
+        virtual void get_values_for_ids(const selection_type& selector, boost::span<const std::string> ids,
+                                        boost::span<data_type> values, ReSampleMethod m=SUM)
+        {
+            if (values.size() != ids.size()) {
+                throw std::invalid_argument("Got " + std::to_string(values.size()) + " value slots for "
+                                            + std::to_string(ids.size()) + " feature ids");
+            }
+            if constexpr (requires(selection_type s, const std::string& id) { s.set_id(id); }) {
+                selection_type feature_selector = selector;
+                for (std::size_t i = 0; i < ids.size(); ++i) {
+                    feature_selector.set_id(ids[i]);
+                    values[i] = get_value(feature_selector, m);
+                }
+            }
+            else {
+                throw std::runtime_error("This data provider's selectors can not select values by feature id");
+            }
+        }
+
         virtual bool is_property_sum_over_time_step(const std::string& name) const {return false; }
 
+        /**
+         * Whether this provider may be queried from several threads at once, as when a layer advances its
+         * catchments on worker threads.
+         *
+         * Providers that keep unguarded shared state, or that call into a runtime such as the embedded Python
+         * interpreter, keep the default of ``false``.
+         *
+         * @return Whether it is safe to query this provider concurrently from different threads.
+         */
+        virtual bool supports_concurrent_access() const { return false; }
+
         private:
     };
 
@@ -41,7 +41,7 @@ class CatchmentAggrDataSelector
      * 
      * @return std::string 
      */
-    std::string get_variable_name() const { return variable_name; }
+    const std::string& get_variable_name() const { return variable_name; }
 
     /**
      * @brief Get the initial time for this selector
@@ -62,14 +62,14 @@ class CatchmentAggrDataSelector
      * 
      * @return std::string 
      */
-    std::string get_output_units() const { return output_units; }
+    const std::string& get_output_units() const { return output_units; }
 
     /**
      * @brief Set the variable name for this selector
      * 
      * @param var The name of the variable to access
      */
-    void set_variable_name(std::string var) { variable_name = var; }
+    void set_variable_name(const std::string& var) { variable_name = var; }
 
     /**
      * @brief Set the init time for this selector
@@ -90,21 +90,21 @@ class CatchmentAggrDataSelector
      * 
      * @param units The units of the output
      */
-    void set_output_units(std::string units) { output_units = units; }
+    void set_output_units(const std::string& units) { output_units = units; }
 
     /**
      * @brief Get the id string for this NetCDF Data Selector
      * 
      * @return std::string 
      */
-    std::string get_id() const { return id_str; }
+    const std::string& get_id() const { return id_str; }
 
     /**
      * @brief Set the id string for this NetCDF Data Selector
      * 
      * @param s 
      */
-    void set_id(std::string s) { id_str = s; }
+    void set_id(const std::string& s) { id_str = s; }
 
     private:
 
@@ -0,0 +1,95 @@
+#ifndef NGEN_FORCING_FILE_INDEX_HPP
+#define NGEN_FORCING_FILE_INDEX_HPP
+
+#include <NGenConfig.h>
+
+#if NGEN_WITH_MPI
+#include <mpi.h>
+#endif
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace data_access
+{
+    /**
+     * @brief The forcing files in a directory that match a `file_pattern`, indexed by catchment id.
+     *
+     * A `file_pattern` is a regular expression for file names, in which `{{id}}` stands for a catchment's id.  The
+     * directory is listed once, and each of the catchment ids given when the index is built is indexed by the
+     * files whose names contain it.  Finding a catchment's file then checks the pattern against just those files
+     * rather than against every file in the directory.  As when the directory was scanned for each catchment, a
+     * catchment's file is the first in the listing whose name matches the pattern with the id substituted.
+     *
+     * An id that was not indexed, or a pattern that does not require the id to appear literally in the name, is
+     * looked up by checking the pattern against every file in the listing, which is still not read again.
+     */
+    class ForcingFileIndex
+    {
+        public:
+
+        //! A directory entry that may be a forcing file
+        struct entry {
+            std::string name;
+            bool known_file; //!< Reported as a regular file or link; otherwise the directory did not report a type
+        };
+
+        /**
+         * @brief List the entries of a directory that may be forcing files, retrying transient failures.
+         *
+         * @param directory The directory, ending with "/"
+         * @throws std::runtime_error If the directory can not be opened.
+         */
+        static std::vector<entry> list_directory(const std::string& directory);
+
+#if NGEN_WITH_MPI
+        /**
+         * @brief List a directory on one rank and broadcast the listing to the others; collective over @p comm.
+         *
+         * @param directory The directory, ending with "/"
+         * @param comm The ranks to share the listing
+         * @param root The rank that lists the directory
+         * @throws std::runtime_error On every rank, if the directory can not be opened.
+         */
+        static std::vector<entry> list_directory(const std::string& directory, MPI_Comm comm, int root);
+#endif
+
+        /**
+         * @param directory The directory, ending with "/"
+         * @param file_pattern The pattern for the names of the forcing files
+         * @param entries The listing of the directory, as from @ref list_directory
+         * @param ids The catchment ids to index
+         */
+        ForcingFileIndex(std::string directory, std::string file_pattern, std::vector<entry> entries,
+                         const std::vector<std::string>& ids);
+
+        /**
+         * @brief Get the path of a catchment's forcing file.
+         *
+         * @param id The catchment's id
+         * @return The path of the file, or an empty string if no file matches.
+         * @throws std::runtime_error If the first match is not a regular file, or its type can not be found.
+         */
+        std::string find(const std::string& id) const;
+
+        private:
+
+        //! The pattern with the id substituted, as a regular expression
+        std::string pattern_for(const std::string& id) const;
+
+        //! The path of a matching entry, checking that it is a file
+        std::string resolve(const entry& file) const;
+
+        std::string directory;
+        std::string file_pattern;
+        std::vector<entry> entries;
+        std::size_t id_position;    //!< Where `{{id}}` is in the pattern, or npos
+        bool literal_id = false;    //!< Whether a name matching the pattern must contain the id
+        std::size_t fixed_match;    //!< The first match of a pattern without `{{id}}`, or npos
+        std::unordered_map<std::string, std::vector<std::size_t>> id_entries;
+    };
+}
+
+#endif // NGEN_FORCING_FILE_INDEX_HPP
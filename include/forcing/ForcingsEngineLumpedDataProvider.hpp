@@ -9,6 +9,63 @@
 
 namespace data_access {
 
+namespace detail {
+
+//! The values of every output variable of a lumped Forcings Engine, for every divide, at one time.
+//!
+//! The providers for the divides of an engine share its snapshot. The first query for a time
+//! advances the engine and copies all of its outputs out of Python; the queries of the other
+//! divides for that time then only index into the copy.
+struct ForcingsEngineLumpedSnapshot {
+    using bmi_type = ForcingsEngineStorage::bmi_type;
+
+    //! @param bmi Forcings Engine instance.
+    //! @param variables Output variables to copy at each time; those not of type double are left out.
+    ForcingsEngineLumpedSnapshot(std::shared_ptr<bmi_type> bmi, const std::vector<std::string>& variables);
+
+    //! Get the snapshot of a Forcings Engine instance, creating it if no provider holds it.
+    //! @param init Initialization file path for the Forcings Engine instance.
+    //! @param bmi Forcings Engine instance.
+    //! @param variables Output variables to copy at each time.
+    static std::shared_ptr<ForcingsEngineLumpedSnapshot> shared(
+        const std::string& init,
+        const std::shared_ptr<bmi_type>& bmi,
+        const std::vector<std::string>& variables
+    );
+
+    //! Get the index of an output variable within the snapshot.
+    //! @throws std::runtime_error If the variable is not in the snapshot.
+    std::size_t variable_index(const std::string& name) const;
+
+    //! Get the value of a variable for a divide at a time, advancing the engine to that time
+    //! and copying its outputs unless the snapshot already holds it.
+    //! @param variable Index of the variable, from @ref variable_index.
+    //! @param divide_idx Index of the divide within the Forcings Engine domain.
+    //! @param time Model time to advance the engine until, in seconds.
+    //! @throws std::out_of_range If the variable has no value for the divide.
+    double value(std::size_t variable, std::size_t divide_idx, double time);
+
+    //! Get the Forcings Engine instance.
+    const std::shared_ptr<bmi_type>& model() const noexcept
+    {
+        return bmi_;
+    }
+
+  private:
+    std::shared_ptr<bmi_type> bmi_;
+    std::unordered_map<std::string, std::size_t> variable_indices_;
+    std::vector<std::string> variables_;
+
+    //! Values per variable, indexed by divide.
+    std::vector<std::vector<double>> values_;
+
+    //! Model time of the values, when @c filled_.
+    double time_ = 0;
+    bool filled_ = false;
+};
+
+} // namespace detail
+
 struct ForcingsEngineLumpedDataProvider final :
   public ForcingsEngineDataProvider<double, CatchmentAggrDataSelector>
 {
@@ -40,8 +97,14 @@ struct ForcingsEngineLumpedDataProvider final :
     std::size_t divide_index() const noexcept;
 
   private:
+    //! Get the value of a variable at the step ending at @p current.
+    double value_at(std::size_t variable, clock_type::time_point current);
+
     std::size_t divide_id_;
     std::size_t divide_idx_;
+
+    //! Outputs of the Forcings Engine, shared with the providers of the other divides.
+    std::shared_ptr<detail::ForcingsEngineLumpedSnapshot> snapshot_;
 };
 
 } // namespace data_access
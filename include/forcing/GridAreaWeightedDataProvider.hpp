@@ -0,0 +1,109 @@
+#ifndef NGEN_GRID_AREA_WEIGHTED_DATAPROVIDER_HPP
+#define NGEN_GRID_AREA_WEIGHTED_DATAPROVIDER_HPP
+
+#include "GenericDataProvider.hpp"
+#include "GridCellWeights.hpp"
+#include "GridDataSelector.hpp"
+
+#include <ctime>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace data_access
+{
+    /**
+     * @brief A provider of lumped catchment forcings from a gridded provider, by area-weighted averaging.
+     *
+     * The weights of the grid cells within each catchment are computed once, as a @ref GridCellWeights matrix, and
+     * each query reads the overlapped cells from the gridded provider once and averages them over every catchment
+     * in one sparse matrix-vector product.  The averages of each variable are kept until a query of that variable
+     * for another window, so the queries of the other catchments for the same window only index into them, in
+     * whatever order they ask for their variables.  Averaging is linear, so
+     * resampling the cells in time before averaging them gives the same result as the other way round.
+     */
+    class GridAreaWeightedDataProvider : public GenericDataProvider
+    {
+        public:
+
+        using grid_provider_type = DataProvider<Cell, GridDataSelector>;
+
+        /**
+         * @param source The gridded provider, which returns the cells of a selector in the selector's order.
+         * @param weights The weights of the cells of the source's grid within each catchment.
+         */
+        GridAreaWeightedDataProvider(std::shared_ptr<grid_provider_type> source,
+                                     std::shared_ptr<const GridCellWeights> weights);
+
+        boost::span<const std::string> get_available_variable_names() const override;
+
+        long get_data_start_time() const override;
+
+        long get_data_stop_time() const override;
+
+        long record_duration() const override;
+
+        size_t get_ts_index_for_time(const time_t &epoch_time) const override;
+
+        /**
+         * Get the area-weighted average of a forcing property over a catchment for an arbitrary time period.
+         *
+         * A catchment that does not overlap the grid has an average of NaN.
+         *
+         * @throws std::out_of_range If data for the time period is not available, or the id is not in the weights.
+         */
+        double get_value(const CatchmentAggrDataSelector& selector, ReSampleMethod m) override;
+
+        /**
+         * Get the area-weighted averages of a forcing property over a catchment for each time step of the source
+         * in an arbitrary time period.
+         */
+        std::vector<double> get_values(const CatchmentAggrDataSelector& selector, ReSampleMethod m) override;
+
+        /**
+         * Get the area-weighted averages of a forcing property over many catchments at once.
+         *
+         * @see DataProvider::get_values_for_ids
+         * @throws std::out_of_range If data for the time period is not available, or an id is not in the weights.
+         */
+        void get_values_for_ids(const CatchmentAggrDataSelector& selector, boost::span<const std::string> ids,
+                                boost::span<double> values, ReSampleMethod m=SUM) override;
+
+        bool is_property_sum_over_time_step(const std::string& name) const override;
+
+        void finalize() override;
+
+        private:
+
+        std::shared_ptr<grid_provider_type> source;
+        std::shared_ptr<const GridCellWeights> weights;
+        std::unordered_map<std::string, std::size_t> id_pos;
+
+        //! Selector of every cell of @ref weights, whose window and variable are set for each query
+        GridDataSelector cells_selector;
+
+        //! Values of the cells, in the order of @ref GridCellWeights::cells
+        std::vector<double> field;
+
+        //! Averages over each catchment of a variable, for the window, units and method of its last query
+        struct CachedAverages {
+            time_t init_time = 0;
+            long duration = 0;
+            std::string units;
+            ReSampleMethod method = SUM;
+            bool valid = false;
+            std::vector<double> values;
+        };
+
+        //! The averages of each variable queried, by variable name
+        std::unordered_map<std::string, CachedAverages> averages;
+
+        std::size_t get_id_index(const std::string& id) const;
+
+        //! Get the averages over every catchment for the window and variable of @p selector.
+        const std::vector<double>& averages_for(const CatchmentAggrDataSelector& selector, ReSampleMethod m);
+    };
+}
+
+#endif // NGEN_GRID_AREA_WEIGHTED_DATAPROVIDER_HPP
@@ -0,0 +1,146 @@
+#ifndef NGEN_GRID_CELL_WEIGHTS_HPP
+#define NGEN_GRID_CELL_WEIGHTS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <boost/core/span.hpp>
+
+#include <geojson/JSONGeometry.hpp>
+
+#include "GridDataSelector.hpp"
+
+namespace data_access
+{
+    /**
+     * @brief A sparse matrix of the area weights of grid cells within each of a set of catchments.
+     *
+     * Row @c i holds, for each grid cell overlapping catchment @c i, the fraction of the catchment's area that lies
+     * in that cell, so the areal average of a gridded field over every catchment is one sparse matrix-vector
+     * product (@ref apply).  The matrix is stored in compressed sparse row form, and its columns index the
+     * compacted list of cells overlapped by any catchment (@ref cells) rather than the whole grid, so a field only
+     * needs values for those cells.
+     *
+     * Building the weights intersects every catchment with each cell under its envelope, which is costly for a
+     * large hydrofabric; @ref load_or_build keeps them in a file keyed by the grid and the catchment geometries so
+     * later runs over the same domain read them back instead.  The cache file is, with all integers and values in
+     * the byte order of the machine that wrote it:
+     *
+     * @code
+     * char[8]   magic "NGENGCW1"
+     * uint32    byte order mark 0x01020304
+     * uint32    reserved, 0
+     * uint64    key, from @ref key
+     * uint64    number of catchments (N)
+     * uint64    number of cells (C)
+     * uint64    number of weights (W)
+     * N x (catchment id)   each a uint32 byte length and the bytes
+     * C x (uint64 column, uint64 row)
+     * (N + 1) x uint64     row offsets
+     * W x uint64           cell of each weight
+     * W x float64          weights
+     * @endcode
+     */
+    class GridCellWeights
+    {
+        public:
+
+        //! First eight bytes of every weights cache file
+        static constexpr char MAGIC[8] = {'N', 'G', 'E', 'N', 'G', 'C', 'W', '1'};
+
+        /**
+         * @brief Compute the weights of the cells of @p grid within each catchment.
+         *
+         * Cells are taken as rectangles in the coordinate plane of the grid, and the area of each overlap is its
+         * area in that plane, scaled by the cosine of the cell's central latitude when the grid is
+         * @ref GridSpecification::geographic.  A catchment that does not overlap the grid gets no weights, and its
+         * areal average is NaN.
+         *
+         * @param grid The grid the field is defined on.
+         * @param ids The catchment ids, which become the rows of the matrix in this order.
+         * @param shapes The geometry of each catchment, the same size as @p ids.
+         * @throws std::invalid_argument If @p shapes is not the same size as @p ids, or the grid is empty.
+         */
+        static GridCellWeights build(const GridSpecification& grid, std::vector<std::string> ids,
+                                     boost::span<const geojson::multipolygon_t> shapes);
+
+        /**
+         * @brief Read the weights from the cache file at @p path if it holds them for this grid and these
+         * catchments, else build them and write them to @p path.
+         *
+         * A cache file that can not be written only costs rebuilding the weights next time, so it is not an error.
+         *
+         * @see build
+         */
+        static GridCellWeights load_or_build(const std::string& path, const GridSpecification& grid,
+                                             std::vector<std::string> ids,
+                                             boost::span<const geojson::multipolygon_t> shapes);
+
+        /**
+         * @brief Read the weights from a cache file, if it exists and was written for @p key.
+         *
+         * @throws std::runtime_error If the file exists with the right key but is truncated, or its row offsets or
+         * cell indices do not describe a valid matrix.
+         */
+        static std::optional<GridCellWeights> load(const std::string& path, std::uint64_t key);
+
+        /**
+         * @brief A hash of the grid and the catchment ids and geometries that identifies a set of weights.
+         */
+        static std::uint64_t key(const GridSpecification& grid, boost::span<const std::string> ids,
+                                 boost::span<const geojson::multipolygon_t> shapes);
+
+        /**
+         * @brief Write the weights to a cache file, replacing any file at @p path.
+         *
+         * @throws std::runtime_error If the file can not be written.
+         */
+        void save(const std::string& path) const;
+
+        /**
+         * @brief Compute the areal average of a field over every catchment.
+         *
+         * @param field The value of the field in each of @ref cells, in that order.
+         * @param averages Storage for the average over each catchment, in the order of @ref ids.
+         * @throws std::invalid_argument If either span is not of the expected size.
+         */
+        void apply(boost::span<const double> field, boost::span<double> averages) const;
+
+        //! The catchment ids, in the order of the rows of the matrix
+        const std::vector<std::string>& ids() const { return feature_ids; }
+
+        //! The cells overlapped by any catchment, in the order of the columns of the matrix
+        const std::vector<Cell>& cells() const { return columns; }
+
+        //! The key of the grid and catchments the weights were built for
+        std::uint64_t get_key() const { return weights_key; }
+
+        //! The cells of catchment @p row_idx, as indices into @ref cells
+        boost::span<const std::uint64_t> row_cells(std::size_t row_idx) const
+        {
+            return { cell_indices.data() + row_offsets[row_idx], row_offsets[row_idx + 1] - row_offsets[row_idx] };
+        }
+
+        //! The weights of the cells of catchment @p row_idx, in the order of @ref row_cells
+        boost::span<const double> row_weights(std::size_t row_idx) const
+        {
+            return { weights.data() + row_offsets[row_idx], row_offsets[row_idx + 1] - row_offsets[row_idx] };
+        }
+
+        private:
+
+        GridCellWeights() = default;
+
+        std::uint64_t weights_key = 0;
+        std::vector<std::string> feature_ids;
+        std::vector<Cell> columns;
+        std::vector<std::uint64_t> row_offsets;
+        std::vector<std::uint64_t> cell_indices;
+        std::vector<double> weights;
+    };
+}
+
+#endif // NGEN_GRID_CELL_WEIGHTS_HPP
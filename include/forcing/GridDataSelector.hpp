@@ -1,6 +1,9 @@
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -69,8 +72,21 @@ struct GridSpecification {
 
     //! Extent of the grid region (aka min-max corner points)
     BoundingBox extent;
+
+    //! Whether the coordinates are longitude and latitude in degrees, rather than projected
+    bool geographic = true;
 };
 
+//! Index of the cell of size @p step containing @p position, clamped to [0, @p upper_bound).
+inline std::uint64_t clamped_cell_index(double position, double min, double step, std::uint64_t upper_bound) {
+    const auto index = std::floor((position - min) / step);
+    if (index < 0) {
+        return 0;
+    }
+
+    return std::min(static_cast<std::uint64_t>(index), upper_bound - 1);
+}
+
 struct SelectorConfig {
     //! Initial time for query.
     //! @todo Refactor to use std::chrono
@@ -150,21 +166,25 @@ struct GridDataSelector {
         const auto xmax = grid.extent.xmax();
         const auto ymin = grid.extent.ymin();
         const auto ymax = grid.extent.ymax();
-        const auto ydiff = static_cast<double>(grid.rows) / (ymax - ymin);
-        const auto xdiff = static_cast<double>(grid.columns) / (xmax - xmin);
-    
+        const auto ydiff = (ymax - ymin) / static_cast<double>(grid.rows);
+        const auto xdiff = (xmax - xmin) / static_cast<double>(grid.columns);
+
+        // Only the cells under the polygon's envelope can intersect it
         const auto bbox = BoundingBox{ boost::geometry::return_envelope<box_t>(polygon) };
-        for (double row = bbox.ymin(); row < bbox.ymax() - ydiff; row += ydiff) {
-            for (double col = bbox.xmin(); col < bbox.xmax() - xdiff; row += xdiff) {
+        const auto col_min = clamped_cell_index(bbox.xmin(), xmin, xdiff, grid.columns);
+        const auto col_max = clamped_cell_index(bbox.xmax(), xmin, xdiff, grid.columns);
+        const auto row_min = clamped_cell_index(bbox.ymin(), ymin, ydiff, grid.rows);
+        const auto row_max = clamped_cell_index(bbox.ymax(), ymin, ydiff, grid.rows);
+
+        for (auto row = row_min; row <= row_max; row++) {
+            for (auto col = col_min; col <= col_max; col++) {
                 const box_t cell_box = {
-                    /*min_corner=*/{ col, row },
-                    /*max_corner=*/{ col + xdiff, row + ydiff }
+                    /*min_corner=*/{ xmin + col * xdiff, ymin + row * ydiff },
+                    /*max_corner=*/{ xmin + (col + 1) * xdiff, ymin + (row + 1) * ydiff }
                 };
 
                 if (boost::geometry::intersects(cell_box, polygon)) {
-                    auto x = position_(col, xmin, xmax, grid.columns);
-                    auto y = position_(row, ymin, ymax, grid.rows);
-                    cells_.emplace_back(Cell{x, y, /*z=*/0UL, /*value=*/NAN});
+                    cells_.emplace_back(Cell{/*x=*/col, /*y=*/row, /*z=*/0UL, /*value=*/NAN});
                 }
             }
         }
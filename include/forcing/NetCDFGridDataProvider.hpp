@@ -0,0 +1,126 @@
+#ifndef NGEN_NETCDF_GRID_DATAPROVIDER_HPP
+#define NGEN_NETCDF_GRID_DATAPROVIDER_HPP
+
+#include <NGenConfig.h>
+
+#if NGEN_WITH_NETCDF
+
+#include "DataProvider.hpp"
+#include "GridDataSelector.hpp"
+
+#include <cstdint>
+#include <ctime>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <StreamHandler.hpp>
+
+namespace netCDF {
+    class NcVar;
+    class NcFile;
+}
+
+namespace data_access
+{
+    /**
+     * @brief A provider of gridded forcings from a NetCDF file.
+     *
+     * The file holds each forcing variable over the dimensions `(time, y, x)`, with the cell centres given by the
+     * one dimensional, evenly spaced coordinate variables `x` and `y` (or `lon` and `lat`), and the start of each
+     * time step by the one dimensional variable `time`, whose `units` attribute is read as it is for
+     * @ref NetCDFPerFeatureDataProvider.  Either coordinate may decrease along its dimension; cells are indexed from
+     * the minimum corner of the grid all the same.  The grid is taken as longitude and latitude when both
+     * coordinates are in degrees, and as projected otherwise, which decides how the areas of its cells are measured
+     * (@ref GridSpecification::geographic).
+     *
+     * Each query reads the time steps of its window over the smallest block of the grid holding all of its cells,
+     * so it is meant for a few large selections, as from @ref GridAreaWeightedDataProvider, rather than one query
+     * per cell.
+     */
+    class NetCDFGridDataProvider : public DataProvider<Cell, GridDataSelector>
+    {
+        public:
+
+        /**
+         * @param input_path The path to a NetCDF file of gridded forcing values.
+         * @param log_s An output log stream for messages from the underlying library.
+         * @throws std::runtime_error If the file does not have a regular grid or evenly spaced time steps.
+         */
+        NetCDFGridDataProvider(std::string input_path, utils::StreamHandler log_s);
+        NetCDFGridDataProvider() = delete;
+        // Defined in the .cpp file so that client code doesn't need the full definition of NcFile
+        ~NetCDFGridDataProvider();
+
+        //! The grid the variables of the file are defined on
+        const GridSpecification& get_grid() const { return *grid; }
+
+        void finalize() override;
+
+        boost::span<const std::string> get_available_variable_names() const override;
+
+        long get_data_start_time() const override;
+
+        long get_data_stop_time() const override;
+
+        long record_duration() const override;
+
+        size_t get_ts_index_for_time(const time_t &epoch_time) const override;
+
+        /**
+         * Get the value of a forcing property in the one cell of @p selector for an arbitrary time period.
+         *
+         * @throws std::invalid_argument If the selector does not have exactly one cell.
+         * @see get_values
+         */
+        Cell get_value(const GridDataSelector& selector, ReSampleMethod m) override;
+
+        /**
+         * Get the value of a forcing property in each cell of @p selector for an arbitrary time period, converting
+         * units if needed.
+         *
+         * @return The cells of the selector, in its order, with their values set.
+         * @throws std::out_of_range If data for the time period is not available, or a cell is not in the grid.
+         * @throws std::runtime_error If the variable is not in the file.
+         */
+        std::vector<Cell> get_values(const GridDataSelector& selector, ReSampleMethod m) override;
+
+        private:
+
+        utils::StreamHandler log_stream;
+        std::string file_path;
+        std::shared_ptr<netCDF::NcFile> nc_file;
+
+        std::optional<GridSpecification> grid;
+        //! Whether the x and y coordinates decrease along their dimensions in the file
+        bool x_reversed = false;
+        bool y_reversed = false;
+
+        std::vector<std::string> variable_names;
+        std::map<std::string, std::string> ncvar_names;
+        std::map<std::string, std::string> units_cache;
+
+        std::vector<double> time_vals;
+        double time_stride = 0;
+        time_t start_time = 0;
+        time_t stop_time = 0;
+
+        /**
+         * Read the coordinate variable @p name, or @p alt_name if there is none, as the centres of evenly spaced
+         * cells.
+         *
+         * @param degrees Set to whether the coordinates are longitude or latitude in degrees, as they are for
+         *                @p alt_name or a `units` attribute starting with "degree".
+         * @return The minimum and maximum edges of the cells.
+         */
+        std::pair<double, double> read_axis(const std::string& name, const std::string& alt_name,
+                                            std::uint64_t& size, bool& reversed, bool& degrees);
+    };
+}
+
+#endif // NGEN_WITH_NETCDF
+
+#endif // NGEN_NETCDF_GRID_DATAPROVIDER_HPP
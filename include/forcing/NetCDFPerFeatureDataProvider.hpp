@@ -17,6 +17,10 @@
 #include <sstream>
 #include <exception>
 #include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <tuple>
 #include "assert.h"
 #include <iomanip>
 #include <optional>
@@ -24,9 +28,15 @@
 #include <boost/compute/detail/lru_cache.hpp>
 
 #include <StreamHandler.hpp>
+#include <mediator/UnitsHelper.hpp>
 
 #include "AorcForcing.hpp"
 
+#if NGEN_WITH_MPI
+#include <mpi.h>
+#include "NodeSharedPageCache.hpp"
+#endif
+
 namespace netCDF {
     class NcVar;
     class NcFile;
@@ -34,6 +44,8 @@ namespace netCDF {
 
 namespace data_access
 {
+    class NodeSharedPageCache;
+
     class NetCDFPerFeatureDataProvider : public GenericDataProvider
     {
         
@@ -92,6 +104,50 @@ namespace data_access
          */
         void hint_shared_provider_id(const std::string& id);
 
+        /**
+         * @brief Read forcing pages ahead of the simulation on a background thread.
+         *
+         * Once a page of a variable is accessed, the next @p depth pages of that variable are queued for a
+         * background thread that reads them into the value cache, so NetCDF reads and decompression overlap
+         * with model execution instead of stalling the first catchment to need each page. The value cache
+         * is resized to hold the read-ahead pages of every variable.
+         *
+         * A depth of 0, the default, reads pages only when they are needed. Setting the current depth again
+         * has no effect, so this may be called for every catchment sharing the provider.
+         *
+         * @param depth The number of pages past the one in use to read ahead, per variable.
+         */
+        void set_read_ahead(std::size_t depth);
+
+        /**
+         * @brief Ask for this provider's pages to be shared by the MPI ranks on each node.
+         *
+         * Takes effect when @ref share_node_caches is called; it has no effect in builds without MPI.
+         */
+        void request_node_shared_cache();
+
+#if NGEN_WITH_MPI
+        /**
+         * @brief Share the pages of the providers that asked for it between the ranks on each node.
+         *
+         * Must be called by every rank of @p comm, once all providers have been created and hinted with their ids.
+         * For each file that any rank on a node asked to share, the ranks of the node allocate a
+         * @ref NodeSharedPageCache holding the rows of every id hinted on the node, and from then on a page is read
+         * once per node, by whichever rank needs it first; each rank keeps only its own rows in its value cache.
+         * Pages are not shared on nodes with a single rank.
+         *
+         * @param comm The communicator of all ranks, usually `MPI_COMM_WORLD`
+         */
+        static void share_node_caches(MPI_Comm comm);
+
+        /**
+         * @brief Stop sharing pages and free the shared memory windows.
+         *
+         * Must be called by every rank of the communicator given to @ref share_node_caches, before `MPI_Finalize`.
+         */
+        static void release_node_caches();
+#endif
+
         /**
          * @brief Cleanup the shared providers cache, ensuring that the files get closed.
          */
@@ -111,6 +167,9 @@ namespace data_access
         /** Return the variables that are accessable by this data provider */
         boost::span<const std::string> get_available_variable_names() const override;
 
+        /** Queries are serialized on @ref value_cache_mutex, so catchments may share this provider across threads. */
+        bool supports_concurrent_access() const override { return true; }
+
         /** return a list of ids in the current file */
         const std::vector<std::string>& get_ids() const;
 
@@ -147,6 +206,48 @@ namespace data_access
 
         virtual std::vector<double> get_values(const CatchmentAggrDataSelector& selector, data_access::ReSampleMethod m) override;
 
+        /**
+         * Get the value of a forcing property for an arbitrary time period for many catchments at once.
+         *
+         * Each page of the time period is looked up once for the whole set and the units conversion is applied
+         * to all of the values together, so the cost per catchment is an index lookup and a weighted sum.
+         *
+         * @see DataProvider::get_values_for_ids
+         * @throws std::out_of_range If data for the time period is not available, or an id is not in the file.
+         */
+        void get_values_for_ids(const CatchmentAggrDataSelector& selector, boost::span<const std::string> ids,
+                                boost::span<double> values, ReSampleMethod m=SUM) override;
+
+        /**
+         * @brief An opaque handle to a query compiled by @ref compile_query.
+         */
+        using query_handle = std::size_t;
+
+        /**
+         * @brief Resolve the parts of a query that stay the same from one time step to the next.
+         *
+         * The variable, its units converter and the weights of the forcing time steps in the window are resolved
+         * for the variable, duration and output units of @p selector and the resampling method @p m; the
+         * selector's id and start time are not part of the query.  Compiling the same query again returns the
+         * same handle.  The other value getters compile their queries this way too, so repeated selectors cost a
+         * table lookup rather than resolving the query again.
+         *
+         * @throws std::runtime_error If the variable is not in the file.
+         */
+        query_handle compile_query(const CatchmentAggrDataSelector& selector, ReSampleMethod m);
+
+        /**
+         * @brief Get the value of a compiled query for one feature and the window starting at @p init_time.
+         *
+         * @param query A handle returned by @ref compile_query on this provider
+         * @param feature_idx The position of the feature in @ref get_ids, once all ids have been hinted
+         * @param init_time The start of the window, as a seconds-based epoch time
+         * @return The value of the forcing property for the window, with units converted if needed.
+         * @throws std::out_of_range If data for the time period is not available, or there is no such feature.
+         * @throws std::invalid_argument If @p query is not a handle from this provider.
+         */
+        double get_value(query_handle query, std::size_t feature_idx, time_t init_time);
+
         private:
 
         time_t sim_start_date_time_epoch;
@@ -155,6 +256,9 @@ namespace data_access
 
         static std::mutex shared_providers_mutex;
         static std::map<std::string, std::shared_ptr<NetCDFPerFeatureDataProvider>> shared_providers;
+        // the NetCDF library is not thread safe, so every provider's file access is serialized through this
+        static std::mutex netcdf_io_mutex;
+        friend class NetCDFGridDataProvider;
 
         std::vector<std::string> variable_names;
         std::vector<std::string> loc_ids;
@@ -174,14 +278,135 @@ namespace data_access
         std::map<std::string,netCDF::NcVar> ncvar_cache;
         std::map<std::string,std::string> units_cache;
         boost::compute::detail::lru_cache<std::string, std::shared_ptr<std::vector<double>>> value_cache;
+        // guards the value/ncvar/units caches and the file handle in get_value
+        std::mutex value_cache_mutex;
         // number of time slices per cache entry
         // this is a tunable parameter; your mileage may vary
         // NOTE: it would be nice if this were divisible by 2 and 4
         size_t cache_slice_t_size = 24;
         size_t cache_slice_c_size = 1;
 
+        // read-ahead state; all of it is guarded by value_cache_mutex
+        std::size_t read_ahead_depth = 0;
+        std::map<std::string, std::size_t> read_ahead_horizon;         // per variable, the last page index queued
+        std::deque<std::pair<std::string, std::size_t>> read_ahead_queue; // variable name and page start (c idx)
+        std::string read_ahead_in_flight;                              // cache key of the page being read, if any
+        bool read_ahead_stopping = false;
+        std::condition_variable read_ahead_cv;                         // wakes the worker for new requests or to stop
+        std::condition_variable page_ready_cv;                         // wakes readers waiting on an in-flight page
+        std::thread read_ahead_thread;
+
+        // How this provider's pages map onto a node shared cache; never changed once built, so the read-ahead thread
+        // can use a copy of the pointer taken under value_cache_mutex after it lets go of the lock
+        struct NodeCacheBinding {
+            std::shared_ptr<NodeSharedPageCache> cache;
+            std::vector<std::pair<size_t, size_t>> chunks;   // the chunks of the ids hinted on the node
+            std::vector<std::size_t> rows;                   // for each of this rank's cache rows, its row in a node page
+            std::map<std::string, std::size_t> var_index;   // file variable name to its index in the node cache
+        };
+
+        // node shared pages; set by share_node_caches and guarded by value_cache_mutex
+        bool node_shared_cache_requested = false;
+        std::shared_ptr<const NodeCacheBinding> node_cache;  // null unless pages are shared on the node
+#if NGEN_WITH_MPI
+        // the caches of every shared file on the node, in the same order on each rank, for release_node_caches
+        static std::vector<std::shared_ptr<NodeSharedPageCache>> node_caches;
+
+        /**
+         * @brief The variables of the file that have pages, the time dimension of which is the last one.
+         */
+        std::vector<std::string> paged_variable_names() const;
+
+        //! Use @p cache for this provider's pages, the rows of which are the ids in @p node_page_chunks
+        void attach_node_cache(std::shared_ptr<NodeSharedPageCache> cache, std::vector<std::pair<size_t, size_t>> node_page_chunks);
+#endif
+
+        /**
+         * @brief The weights of a query's window, which depend on where the window starts within a forcing time step.
+         */
+        struct query_window
+        {
+            double phase;                          // offset of the window's start into its first time step
+            std::vector<double> weights;           // one per time step of the window
+            double scale;                          // the resampling scale applied to the weighted sum
+        };
+
+        /**
+         * @brief The parts of a query that are resolved once; see @ref compile_query.
+         */
+        struct compiled_query
+        {
+            const netCDF::NcVar* ncvar;
+            std::string var_name;                  // the file's name for the variable, as used in page keys
+            long duration;
+            ReSampleMethod method;
+            UnitsHelper::unit_converter converter;
+            // set instead of the converter when the units can not be converted, and thrown on every evaluation
+            std::optional<UnitsHelper::unit_conversion_exception> conversion_error;
+            // weights of the window's time steps and the resampling scale, for the window's last seen offset into
+            // its first time step and length; replaced, never modified, so an evaluation that waits on the
+            // read-ahead thread keeps using its own copy
+            std::shared_ptr<const query_window> window;
+        };
+        // a deque, so a query stays put while evaluate_query waits on the read-ahead thread; guarded by value_cache_mutex
+        std::deque<compiled_query> compiled_queries;
+        std::map<std::tuple<std::string, long, std::string, ReSampleMethod>, query_handle> query_index;
+
         const netCDF::NcVar& get_ncvar(const std::string& name);
 
+        /**
+         * @brief @ref compile_query for callers that already hold @ref value_cache_mutex.
+         */
+        query_handle find_or_compile_query(const CatchmentAggrDataSelector& selector, ReSampleMethod m);
+
+        /**
+         * @brief Evaluate @p query over the window starting at @p init_time for the cache rows @p rows.
+         *
+         * @param values Storage for the values, the same size as @p rows
+         * @param lock The held lock on @ref value_cache_mutex
+         */
+        void evaluate_query(compiled_query& query, boost::span<const std::size_t> rows, time_t init_time,
+                            boost::span<double> values, std::unique_lock<std::mutex>& lock);
+
+        /**
+         * @brief Get the page of @p ncvar starting at time index @p page_c_idx, reading it if it is not cached.
+         *
+         * @param lock The held lock on @ref value_cache_mutex, released while waiting on the read-ahead thread
+         */
+        std::shared_ptr<std::vector<double>> get_page(const netCDF::NcVar& ncvar, const std::string& var_name,
+                                                      std::size_t page_c_idx, std::unique_lock<std::mutex>& lock);
+
+        /**
+         * @brief Read the page of @p ncvar starting at time index @p page_c_idx into @p page, one read per chunk.
+         *
+         * Holds @ref netcdf_io_mutex for the duration of the reads.
+         */
+        void read_page(const netCDF::NcVar& ncvar, std::size_t page_c_idx, std::size_t page_cache_line_size,
+                       const std::vector<std::pair<size_t, size_t>>& page_chunks, double* page);
+
+        /**
+         * @brief Fill @p page with this rank's rows of a page, through the node's shared cache if there is one.
+         *
+         * @param page_chunks The chunks of this rank's rows, as read under @ref value_cache_mutex
+         * @param shared The node cache binding, as read under @ref value_cache_mutex; may be null
+         */
+        void load_page(const netCDF::NcVar& ncvar, const std::string& var_name, std::size_t page_c_idx,
+                       std::size_t page_cache_line_size, const std::vector<std::pair<size_t, size_t>>& page_chunks,
+                       const std::shared_ptr<const NodeCacheBinding>& shared, std::vector<double>& page);
+
+        /**
+         * @brief Queue the pages of @p var_name after page @p p_idx, up to the read-ahead depth, for the worker.
+         *
+         * The caller must hold @ref value_cache_mutex.
+         */
+        void queue_read_ahead(const std::string& var_name, std::size_t p_idx);
+
+        //! Body of the read-ahead thread: read queued pages into the value cache until stopped
+        void read_ahead_loop();
+
+        //! Stop and join the read-ahead thread, if running, and drop any queued requests
+        void stop_read_ahead();
+
         const std::string& get_ncvar_units(const std::string& name);
 
         void test_data_is_readable();
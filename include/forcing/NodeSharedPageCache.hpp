@@ -0,0 +1,88 @@
+#ifndef NGEN_NODE_SHARED_PAGE_CACHE_HPP
+#define NGEN_NODE_SHARED_PAGE_CACHE_HPP
+
+#include <NGenConfig.h>
+
+#if NGEN_WITH_MPI
+
+#include <mpi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace data_access
+{
+    /**
+     * @brief Pages of forcing values kept once per node, in an MPI shared memory window.
+     *
+     * The window holds a fixed number of page slots for each variable, a page going to slot
+     * `page index % slots_per_var` of its variable.  The first rank on the node to need a page that is not in its
+     * slot reads it in, and every rank on the node then copies its own rows out of the slot, so a page is read
+     * and decompressed once per node rather than once per rank.
+     *
+     * Each slot is guarded by a sequence lock: a reader copies out of the slot and retries if the slot's sequence
+     * number changed meanwhile, so readers never block each other.  A rank that loads a page copies its rows
+     * before releasing the slot, so ranks that want different pages of the same slot still make progress.
+     *
+     * Requires a window in the MPI unified memory model, as shared memory windows are on every common platform;
+     * see @ref usable.
+     */
+    class NodeSharedPageCache
+    {
+        public:
+
+        /**
+         * @brief Allocate the shared window; collective over @p node_comm.
+         *
+         * @param node_comm A communicator of ranks sharing memory, as from `MPI_Comm_split_type(MPI_COMM_TYPE_SHARED)`
+         * @param owner The rank in @p node_comm that allocates the window's memory
+         * @param n_vars The number of variables with pages in the cache
+         * @param slots_per_var The number of pages of each variable the cache holds at once
+         * @param slot_values The size of the largest page, in values
+         */
+        NodeSharedPageCache(MPI_Comm node_comm, int owner, std::size_t n_vars, std::size_t slots_per_var, std::size_t slot_values);
+
+        NodeSharedPageCache(const NodeSharedPageCache&) = delete;
+        NodeSharedPageCache& operator=(const NodeSharedPageCache&) = delete;
+
+        /**
+         * @brief Does nothing, as freeing the window is collective; see @ref free.
+         */
+        ~NodeSharedPageCache() = default;
+
+        //! Whether the window is in the unified memory model, so that the cache can be used
+        bool usable() const { return unified; }
+
+        /**
+         * @brief Get a page, loading it into the shared window if it is not there.
+         *
+         * @param var_idx The index of the page's variable
+         * @param page_idx The index of the page among the pages of its variable
+         * @param load Fills the slot's values with the page, if this rank is the one to read it
+         * @param copy Copies what this rank needs out of the slot's values; may be called again if the slot was
+         *             overwritten while copying
+         */
+        void fetch(std::size_t var_idx, std::size_t page_idx, const std::function<void(double*)>& load,
+                   const std::function<void(const double*)>& copy);
+
+        /**
+         * @brief Free the shared window; collective over the communicator the cache was created with.
+         */
+        void free();
+
+        private:
+
+        MPI_Win window = MPI_WIN_NULL;
+        bool unified = false;
+        std::size_t n_vars;
+        std::size_t slots_per_var;
+        std::size_t slot_values;
+        std::uint64_t* slot_headers = nullptr;   // a cache line per slot: page tag, then sequence number
+        double* slot_data = nullptr;
+    };
+}
+
+#endif // NGEN_WITH_MPI
+
+#endif // NGEN_NODE_SHARED_PAGE_CACHE_HPP
@@ -30,6 +30,8 @@ class NullForcingProvider : public data_access::GenericDataProvider
 
     inline bool is_property_sum_over_time_step(const std::string& name) const override;
 
+    bool supports_concurrent_access() const override { return true; }
+
     boost::span<const std::string> get_available_variable_names() const override;
 };
 
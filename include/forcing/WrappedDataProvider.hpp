@@ -136,6 +136,16 @@ namespace data_access {
             return wrapped_provider->is_property_sum_over_time_step(name);
         }
 
+        /**
+         * Whether the wrapped provider may be queried concurrently; a wrapper with nothing to wrap yet holds no
+         * state of its own, so it is.
+         *
+         * @return Whether it is safe to query this provider concurrently from different threads.
+         */
+        bool supports_concurrent_access() const override {
+            return wrapped_provider == nullptr || wrapped_provider->supports_concurrent_access();
+        }
+
     protected:
         GenericDataProvider* wrapped_provider;
 
@@ -4,6 +4,7 @@
 #include <features/Features.hpp>
 #include <FeatureCollection.hpp>
 #include <JSONGeometry.hpp>
+#include <StreamingReader.hpp>
 
 #include <iostream>
 #include <memory>
@@ -15,11 +16,6 @@
 #include <boost/property_tree/ptree.hpp>
 
 namespace geojson {
-    /**
-     * Easy short-hand for a smart pointer to a FeatureCollection
-     */
-    typedef std::shared_ptr<FeatureCollection> GeoJSON;
-
     /**
      * Creates a single boost geometry point from the values in a boost property tree
      * 
@@ -224,74 +220,22 @@ namespace geojson {
         throw std::invalid_argument("tree");
     }
 
-    static Feature build_feature(boost::property_tree::ptree &tree) {
-        bool has_geometry_collection = false;
-        bool has_geometry = false;
-
-        geometry geometry_object;
-        std::vector<geometry> geometry_collection;
-        FeatureType type = FeatureType::None;
-        std::string id = "";
-        std::vector<double> bounding_box;
-        PropertyMap properties;
-        PropertyMap foreign_members;
-
-        for (auto& child : tree) {
-            if (child.first == "geometry") {
-                const std::string& geometry_type = child.second.get<std::string>("type");
-                geometry_object = build_geometry(child.second);
-                has_geometry = true;
-
-                if (geometry_type == "Point") {
-                    type = FeatureType::Point;
-                }
-                else if (geometry_type == "LineString") {
-                    type = FeatureType::LineString;
-                }
-                else if (geometry_type == "Polygon") {
-                    type = FeatureType::Polygon;
-                }
-                else if (geometry_type == "MultiPoint") {
-                    type = FeatureType::MultiPoint;
-                }
-                else if (geometry_type == "MultiLineString") {
-                    type = FeatureType::MultiLineString;
-                }
-                else if (geometry_type == "MultiPolygon") {
-                    type = FeatureType::MultiPolygon;
-                }
-            }
-            else if (child.first == "geometries") {
-                // Since the feature can have a number of different types of geometries and the
-                // type of the feature comes from the geometry, we simply set this as a collection
-                type = FeatureType::GeometryCollection;
-                has_geometry_collection = true;
-
-                // Loop through the underlying collection of geometric json definitions and use
-                // those to create geometric objects
-                for (auto &geom : child.second) {
-                    geometry_collection.push_back(build_geometry(geom.second));
-                }
-            }
-            else if (child.first == "id") {
-                id = std::move(child.second.data());
-            }
-            else if (child.first == "bbox") {
-                for (auto &value : tree.get_child("bbox")) {
-                    bounding_box.push_back(std::stod(value.second.data()));
-                }
-            }
-            else if (child.first == "properties") {
-                for (auto& property : child.second) {
-                    properties.emplace(property.first, JSONProperty(property.first, property.second));
-                }
-            }
-            else {
-                foreign_members.emplace(child.first, JSONProperty(child.first, child.second));
-            }
-        }
-
-        
+    /**
+     * @brief Create the feature class matching @p type around an already built geometry
+     *
+     * @param type The type of feature to create; anything other than a single geometry type creates a collection
+     * @param geometry_object The geometry of a single geometry feature
+     * @param geometry_collection The geometries of a collection feature
+     */
+    static Feature make_feature(
+        FeatureType type,
+        geometry &geometry_object,
+        std::vector<geometry> &geometry_collection,
+        const std::string &id,
+        PropertyMap &properties,
+        std::vector<double> &bounding_box,
+        PropertyMap &foreign_members
+    ) {
         switch (type) {
             case FeatureType::Point:
                 return std::make_shared<PointFeature>(PointFeature(
@@ -366,6 +310,77 @@ namespace geojson {
         }
     }
 
+    static Feature build_feature(boost::property_tree::ptree &tree) {
+        bool has_geometry_collection = false;
+        bool has_geometry = false;
+
+        geometry geometry_object;
+        std::vector<geometry> geometry_collection;
+        FeatureType type = FeatureType::None;
+        std::string id = "";
+        std::vector<double> bounding_box;
+        PropertyMap properties;
+        PropertyMap foreign_members;
+
+        for (auto& child : tree) {
+            if (child.first == "geometry") {
+                const std::string& geometry_type = child.second.get<std::string>("type");
+                geometry_object = build_geometry(child.second);
+                has_geometry = true;
+
+                if (geometry_type == "Point") {
+                    type = FeatureType::Point;
+                }
+                else if (geometry_type == "LineString") {
+                    type = FeatureType::LineString;
+                }
+                else if (geometry_type == "Polygon") {
+                    type = FeatureType::Polygon;
+                }
+                else if (geometry_type == "MultiPoint") {
+                    type = FeatureType::MultiPoint;
+                }
+                else if (geometry_type == "MultiLineString") {
+                    type = FeatureType::MultiLineString;
+                }
+                else if (geometry_type == "MultiPolygon") {
+                    type = FeatureType::MultiPolygon;
+                }
+            }
+            else if (child.first == "geometries") {
+                // Since the feature can have a number of different types of geometries and the
+                // type of the feature comes from the geometry, we simply set this as a collection
+                type = FeatureType::GeometryCollection;
+                has_geometry_collection = true;
+
+                // Loop through the underlying collection of geometric json definitions and use
+                // those to create geometric objects
+                for (auto &geom : child.second) {
+                    geometry_collection.push_back(build_geometry(geom.second));
+                }
+            }
+            else if (child.first == "id") {
+                id = std::move(child.second.data());
+            }
+            else if (child.first == "bbox") {
+                for (auto &value : tree.get_child("bbox")) {
+                    bounding_box.push_back(std::stod(value.second.data()));
+                }
+            }
+            else if (child.first == "properties") {
+                for (auto& property : child.second) {
+                    properties.emplace(property.first, JSONProperty(property.first, property.second));
+                }
+            }
+            else {
+                foreign_members.emplace(child.first, JSONProperty(child.first, child.second));
+            }
+        }
+
+
+        return make_feature(type, geometry_object, geometry_collection, id, properties, bounding_box, foreign_members);
+    }
+
     /**
      * @brief helper function to build a GeoJSON FeatureCollection from a property tree
      * @param tree boost::property_tree::ptree holding the parsed GeoJSON
@@ -441,16 +456,17 @@ namespace geojson {
         return collection;
     }
 
+    /**
+     * @brief Read a GeoJSON FeatureCollection file, optionally keeping only the features in @p ids
+     *
+     * The file is parsed incrementally by @ref read_streaming rather than into a property tree.
+     */
     static GeoJSON read(const std::string &file_path, const std::vector<std::string> &ids = {}) {
-        boost::property_tree::ptree tree;
-        boost::property_tree::json_parser::read_json(file_path, tree);
-        return build_collection(tree, ids);
+        return read_streaming(file_path, ids);
     }
 
     static GeoJSON read(std::stringstream &data, const std::vector<std::string> &ids = {}) {
-        boost::property_tree::ptree tree;
-        boost::property_tree::json_parser::read_json(data, tree);
-        return build_collection(tree, ids);
+        return read_streaming(data, ids);
     }
 
 
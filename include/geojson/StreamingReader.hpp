@@ -0,0 +1,42 @@
+#ifndef GEOJSON_STREAMING_READER_H
+#define GEOJSON_STREAMING_READER_H
+
+#include <FeatureCollection.hpp>
+
+#include <istream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace geojson {
+    /**
+     * Easy short-hand for a smart pointer to a FeatureCollection
+     */
+    typedef std::shared_ptr<FeatureCollection> GeoJSON;
+
+    /**
+     * @brief Read a GeoJSON FeatureCollection from a stream without building a property tree for the document
+     *
+     * The document is read in fixed size chunks by Boost.JSON's event (SAX) parser, so only the feature being read
+     * is held in memory besides the features that are kept. Each feature is built as its closing brace is read;
+     * when @p ids is not empty and a feature's top level id comes before its geometry and properties, those are
+     * skipped over without being built for a feature outside of the subset.
+     *
+     * The resulting collection matches the one built by @ref build_collection from a parsed property tree of the
+     * same document, including the fallback to the "id" property for features without a top level id.
+     *
+     * @param data The stream to read the document from
+     * @param ids optional subset of string feature ids, only features with these ids will be in the collection
+     * @throws std::runtime_error if the document is not valid JSON, or a geometry is malformed
+     */
+    GeoJSON read_streaming(std::istream &data, const std::vector<std::string> &ids = {});
+
+    /**
+     * @brief Read a GeoJSON FeatureCollection from the file at @p file_path without building a property tree
+     *
+     * @see read_streaming(std::istream&, const std::vector<std::string>&)
+     */
+    GeoJSON read_streaming(const std::string &file_path, const std::vector<std::string> &ids = {});
+}
+
+#endif // GEOJSON_STREAMING_READER_H
@@ -36,6 +36,9 @@ geojson::PropertyMap build_properties(
 /**
  * Build a feature from a GPKG table row
  * 
+ * If the row does not contain the geometry column, the feature is built without
+ * a geometry or bounding box.
+ *
  * @param[in] row SQLite iterator at the row to build a feature from
  * @param[in] geom_col Name of geometry column containing GPKG WKB
  * @return geojson::Feature Feature containing geometry and properties from the given row
@@ -46,18 +49,35 @@ geojson::Feature build_feature(
     const std::string& geom_col
 );
 
+/**
+ * Options limiting what is loaded from a GPKG layer
+ */
+struct read_options
+{
+    //! Attribute columns to load in addition to the ID column (if empty, every column is loaded).
+    //! Requested columns that the layer does not have are ignored.
+    std::vector<std::string> columns = {};
+
+    //! Whether to decode and project geometries. If false, the geometry column is not
+    //! selected, features are built without a geometry or bounding box, and the
+    //! collection has no bounding box.
+    bool geometry = true;
+};
+
 /**
  * Build a feature collection from a GPKG layer
  *
  * @param[in] gpkg_path Path to GPKG file
  * @param[in] layer Layer name within GPKG file to create a collection from
  * @param[in] ids optional subset of feature IDs to capture (if empty, the entire layer is converted)
+ * @param[in] options optional limits on the columns and geometry loaded (by default, everything is loaded)
  * @return std::shared_ptr<geojson::FeatureCollection> 
  */
 std::shared_ptr<geojson::FeatureCollection> read(
     const std::string& gpkg_path,
     const std::string& layer,
-    const std::vector<std::string>& ids
+    const std::vector<std::string>& ids,
+    const read_options& options = {}
 );
 
 } // namespace geopackage
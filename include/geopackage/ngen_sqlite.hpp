@@ -154,6 +154,15 @@ class database
     //! @return SQLite row iterator
     iterator query(const std::string& statement, const boost::span<const std::string> binds = {});
 
+    //! Execute a statement that does not return rows
+    //! @param statement SQL statement, i.e. creating a temporary table
+    void execute(const std::string& statement);
+
+    //! Execute a statement once per value, within a single transaction
+    //! @param statement String statement with one parameter
+    //! @param values text values to bind to the parameter, one per execution
+    void execute_each(const std::string& statement, const boost::span<const std::string> values);
+
     //! Query the SQLite Database with a bound statement and get the result
     //! @param statement String query with parameters
     //! @param params parameters to bind to statement
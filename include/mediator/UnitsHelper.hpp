@@ -1,6 +1,8 @@
 #ifndef NGEN_UNITSHELPER_H
 #define NGEN_UNITSHELPER_H
 
+#include <cstddef>
+#include <memory>
 #include <set>
 #include <stdexcept>
 #include <string>
@@ -16,6 +18,33 @@ class UnitsHelper {
 
     static double* convert_values(const std::string &in_units, double* values, const std::string &out_units, double* out_values, const size_t & count);
 
+    /**
+     * A conversion between two units, resolved once so that it can be applied many times without being looked up.
+     *
+     * A default constructed converter leaves values unchanged, as does one for units that need no conversion.
+     */
+    class unit_converter {
+        public:
+        double convert(double value) const;
+
+        /** Convert @p count values from @p in_values into @p out_values, which may be the same array */
+        void convert(const double* in_values, double* out_values, std::size_t count) const;
+
+        bool is_identity() const { return converter == nullptr; }
+
+        private:
+        friend class UnitsHelper;
+        std::shared_ptr<const void> converter;
+    };
+
+    /**
+     * Resolve the conversion from @p in_units to @p out_units, with the same handling of unit-less and empty unit
+     * strings as @ref get_converted_value.
+     *
+     * @throws unit_conversion_exception If the units can not be parsed or converted between.
+     */
+    static unit_converter get_unit_converter(const std::string &in_units, const std::string &out_units);
+
     struct unit_conversion_exception : public std::runtime_error {
         unit_conversion_exception(std::string message) : std::runtime_error(message) {}
         unit_conversion_exception(std::string const& message, std::string const& in_units, std::string const& out_units)
@@ -22,6 +22,30 @@ namespace realization {
 
         bool is_bmi_output_variable(const std::string &var_name) const override;
 
+        /**
+         * Get the key shared by formulations whose models can be held by one model instance.
+         *
+         * This is empty unless the formulation is configured with the library's vector registration function (see
+         * bmi_vector.h), and otherwise identifies the library, its registration functions and whether the time step
+         * is fixed.
+         *
+         * @return The grouping key, or an empty string if this formulation can only run its own model.
+         */
+        std::string get_group_key() const override;
+
+        /**
+         * Move @p members to one model instance holding all their catchments, initialized from each one's BMI init
+         * config through the library's ``initialize_catchments``.
+         *
+         * If the shared model can not be made, does not hold the same variables for each catchment as the
+         * catchment's own model, or can not take a member's ``model_params`` values (see
+         * @ref set_shared_model_parameters), a warning is logged and every member keeps its own model.
+         *
+         * @param members Formulations of this type with this formulation's @ref get_group_key, including this one.
+         * @return The group, or null if the members were not grouped.
+         */
+        std::shared_ptr<Formulation_Group> make_group(const std::vector<Catchment_Formulation*>& members) override;
+
     protected:
 
         /**
@@ -64,8 +88,8 @@ namespace realization {
          */
         template<class T, class O>
         T get_var_value_as(time_step_t t_index, const std::string& var_name) {
-            std::vector<O> outputs = models::bmi::GetValue<O>(*get_bmi_model(), var_name);
-            return (T) outputs[t_index];
+            std::vector<O> storage;
+            return (T) models::bmi::GetValueView<O>(*get_bmi_model(), var_name, storage)[t_index];
         }
 
         /**
@@ -104,6 +128,17 @@ namespace realization {
         friend class ::Bmi_Formulation_Test;
         friend class ::Bmi_C_Formulation_Test;
         friend class ::Bmi_C_Pet_IT;
+
+    private:
+
+        /** Path of the model's library, kept when it can share a model instance with other catchments. */
+        std::string library_file;
+        /** Name of the library's registration function, kept as for @ref library_file. */
+        std::string registration_function;
+        /** Name of the library's vector registration function, or empty if the formulation did not configure one. */
+        std::string vector_registration_function;
+        /** The properties this formulation was created from, kept until it is moved to a shared model. */
+        geojson::PropertyMap shared_model_properties;
     };
 
 }
@@ -32,8 +32,8 @@ namespace realization {
 
         template<class T, class O>
         T get_var_value_as(time_step_t t_index, const std::string& var_name) {
-            std::vector<O> outputs = models::bmi::GetValue<O>(*get_bmi_model(), var_name);
-            return (T) outputs[t_index];
+            std::vector<O> storage;
+            return (T) models::bmi::GetValueView<O>(*get_bmi_model(), var_name, storage)[t_index];
         }
 
         double get_var_value_as_double(const int& index, const std::string& var_name) override;
@@ -30,11 +30,13 @@
 #define BMI_REALIZATION_CFG_PARAM_OPT__PYTHON_TYPE_NAME "python_type"
 #define BMI_REALIZATION_CFG_PARAM_OPT__PYTHON_MODULE_PATH "module_path"
 #define BMI_REALIZATION_CFG_PARAM_OPT__REGISTRATION_FUNC "registration_function"
+#define BMI_REALIZATION_CFG_PARAM_OPT__VECTOR_REGISTRATION_FUNC "vector_registration_function"
 #define BMI_REALIZATION_CFG_PARAM_OPT__CPP_CREATE_FUNC "create_function"
 #define BMI_REALIZATION_CFG_PARAM_OPT__CPP_DESTROY_FUNC "destroy_function"
 #define BMI_REALIZATION_CFG_PARAM_OPT__CPP_CREATE_FUNC_DEFAULT "bmi_model_create"
 #define BMI_REALIZATION_CFG_PARAM_OPT__CPP_DESTROY_FUNC_DEFAULT "bmi_model_destroy"
 #define BMI_REALIZATION_CFG_PARAM_OPT__CACHE_INPUT_VAR_METADATA "cache_input_variable_metadata"
+#define BMI_REALIZATION_CFG_PARAM_OPT__CONCURRENCY_SAFE "concurrency_safe"
 
 /* *************** See also the Forcing.h file for several CSDMS Standard Names definitions *************** */
 
@@ -175,6 +177,18 @@ namespace realization {
          */
         virtual bool is_model_initialized() const = 0;
 
+        /**
+         * Whether this formulation may be queried as a provider from a worker thread.
+         *
+         * A formulation provides only its own catchment's values, to modules of that same catchment, so this depends
+         * only on whether the forcing it passes through may be queried concurrently.
+         *
+         * @return Whether it is safe to query this provider concurrently from different threads.
+         */
+        bool supports_concurrent_access() const override {
+            return forcing == nullptr || forcing->supports_concurrent_access();
+        }
+
         /**
          * Set the precision of output values when converted to text.
          *
@@ -3,11 +3,15 @@
 
 #include <utility>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
 #include "Bmi_Formulation.hpp"
 #include "Bmi_Adapter.hpp"
 #include <DataProvider.hpp>
 #include "bmi_utilities.hpp"
 #include "bmi/protocols.hpp"
+#include <mediator/UnitsHelper.hpp>
 
 using data_access::MEAN;
 using data_access::SUM;
@@ -29,8 +33,12 @@ namespace realization {
 
         //Bmi_Var_Details() : Bmi_Var_Details("", "", nullptr, -1, -1, "", "") { }
 
+        /**
+         * @throws std::runtime_error If there is no logic for setting values of @p cpp_type.
+         */
         Bmi_Var_Details(std::string name, std::string alias, const int item_size, const int num_items, std::string cpp_type, std::string units)
-            : name(std::move(name)), mapped_alias(std::move(alias)), cpp_type(std::move(cpp_type)), units(std::move(units)), item_size(item_size), num_items(num_items) { }
+            : name(std::move(name)), mapped_alias(std::move(alias)), cpp_type(std::move(cpp_type)), units(std::move(units)), item_size(item_size), num_items(num_items),
+              value_type(models::bmi::resolve_cxx_value_type(this->cpp_type)) { }
 
         Bmi_Var_Details(const Bmi_Var_Details& source) = default;
 
@@ -64,6 +72,10 @@ namespace realization {
             return num_items;
         }
 
+        models::bmi::Cxx_Value_Type get_value_type() const {
+            return value_type;
+        }
+
     private:
         /** The module's publicized name for this variable. */
         const std::string name;
@@ -77,6 +89,8 @@ namespace realization {
         int item_size;
         /** The number of items for this variable. */
         int num_items;
+        /** The C++ type corresponding to this variable's type, resolved once from @ref cpp_type. */
+        models::bmi::Cxx_Value_Type value_type;
     };
 
     /**
@@ -357,6 +371,16 @@ namespace realization {
         const std::vector<std::string> get_bmi_input_variables() const override;
         const std::vector<std::string> get_bmi_output_variables() const override;
 
+        /**
+         * Whether this formulation may be advanced concurrently with other catchments' formulations.
+         *
+         * Many BMI libraries keep static or global state, so a module is only advanced concurrently when its config
+         * sets ``concurrency_safe``, and only if its forcing and input providers may also be queried concurrently.
+         *
+         * @return Whether it is safe to call @ref get_response from a worker thread.
+         */
+        bool is_concurrency_safe() const override;
+
         virtual void check_mass_balance(const int& iteration, const int& total_steps, const std::string& timestamp) const override {
             //Create the protocol context, each member is const, and cannot change during the check
             models::bmi::protocols::Context ctx{iteration, total_steps, timestamp, id};
@@ -449,6 +473,33 @@ namespace realization {
          */
         void set_initial_bmi_parameters(geojson::PropertyMap properties);
 
+        /**
+         * Set the ``model_params`` values in @p properties on a view of this catchment in a model instance shared with
+         * other catchments, ahead of @ref bind_shared_model.
+         *
+         * Unlike @ref set_initial_bmi_parameters, which skips a value it can not set, this fails unless every value
+         * can be set on @p model just as on the formulation's own model: the target must have the same type and size
+         * in both (so it is held per catchment in the shared model), and the value must fill it.
+         *
+         * @param model The view of this catchment in the shared model.
+         * @param properties The configuration properties the formulation was created from.
+         * @throws std::runtime_error If a value does not fit its target in @p model.
+         */
+        void set_shared_model_parameters(models::bmi::Bmi_Adapter& model, const geojson::PropertyMap& properties) const;
+
+        /**
+         * Replace the backing model with a view of this catchment in a model instance shared with other catchments.
+         *
+         * This must happen before the first time step, once @ref set_shared_model_parameters has set the
+         * ``model_params`` values on @p model.  It does not throw, so a set of catchments can all be moved to a shared
+         * model after every check on them has passed.
+         *
+         * @param model The view of this catchment in the shared model.
+         * @param protocols The BMI protocols, already initialized for @p model.
+         */
+        void bind_shared_model(std::shared_ptr<models::bmi::Bmi_Adapter> model,
+                               models::bmi::protocols::NgenBmiProtocols protocols);
+
         /**
          * Test whether backing model has fixed time step size.
          *
@@ -553,6 +604,9 @@ namespace realization {
          */
         static std::set<Bmi_Var_Details> known_bmi_input_vars;
 
+        //! Serializes inserts into @ref known_bmi_input_vars when catchments are advanced concurrently.
+        static std::mutex known_bmi_input_vars_mutex;
+
         /**
          * BMI input variables details for this instance, cached to improve compute performance when setting values
          * prior to updates.
@@ -614,6 +668,129 @@ namespace realization {
 
         /** Whether @ref set_model_inputs_prior_to_update should store and reuse metadata. */
         bool cache_input_variable_metadata = false;
+        /** Whether the config declares the module safe to advance concurrently with other catchments' modules. */
+        bool concurrency_safe = false;
+
+        /**
+         * An available output variable, resolved once so that reading it does not query the model for its name or
+         * units.
+         */
+        struct Resolved_Output {
+            /** The module's publicized name for the variable. */
+            std::string bmi_name;
+            /** The units the module reports for the variable. */
+            std::string native_units;
+            /** The units @ref converter converts to, which are those most recently requested. */
+            std::string converted_units;
+            UnitsHelper::unit_converter converter;
+            /** Why no converter could be resolved for @ref converted_units, reported again on each read. */
+            std::optional<UnitsHelper::unit_conversion_exception> conversion_error;
+            bool converter_resolved = false;
+        };
+
+        /** Outputs resolved by @ref resolve_outputs, one per BMI output variable. */
+        std::vector<Resolved_Output> resolved_outputs;
+
+        /** Index into @ref resolved_outputs for each name in @ref available_forcings. */
+        std::unordered_map<std::string, std::size_t> resolved_output_index;
+
+        /** Index into @ref resolved_outputs of the main output, or @ref unresolved if it is not an output. */
+        std::size_t main_output_index = unresolved;
+
+        /** Index into @ref resolved_outputs of each output variable name, or @ref unresolved. */
+        std::vector<std::size_t> output_column_indices;
+
+        static constexpr std::size_t unresolved = static_cast<std::size_t>(-1);
+
+        /**
+         * Build @ref resolved_outputs and its indexes from the model's output variables and the configured name map.
+         *
+         * Called once the model is initialized and the output variables are configured.
+         */
+        void resolve_outputs();
+
+        /**
+         * Get the index into @ref resolved_outputs of an available output, or @ref unresolved.
+         */
+        std::size_t find_resolved_output(const std::string &name) const;
+
+        /**
+         * Get the converter from a resolved output's native units to @p output_units, resolving it if those are not
+         * the units of the previous read.
+         *
+         * @throws UnitsHelper::unit_conversion_exception If the units can not be converted between.
+         */
+        const UnitsHelper::unit_converter& bind_output_converter(Resolved_Output &output, const std::string &output_units);
+
+        /**
+         * Read the current value of a resolved output, converted to @p output_units.
+         *
+         * @throws UnitsHelper::unit_conversion_exception If the units can not be converted between, holding the
+         *                                                unconverted value.
+         */
+        double read_resolved_output(std::size_t index, const std::string &output_units);
+
+        /**
+         * Selector reused by @ref perform_set for every input, so its strings keep their storage between sets.
+         */
+        mutable CatchmentAggrDataSelector input_selector;
+
+        /**
+         * Scratch storage that @ref perform_set converts input values into before passing them to the model.
+         *
+         * Held as doubles, so it is aligned for any of the types in @ref models::bmi::Cxx_Value_Type, and grown to
+         * the largest input seen, so setting inputs does not allocate once the first time step is done.
+         */
+        mutable std::vector<double> input_staging;
+
+        /**
+         * An input variable set straight from an output variable of another module's model, bypassing that module's
+         * @ref get_value, because the two have the same type, item count and units.
+         */
+        struct Input_Coupling {
+            /** The model with the output variable. */
+            std::shared_ptr<models::bmi::Bmi_Adapter> source_model;
+            /** The source model's BMI name for the output variable. */
+            std::string source_name;
+            /** The size in bytes of the values, which is that of both variables. */
+            std::size_t nbytes;
+            /** Whether to pass the source model's own storage to the input, which is dropped if a pointer can not be got. */
+            bool by_pointer;
+        };
+
+        /** Couplings made by @ref couple_input, keyed by the BMI name of the input variable. */
+        std::map<std::string, Input_Coupling> input_couplings;
+
+        /**
+         * The coupling for each variable in @ref bmi_input_var_details at the same index, or ``nullptr`` for those set
+         * through their provider.
+         */
+        std::vector<Input_Coupling*> bmi_input_couplings;
+
+        /**
+         * Couple an input variable to the output of another module that provides it, if they match.
+         *
+         * The output is the one @p source would provide for the input's mapped alias through @ref get_value.  They
+         * are coupled only when both have the same analogous C++ type, item size, total size and units, so the
+         * values need no conversion.  Each time step, the input is then set from the output's storage where the
+         * source model supports ``GetValuePtr``, or from a single ``GetValue`` copy otherwise.
+         *
+         * This must be done before the first time step, as the couplings are indexed along with the other input
+         * metadata in @ref initialize_bmi_input_var_metadata.
+         *
+         * @param input_name The BMI name of this module's input variable.
+         * @param source The module providing the input.
+         * @return Whether the input was coupled.
+         */
+        bool couple_input(const std::string &input_name, const Bmi_Module_Formulation &source);
+
+        /**
+         * Set an input variable from the output it is coupled to.
+         *
+         * @param input_name The BMI name of the input variable.
+         * @param coupling The coupling of the input variable.
+         */
+        void perform_coupled_set(const std::string &input_name, Input_Coupling &coupling);
 
         /**
          * Set BMI input variables before `BMI update, using saved metadata rather than re-fetching or re-calculating.
@@ -326,6 +326,20 @@ namespace realization {
             return "bmi_multi";
         }
 
+        /**
+         * A multi-module formulation is safe to advance concurrently only if every nested module is.
+         *
+         * @return Whether all nested modules are safe to advance concurrently with other catchments.
+         */
+        bool is_concurrency_safe() const override {
+            for (const auto &module : modules) {
+                if (!module->is_concurrency_safe()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         /**
          * Get the current time for the primary nested BMI model in its native format and units.
          *
@@ -583,6 +597,16 @@ namespace realization {
             }
         }
 
+        /**
+         * Plan how nested modules set inputs provided by the outputs of earlier modules.
+         *
+         * Each such input is coupled directly to the model of the module providing it when the two variables match
+         * (see @ref Bmi_Module_Formulation::couple_input), so that setting it each time step reads the output in
+         * place, skipping the providing module's name lookup and unit conversion.  Inputs that need converting,
+         * and those with deferred providers, are still set through their providers.
+         */
+        void init_input_couplings();
+
         /**
          * Initialize a nested formulation from the given properties and update multi formulation metadata.
          *
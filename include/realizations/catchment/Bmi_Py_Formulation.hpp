@@ -35,6 +35,15 @@ namespace realization {
 
         bool is_bmi_output_variable(const std::string &var_name) const override;
 
+        /**
+         * Python modules share the embedded interpreter and its GIL, so they are never advanced concurrently.
+         *
+         * @return ``false``
+         */
+        bool is_concurrency_safe() const override {
+            return false;
+        }
+
     protected:
 
         std::shared_ptr<models::bmi::Bmi_Adapter> construct_model(const geojson::PropertyMap &properties) override;
@@ -10,6 +10,29 @@
 
 namespace realization {
 
+    /**
+     * A set of catchment formulations whose models are advanced together, through one shared model instance.
+     *
+     * A time step is advanced by calling @ref update_member for every member, which sets its inputs and queues its
+     * update, and then @ref update once.  After that, each member's @ref Catchment_Formulation::get_response for the
+     * same time step only reads its results.
+     */
+    class Formulation_Group {
+        public:
+            virtual ~Formulation_Group() = default;
+
+            /**
+             * Set the inputs of the member at @p member (in the order the group was made with) for time step
+             * @p t_index and queue the update of its catchment.
+             */
+            virtual void update_member(std::size_t member, time_step_t t_index, time_step_t t_delta) = 0;
+
+            /**
+             * Advance the shared model once, for every member queued by @ref update_member.
+             */
+            virtual void update() = 0;
+    };
+
     class Catchment_Formulation : public Formulation, public HY_CatchmentArea {
         public:
             Catchment_Formulation(std::string id, std::shared_ptr<data_access::GenericDataProvider> forcing, utils::StreamHandler output_stream);
@@ -65,6 +88,44 @@ namespace realization {
              */
             virtual double get_response(time_step_t t_index, time_step_t t_delta) override = 0;
 
+            /**
+             * Whether this formulation may be advanced (@ref get_response, @ref check_mass_balance, and
+             * @ref get_output_values_for_timestep) on a worker thread, concurrently with other catchments.
+             *
+             * Formulations that cannot guarantee this keep the default of ``false`` and are always run on the
+             * main thread, in layer order.
+             *
+             * @return Whether this formulation is safe to advance concurrently with other catchments.
+             */
+            virtual bool is_concurrency_safe() const {
+                return false;
+            }
+
+            /**
+             * Get the key shared by formulations that can be advanced together through one model instance.
+             *
+             * Formulations with the same non-empty key may be passed together to @ref make_group.
+             *
+             * @return The grouping key, or an empty string if this formulation can only run its own model.
+             */
+            virtual std::string get_group_key() const {
+                return {};
+            }
+
+            /**
+             * Bind @p members, which all have this formulation's @ref get_group_key and include it, to one model
+             * instance shared between them.
+             *
+             * This must be done before any of them is advanced.  If the members can not be grouped after all, each
+             * keeps its own model and null is returned.
+             *
+             * @param members The formulations to group, in the order they will be advanced.
+             * @return The group, or null if the members were not grouped.
+             */
+            virtual std::shared_ptr<Formulation_Group> make_group(const std::vector<Catchment_Formulation*>& /* members */) {
+                return nullptr;
+            }
+
             const std::vector<std::string>& get_required_parameters() const override = 0;
 
             void create_formulation(boost::property_tree::ptree &config, geojson::PropertyMap *global = nullptr) override = 0;
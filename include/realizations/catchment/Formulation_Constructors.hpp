@@ -15,8 +15,11 @@
 #include <GenericDataProvider.hpp>
 #include "CsvPerFeatureForcingProvider.hpp"
 #include "NullForcingProvider.hpp"
+#include "BinaryForcingDataProvider.hpp"
+#include "GridAreaWeightedDataProvider.hpp"
 #if NGEN_WITH_NETCDF
     #include "NetCDFPerFeatureDataProvider.hpp"
+    #include "NetCDFGridDataProvider.hpp"
 #endif
 
 namespace realization {
@@ -40,12 +43,17 @@ namespace realization {
         std::string formulation_type,
         std::string identifier,
         forcing_params &forcing_config,
-        utils::StreamHandler output_stream
+        utils::StreamHandler output_stream,
+        std::shared_ptr<data_access::GenericDataProvider> forcing_provider = nullptr
     ) {
         constructor formulation_constructor = formulation_constructors.at(formulation_type);
 
         std::shared_ptr<data_access::GenericDataProvider> fp;
-        if (forcing_config.provider == "CsvPerFeature" || forcing_config.provider == ""){
+        if (forcing_provider != nullptr){
+            // already made from forcing_config, as when the formulation manager reads forcing files ahead
+            fp = forcing_provider;
+        }
+        else if (forcing_config.provider == "CsvPerFeature" || forcing_config.provider == ""){
             fp = std::make_shared<CsvPerFeatureForcingProvider>(forcing_config);
         }
 #if NGEN_WITH_NETCDF
@@ -63,12 +71,27 @@ namespace realization {
             // TODO: this is not _ideal_ but implements the idea.
             // refactor in the future.
             f->hint_shared_provider_id(identifier);
+            if (forcing_config.read_ahead > 0) {
+                f->set_read_ahead(forcing_config.read_ahead);
+            }
+            if (forcing_config.node_shared_cache) {
+                f->request_node_shared_cache();
+            }
             fp = f;
         }
 #endif
+        else if (forcing_config.provider == "Binary"){
+            fp = data_access::BinaryForcingDataProvider::get_shared_provider(forcing_config.path, forcing_config.simulation_start_t, forcing_config.simulation_end_t);
+        }
         else if (forcing_config.provider == "NullForcingProvider"){
             fp = std::make_shared<NullForcingProvider>();
         }
+        else if (forcing_config.provider == "GridAreaWeighted"){
+            // averages over every catchment at once, so the formulation manager makes one for the whole fabric
+            throw std::runtime_error(
+                    "The GridAreaWeighted forcing provider of \"" + identifier + "\" must be made by the "
+                    "formulation manager, which weights the grid cells for every catchment of the hydrofabric");
+        }
         else { // Some unknown string in the provider field?
             throw std::runtime_error(
                     "Invalid formulation forcing provider configuration! identifier: \"" + identifier +
@@ -15,10 +15,16 @@
 #include <unistd.h>
 #include <string>
 #include <iostream>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include <boost/property_tree/ptree.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <FeatureBuilder.hpp>
+#include <ForcingFileIndex.hpp>
+#include <WorkerPool.hpp>
 #include "features/Features.hpp"
 #include "Formulation_Constructors.hpp"
 #include "LayerData.hpp"
@@ -27,6 +33,7 @@
 #include "realizations/config/config.hpp"
 #include "realizations/config/layer.hpp"
 #include "realizations/config/output.hpp"
+#include "realizations/config/execution.hpp"
 
 namespace realization {
 
@@ -68,6 +75,18 @@ namespace realization {
                     global_config = realization::config::Config(*possible_global_config);
                 }
 
+                // Index forcing file directories by the catchments being read
+                forcing_fabric = fabric;
+                forcing_index_ids.clear();
+                for (geojson::Feature location : *fabric) {
+                    forcing_index_ids.push_back(location->get_id());
+                }
+                #if NGEN_WITH_MPI
+                if (forcing_index_comm != MPI_COMM_NULL) {
+                    share_forcing_file_indexes();
+                }
+                #endif
+
                 /**
                  * Read the layer descriptions
                 */
@@ -139,6 +158,11 @@ namespace realization {
                     throw std::runtime_error(msg);
                 }
 
+                if (execution_config.resolved_threads() > 1) {
+                    preload_csv_forcings(simulation_time_config, fabric,
+                                         possible_catchment_configs ? &*possible_catchment_configs : nullptr);
+                }
+
                 if (possible_catchment_configs) {
                     for (std::pair<std::string, boost::property_tree::ptree> catchment_config : *possible_catchment_configs) {
                       int catchment_index = fabric->find(catchment_config.first);
@@ -181,6 +205,9 @@ namespace realization {
                         this->add_formulation(missing_formulation);
                     }
                 }
+                preloaded_forcings.clear();
+                grid_forcing_providers.clear();
+                forcing_fabric = nullptr;
             }
 
             void add_formulation(std::shared_ptr<Catchment_Formulation> formulation) {
@@ -223,6 +250,11 @@ namespace realization {
                 return output_config;
             }
 
+            //! The parsed execution configuration block (defaults when absent).
+            const realization::config::Execution& get_execution_config() const {
+                return execution_config;
+            }
+
             typename std::map<std::string, std::shared_ptr<Catchment_Formulation>>::const_iterator begin() const {
                 return this->formulations.cbegin();
             }
@@ -274,6 +306,9 @@ namespace realization {
                 }
 
 #if NGEN_WITH_NETCDF
+#if NGEN_WITH_MPI
+                data_access::NetCDFPerFeatureDataProvider::release_node_caches();
+#endif
                 data_access::NetCDFPerFeatureDataProvider::cleanup_shared_providers();
 #endif
             }
@@ -281,11 +316,13 @@ namespace realization {
             /**
              * Parse the output configuration from the realization tree (preferring
              * the "output" block, falling back to the deprecated top-level keys),
-             * warn on deprecated usage, and validate build support. Called once at
-             * construction so output accessors are valid before read().
+             * warn on deprecated usage, and validate build support. The optional
+             * "execution" block is parsed here as well. Called once at construction
+             * so output and execution accessors are valid before read().
              */
             void initialize_output_config() {
                 output_config = realization::config::Output::from_realization(tree);
+                execution_config = realization::config::Execution::from_realization(tree);
                 #if !NGEN_QUIET
                 if (output_config.from_legacy_keys) {
                     std::cerr << "WARNING: top-level 'output_root', 'disable_catchment_output', and "
@@ -300,12 +337,47 @@ namespace realization {
                 #endif
             }
 
+            #if NGEN_WITH_MPI
+            /**
+             * @brief Have the ranks of @p comm share the listing of each forcing directory that is configured with
+             * `broadcast_file_index`, so that only one rank reads the directory.
+             *
+             * Must be called on every rank before @ref read, which then lists those directories on rank 0 of
+             * @p comm and broadcasts them; every rank of @p comm must call @ref read.
+             *
+             * @param comm The ranks reading the realization
+             */
+            void set_forcing_index_comm(MPI_Comm comm) {
+                forcing_index_comm = comm;
+            }
+            #endif
+
             /**
              * @brief return the layer storage used for formulations
              * @return a reference to the LayerStorageObject
              */
             ngen::LayerDataStorage& get_layer_metadata() { return layer_storage; }
 
+            /**
+             * @brief Whether a realization config needs the geometry of the catchments of the hydrofabric.
+             *
+             * Only the `GridAreaWeighted` forcing provider uses it, to weight the grid cells within each catchment,
+             * so the hydrofabric can be read without geometry when no forcing config names that provider.
+             *
+             * @param realization_config The parsed realization config.
+             */
+            static bool uses_catchment_geometry(const boost::property_tree::ptree &realization_config) {
+                for (const auto& child : realization_config) {
+                    if (child.first == "forcing" && child.second.get<std::string>("provider", "") == "GridAreaWeighted") {
+                        return true;
+                    }
+                    if (uses_catchment_geometry(child.second)) {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
 
         protected:
             std::shared_ptr<Catchment_Formulation> construct_formulation_from_config(
@@ -343,8 +415,9 @@ namespace realization {
                     throw std::runtime_error(message);
                 }
 
-                forcing_params forcing_config = this->get_forcing_params(catchment_formulation.forcing.parameters, identifier, simulation_time_config);
-                std::shared_ptr<Catchment_Formulation> constructed_formulation = construct_formulation(catchment_formulation.formulation.type, identifier, forcing_config, output_stream);
+                std::shared_ptr<data_access::GenericDataProvider> forcing_provider;
+                forcing_params forcing_config = this->get_forcing(catchment_formulation.forcing.parameters, identifier, simulation_time_config, forcing_provider);
+                std::shared_ptr<Catchment_Formulation> constructed_formulation = construct_formulation(catchment_formulation.formulation.type, identifier, forcing_config, output_stream, forcing_provider);
                 //, geometry);
 
                 Catchment_Formulation::config_pattern_substitution(catchment_formulation.formulation.parameters,
@@ -358,8 +431,9 @@ namespace realization {
             std::shared_ptr<Catchment_Formulation> construct_missing_formulation(geojson::Feature& feature, utils::StreamHandler output_stream, simulation_time_params &simulation_time_config){
                 const std::string identifier = feature->get_id();
   
-                forcing_params forcing_config = this->get_forcing_params(global_config.forcing.parameters, identifier, simulation_time_config);
-                std::shared_ptr<Catchment_Formulation> missing_formulation = construct_formulation(global_config.formulation.type, identifier, forcing_config, output_stream);
+                std::shared_ptr<data_access::GenericDataProvider> forcing_provider;
+                forcing_params forcing_config = this->get_forcing(global_config.forcing.parameters, identifier, simulation_time_config, forcing_provider);
+                std::shared_ptr<Catchment_Formulation> missing_formulation = construct_formulation(global_config.formulation.type, identifier, forcing_config, output_stream, forcing_provider);
                 // Need to work with a copy, since it is altered in-place
                 realization::config::Config global_copy = global_config;
                 Catchment_Formulation::config_pattern_substitution(global_copy.formulation.parameters,
@@ -378,6 +452,238 @@ namespace realization {
                 return missing_formulation;
             }
 
+            /**
+             * @brief Read the per-catchment CSV forcing files of the fabric's catchments on the execution threads.
+             *
+             * The providers are kept until the catchments' formulations are constructed, which then use them
+             * rather than reading the files again.  A catchment whose forcing can not be found or read here is
+             * left for the construction of its formulation to report, so errors surface as they do without
+             * preloading.
+             *
+             * @param simulation_time_config The simulation period.
+             * @param fabric The catchments that will have formulations.
+             * @param catchment_configs The catchment-specific configs, if there are any.
+             */
+            void preload_csv_forcings(simulation_time_params &simulation_time_config, geojson::GeoJSON fabric,
+                                      const boost::property_tree::ptree* catchment_configs) {
+                std::vector<std::pair<std::string, forcing_params>> pending;
+                for (geojson::Feature location : *fabric) {
+                    const std::string identifier = location->get_id();
+                    const geojson::PropertyMap* forcing_prop_map = &global_config.forcing.parameters;
+                    config::Forcing catchment_forcing;
+                    if (catchment_configs != nullptr) {
+                        auto catchment_config = catchment_configs->find(identifier);
+                        if (catchment_config != catchment_configs->not_found()) {
+                            auto possible_forcing = catchment_config->second.get_child_optional("forcing");
+                            if (!possible_forcing) {
+                                continue;
+                            }
+                            catchment_forcing = config::Forcing(*possible_forcing);
+                            forcing_prop_map = &catchment_forcing.parameters;
+                        }
+                    }
+
+                    if (forcing_prop_map->count("path") == 0) {
+                        continue;
+                    }
+                    auto provider = forcing_prop_map->find("provider");
+                    if (provider != forcing_prop_map->end() && provider->second.as_string() != "CsvPerFeature"
+                        && !provider->second.as_string().empty()) {
+                        continue;
+                    }
+                    try {
+                        pending.emplace_back(identifier, get_forcing_params(*forcing_prop_map, identifier, simulation_time_config));
+                    }
+                    catch (const std::exception&) {
+                        continue;
+                    }
+                }
+
+                std::vector<std::shared_ptr<data_access::GenericDataProvider>> providers(pending.size());
+                utils::WorkerPool pool(execution_config.resolved_threads());
+                pool.parallel_for(pending.size(), [&](std::size_t i) {
+                    try {
+                        providers[i] = std::make_shared<CsvPerFeatureForcingProvider>(pending[i].second);
+                    }
+                    catch (const std::exception&) {
+                        // read again, and reported, when the catchment's formulation is constructed
+                    }
+                });
+
+                for (std::size_t i = 0; i < pending.size(); ++i) {
+                    if (providers[i] != nullptr) {
+                        preloaded_forcings.emplace(pending[i].first, std::make_pair(pending[i].second, providers[i]));
+                    }
+                }
+            }
+
+            /**
+             * @brief Get the forcing params for a catchment, along with its provider if that was preloaded or is
+             * shared by every catchment.
+             *
+             * A preloaded provider is handed out once, to the first formulation constructed for the catchment.
+             *
+             * @param forcing_prop_map The forcing config for the catchment.
+             * @param identifier The catchment's id.
+             * @param simulation_time_config The simulation period.
+             * @param provider Set to the preloaded or shared provider, or left empty if there is none.
+             * @return The forcing params for the catchment.
+             */
+            forcing_params get_forcing(const geojson::PropertyMap &forcing_prop_map, const std::string &identifier,
+                                       simulation_time_params &simulation_time_config,
+                                       std::shared_ptr<data_access::GenericDataProvider> &provider) {
+                auto preloaded = preloaded_forcings.find(identifier);
+                if (preloaded == preloaded_forcings.end()) {
+                    forcing_params params = this->get_forcing_params(forcing_prop_map, identifier, simulation_time_config);
+                    if (params.provider == "GridAreaWeighted") {
+                        provider = get_grid_forcing_provider(params);
+                    }
+                    return params;
+                }
+                forcing_params params = preloaded->second.first;
+                provider = preloaded->second.second;
+                preloaded_forcings.erase(preloaded);
+                return params;
+            }
+
+            /**
+             * @brief Get the provider of area-weighted averages of a gridded forcing file over the catchments of the
+             * fabric, making it the first time the file is configured.
+             *
+             * One provider serves every catchment of the fabric, so the weights of the grid cells within the
+             * catchments are built once, or read from the `weights_cache` file if it holds them for this grid and
+             * these catchments.  When more than one MPI rank reads the realization, each rank has its own
+             * catchments, so the rank is appended to the name of the cache file.
+             *
+             * @param forcing_config The forcing params of a catchment whose provider is `GridAreaWeighted`.
+             * @return The provider of the catchments of the fabric.
+             * @throws std::runtime_error If a catchment of the fabric has no polygon geometry.
+             */
+            std::shared_ptr<data_access::GenericDataProvider> get_grid_forcing_provider(const forcing_params &forcing_config) {
+            #if NGEN_WITH_NETCDF
+                auto key = std::make_pair(forcing_config.path, forcing_config.weights_cache);
+                auto found = grid_forcing_providers.find(key);
+                if (found != grid_forcing_providers.end()) {
+                    return found->second;
+                }
+
+                auto source = std::make_shared<data_access::NetCDFGridDataProvider>(forcing_config.path, utils::getStdOut());
+                std::vector<std::string> ids;
+                std::vector<geojson::multipolygon_t> shapes;
+                for (geojson::Feature location : *forcing_fabric) {
+                    ids.push_back(location->get_id());
+                    shapes.push_back(get_catchment_shape(*location));
+                    // would otherwise have no weights, and silently get NaN forcings
+                    if (shapes.back().empty()) {
+                        throw std::runtime_error("Catchment " + location->get_id() + " has no polygon geometry to "
+                                                 "weight the cells of gridded forcing file " + forcing_config.path);
+                    }
+                }
+
+                std::string cache_path = forcing_config.weights_cache;
+                #if NGEN_WITH_MPI
+                if (!cache_path.empty() && forcing_index_comm != MPI_COMM_NULL) {
+                    int size, rank;
+                    MPI_Comm_size(forcing_index_comm, &size);
+                    MPI_Comm_rank(forcing_index_comm, &rank);
+                    if (size > 1) {
+                        cache_path += "." + std::to_string(rank);
+                    }
+                }
+                #endif
+                auto weights = cache_path.empty()
+                    ? data_access::GridCellWeights::build(source->get_grid(), std::move(ids), shapes)
+                    : data_access::GridCellWeights::load_or_build(cache_path, source->get_grid(), std::move(ids), shapes);
+
+                auto provider = std::make_shared<data_access::GridAreaWeightedDataProvider>(
+                    source, std::make_shared<const data_access::GridCellWeights>(std::move(weights)));
+                grid_forcing_providers.emplace(key, provider);
+                return provider;
+            #else
+                throw std::runtime_error("The GridAreaWeighted forcing provider reads gridded NetCDF files, but this "
+                                         "build of ngen does not have NetCDF support.");
+            #endif
+            }
+
+            /**
+             * @brief The area of a catchment, for weighting the grid cells within it.
+             *
+             * A catchment without a polygon geometry has no area, so its shape is empty.
+             */
+            static geojson::multipolygon_t get_catchment_shape(const geojson::FeatureBase &catchment) {
+                geojson::geometry geometry = catchment.geometry();
+                if (const auto* polygon = boost::get<geojson::polygon_t>(&geometry)) {
+                    return geojson::multipolygon_t{*polygon};
+                }
+                if (const auto* multipolygon = boost::get<geojson::multipolygon_t>(&geometry)) {
+                    return *multipolygon;
+                }
+                return {};
+            }
+
+            #if NGEN_WITH_MPI
+            /**
+             * @brief Build the forcing file indexes configured with `broadcast_file_index` from listings made by
+             * one rank; collective over the forcing index communicator.
+             *
+             * The global forcing config and then the catchment configs, in the order of the realization config,
+             * are checked on every rank, so every rank takes part in the same broadcasts.
+             */
+            void share_forcing_file_indexes() {
+                std::vector<realization::config::Forcing> forcing_configs = {global_config.forcing};
+                auto possible_catchment_configs = tree.get_child_optional("catchments");
+                if (possible_catchment_configs) {
+                    for (const auto& catchment_config : *possible_catchment_configs) {
+                        auto possible_forcing = catchment_config.second.get_child_optional("forcing");
+                        if (possible_forcing) {
+                            forcing_configs.emplace_back(*possible_forcing);
+                        }
+                    }
+                }
+
+                for (const auto& forcing : forcing_configs) {
+                    if (!forcing.has_key("file_pattern") || !forcing.has_key("path") || !forcing.has_key("broadcast_file_index")
+                        || !forcing.parameters.at("broadcast_file_index").as_boolean()) {
+                        continue;
+                    }
+                    std::string path = forcing.parameters.at("path").as_string();
+                    if (path.empty()) {
+                        continue;
+                    }
+                    if (path.back() != '/') {
+                        path += "/";
+                    }
+                    auto key = std::make_pair(path, forcing.parameters.at("file_pattern").as_string());
+                    if (forcing_file_indexes.count(key) == 0) {
+                        auto entries = data_access::ForcingFileIndex::list_directory(path, forcing_index_comm, 0);
+                        forcing_file_indexes.emplace(key, std::make_shared<data_access::ForcingFileIndex>(
+                            key.first, key.second, std::move(entries), forcing_index_ids));
+                    }
+                }
+            }
+            #endif
+
+            /**
+             * @brief Get the index of the forcing files in a directory matching a pattern, building it if needed.
+             *
+             * The directory is listed once for each pattern, and the files indexed by the ids of the catchments
+             * being read.
+             *
+             * @param path The directory, ending with "/".
+             * @param file_pattern The pattern for the names of the forcing files.
+             * @return The index.
+             */
+            const data_access::ForcingFileIndex& get_forcing_file_index(const std::string &path, const std::string &file_pattern) {
+                auto key = std::make_pair(path, file_pattern);
+                auto found = forcing_file_indexes.find(key);
+                if (found == forcing_file_indexes.end()) {
+                    auto entries = data_access::ForcingFileIndex::list_directory(path);
+                    found = forcing_file_indexes.emplace(key, std::make_shared<data_access::ForcingFileIndex>(
+                        path, file_pattern, std::move(entries), forcing_index_ids)).first;
+                }
+                return *found->second;
+            }
+
             forcing_params get_forcing_params(const geojson::PropertyMap &forcing_prop_map, std::string identifier, simulation_time_params &simulation_time_config) {
                 std::string path = "";
                 if(forcing_prop_map.count("path") != 0){
@@ -388,12 +694,26 @@ namespace realization {
                     provider = forcing_prop_map.at("provider").as_string();
                 }
                 if (forcing_prop_map.count("file_pattern") == 0) {
-                    return forcing_params(
+                    forcing_params params(
                         path,
                         provider,
                         simulation_time_config.start_time,
                         simulation_time_config.end_time
                     );
+                    if(forcing_prop_map.count("read_ahead") != 0){
+                        long read_ahead = forcing_prop_map.at("read_ahead").as_natural_number();
+                        if (read_ahead < 0) {
+                            throw std::runtime_error("Error with NGEN config - 'read_ahead' in forcing params can not be negative.");
+                        }
+                        params.read_ahead = read_ahead;
+                    }
+                    if(forcing_prop_map.count("node_shared_cache") != 0){
+                        params.node_shared_cache = forcing_prop_map.at("node_shared_cache").as_boolean();
+                    }
+                    if(forcing_prop_map.count("weights_cache") != 0){
+                        params.weights_cache = forcing_prop_map.at("weights_cache").as_string();
+                    }
+                    return params;
                 }
 
                 if (path.empty()) {
@@ -406,115 +726,20 @@ namespace realization {
                     path += "/";
                 }
 
-                std::string filepattern = forcing_prop_map.at("file_pattern").as_string();
-
-                int id_index = filepattern.find("{{id}}");
-
-                // If an index for '{{id}}' was found, we can count on that being where the id for this realization can be found.
+                // If the pattern has '{{id}}', that is where the id for this realization can be found.
                 //     For instance, if we have a pattern of '.*{{id}}_14_15.csv' and this is named 'cat-87',
                 //     this will match on 'stuff_example_cat-87_14_15.csv'
-                if (id_index != std::string::npos) {
-                    filepattern = filepattern.replace(id_index, sizeof("{{id}}") - 1, identifier);
-                }
-
-                // Create a regular expression used to identify proper file names
-                std::regex pattern(filepattern);
-
-                // A stream providing the functions necessary for evaluating a directory:
-                //    https://www.gnu.org/software/libc/manual/html_node/Opening-a-Directory.html#Opening-a-Directory
-                DIR *directory = nullptr;
-
-                // structure representing the member of a directory: https://www.gnu.org/software/libc/manual/html_node/Directory-Entries.html
-                struct dirent *entry = nullptr;
-
-                // Attempt to open the directory for evaluation
-                directory = opendir(path.c_str());
-                // Allow for a few retries in certain failure situations
-                size_t attemptCount = 0;
-                std::string errMsg;
-                while (directory == nullptr && attemptCount++ < 5) {
-                    // For several error codes, we should break immediately and not retry
-                    if (errno == ENOENT) {
-                        errMsg = "No such file or directory.";
-                        break;
-                    }
-                    if (errno == ENXIO) {
-                        errMsg = "No such device or address.";
-                        break;
-                    }
-                    if (errno == EACCES) {
-                        errMsg = "Permission denied.";
-                        break;
-                    }
-                    if (errno == EPERM) {
-                        errMsg = "Operation not permitted.";
-                        break;
-                    }
-                    if (errno == ENOTDIR) {
-                        errMsg = "File at provided path is not a directory.";
-                        break;
-                    }
-                    if (errno == EMFILE) {
-                        errMsg = "The current process has too many open files.";
-                        break;
-                    }
-                    if (errno == ENFILE) {
-                        errMsg = "The system has too many open files.";
-                        break;
-                    }
-                    sleep(2);
-                    directory = opendir(path.c_str());
-                    errMsg = "Received system error number " + std::to_string(errno);
-                }
-
-                // If the directory could be found and opened, we can go ahead and iterate
-                if (directory != nullptr) {
-                    bool match;
-                    while ((entry = readdir(directory))) {
-                        match = std::regex_match(entry->d_name, pattern);
-                        if( match ) {
-                            // If the entry is a regular file or symlink AND the name matches the pattern, 
-                            //    we can consider this ready to be interpretted as valid forcing data (even if it isn't)
-                            #ifdef _DIRENT_HAVE_D_TYPE
-                            if ( entry->d_type == DT_REG or entry->d_type == DT_LNK ) {
-                                return forcing_params(
-                                    path + entry->d_name,
-                                    provider,
-                                    simulation_time_config.start_time,
-                                    simulation_time_config.end_time
-                                );
-                            }
-                            else if ( entry->d_type == DT_UNKNOWN )
-                            #endif
-                            {
-                                //dirent is not guaranteed to provide propoer file type identification in d_type
-                                //so if a system returns unknown or it isn't supported, need to use stat to determine if it is a file
-                                struct stat st;
-                                if( stat((path+entry->d_name).c_str(), &st) != 0) {
-                                    throw std::runtime_error("Could not stat file "+path+entry->d_name);
-                                }
-                                if( S_ISREG(st.st_mode) ) {
-                                    //Sinde we used stat and not lstat, we get the result of the target of links as well
-                                    //so this covers both cases we are interested in.
-                                    return forcing_params(
-                                        path + entry->d_name,
-                                        provider,
-                                        simulation_time_config.start_time,
-                                        simulation_time_config.end_time
-                                    );
-                                }
-                                throw std::runtime_error("Forcing data is path "+path+entry->d_name+" is not a file");
-                            }
-                        } //no match found, try next entry
-                    } // end while iter dir
-                } //end if directory
-                else {
-                    // The directory wasn't found or otherwise couldn't be opened; forcing data cannot be retrieved
-                    throw std::runtime_error("Error opening forcing data dir '" + path + "' after " + std::to_string(attemptCount) + " attempts: " + errMsg);
+                std::string filepattern = forcing_prop_map.at("file_pattern").as_string();
+                std::string file = get_forcing_file_index(path, filepattern).find(identifier);
+                if (!file.empty()) {
+                    return forcing_params(
+                        file,
+                        provider,
+                        simulation_time_config.start_time,
+                        simulation_time_config.end_time
+                    );
                 }
 
-                closedir(directory);
-
                 throw std::runtime_error("Forcing data could not be found for '" + identifier + "'");
             }
 
@@ -657,6 +882,27 @@ namespace realization {
 
             realization::config::Output output_config;
 
+            realization::config::Execution execution_config;
+
+            //! Indexes of forcing files, by directory and file pattern
+            std::map<std::pair<std::string, std::string>, std::shared_ptr<const data_access::ForcingFileIndex>> forcing_file_indexes;
+
+            //! The ids of the catchments being read, by which forcing files are indexed
+            std::vector<std::string> forcing_index_ids;
+
+            #if NGEN_WITH_MPI
+            MPI_Comm forcing_index_comm = MPI_COMM_NULL;
+            #endif
+
+            //! Forcing read ahead of formulation construction, by catchment id; see preload_csv_forcings
+            std::unordered_map<std::string, std::pair<forcing_params, std::shared_ptr<data_access::GenericDataProvider>>> preloaded_forcings;
+
+            //! The catchments being read, whose areas weight the cells of gridded forcing files
+            geojson::GeoJSON forcing_fabric;
+
+            //! Providers of gridded forcing files, by file and weights cache path; see get_grid_forcing_provider
+            std::map<std::pair<std::string, std::string>, std::shared_ptr<data_access::GenericDataProvider>> grid_forcing_providers;
+
             ngen::LayerDataStorage layer_storage;
 
     };
@@ -0,0 +1,106 @@
+#ifndef NGEN_REALIZATION_CONFIG_EXECUTION_H
+#define NGEN_REALIZATION_CONFIG_EXECUTION_H
+
+#include <string>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/property_tree/ptree.hpp>
+
+namespace realization {
+  namespace config {
+
+    //! Key for the optional execution configuration block in a realization config.
+    static const std::string EXECUTION_CONFIG_KEY = "execution";
+
+    //! How nexuses store their per-timestep flow bookkeeping:
+    //!   map   - HY_PointHydroNexus, hash maps keyed by timestep (unbounded history)
+    //!   dense - HY_DensePointHydroNexus, a fixed ring of timestep slots (bounded memory)
+    enum class NexusStorage { map, dense };
+
+    inline NexusStorage parse_nexus_storage(const std::string& s)
+    {
+        if (s == "map")   return NexusStorage::map;
+        if (s == "dense") return NexusStorage::dense;
+        throw std::runtime_error("Invalid nexus storage '" + s + "'; expected 'map' or 'dense'.");
+    }
+
+    /**
+     * Parsed representation of a realization config's execution settings.
+     *
+     * @code{.json}
+     * "execution": {
+     *     "threads": 4,
+     *     "nexus_storage": "dense",
+     *     "nexus_window": 4
+     * }
+     * @endcode
+     *
+     * ``threads`` is the number of threads (including the main thread) used to advance the
+     * catchments of a layer within one timestep. ``1`` (the default, and the behavior when the
+     * block is absent) keeps the original serial loop; ``0`` requests one thread per hardware
+     * core. Only catchments whose modules set ``concurrency_safe`` (and whose forcing providers
+     * allow concurrent queries) are advanced on the extra threads. Nexus contributions are always
+     * merged in the layer's catchment order, so results do not depend on the thread count. The
+     * same threads read the catchments' CSV forcing files while the realization is loaded.
+     *
+     * ``nexus_storage`` selects the nexus implementation for serial runs; MPI runs need
+     * remote-capable point nexuses, so they reject ``dense``. ``nexus_window`` is the number of
+     * timesteps a dense nexus retains.
+     */
+    struct Execution {
+        //! Thread count requested when the block or key is absent.
+        static constexpr unsigned DEFAULT_THREADS = 1;
+        //! Timesteps retained by a dense nexus when no window is configured.
+        static constexpr unsigned DEFAULT_NEXUS_WINDOW = 4;
+
+        //! Requested thread count; 0 means "use the hardware concurrency".
+        unsigned threads = DEFAULT_THREADS;
+        NexusStorage nexus_storage = NexusStorage::map;
+        unsigned nexus_window = DEFAULT_NEXUS_WINDOW;
+
+        Execution() = default;
+
+        //! Parse the "execution" block sub-tree.
+        static Execution parse_block(const boost::property_tree::ptree& execution_tree)
+        {
+            Execution exec;
+            int requested = execution_tree.get<int>("threads", DEFAULT_THREADS);
+            if (requested < 0) {
+                throw std::runtime_error("Invalid execution thread count " + std::to_string(requested)
+                                         + "; expected 0 (hardware concurrency) or a positive integer.");
+            }
+            exec.threads = static_cast<unsigned>(requested);
+            if (auto n = execution_tree.get_optional<std::string>("nexus_storage")) {
+                exec.nexus_storage = parse_nexus_storage(*n);
+            }
+            int window = execution_tree.get<int>("nexus_window", DEFAULT_NEXUS_WINDOW);
+            if (window < 1) {
+                throw std::runtime_error("Invalid nexus window " + std::to_string(window)
+                                         + "; expected a positive number of timesteps.");
+            }
+            exec.nexus_window = static_cast<unsigned>(window);
+            return exec;
+        }
+
+        //! Build from a realization tree, using defaults when no "execution" block is present.
+        static Execution from_realization(const boost::property_tree::ptree& realization_tree)
+        {
+            auto block = realization_tree.get_child_optional(EXECUTION_CONFIG_KEY);
+            return block ? parse_block(*block) : Execution();
+        }
+
+        //! The thread count to actually use, resolving 0 to the hardware concurrency (at least 1).
+        unsigned resolved_threads() const
+        {
+            if (threads != 0) {
+                return threads;
+            }
+            unsigned hw = std::thread::hardware_concurrency();
+            return hw == 0 ? 1 : hw;
+        }
+    };
+
+  }//end namespace config
+}//end namespace realization
+#endif //NGEN_REALIZATION_CONFIG_EXECUTION_H
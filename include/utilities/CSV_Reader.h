@@ -8,6 +8,9 @@
 #include <algorithm>
 #include <boost/algorithm/string.hpp>
 #include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
 
 /*
  * @brief A class to read data from a csv file.
@@ -24,6 +27,17 @@ public:
 
     // Function to fetch data from a CSV File
     std::vector<std::vector<std::string> > getData();
+
+    /*
+     * Read the file in a single pass, calling handleRow with views of the fields of each line that is not
+     * blank. The views point into a buffer holding the whole file, so they are only valid during the call;
+     * nothing is copied out of the file for fields the handler does not keep.
+     */
+    template<typename RowHandler>
+    void forEachRow(RowHandler&& handleRow);
+
+private:
+    std::string readFile();
 };
 
 /*
@@ -68,4 +82,67 @@ inline std::vector<std::vector<std::string> > CSVReader::getData()
     return dataList;
 }
 
+/*
+* Reads the whole file into one buffer.
+*/
+inline std::string CSVReader::readFile()
+{
+    errno = 0;
+    std::ifstream file(fileName, std::ios::binary | std::ios::ate);
+
+    if (file.fail()) {
+        throw std::runtime_error(
+                errno == 0
+                    ? "Error: failure opening " + fileName
+                    : "Errno " + std::to_string(errno) + " (" + strerror(errno) + ") opening " + fileName
+        );
+    }
+
+    std::string contents(static_cast<std::size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    if (!file.read(&contents[0], contents.size())) {
+        throw std::runtime_error("Error: failure reading " + fileName);
+    }
+    return contents;
+}
+
+template<typename RowHandler>
+inline void CSVReader::forEachRow(RowHandler&& handleRow)
+{
+    const std::string contents = readFile();
+    const std::string_view text(contents);
+    std::vector<std::string_view> fields;
+
+    std::size_t lineStart = 0;
+    while (lineStart < text.size())
+    {
+        std::size_t lineEnd = text.find('\n', lineStart);
+        if (lineEnd == std::string_view::npos) {
+            lineEnd = text.size();
+        }
+        std::string_view line = text.substr(lineStart, lineEnd - lineStart);
+        lineStart = lineEnd + 1;
+
+        if (!line.empty() && line.back() == '\r') {
+            line.remove_suffix(1);
+        }
+        if (line.find_first_not_of(" \t") == std::string_view::npos) {
+            continue;
+        }
+
+        fields.clear();
+        std::size_t fieldStart = 0;
+        while (true) {
+            std::size_t fieldEnd = line.find_first_of(delimeter, fieldStart);
+            if (fieldEnd == std::string_view::npos) {
+                fields.push_back(line.substr(fieldStart));
+                break;
+            }
+            fields.push_back(line.substr(fieldStart, fieldEnd - fieldStart));
+            fieldStart = fieldEnd + 1;
+        }
+        handleRow(static_cast<const std::vector<std::string_view>&>(fields));
+    }
+}
+
 #endif //CSV_Reader_H
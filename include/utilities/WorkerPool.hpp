@@ -0,0 +1,161 @@
+#ifndef NGEN_WORKER_POOL_HPP
+#define NGEN_WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace utils {
+
+    /**
+     * @brief A small, persistent pool of threads for fork-join loops.
+     *
+     * Threads are started once at construction and parked between calls, so the per-call cost of
+     * @ref parallel_for is a wake-up rather than thread creation. The calling thread takes part in
+     * every loop, so a pool of size ``n`` owns ``n - 1`` background threads and a pool of size 1
+     * runs everything inline.
+     *
+     * Only one @ref parallel_for may be in flight at a time; it is not reentrant.
+     */
+    class WorkerPool {
+    public:
+        using body_type = std::function<void(std::size_t)>;
+
+        /**
+         * @param num_threads Total threads participating in each loop, including the caller (minimum 1).
+         */
+        explicit WorkerPool(std::size_t num_threads)
+        {
+            std::size_t background = num_threads > 1 ? num_threads - 1 : 0;
+            workers.reserve(background);
+            for (std::size_t i = 0; i < background; ++i) {
+                workers.emplace_back([this]() { worker_loop(); });
+            }
+        }
+
+        WorkerPool(const WorkerPool&) = delete;
+        WorkerPool& operator=(const WorkerPool&) = delete;
+
+        ~WorkerPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                stopping = true;
+            }
+            work_cv.notify_all();
+            for (auto& t : workers) {
+                t.join();
+            }
+        }
+
+        //! Total threads participating in each loop, including the caller.
+        std::size_t size() const { return workers.size() + 1; }
+
+        /**
+         * @brief Call @p body once for every index in ``[0, count)`` and wait for all calls to finish.
+         *
+         * Indexes are handed out dynamically, so the order and thread of each call is unspecified. If
+         * any call throws, the remaining indexes are still processed and one of the exceptions is
+         * rethrown on the calling thread once the loop completes.
+         *
+         * @param count Number of indexes to process.
+         * @param body Work for a single index.
+         */
+        void parallel_for(std::size_t count, const body_type& body)
+        {
+            if (count == 0) {
+                return;
+            }
+            if (workers.empty() || count == 1) {
+                for (std::size_t i = 0; i < count; ++i) {
+                    body(i);
+                }
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                job = &body;
+                job_count = count;
+                next_index.store(0);
+                active = workers.size();
+                job_error = nullptr;
+                ++generation;
+            }
+            work_cv.notify_all();
+
+            drain();
+
+            std::unique_lock<std::mutex> lock(mtx);
+            done_cv.wait(lock, [this]() { return active == 0; });
+            job = nullptr;
+            if (job_error) {
+                std::exception_ptr err = job_error;
+                job_error = nullptr;
+                std::rethrow_exception(err);
+            }
+        }
+
+    private:
+        //! Claim and run indexes of the current job until none remain.
+        void drain()
+        {
+            std::size_t i;
+            while ((i = next_index.fetch_add(1)) < job_count) {
+                try {
+                    (*job)(i);
+                }
+                catch (...) {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    if (!job_error) {
+                        job_error = std::current_exception();
+                    }
+                }
+            }
+        }
+
+        void worker_loop()
+        {
+            std::uint64_t seen = 0;
+            while (true) {
+                {
+                    std::unique_lock<std::mutex> lock(mtx);
+                    work_cv.wait(lock, [&]() { return stopping || generation != seen; });
+                    if (stopping) {
+                        return;
+                    }
+                    seen = generation;
+                }
+                drain();
+                {
+                    std::lock_guard<std::mutex> lock(mtx);
+                    if (--active == 0) {
+                        done_cv.notify_one();
+                    }
+                }
+            }
+        }
+
+        std::vector<std::thread> workers;
+        std::mutex mtx;
+        std::condition_variable work_cv;
+        std::condition_variable done_cv;
+
+        const body_type* job = nullptr;
+        std::size_t job_count = 0;
+        std::atomic<std::size_t> next_index{0};
+        std::size_t active = 0;
+        std::exception_ptr job_error;
+        std::uint64_t generation = 0;
+        bool stopping = false;
+    };
+
+}
+
+#endif // NGEN_WORKER_POOL_HPP
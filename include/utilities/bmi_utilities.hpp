@@ -1,8 +1,14 @@
 #ifndef NGEN_BMI_UTILITIES_HPP
 #define NGEN_BMI_UTILITIES_HPP
 
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
+#include <boost/core/span.hpp>
 #include <boost/type_index.hpp>
 #include "Bmi_Adapter.hpp"
 
@@ -28,6 +34,139 @@ namespace models {
             }
         }
 
+        /**
+         * @brief The C++ types a BMI variable's values can be set as, as named by @ref Bmi_Adapter::get_analogous_cxx_type.
+         */
+        enum class Cxx_Value_Type : unsigned char {
+            DOUBLE,
+            FLOAT,
+            SHORT,
+            UNSIGNED_SHORT,
+            INT,
+            UNSIGNED_INT,
+            LONG,
+            UNSIGNED_LONG,
+            LONG_LONG,
+            UNSIGNED_LONG_LONG
+        };
+
+        /**
+         * @brief Find the @ref Cxx_Value_Type named by a C++ type name, or one of its Fortran equivalents.
+         *
+         * @param type The type name, as from @ref Bmi_Adapter::get_analogous_cxx_type
+         * @return std::optional<Cxx_Value_Type> The type, or nothing if it is not one of @ref Cxx_Value_Type
+         */
+        inline std::optional<Cxx_Value_Type> find_cxx_value_type(const std::string& type) {
+            if (type == "double" || type == "double precision")
+                return Cxx_Value_Type::DOUBLE;
+
+            if (type == "float" || type == "real")
+                return Cxx_Value_Type::FLOAT;
+
+            if (type == "short" || type == "short int" || type == "signed short" || type == "signed short int")
+                return Cxx_Value_Type::SHORT;
+
+            if (type == "unsigned short" || type == "unsigned short int")
+                return Cxx_Value_Type::UNSIGNED_SHORT;
+
+            if (type == "int" || type == "signed" || type == "signed int" || type == "integer")
+                return Cxx_Value_Type::INT;
+
+            if (type == "unsigned" || type == "unsigned int")
+                return Cxx_Value_Type::UNSIGNED_INT;
+
+            if (type == "long" || type == "long int" || type == "signed long" || type == "signed long int")
+                return Cxx_Value_Type::LONG;
+
+            if (type == "unsigned long" || type == "unsigned long int")
+                return Cxx_Value_Type::UNSIGNED_LONG;
+
+            if (type == "long long" || type == "long long int" || type == "signed long long" || type == "signed long long int")
+                return Cxx_Value_Type::LONG_LONG;
+
+            if (type == "unsigned long long" || type == "unsigned long long int")
+                return Cxx_Value_Type::UNSIGNED_LONG_LONG;
+
+            return std::nullopt;
+        }
+
+        /**
+         * @brief Resolve the name of a C++ type, or one of its Fortran equivalents, to a @ref Cxx_Value_Type.
+         *
+         * @param type The type name, as from @ref Bmi_Adapter::get_analogous_cxx_type
+         * @return Cxx_Value_Type The type
+         * @throws std::runtime_error If there is no logic for setting values of the type
+         */
+        inline Cxx_Value_Type resolve_cxx_value_type(const std::string& type) {
+            std::optional<Cxx_Value_Type> resolved = find_cxx_value_type(type);
+            if (!resolved) {
+                throw std::runtime_error("Unable to get value of variable as type '" + type +
+                    "': no logic for converting value to variable's type.");
+            }
+            return *resolved;
+        }
+
+        /**
+         * @brief The @ref Cxx_Value_Type of @tparam T, or nothing if @tparam T is not one of them.
+         */
+        template <typename T>
+        constexpr std::optional<Cxx_Value_Type> cxx_value_type_of() {
+            if constexpr (std::is_same_v<T, double>) return Cxx_Value_Type::DOUBLE;
+            else if constexpr (std::is_same_v<T, float>) return Cxx_Value_Type::FLOAT;
+            else if constexpr (std::is_same_v<T, short>) return Cxx_Value_Type::SHORT;
+            else if constexpr (std::is_same_v<T, unsigned short>) return Cxx_Value_Type::UNSIGNED_SHORT;
+            else if constexpr (std::is_same_v<T, int>) return Cxx_Value_Type::INT;
+            else if constexpr (std::is_same_v<T, unsigned int>) return Cxx_Value_Type::UNSIGNED_INT;
+            else if constexpr (std::is_same_v<T, long>) return Cxx_Value_Type::LONG;
+            else if constexpr (std::is_same_v<T, unsigned long>) return Cxx_Value_Type::UNSIGNED_LONG;
+            else if constexpr (std::is_same_v<T, long long>) return Cxx_Value_Type::LONG_LONG;
+            else if constexpr (std::is_same_v<T, unsigned long long>) return Cxx_Value_Type::UNSIGNED_LONG_LONG;
+            else return std::nullopt;
+        }
+
+        /**
+         * @brief Convert doubles to @p type, writing them to @p dest.
+         *
+         * @param type The type to convert to
+         * @param src Pointer to @p count values
+         * @param count Number of values to convert
+         * @param dest Storage for @p count values of @p type, which must not overlap @p src
+         */
+        inline void convert_values_to_type(Cxx_Value_Type type, const double* src, std::size_t count, void* dest) {
+            switch (type) {
+                case Cxx_Value_Type::DOUBLE:
+                    std::memcpy(dest, src, count * sizeof(double));
+                    return;
+                case Cxx_Value_Type::FLOAT:
+                    std::copy(src, src + count, static_cast<float*>(dest));
+                    return;
+                case Cxx_Value_Type::SHORT:
+                    std::copy(src, src + count, static_cast<short*>(dest));
+                    return;
+                case Cxx_Value_Type::UNSIGNED_SHORT:
+                    std::copy(src, src + count, static_cast<unsigned short*>(dest));
+                    return;
+                case Cxx_Value_Type::INT:
+                    std::copy(src, src + count, static_cast<int*>(dest));
+                    return;
+                case Cxx_Value_Type::UNSIGNED_INT:
+                    std::copy(src, src + count, static_cast<unsigned int*>(dest));
+                    return;
+                case Cxx_Value_Type::LONG:
+                    std::copy(src, src + count, static_cast<long*>(dest));
+                    return;
+                case Cxx_Value_Type::UNSIGNED_LONG:
+                    std::copy(src, src + count, static_cast<unsigned long*>(dest));
+                    return;
+                case Cxx_Value_Type::LONG_LONG:
+                    std::copy(src, src + count, static_cast<long long*>(dest));
+                    return;
+                case Cxx_Value_Type::UNSIGNED_LONG_LONG:
+                    std::copy(src, src + count, static_cast<unsigned long long*>(dest));
+                    return;
+            }
+        }
+
         /**
          * @brief Copy values from a BMI model adapter and box them into a vector.
          * 
@@ -66,8 +205,7 @@ namespace models {
             // This works, and is relatively cheap since the lambda is stateless, only one instance should be created.
             auto sptr = std::shared_ptr<void>(data, [](void *p) { ::operator delete(p); });
             //Delegate to specific adapter's GetValue()
-            //Note, may be able to optimize this furthur using GetValuePtr
-            //which would avoid copying in the BMI model and copying again here
+            //See GetValueView for reading values in place using GetValuePtr
             model.GetValue(name, data);
             std::vector<T> result;
 
@@ -119,6 +257,52 @@ namespace models {
             }
             return result;
         }
+
+        /**
+         * @brief View the values of a variable of a BMI model adapter, without copying them where possible.
+         *
+         * If the variable's type is @tparam T and the adapter supports ``GetValuePtr``, the view is over the model's
+         * own storage, and so sees later changes to the values.  Otherwise the values are copied, through a single
+         * ``GetValue`` into @p fallback where the types match, or converted by @ref GetValue where they do not, and
+         * the view is over @p fallback.  A model that reports a failure to get a pointer is also read by copying.
+         *
+         * The view is valid until the model next reallocates the variable's storage, or @p fallback is modified or
+         * destroyed.
+         *
+         * @tparam T Type of the values to view
+         * @param model Bmi model adapter to read values from
+         * @param name Bmi variable name to query the model for
+         * @param fallback Storage for the values if they must be copied
+         * @return boost::span<const T> The values of variable @p name
+         */
+        template <typename T>
+        boost::span<const T> GetValueView(Bmi_Adapter& model, const std::string& name, std::vector<T>& fallback) {
+            int total_mem = model.GetVarNbytes(name);
+            int item_size = model.GetVarItemsize(name);
+            constexpr std::optional<Cxx_Value_Type> view_type = cxx_value_type_of<T>();
+            if (view_type && total_mem > 0 && item_size == (int) sizeof(T)
+                && find_cxx_value_type(model.get_analogous_cxx_type(model.GetVarType(name), item_size)) == view_type) {
+                std::size_t num_items = total_mem / item_size;
+                if (model.has_value_ptr()) {
+                    const void* ptr = nullptr;
+                    try {
+                        ptr = model.GetValuePtr(name);
+                    }
+                    catch (const std::exception&) {
+                        // Models may throw any exception for an unimplemented GetValuePtr; fall back to copying below
+                    }
+                    if (ptr != nullptr) {
+                        return boost::span<const T>(static_cast<const T*>(ptr), num_items);
+                    }
+                }
+                fallback.resize(num_items);
+                model.GetValue(name, fallback.data());
+                return boost::span<const T>(fallback.data(), fallback.size());
+            }
+            // Types that need converting, and variables with no valid items (for which GetValue throws)
+            fallback = GetValue<T>(model, name);
+            return boost::span<const T>(fallback.data(), fallback.size());
+        }
     }
 }
 
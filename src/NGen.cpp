@@ -44,6 +44,7 @@
 #include <mpi.h>
 #include "parallel_utils.h"
 #include "core/Partition_Parser.hpp"
+#include "core/Partition_Index.hpp"
 #include <HY_Features_MPI.hpp>
 
 #include "core/Partition_One.hpp"
@@ -53,6 +54,7 @@
 #include <Layer.hpp>
 #include <SurfaceLayer.hpp>
 #include <DomainLayer.hpp>
+#include <WorkerPool.hpp>
 #include "utilities/output/NexusOutputsMgr.hpp"
 #include "utilities/output/PerNexusCsvOutputMgr.hpp"
 #include "utilities/output/CatchmentOutputsMgr.hpp"
@@ -310,7 +312,11 @@ int main(int argc, char* argv[]) {
         }
 
         // Do some extra steps if we expect to load a subdivided hydrofabric
-        if (is_subdivided_hydrofabric_wanted) {
+        if (is_subdivided_hydrofabric_wanted && !error && Partition_Index::is_index_file(PARTITION_PATH)) {
+            std::cout << "Subdividing the hydrofabric requires a JSON partition config, not a partition index." << std::endl;
+            error = true;
+        }
+        else if (is_subdivided_hydrofabric_wanted) {
             // Ensure the hydrofabric is subdivided (either already or by doing it now), and then
             // adjust these paths
             if (parallel::is_hydrofabric_subdivided(catchmentDataFile, MPI_COMM_WORLD, true) ||
@@ -352,12 +358,18 @@ int main(int argc, char* argv[]) {
     #if NGEN_WITH_MPI
     PartitionData local_data;
     if (mpi_num_procs > 1) {
-        Partitions_Parser partition_parser(PARTITION_PATH);
-        // TODO: add something here to make sure this step worked for every rank, and maybe to checksum the file
-        partition_parser.parse_partition_file();
+        if (Partition_Index::is_index_file(PARTITION_PATH)) {
+            // Indexed partition files let each rank read just its own partition
+            local_data = Partition_Index::read_partition(PARTITION_PATH, mpi_rank);
+        }
+        else {
+            Partitions_Parser partition_parser(PARTITION_PATH);
+            // TODO: add something here to make sure this step worked for every rank, and maybe to checksum the file
+            partition_parser.parse_partition_file();
 
-        std::vector<PartitionData> &partitions = partition_parser.partition_ranks;
-        local_data = std::move(partitions[mpi_rank]);
+            std::vector<PartitionData> &partitions = partition_parser.partition_ranks;
+            local_data = std::move(partitions[mpi_rank]);
+        }
         if (!nexus_subset_ids.empty()) {
             std::cerr << "Warning: CLI provided nexus subset will be ignored when using partition config";
         }
@@ -369,11 +381,22 @@ int main(int argc, char* argv[]) {
     }
     #endif // NGEN_WITH_MPI
 
+    boost::property_tree::ptree realization_config;
+    boost::property_tree::json_parser::read_json(REALIZATION_CONFIG_PATH, realization_config);
+
+    #if NGEN_WITH_SQLITE3
+    // Only GridAreaWeighted forcings use catchment geometry, to weight the grid cells within each catchment,
+    // so don't decode or project it otherwise.
+    // All attribute columns are kept, since formulations may read any of them.
+    ngen::geopackage::read_options gpkg_options;
+    gpkg_options.geometry = realization::Formulation_Manager::uses_catchment_geometry(realization_config);
+    #endif
+
     // TODO: Instead of iterating through a collection of FeatureBase objects mapping to nexi, we instead want to iterate through HY_HydroLocation objects
     geojson::GeoJSON nexus_collection;
     if (boost::algorithm::ends_with(nexusDataFile, "gpkg")) {
       #if NGEN_WITH_SQLITE3
-      nexus_collection = ngen::geopackage::read(nexusDataFile, "nexus", nexus_subset_ids);
+      nexus_collection = ngen::geopackage::read(nexusDataFile, "nexus", nexus_subset_ids, gpkg_options);
       #else
       throw std::runtime_error("SQLite3 support required to read GeoPackage files.");
       #endif
@@ -393,7 +416,7 @@ int main(int argc, char* argv[]) {
     // rather than erroring on missing features.
     if (boost::algorithm::ends_with(catchmentDataFile, "gpkg")) {
       #if NGEN_WITH_SQLITE3
-      catchment_collection = ngen::geopackage::read(catchmentDataFile, "divides", catchment_subset_ids);
+      catchment_collection = ngen::geopackage::read(catchmentDataFile, "divides", catchment_subset_ids, gpkg_options);
       #else
       throw std::runtime_error("SQLite3 support required to read GeoPackage files.");
       #endif
@@ -411,9 +434,6 @@ int main(int argc, char* argv[]) {
     //to map features to their primary id as well as the alternative property
     nexus_collection->update_ids("id");
 
-    boost::property_tree::ptree realization_config;
-    boost::property_tree::json_parser::read_json(REALIZATION_CONFIG_PATH, realization_config);
-
     std::shared_ptr<Simulation_Time> sim_time;
 
     auto possible_simulation_time = realization_config.get_child_optional("time");
@@ -429,8 +449,17 @@ int main(int argc, char* argv[]) {
 
     std::shared_ptr<realization::Formulation_Manager> manager =
         std::make_shared<realization::Formulation_Manager>(realization_config);
+    #if NGEN_WITH_MPI
+    // read is collective for forcing directories configured with broadcast_file_index, which only rank 0 lists
+    manager->set_forcing_index_comm(MPI_COMM_WORLD);
+    #endif
     manager->read(simulation_time_config, catchment_collection, utils::getStdOut());
 
+    #if NGEN_WITH_NETCDF && NGEN_WITH_MPI
+    // collective: every rank takes part, whether or not it has forcing files to share
+    data_access::NetCDFPerFeatureDataProvider::share_node_caches(MPI_COMM_WORLD);
+    #endif
+
     //TODO refactor manager->read so certain configs can be queried before the entire
     //realization collection is created
     #if NGEN_WITH_ROUTING
@@ -473,7 +502,7 @@ int main(int argc, char* argv[]) {
     const auto& catchment_output = manager->get_output_config().catchment;
     if (catchment_output.enable) {
         std::vector<utils::FeatureDescriptor> descriptors;
-        for (const auto& id : features.catchments()) {
+        for (const auto& id : features.catchment_ids()) {
             descriptors.emplace_back(id, manager->get_formulation(id)->get_output_fields());
         }
         realization::config::Output cat_config = manager->get_output_config();
@@ -530,17 +559,11 @@ int main(int argc, char* argv[]) {
             "Routing is enabled but nexus output is disabled (output.nexus.enable = false); "
             "the routing run has no nexus output to consume.");
     }
-    #if NGEN_WITH_MPI
-    std::vector<std::string> nexus_ids;
-    std::copy_if(features.nexuses().begin(), features.nexuses().end(), std::back_inserter(nexus_ids),
-                 [&features](std::string nid) { return !features.is_remote_sender_nexus((nid)); });
+    // Under MPI this holds only the local (not remote sender) nexuses.
     // TODO: (later) I'd love to be able to use local_data.nexus_ids and local_data.remote_connections for this, but
     // TODO:        they aren't well documented and I've already misused them once.  However, this could probably be
     // TODO:        optimized in the future based on those.
-
-    #else
-    std::vector<std::string> nexus_ids(features.nexuses().begin(), features.nexuses().end());
-    #endif
+    std::vector<std::string> nexus_ids = features.nexus_ids();
 
     if (nexus_output.enable && nexus_output.format == realization::config::OutputFormat::netcdf) {
         // TODO: (later) use nullptr for now, until full support for multiple formulations per catchment is available
@@ -614,6 +637,14 @@ int main(int argc, char* argv[]) {
     std::vector<std::shared_ptr<ngen::Layer>> layers;
     layers.resize(keys.size());
 
+    // Optional within-layer catchment concurrency; one pool is shared by all layers since they run in turn
+    std::shared_ptr<utils::WorkerPool> catchment_pool;
+    unsigned execution_threads = manager->get_execution_config().resolved_threads();
+    if (execution_threads > 1) {
+        catchment_pool = std::make_shared<utils::WorkerPool>(execution_threads);
+        std::cout << "Advancing catchments with " << execution_threads << " threads per rank" << std::endl;
+    }
+
     for (long i = 0; i < keys.size(); ++i) {
         auto& desc = layer_meta_data.get_layer(keys[i]);
         std::vector<std::string> cat_ids;
@@ -627,9 +658,7 @@ int main(int argc, char* argv[]) {
                 std::make_shared<ngen::DomainLayer>(desc, layer_sim_time, features, 0, formulation,
                                                     domain_outputs_mgr);
         } else {
-            for (std::string id : features.catchments(keys[i])) {
-                cat_ids.push_back(id);
-            }
+            cat_ids = features.catchment_ids(keys[i]);
             if (keys[i] != 0) {
                 layers[i] = std::make_shared<ngen::Layer>(
                     desc,
@@ -652,6 +681,7 @@ int main(int argc, char* argv[]) {
                     catchment_outputs_mgr
                 );
             }
+            layers[i]->set_worker_pool(catchment_pool);
         }
     }
 
@@ -138,6 +138,17 @@ void* AbstractCLibBmiAdapter::dynamic_load_symbol(
     return symbol;
 }
 
+bool AbstractCLibBmiAdapter::exports_symbol(const std::string& symbol_name) {
+    if (dyn_lib_handle == nullptr) {
+        return false;
+    }
+    // Clear any previous error, then clear the one a missing symbol leaves behind
+    dlerror();
+    void* symbol = dlsym(dyn_lib_handle, symbol_name.c_str());
+    dlerror();
+    return symbol != nullptr;
+}
+
 void AbstractCLibBmiAdapter::finalizeForLibAbstraction() {
     //  close the dynamically loaded library
     if (dyn_lib_handle != nullptr) {
@@ -90,6 +90,37 @@ Bmi_C_Adapter::Bmi_C_Adapter(const std::string &type_name, std::string library_f
     }
 }
 
+/**
+ * Public constructor for one model instance holding several catchments.
+ *
+ * @param type_name The name of the backing BMI module/model type.
+ * @param library_file_path The string path to the shared library file for external module.
+ * @param catchment_init_configs The BMI initialization config file of each catchment, in catchment order.
+ * @param has_fixed_time_step Whether the model has a fixed time step size.
+ * @param registration_func The name for the @see bmi_registration_function.
+ * @param vector_registration_func The name of the library's function registering its Bmi_Vector extension.
+ */
+Bmi_C_Adapter::Bmi_C_Adapter(const std::string &type_name, std::string library_file_path,
+                             std::vector<std::string> catchment_init_configs, bool has_fixed_time_step,
+                             std::string registration_func, std::string vector_registration_func)
+        : Bmi_C_Adapter(type_name, std::move(library_file_path),
+                        catchment_init_configs.empty() ? "" : catchment_init_configs.front(),
+                        has_fixed_time_step, std::move(registration_func), false)
+{
+    this->catchment_init_configs = std::move(catchment_init_configs);
+    this->vector_registration_function = std::move(vector_registration_func);
+    try {
+        construct_and_init_backing_model_for_type();
+        model_initialized = true;
+        bmi_model_time_convert_factor = get_time_convert_factor();
+    }
+    // As above, record that the attempt was made before re-throwing
+    catch (...) {
+        model_initialized = true;
+        throw;
+    }
+}
+
 // TODO: since the dynamically loaded lib and model struct can't easily be copied (without risking breaking once
 //  original object closes the handle for its dynamically loaded lib) it make more sense to remove the copy constructor.
 // TODO: However, it may make sense to bring it back once it is possible to serialize and deserialize the model.
@@ -317,6 +348,10 @@ std::shared_ptr<std::vector<std::string>> Bmi_C_Adapter::inner_get_variable_name
 }
 
 void Bmi_C_Adapter::SetValue(std::string name, void *src) {
+    set_value_from_buffer(name, src);
+}
+
+void Bmi_C_Adapter::set_value_from_buffer(const std::string &name, void *src) {
     int result = bmi_model->set_value(bmi_model.get(), name.c_str(), src);
     if (result != BMI_SUCCESS) {
         throw models::external::State_Exception("Failed to set values of " + name + " variable for " + model_name);
@@ -449,3 +484,25 @@ void Bmi_C_Adapter::GetGridNodesPerFace(const int grid, int *nodes_per_face) {
         throw std::runtime_error(model_name + " failed to get grid " + std::to_string(grid) + " nodes per face.");
     }
 }
+
+int Bmi_C_Adapter::initialize_catchments() {
+    if (!exports_symbol(vector_registration_function)) {
+        init_exception_msg = "Cannot init " + model_name + " for several catchments; library does not export "
+                             "vector registration function '" + vector_registration_function + "'";
+        throw ::external::ExternalIntegrationException(init_exception_msg);
+    }
+    auto register_bmi_vector = (Bmi_Vector *(*)(Bmi_Vector *)) dynamic_load_symbol(vector_registration_function);
+    Bmi_Vector extension{};
+    register_bmi_vector(&extension);
+    if (extension.initialize_catchments == nullptr) {
+        init_exception_msg = "Cannot init " + model_name + " for several catchments; vector registration function '"
+                             + vector_registration_function + "' did not set initialize_catchments";
+        throw ::external::ExternalIntegrationException(init_exception_msg);
+    }
+    std::vector<const char*> config_files;
+    config_files.reserve(catchment_init_configs.size());
+    for (const std::string &config : catchment_init_configs) {
+        config_files.push_back(config.c_str());
+    }
+    return extension.initialize_catchments(bmi_model.get(), (int) config_files.size(), config_files.data());
+}
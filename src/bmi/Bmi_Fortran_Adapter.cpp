@@ -153,6 +153,10 @@ void Bmi_Fortran_Adapter::SetValue(std::string name, void *src) {
     inner_set_value(name, src);
 }
 
+void Bmi_Fortran_Adapter::set_value_from_buffer(const std::string &name, void *src) {
+    inner_set_value(name, src);
+}
+
 bool Bmi_Fortran_Adapter::is_model_initialized() {
     return model_initialized;
 }
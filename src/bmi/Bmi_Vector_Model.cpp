@@ -0,0 +1,319 @@
+#include "bmi/Bmi_Vector_Model.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+namespace models {
+namespace bmi {
+
+Bmi_Vector_Model::Bmi_Vector_Model(std::shared_ptr<Bmi_Adapter> model, int count)
+    : model(std::move(model))
+    , count(count)
+    , is_queued(count > 0 ? count : 0, false) {
+    if (this->model == nullptr) {
+        throw std::invalid_argument("Cannot share a null BMI model between catchments");
+    }
+    if (count <= 0) {
+        throw std::invalid_argument("Cannot share a BMI model between " + std::to_string(count) + " catchments");
+    }
+}
+
+Bmi_Vector_Model::Variable& Bmi_Vector_Model::variable(const std::string& name) {
+    auto it = variables.find(name);
+    if (it != variables.end()) {
+        return it->second;
+    }
+    int nbytes = model->GetVarNbytes(name);
+    if (nbytes % count != 0) {
+        throw std::runtime_error(model->get_model_name() + " variable " + name + " has " + std::to_string(nbytes)
+                                 + " bytes, which can not be split between " + std::to_string(count) + " catchments");
+    }
+    Variable& var = variables[name];
+    var.slot_nbytes = nbytes / count;
+    var.item_size = model->GetVarItemsize(name);
+    return var;
+}
+
+char* Bmi_Vector_Model::slot_values(const std::string& name, int index) {
+    Variable& var = variable(name);
+    std::size_t offset = var.slot_nbytes * index;
+    if (var.is_staged) {
+        return var.staged.data() + offset;
+    }
+    if (!var.is_cached && model->has_value_ptr()) {
+        void* values = nullptr;
+        try {
+            values = model->GetValuePtr(name);
+        }
+        catch (const std::exception&) {
+            // not implemented by the model; read through the cached copy below
+            values = nullptr;
+        }
+        if (values != nullptr) {
+            return static_cast<char*>(values) + offset;
+        }
+    }
+    if (!var.is_cached) {
+        var.cached.resize(var.slot_nbytes * count);
+        model->GetValue(name, var.cached.data());
+        var.is_cached = true;
+    }
+    return var.cached.data() + offset;
+}
+
+void Bmi_Vector_Model::stage(const std::string& name, int index, const void* src, const int* inds, int item_count) {
+    Variable& var = variable(name);
+    if (!var.is_staged) {
+        // Start from the model's values, so catchments that set nothing this time step keep theirs
+        var.staged.resize(var.slot_nbytes * count);
+        model->GetValue(name, var.staged.data());
+        var.is_staged = true;
+    }
+    char* dest = var.staged.data() + var.slot_nbytes * index;
+    if (inds == nullptr) {
+        std::memcpy(dest, src, var.slot_nbytes);
+        return;
+    }
+    const char* values = static_cast<const char*>(src);
+    for (int i = 0; i < item_count; ++i) {
+        if (inds[i] < 0 || (std::size_t) inds[i] * var.item_size >= var.slot_nbytes) {
+            throw std::out_of_range("Index " + std::to_string(inds[i]) + " out of range for " + name);
+        }
+        std::memcpy(dest + inds[i] * var.item_size, values + i * var.item_size, var.item_size);
+    }
+}
+
+void Bmi_Vector_Model::queue_update(int index, std::optional<double> until) {
+    if (is_queued[index]) {
+        throw std::runtime_error("Catchment " + std::to_string(index) + " of shared " + model->get_model_name()
+                                 + " model updated again before the model was advanced");
+    }
+    if (queued_count > 0 && until != queued_until) {
+        throw std::runtime_error("Catchment " + std::to_string(index) + " of shared " + model->get_model_name()
+                                 + " model asked for a different update than the catchments before it");
+    }
+    is_queued[index] = true;
+    ++queued_count;
+    queued_until = until;
+}
+
+void Bmi_Vector_Model::update() {
+    if (queued_count != count) {
+        throw std::runtime_error("Cannot advance shared " + model->get_model_name() + " model with only "
+                                 + std::to_string(queued_count) + " of its " + std::to_string(count)
+                                 + " catchments ready");
+    }
+    for (auto& entry : variables) {
+        Variable& var = entry.second;
+        if (var.is_staged) {
+            model->set_value_from_buffer(entry.first, var.staged.data());
+            var.is_staged = false;
+        }
+        var.is_cached = false;
+    }
+    if (queued_until) {
+        model->UpdateUntil(*queued_until);
+    }
+    else {
+        model->Update();
+    }
+    std::fill(is_queued.begin(), is_queued.end(), false);
+    queued_count = 0;
+    queued_until.reset();
+}
+
+Bmi_Vector_Slot_Adapter::Bmi_Vector_Slot_Adapter(std::shared_ptr<Bmi_Vector_Model> vector_model, int index,
+                                                 std::string bmi_init_config)
+    : Bmi_Adapter(vector_model->get_model().get_model_name(), std::move(bmi_init_config), true)
+    , vector_model(std::move(vector_model))
+    , index(index) {
+    if (index < 0 || index >= this->vector_model->get_count()) {
+        throw std::out_of_range("No catchment " + std::to_string(index) + " in shared " + model_name + " model");
+    }
+    model_initialized = true;
+    bmi_model_time_convert_factor = get_time_convert_factor();
+}
+
+bool Bmi_Vector_Slot_Adapter::is_model_initialized() {
+    return vector_model->get_model().is_model_initialized();
+}
+
+const std::string Bmi_Vector_Slot_Adapter::get_analogous_cxx_type(const std::string& external_type_name,
+                                                                  const size_t item_size) {
+    return vector_model->get_model().get_analogous_cxx_type(external_type_name, item_size);
+}
+
+void Bmi_Vector_Slot_Adapter::set_value_from_buffer(const std::string& name, void* src) {
+    vector_model->stage(name, index, src, nullptr, 0);
+}
+
+void Bmi_Vector_Slot_Adapter::Update() {
+    vector_model->queue_update(index, std::nullopt);
+}
+
+void Bmi_Vector_Slot_Adapter::UpdateUntil(double time) {
+    vector_model->queue_update(index, time);
+}
+
+void Bmi_Vector_Slot_Adapter::Finalize() { }
+
+std::string Bmi_Vector_Slot_Adapter::GetComponentName() {
+    return vector_model->get_model().GetComponentName();
+}
+
+int Bmi_Vector_Slot_Adapter::GetInputItemCount() {
+    return vector_model->get_model().GetInputItemCount();
+}
+
+int Bmi_Vector_Slot_Adapter::GetOutputItemCount() {
+    return vector_model->get_model().GetOutputItemCount();
+}
+
+std::vector<std::string> Bmi_Vector_Slot_Adapter::GetInputVarNames() {
+    return vector_model->get_model().GetInputVarNames();
+}
+
+std::vector<std::string> Bmi_Vector_Slot_Adapter::GetOutputVarNames() {
+    return vector_model->get_model().GetOutputVarNames();
+}
+
+int Bmi_Vector_Slot_Adapter::GetVarGrid(std::string name) {
+    return vector_model->get_model().GetVarGrid(std::move(name));
+}
+
+std::string Bmi_Vector_Slot_Adapter::GetVarType(std::string name) {
+    return vector_model->get_model().GetVarType(std::move(name));
+}
+
+std::string Bmi_Vector_Slot_Adapter::GetVarUnits(std::string name) {
+    return vector_model->get_model().GetVarUnits(std::move(name));
+}
+
+int Bmi_Vector_Slot_Adapter::GetVarItemsize(std::string name) {
+    return (int) vector_model->variable(name).item_size;
+}
+
+int Bmi_Vector_Slot_Adapter::GetVarNbytes(std::string name) {
+    return (int) vector_model->variable(name).slot_nbytes;
+}
+
+std::string Bmi_Vector_Slot_Adapter::GetVarLocation(std::string name) {
+    return vector_model->get_model().GetVarLocation(std::move(name));
+}
+
+double Bmi_Vector_Slot_Adapter::GetCurrentTime() {
+    return vector_model->get_model().GetCurrentTime();
+}
+
+double Bmi_Vector_Slot_Adapter::GetStartTime() {
+    return vector_model->get_model().GetStartTime();
+}
+
+double Bmi_Vector_Slot_Adapter::GetEndTime() {
+    return vector_model->get_model().GetEndTime();
+}
+
+std::string Bmi_Vector_Slot_Adapter::GetTimeUnits() {
+    return vector_model->get_model().GetTimeUnits();
+}
+
+double Bmi_Vector_Slot_Adapter::GetTimeStep() {
+    return vector_model->get_model().GetTimeStep();
+}
+
+void Bmi_Vector_Slot_Adapter::GetValue(std::string name, void* dest) {
+    std::memcpy(dest, vector_model->slot_values(name, index), vector_model->variable(name).slot_nbytes);
+}
+
+void* Bmi_Vector_Slot_Adapter::GetValuePtr(std::string name) {
+    return vector_model->slot_values(name, index);
+}
+
+void Bmi_Vector_Slot_Adapter::GetValueAtIndices(std::string name, void* dest, int* inds, int count) {
+    const char* values = vector_model->slot_values(name, index);
+    const auto& var = vector_model->variable(name);
+    char* out = static_cast<char*>(dest);
+    for (int i = 0; i < count; ++i) {
+        if (inds[i] < 0 || (std::size_t) inds[i] * var.item_size >= var.slot_nbytes) {
+            throw std::out_of_range("Index " + std::to_string(inds[i]) + " out of range for " + name);
+        }
+        std::memcpy(out + i * var.item_size, values + inds[i] * var.item_size, var.item_size);
+    }
+}
+
+void Bmi_Vector_Slot_Adapter::SetValue(std::string name, void* src) {
+    vector_model->stage(name, index, src, nullptr, 0);
+}
+
+void Bmi_Vector_Slot_Adapter::SetValueAtIndices(std::string name, int* inds, int count, void* src) {
+    vector_model->stage(name, index, src, inds, count);
+}
+
+int Bmi_Vector_Slot_Adapter::GetGridRank(const int grid) {
+    return vector_model->get_model().GetGridRank(grid);
+}
+
+int Bmi_Vector_Slot_Adapter::GetGridSize(const int grid) {
+    return vector_model->get_model().GetGridSize(grid) / vector_model->get_count();
+}
+
+std::string Bmi_Vector_Slot_Adapter::GetGridType(const int grid) {
+    return vector_model->get_model().GetGridType(grid);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridShape(const int grid, int* shape) {
+    vector_model->get_model().GetGridShape(grid, shape);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridSpacing(const int grid, double* spacing) {
+    vector_model->get_model().GetGridSpacing(grid, spacing);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridOrigin(const int grid, double* origin) {
+    vector_model->get_model().GetGridOrigin(grid, origin);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridX(const int grid, double* x) {
+    vector_model->get_model().GetGridX(grid, x);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridY(const int grid, double* y) {
+    vector_model->get_model().GetGridY(grid, y);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridZ(const int grid, double* z) {
+    vector_model->get_model().GetGridZ(grid, z);
+}
+
+int Bmi_Vector_Slot_Adapter::GetGridNodeCount(const int grid) {
+    return vector_model->get_model().GetGridNodeCount(grid);
+}
+
+int Bmi_Vector_Slot_Adapter::GetGridEdgeCount(const int grid) {
+    return vector_model->get_model().GetGridEdgeCount(grid);
+}
+
+int Bmi_Vector_Slot_Adapter::GetGridFaceCount(const int grid) {
+    return vector_model->get_model().GetGridFaceCount(grid);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridEdgeNodes(const int grid, int* edge_nodes) {
+    vector_model->get_model().GetGridEdgeNodes(grid, edge_nodes);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridFaceEdges(const int grid, int* face_edges) {
+    vector_model->get_model().GetGridFaceEdges(grid, face_edges);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridFaceNodes(const int grid, int* face_nodes) {
+    vector_model->get_model().GetGridFaceNodes(grid, face_nodes);
+}
+
+void Bmi_Vector_Slot_Adapter::GetGridNodesPerFace(const int grid, int* nodes_per_face) {
+    vector_model->get_model().GetGridNodesPerFace(grid, nodes_per_face);
+}
+
+} // namespace bmi
+} // namespace models
@@ -1,5 +1,6 @@
 #include <HY_Features.hpp>
 #include <HY_PointHydroNexus.hpp>
+#include <HY_DensePointHydroNexus.hpp>
 #include <Formulation_Manager.hpp>
 
 using namespace hy_features;
@@ -24,6 +25,11 @@ HY_Features::HY_Features(network::Network network, std::shared_ptr<Formulation_M
       std::string feat_type;
       std::vector<std::string> origins, destinations;
 
+      realization::config::Execution execution;
+      if (formulations) {
+        execution = formulations->get_execution_config();
+      }
+
       for(const auto& feat_idx : network){
         feat_id = network.get_id(feat_idx);//feature->get_id();
         feat_type = feat_id.substr(0, feat_id.find(hy_features::identifiers::separator) );
@@ -57,8 +63,14 @@ HY_Features::HY_Features(network::Network network, std::shared_ptr<Formulation_M
         else if(hy_features::identifiers::isNexus(feat_type))
         {
             origins = network.get_origination_ids(feat_id);
-            _nexuses.emplace(feat_id, std::make_unique<HY_PointHydroNexus>(
-                                          HY_PointHydroNexus(feat_id, destinations, origins) ));
+            if (execution.nexus_storage == realization::config::NexusStorage::dense) {
+              _nexuses.emplace(feat_id, std::make_shared<HY_DensePointHydroNexus>(
+                                            feat_id, destinations, origins, execution.nexus_window ));
+            }
+            else {
+              _nexuses.emplace(feat_id, std::make_unique<HY_PointHydroNexus>(
+                                            HY_PointHydroNexus(feat_id, destinations, origins) ));
+            }
         }
         else
         {
@@ -67,6 +79,24 @@ HY_Features::HY_Features(network::Network network, std::shared_ptr<Formulation_M
         }
       }
 
+      index_features();
+}
+
+void HY_Features::index_features()
+{
+  for(const auto& id : network.filter(hy_features::identifiers::catchment)) {
+    _catchment_ids.push_back(id);
+  }
+  for(long lyr : hf_layers) {
+    auto& ids = _layer_catchment_ids[lyr];
+    for(const auto& id : network.filter(hy_features::identifiers::catchment, lyr)) {
+      ids.push_back(id);
+    }
+  }
+  for(const auto& id : network.filter(hy_features::identifiers::nexus)) {
+    _nexus_ids.push_back(id);
+    _nexus_pointers.push_back(_nexuses.at(id).get());
+  }
 }
 
 HY_Features::~HY_Features() = default;
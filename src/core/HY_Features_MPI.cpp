@@ -9,6 +9,13 @@ using namespace hy_features;
 HY_Features_MPI::HY_Features_MPI( PartitionData partition_data, geojson::GeoJSON linked_hydro_fabric, std::shared_ptr<Formulation_Manager> formulations, int mpi_rank, int mpi_num_procs) :
       network(linked_hydro_fabric), mpi_rank(mpi_rank), mpi_num_procs(mpi_num_procs)
 { 
+      // Every nexus of an MPI run must be able to exchange flows with other ranks, which the dense nexus can not
+      if (formulations != nullptr
+          && formulations->get_execution_config().nexus_storage == realization::config::NexusStorage::dense) {
+        throw std::runtime_error("The 'dense' nexus storage is not supported in MPI runs; "
+                                 "remove 'nexus_storage' from the execution block or set it to 'map'");
+      }
+
       std::string feat_id;
       std::string feat_type;
       std::vector<std::string> origins, destinations;
@@ -80,6 +87,32 @@ HY_Features_MPI::HY_Features_MPI( PartitionData partition_data, geojson::GeoJSON
           std::cerr<<"HY_Features::HY_Features unknown feature identifier type "<<feat_type<<" for feature id."<<feat_id
                    <<" Skipping feature"<<std::endl;
         }
-      }	
+      }
+
+      index_features();
+
+      std::vector<HY_PointHydroNexusRemote*> remote_nexuses;
+      remote_nexuses.reserve(_nexuses.size());
+      for(const auto& nexus : _nexuses) {
+          remote_nexuses.push_back(nexus.second.get());
+      }
+      _exchange = std::make_unique<HY_RemoteNexusExchange>(remote_nexuses, MPI_COMM_WORLD);
+}
+
+void HY_Features_MPI::index_features()
+{
+    for(const auto& id : network.filter("cat")) {
+        _catchment_ids.push_back(id);
+    }
+    for(long lyr : hf_layers) {
+        auto& ids = _layer_catchment_ids[lyr];
+        for(const auto& id : network.filter("cat", lyr)) {
+            ids.push_back(id);
+        }
+    }
+    for(const auto& id : nexuses()) {
+        _nexus_ids.push_back(id);
+        _nexus_pointers.push_back(_nexuses.at(id).get());
+    }
 }
 #endif //NGEN_WITH_MPI
@@ -1,6 +1,9 @@
 #include <Layer.hpp>
 #include <Catchment_Formulation.hpp>
 #include <CatchmentOutputsMgr.hpp>
+#include <WorkerPool.hpp>
+#include <HY_DensePointHydroNexus.hpp>
+#include <map>
 
 #if NGEN_WITH_MPI
 #include "HY_Features_MPI.hpp"
@@ -12,6 +15,187 @@
 // are complete.
 ngen::Layer::~Layer() = default;
 
+void ngen::Layer::compile_plan(std::unordered_map<std::string, int> const& catchment_indexes)
+{
+    plan.clear();
+    plan.reserve(processing_units.size());
+    concurrent_units.clear();
+    serial_units.clear();
+    for (std::size_t i = 0; i < processing_units.size(); ++i) {
+        const std::string& id = processing_units[i];
+        CatchmentPlanEntry entry;
+        entry.id = &id;
+        //TODO redesign to avoid this cast
+        entry.formulation = dynamic_cast<realization::Catchment_Formulation*>(features.catchment_at(id).get());
+        if (entry.formulation == nullptr) {
+            throw std::runtime_error("No catchment formulation found for processing unit '" + id + "'");
+        }
+        //TODO put this somewhere else.  For now, just trying to ensure we get m^3/s into nexus output
+        try {
+            entry.area_sqkm = catchment_data->get_feature(id)->get_property("areasqkm").as_real_number();
+        }
+        catch(std::invalid_argument &e) {
+            entry.area_sqkm = catchment_data->get_feature(id)->get_property("area_sqkm").as_real_number();
+        }
+        //TODO in a DENDRITIC network, only one destination nexus per catchment
+        //If there is more than one, some form of catchment partitioning will be required.
+        //for now, only contribute to the first one in the list
+        auto destinations = features.destination_nexuses(id);
+        if (!destinations.empty()) {
+            if (destinations.front() == nullptr) {
+                throw std::runtime_error("Invalid (null) nexus instantiation downstream of '"+id+"'");
+            }
+            entry.downstream = destinations.front().get();
+            entry.dense_downstream = dynamic_cast<HY_DensePointHydroNexus*>(entry.downstream);
+            if (entry.dense_downstream != nullptr) {
+                entry.upstream_index = entry.dense_downstream->upstream_index(id);
+            }
+        }
+#if NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
+        entry.outflow_index = catchment_indexes.at(id);
+#endif // NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
+        // Concurrency safety is a static property of each formulation, so sort the units once
+        entry.concurrent = entry.formulation->is_concurrency_safe();
+        plan.push_back(entry);
+    }
+    // Catchments whose models can be held by one model instance are moved to it before any of them advances
+    formulation_groups.clear();
+    std::map<std::string, std::vector<std::size_t>> group_candidates;
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        std::string key = plan[i].formulation->get_group_key();
+        if (!key.empty()) {
+            group_candidates[key].push_back(i);
+        }
+    }
+    for (auto& candidate : group_candidates) {
+        if (candidate.second.size() < 2) {
+            continue;
+        }
+        std::vector<realization::Catchment_Formulation*> members;
+        members.reserve(candidate.second.size());
+        for (std::size_t i : candidate.second) {
+            members.push_back(plan[i].formulation);
+        }
+        std::shared_ptr<realization::Formulation_Group> group = members.front()->make_group(members);
+        if (group == nullptr) {
+            continue;
+        }
+        // Members all read from the one shared instance, so they stay on the calling thread
+        for (std::size_t i : candidate.second) {
+            plan[i].concurrent = false;
+        }
+        formulation_groups.push_back({std::move(group), std::move(candidate.second)});
+    }
+    for (std::size_t i = 0; i < plan.size(); ++i) {
+        (plan[i].concurrent ? concurrent_units : serial_units).push_back(i);
+    }
+    step_responses.assign(plan.size(), 0.0);
+    step_outputs.resize(plan.size());
+    step_errors.resize(plan.size());
+    plan_compiled = true;
+}
+
+double ngen::Layer::advance_catchment(const CatchmentPlanEntry& entry, const std::string& current_timestamp)
+{
+    double response(0.0);
+    try{
+        response = entry.formulation->get_response(output_time_index, simulation_time.get_output_interval_seconds());
+        // Check mass balance if able
+        entry.formulation->check_mass_balance(output_time_index, simulation_time.get_total_output_times(), current_timestamp);
+    }
+    catch(models::external::State_Exception& e){
+        std::string msg = e.what();
+        msg = msg+" at timestep "+std::to_string(output_time_index)
+            +" ("+current_timestamp+")"
+            +" at feature id "+*entry.id;
+        throw models::external::State_Exception(msg);
+    }
+    catch(std::exception& e){
+        std::string msg = e.what();
+        msg = msg+" at timestep "+std::to_string(output_time_index)
+            +" ("+current_timestamp+")"
+            +" at feature id "+*entry.id;
+        throw std::runtime_error(msg);
+    }
+    return response;
+}
+
+void ngen::Layer::advance_group(const FormulationGroupEntry& group_entry, const std::string& current_timestamp)
+{
+    // Set while a single member is being staged, so a failure can name its feature
+    const std::string* feature_id = nullptr;
+    try{
+        for (std::size_t k = 0; k < group_entry.units.size(); ++k) {
+            feature_id = plan[group_entry.units[k]].id;
+            group_entry.group->update_member(k, output_time_index, simulation_time.get_output_interval_seconds());
+        }
+        feature_id = nullptr;
+        group_entry.group->update();
+    }
+    catch(models::external::State_Exception& e){
+        std::string msg = e.what();
+        msg = msg+" at timestep "+std::to_string(output_time_index)
+            +" ("+current_timestamp+")"
+            +(feature_id != nullptr ? " at feature id "+*feature_id
+                                    : " for the "+std::to_string(group_entry.units.size())+" features sharing a model");
+        throw models::external::State_Exception(msg);
+    }
+    catch(std::exception& e){
+        std::string msg = e.what();
+        msg = msg+" at timestep "+std::to_string(output_time_index)
+            +" ("+current_timestamp+")"
+            +(feature_id != nullptr ? " at feature id "+*feature_id
+                                    : " for the "+std::to_string(group_entry.units.size())+" features sharing a model");
+        throw std::runtime_error(msg);
+    }
+}
+
+void ngen::Layer::contribute_response(const CatchmentPlanEntry& entry, double response,
+                                      boost::span<double> catchment_outflows)
+{
+#if NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
+    // XXX: This is currently accumulating in meters of depth, which may not be desirable
+    catchment_outflows[entry.outflow_index] += response;
+#endif // NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
+    double response_m_s = response * (entry.area_sqkm * 1000000);
+    //TODO put this somewhere else as well, for now, an implicit assumption is that a module's get_response returns
+    //m/timestep
+    //since we are operating on a 1 hour (3600s) dt, we need to scale the output appropriately
+    //so no response is m^2/hr...m^2/hr * 1hr/3600s = m^3/hr
+    double response_m_h = response_m_s / 3600.0;
+    //update the nexus with this flow
+    if (entry.dense_downstream != nullptr) {
+        entry.dense_downstream->add_upstream_flow(response_m_h, entry.upstream_index, output_time_index);
+    }
+    else if (entry.downstream != nullptr) {
+        entry.downstream->add_upstream_flow(response_m_h, *entry.id, output_time_index);
+    }
+}
+
+void ngen::Layer::advance_catchments_concurrently(const std::string& current_timestamp)
+{
+    // Failures are captured per unit and rethrown by the caller in processing-unit order, so the
+    // reported error does not depend on thread scheduling.
+    auto advance_unit = [&](std::size_t i) {
+        const CatchmentPlanEntry& entry = plan[i];
+        step_errors[i] = nullptr;
+        try {
+            step_responses[i] = advance_catchment(entry, current_timestamp);
+            if (catchment_output_mgr) {
+                step_outputs[i] = entry.formulation->get_output_values_for_timestep(output_time_index);
+            }
+        }
+        catch (...) {
+            step_errors[i] = std::current_exception();
+        }
+    };
+
+    worker_pool->parallel_for(concurrent_units.size(), [&](std::size_t k) { advance_unit(concurrent_units[k]); });
+    for (std::size_t i : serial_units) {
+        advance_unit(i);
+    }
+}
+
 void ngen::Layer::update_models(boost::span<double> catchment_outflows,
                                 std::unordered_map<std::string, int> const & catchment_indexes,
                                 boost::span<double> nexus_downstream_flows,
@@ -20,75 +204,43 @@ void ngen::Layer::update_models(boost::span<double> catchment_outflows,
 {
     //std::cout<<"Output Time Index: "<<output_time_index<<std::endl;
     if(output_time_index%1000 == 0) std::cout<<"Running timestep " << output_time_index <<std::endl;
+    if (!plan_compiled) {
+        compile_plan(catchment_indexes);
+    }
     std::string current_timestamp = simulation_time.get_timestamp(output_time_index);
     // Catchment output (if enabled) is pushed to this layer's output manager, which owns the
     // sinks and decides formatting/aggregation. Build the time marker once for all catchments
     // in this timestep (mirrors SurfaceLayer).
     utils::time_marker current_time_marker(
         output_time_index, simulation_time.get_current_epoch_time(), current_timestamp);
-    for(const auto& id : processing_units) {
-        //std::cout<<"Running cat "<<id<<std::endl;
-        auto r = features.catchment_at(id);
-        //TODO redesign to avoid this cast
-        auto r_c = std::dynamic_pointer_cast<realization::Catchment_Formulation>(r);
-        double response(0.0);
-        try{
-            response = r_c->get_response(output_time_index, simulation_time.get_output_interval_seconds());
-            // Check mass balance if able
-            r_c->check_mass_balance(output_time_index, simulation_time.get_total_output_times(), current_timestamp);
-        }
-        catch(models::external::State_Exception& e){
-            std::string msg = e.what();
-            msg = msg+" at timestep "+std::to_string(output_time_index)
-                +" ("+current_timestamp+")"
-                +" at feature id "+id;
-            throw models::external::State_Exception(msg);
-        }
-        catch(std::exception& e){
-            std::string msg = e.what();
-            msg = msg+" at timestep "+std::to_string(output_time_index)
-                +" ("+current_timestamp+")"
-                +" at feature id "+id;
-            throw std::runtime_error(msg);
-        }
-#if NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
-        int results_index = catchment_indexes.at(id);
-        // XXX: This is currently accumulating in meters of depth, which may not be desirable
-        catchment_outflows[results_index] += response;
-#endif // NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
-        if (catchment_output_mgr) {
-            catchment_output_mgr->receive_data_entry(
-                id, current_time_marker, r_c->get_output_values_for_timestep(output_time_index));
-        }
-        //TODO put this somewhere else.  For now, just trying to ensure we get m^3/s into nexus output
-        double area;
-        try {
-            area = catchment_data->get_feature(id)->get_property("areasqkm").as_real_number();
-        }
-        catch(std::invalid_argument &e) {
-            area = catchment_data->get_feature(id)->get_property("area_sqkm").as_real_number();
-        }
-        double response_m_s = response * (area * 1000000);
-        //TODO put this somewhere else as well, for now, an implicit assumption is that a module's get_response returns
-        //m/timestep
-        //since we are operating on a 1 hour (3600s) dt, we need to scale the output appropriately
-        //so no response is m^2/hr...m^2/hr * 1hr/3600s = m^3/hr
-        double response_m_h = response_m_s / 3600.0;
-        //update the nexus with this flow
-        for(auto& nexus : features.destination_nexuses(id)) {
-            //TODO in a DENDRITIC network, only one destination nexus per catchment
-            //If there is more than one, some form of catchment partitioning will be required.
-            //for now, only contribute to the first one in the list
-            if(nexus == nullptr){
-                throw std::runtime_error("Invalid (null) nexus instantiation downstream of '"+id+"'");
+    // Advance shared models first; their members' get_response below then only reads the results
+    for (const auto& group_entry : formulation_groups) {
+        advance_group(group_entry, current_timestamp);
+    }
+    if (worker_pool && worker_pool->size() > 1 && plan.size() > 1) {
+        // Catchments within a layer only interact through their downstream nexuses, so they can all
+        // advance at once; the nexus merge below stays serial and in order to keep results deterministic.
+        advance_catchments_concurrently(current_timestamp);
+        for (std::size_t i = 0; i < plan.size(); ++i) {
+            if (step_errors[i]) {
+                std::rethrow_exception(step_errors[i]);
             }
-            nexus->add_upstream_flow(response_m_h, id, output_time_index);
-            /*std::cerr << "Add water to nexus ID = " << nexus->get_id() << " from catchment ID = " << id << " value = "
-              << response << ", ID = " << id << ", time-index = " << output_time_index << std::endl; */
-            break;
+            if (catchment_output_mgr) {
+                catchment_output_mgr->receive_data_entry(*plan[i].id, current_time_marker, step_outputs[i]);
+            }
+            contribute_response(plan[i], step_responses[i], catchment_outflows);
         }
-                
-    } //done catchments
+    }
+    else {
+        for(const auto& entry : plan) {
+            double response = advance_catchment(entry, current_timestamp);
+            if (catchment_output_mgr) {
+                catchment_output_mgr->receive_data_entry(
+                    *entry.id, current_time_marker, entry.formulation->get_output_values_for_timestep(output_time_index));
+            }
+            contribute_response(entry, response, catchment_outflows);
+        } //done catchments
+    }
 
     ++output_time_index;
     if ( output_time_index < simulation_time.get_total_output_times() ) {
@@ -24,13 +24,12 @@ void ngen::SurfaceLayer::update_models(boost::span<double> catchment_outflows,
 
     // On the first time step, check all the nexuses and warn user about ones have no contributing catchments
     if (current_time_index == 0) {
-        for(const auto& id : features.nexuses()) {
-            #if NGEN_WITH_MPI
-            // When running with MPI, only be concerned with the local nexuses
-            if (!features.is_remote_sender_nexus(id) && features.nexus_at(id)->get_contributing_catchments().size() == 0)
-            #else
-            if (features.nexus_at(id)->get_contributing_catchments().size() == 0)
-            #endif
+        // Under MPI, nexus_ids() only holds the local nexuses
+        const auto& nexus_ids = features.nexus_ids();
+        const auto& nexus_pointers = features.nexus_pointers();
+        for(std::size_t i = 0; i < nexus_ids.size(); ++i) {
+            const auto& id = nexus_ids[i];
+            if (nexus_pointers[i]->get_contributing_catchments().size() == 0)
             {
                 // Likely this means a flow value of 0.0, but that's dependent on the nexus class implementation
                 std::cout << "WARNING: Nexus "<< id << " has no contributing catchments for flow values!" << std::endl;
@@ -38,45 +37,73 @@ void ngen::SurfaceLayer::update_models(boost::span<double> catchment_outflows,
         }
     }
 
+    if (!nexus_plan_compiled) {
+        compile_nexus_plan(nexus_indexes);
+    }
+
+#if NGEN_WITH_MPI
+    // All local contributions for this timestep are in, so trade boundary flows with the neighboring ranks
+    features.exchange_remote_flows(current_time_index);
+#endif
+
     // Once contributing catchments are updated for this timestep, dump the nexus output
-    for(const auto& id : features.nexuses()) 
+    for(const auto& entry : nexus_plan)
+    {
+        //std::cerr << "Requesting water from nexus, id = " << entry.id << " at time = " <<current_time_index << ",  percent = 100, destination = " << entry.requester << std::endl;
+        double contribution_at_t = entry.nexus->get_downstream_flow(entry.requester, current_time_index, 100.0);
+
+#if NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
+        nexus_downstream_flows[entry.flow_index] += contribution_at_t;
+#endif // NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
+
+        // TODO: (later) eventually may want to use this form, if we support multiple formulations per catchment
+        //nexus_outputs_mgr->receive_data_entry(form_id, id, current_time_index, current_timestamp, contribution_at_t);
+        if (nexus_outputs_mgr) {
+            nexus_outputs_mgr->receive_data_entry(entry.id, current_time_marker, contribution_at_t);
+        }
+
+        //std::cout<<"\tNexus "<<entry.id<<" has "<<contribution_at_t<<" m^3/s"<<std::endl;
+    } //done nexuses
+    if (nexus_outputs_mgr) {
+        nexus_outputs_mgr->commit_writes();
+    }
+}
+
+void ngen::SurfaceLayer::compile_nexus_plan(std::unordered_map<std::string, int> const& nexus_indexes)
+{
+    nexus_plan.clear();
+    const auto& nexus_ids = features.nexus_ids();
+    const auto& nexus_pointers = features.nexus_pointers();
+    nexus_plan.reserve(nexus_ids.size());
+    for(std::size_t i = 0; i < nexus_ids.size(); ++i)
     {
+        const auto& id = nexus_ids[i];
+        NexusPlanEntry entry;
+        entry.id = id;
+        entry.nexus = nexus_pointers[i];
+
         // Get the correct "requesting" id for downstream_flow
-        const auto& nexus = features.nexus_at(id);
-        const auto& cat_ids = nexus->get_receiving_catchments();
+        const auto& cat_ids = entry.nexus->get_receiving_catchments();
 
         if (cat_ids.size() > 1) {
             std::string error = "Nexus '" + id + "' violates dendritic hydrofabric network assumption";
             throw std::runtime_error(error);
         }
 
-        std::string cat_id;
         if( cat_ids.size() == 1 ) {
             // With a dendritic network, there can only be a single downstream. It will consume 100%  of the available flow
-            cat_id = cat_ids[0];
+            entry.requester = cat_ids[0];
         }
         else {
             // This is a terminal node, SHOULDN'T be remote, so ID shouldn't matter too much
-            cat_id = "terminal";
+            entry.requester = "terminal";
         }
 
-        //std::cerr << "Requesting water from nexus, id = " << id << " at time = " <<current_time_index << ",  percent = 100, destination = " << cat_id << std::endl;
-        double contribution_at_t = features.nexus_at(id)->get_downstream_flow(cat_id, current_time_index, 100.0);
-
 #if NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
-        int nexus_index = nexus_indexes.at(id);
-        nexus_downstream_flows[nexus_index] += contribution_at_t;
+        entry.flow_index = nexus_indexes.at(id);
 #endif // NGEN_WITH_ROUTING && NGEN_WITH_ROUTING_TROUTE_BMI
 
-        // TODO: (later) eventually may want to use this form, if we support multiple formulations per catchment
-        //nexus_outputs_mgr->receive_data_entry(form_id, id, current_time_index, current_timestamp, contribution_at_t);
-        if (nexus_outputs_mgr) {
-            nexus_outputs_mgr->receive_data_entry(id, current_time_marker, contribution_at_t);
-        }
-
-        //std::cout<<"\tNexus "<<id<<" has "<<contribution_at_t<<" m^3/s"<<std::endl;
-    } //done nexuses
-    if (nexus_outputs_mgr) {
-        nexus_outputs_mgr->commit_writes();
+        nexus_plan.push_back(std::move(entry));
     }
+    nexus_plan_compiled = true;
 }
@@ -0,0 +1,174 @@
+#include "HY_DensePointHydroNexus.hpp"
+#include "HY_PointHydroNexusExceptions.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+
+HY_DensePointHydroNexus::HY_DensePointHydroNexus(std::string nexus_id, Catchments receiving_catchments,
+                                                 std::size_t window)
+  : HY_DensePointHydroNexus(std::move(nexus_id), std::move(receiving_catchments), Catchments(), window)
+{
+
+}
+
+HY_DensePointHydroNexus::HY_DensePointHydroNexus(std::string nexus_id, Catchments receiving_catchments,
+                                                 Catchments contributing_catchments, std::size_t window)
+  : HY_HydroNexus(nexus_id, receiving_catchments, contributing_catchments),
+    n_upstream(get_contributing_catchments().size()),
+    slots(std::max<std::size_t>(window, 1)),
+    upstream_flows(slots.size() * n_upstream, 0.0)
+{
+
+}
+
+HY_DensePointHydroNexus::~HY_DensePointHydroNexus() = default;
+
+std::size_t HY_DensePointHydroNexus::upstream_index(const std::string& catchment_id) const
+{
+    // Nexuses have few contributors, so a linear scan over the ids beats a per-nexus hash map
+    const auto& contributing = get_contributing_catchments();
+    auto it = std::find(contributing.begin(), contributing.end(), catchment_id);
+    return it == contributing.end() ? npos : static_cast<std::size_t>(it - contributing.begin());
+}
+
+HY_DensePointHydroNexus::Slot* HY_DensePointHydroNexus::find_slot(time_step_t t)
+{
+    if ( t < 0 || (newest_timestep >= 0 && t <= newest_timestep - static_cast<time_step_t>(slots.size())) ) {
+        BOOST_THROW_EXCEPTION(invalid_time_step() << errmsg_info("Time step " + std::to_string(t) + " has expired from nexus " + id));
+    }
+    Slot& slot = slots[t % slots.size()];
+    return slot.t == t ? &slot : nullptr;
+}
+
+HY_DensePointHydroNexus::Slot& HY_DensePointHydroNexus::claim_slot(time_step_t t)
+{
+    Slot* found = find_slot(t);
+    if ( found != nullptr ) {
+        return *found;
+    }
+    // Whatever occupied this position is at least one window older than t, so it is now expired
+    std::size_t pos = t % slots.size();
+    Slot& slot = slots[pos];
+    slot = Slot();
+    slot.t = t;
+    std::fill_n(contributions_for(pos), n_upstream, 0.0);
+    newest_timestep = std::max(newest_timestep, t);
+    return slot;
+}
+
+void HY_DensePointHydroNexus::add_to_slot(Slot& slot, double val, std::size_t upstream_index)
+{
+    if ( slot.state == SlotState::completed ) {
+        BOOST_THROW_EXCEPTION(completed_time_step() << errmsg_info("Time step " + std::to_string(slot.t) + " of nexus " + id));
+    }
+    if ( slot.state == SlotState::summed ) {
+        // we can not add water for a time step when one or more catchments have made downstream requests
+        BOOST_THROW_EXCEPTION(add_to_summed_nexus() << errmsg_info("Time step " + std::to_string(slot.t) + " of nexus " + id));
+    }
+    if ( upstream_index == npos ) {
+        slot.unlisted_flow += val;
+    }
+    else {
+        contributions_for(slot.t % slots.size())[upstream_index] += val;
+    }
+    ++slot.contributions;
+    slot.state = SlotState::open;
+}
+
+void HY_DensePointHydroNexus::add_upstream_flow(double val, std::string catchment_id, time_step_t t)
+{
+    add_to_slot(claim_slot(t), val, upstream_index(catchment_id));
+}
+
+void HY_DensePointHydroNexus::add_upstream_flow(double val, std::size_t upstream_index, time_step_t t)
+{
+    if ( upstream_index != npos && upstream_index >= n_upstream ) {
+        throw std::out_of_range("Upstream index " + std::to_string(upstream_index) + " out of range for nexus " + id);
+    }
+    add_to_slot(claim_slot(t), val, upstream_index);
+}
+
+double HY_DensePointHydroNexus::get_downstream_flow(std::string catchment_id, time_step_t t, double percent_flow)
+{
+    Slot* slot = find_slot(t);
+
+    if ( slot != nullptr && slot->state == SlotState::completed ) {
+        BOOST_THROW_EXCEPTION(completed_time_step() << errmsg_info("Time step " + std::to_string(t) + " of nexus " + id));
+    }
+
+    if ( percent_flow > 100.0 ) {
+        // no downstream may ever receive more than 100% of flows
+        BOOST_THROW_EXCEPTION(invalid_downstream_request());
+    }
+
+    if ( n_upstream == 0 ) {
+        // there are no contributing catchments so there is no flow to release
+        return 0.0;
+    }
+
+    if ( slot == nullptr || slot->state == SlotState::empty ) {
+        std::cerr << "No recorded flows for time step " << t << "\n";
+        std::cerr << "catchment id requesting flow: " << catchment_id << "\n";
+        std::cerr << "Nex id: " << id << std::endl;
+        BOOST_THROW_EXCEPTION(request_from_empty_nexus() << errmsg_info("Time step " + std::to_string(t) + " of nexus " + id));
+    }
+
+    if ( slot->state == SlotState::open ) {
+        // the flows have not been summed; sum them in upstream order and record the first request
+        const double* row = contributions_for(t % slots.size());
+        double sum = slot->unlisted_flow;
+        for ( std::size_t i = 0; i < n_upstream; ++i ) {
+            sum += row[i];
+        }
+        slot->summed_flow = sum;
+        slot->total_requests = percent_flow;
+        slot->requests = 1;
+        slot->state = SlotState::summed;
+        return sum * (percent_flow / 100);
+    }
+
+    // flows have been summed so some water has already been released
+    if ( slot->total_requests + percent_flow > 100.0 ) {
+        BOOST_THROW_EXCEPTION(invalid_downstream_request());
+    }
+    slot->total_requests += percent_flow;
+    ++slot->requests;
+
+    double released_flux = slot->summed_flow * (percent_flow / 100.0);
+
+    if ( 100.0 - slot->total_requests < 0.00005 ) {
+        // all water has been requested; the slot keeps only its completed marker until it is reused
+        slot->state = SlotState::completed;
+    }
+
+    return released_flux;
+}
+
+std::pair<double, int> HY_DensePointHydroNexus::inspect_upstream_flows(time_step_t t)
+{
+    Slot& slot = slots[t < 0 ? 0 : t % slots.size()];
+    if ( t < 0 || slot.t != t || (slot.state != SlotState::open && slot.state != SlotState::summed) ) {
+        return std::pair<double, int>(0.0, 0);
+    }
+    const double* row = contributions_for(t % slots.size());
+    double total_upstream_flows = slot.unlisted_flow;
+    for ( std::size_t i = 0; i < n_upstream; ++i ) {
+        total_upstream_flows += row[i];
+    }
+    return std::pair<double, int>(total_upstream_flows, slot.contributions);
+}
+
+std::pair<double, int> HY_DensePointHydroNexus::inspect_downstream_requests(time_step_t t)
+{
+    Slot& slot = slots[t < 0 ? 0 : t % slots.size()];
+    if ( t < 0 || slot.t != t || slot.state != SlotState::summed ) {
+        return std::pair<double, int>(0.0, 0);
+    }
+    return std::pair<double, int>(slot.total_requests, slot.requests);
+}
+
+std::string HY_DensePointHydroNexus::get_flow_units()
+{
+    return std::string("m3/s");
+}
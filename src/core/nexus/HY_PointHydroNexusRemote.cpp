@@ -160,7 +160,7 @@ double HY_PointHydroNexusRemote::get_downstream_flow(std::string catchment_id, t
         std::string msg = "Nexus "+id+" attempted to get_downstream_flow, but its communicator type is sender only.";
         throw std::runtime_error(msg);
     }
-    else if ( type == receiver || type == sender_receiver )
+    else if ( !batched && (type == receiver || type == sender_receiver) )
     {
         post_receives();
         // Wait for receives to complete
@@ -169,13 +169,9 @@ double HY_PointHydroNexusRemote::get_downstream_flow(std::string catchment_id, t
         // As long as the functions are called appropriately, e.g. one call to
         // `add_upstream_flow` per upstream catchment per time step, followed
         // by a call to `get_downstream_flow` for each downstream catchment per time step,
-        // this loop will terminate and ensures the synchronization of flows between
+        // this wait will complete and ensures the synchronization of flows between
         // ranks.
-        while ( stored_receives.size() > 0 )
-    	{
-    		process_communications();
-    		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-    	}
+        wait_for_receives();
     }
     
     return HY_PointHydroNexus::get_downstream_flow(catchment_id, t, percent_flow);
@@ -183,6 +179,13 @@ double HY_PointHydroNexusRemote::get_downstream_flow(std::string catchment_id, t
 
 void HY_PointHydroNexusRemote::add_upstream_flow(double val, std::string catchment_id, time_step_t t)
 {
+    if ( batched )
+    {
+        // the owning exchange moves the flows between ranks once all local contributions are in
+        HY_PointHydroNexus::add_upstream_flow(val, catchment_id, t);
+        return;
+    }
+
 	// Process any completed communications to free resources
     // If no communications are pending, this call will do nothing.
 	process_communications();
@@ -190,12 +193,12 @@ void HY_PointHydroNexusRemote::add_upstream_flow(double val, std::string catchme
     // truely asynchronous.  For pure receivers and sender_receivers, this isn't a problem
     // because the get_downstream_flow function will block until all receives are processed.
     // However, for pure senders, this could be a problem.
-    // We can use this spinlock here to limit how far ahead a partition can get.
+    // We block on the oldest send here to limit how far ahead a partition can get.
     // in this case, approximately 100 time steps per downstream catchment...
     while( stored_sends.size() > downstream_ranks.size()*100 )
     {
-        process_communications();
-        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        MPI_Handle_Error( MPI_Wait(&stored_sends.front().mpi_request, MPI_STATUS_IGNORE) );
+        stored_sends.pop_front();
     }
 	
 	// Post receives before sending to prevent deadlock
@@ -266,6 +269,24 @@ void HY_PointHydroNexusRemote::add_upstream_flow(double val, std::string catchme
 	}
 }
 
+void HY_PointHydroNexusRemote::wait_for_receives()
+{
+    MPI_Status status;
+
+    while ( !stored_receives.empty() )
+    {
+        auto& receive = stored_receives.front();
+        MPI_Handle_Error( MPI_Wait(&receive.mpi_request, &status) );
+
+        long time_step = receive.buffer->time_step;
+        double flow = receive.buffer->flow;
+        stored_receives.pop_front();
+
+        // add the received flow
+        HY_PointHydroNexus::add_upstream_flow(flow, id, time_step);
+    }
+}
+
 void HY_PointHydroNexusRemote::process_communications()
 {
     int flag;                                      // boolean value for if a request has completed
@@ -0,0 +1,293 @@
+#include "HY_RemoteNexusExchange.hpp"
+
+#if NGEN_WITH_MPI
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <string>
+
+HY_RemoteNexusExchange::HY_RemoteNexusExchange(const std::vector<HY_PointHydroNexusRemote*>& nexuses, MPI_Comm comm)
+{
+    // Use a private communicator so the batched messages can never match per-nexus messages
+    MPI_Handle_Error( MPI_Comm_dup(comm, &exchange_comm) );
+
+    // Group the boundary nexuses by neighbor rank; ordered maps keep the neighbor order deterministic
+    std::map<int, std::vector<HY_PointHydroNexusRemote*>> outgoing;
+    std::map<int, std::vector<HY_PointHydroNexusRemote*>> incoming;
+
+    for ( auto* nexus : nexuses )
+    {
+        if ( nexus == nullptr || nexus->type == HY_PointHydroNexusRemote::local )
+        {
+            continue;
+        }
+
+        if ( nexus->type == HY_PointHydroNexusRemote::sender || nexus->type == HY_PointHydroNexusRemote::sender_receiver )
+        {
+            // in a dendritic network all remote receivers of a nexus are on a single rank
+            outgoing[*nexus->downstream_ranks.begin()].push_back(nexus);
+        }
+        if ( nexus->type == HY_PointHydroNexusRemote::receiver || nexus->type == HY_PointHydroNexusRemote::sender_receiver )
+        {
+            // each upstream rank sends its flow for this nexus; a sender_receiver relays it on with its own
+            for ( int rank : nexus->upstream_ranks )
+            {
+                incoming[rank].push_back(nexus);
+            }
+        }
+
+        nexus->batched = true;
+    }
+
+    // both sides of a neighbor pair hold the same set of nexuses, so sorting by id aligns the buffers
+    auto by_id = [](HY_PointHydroNexusRemote* a, HY_PointHydroNexusRemote* b) { return a->get_id() < b->get_id(); };
+    for ( auto& group : outgoing )
+    {
+        std::sort(group.second.begin(), group.second.end(), by_id);
+    }
+    for ( auto& group : incoming )
+    {
+        std::sort(group.second.begin(), group.second.end(), by_id);
+    }
+    upstream_neighbors = incoming.size();
+    downstream_neighbors = outgoing.size();
+
+    // Only the sending side knows which of its nexuses relay, so tell each downstream neighbor which shared
+    // nexuses will arrive in its relay message
+    std::vector<std::vector<int>> send_relayed;
+    std::vector<std::vector<int>> receive_relayed;
+    std::vector<MPI_Request> layout_requests;
+    send_relayed.reserve(outgoing.size());
+    receive_relayed.reserve(incoming.size());
+    layout_requests.reserve(outgoing.size() + incoming.size());
+
+    for ( auto& group : incoming )
+    {
+        receive_relayed.emplace_back(group.second.size());
+        layout_requests.emplace_back();
+        MPI_Handle_Error( MPI_Irecv(receive_relayed.back().data(), static_cast<int>(receive_relayed.back().size()), MPI_INT,
+                                    group.first, layout_tag, exchange_comm, &layout_requests.back()) );
+    }
+    for ( auto& group : outgoing )
+    {
+        send_relayed.emplace_back();
+        for ( auto* nexus : group.second )
+        {
+            send_relayed.back().push_back(nexus->type == HY_PointHydroNexusRemote::sender_receiver ? 1 : 0);
+        }
+        layout_requests.emplace_back();
+        MPI_Handle_Error( MPI_Isend(send_relayed.back().data(), static_cast<int>(send_relayed.back().size()), MPI_INT,
+                                    group.first, layout_tag, exchange_comm, &layout_requests.back()) );
+    }
+    std::vector<MPI_Status> layout_statuses(layout_requests.size());
+    MPI_Handle_Error( MPI_Waitall(static_cast<int>(layout_requests.size()), layout_requests.data(), layout_statuses.data()) );
+
+    auto add_message = [](std::vector<Message>& messages, int rank, int tag, std::vector<HY_PointHydroNexusRemote*> members)
+    {
+        if ( members.empty() )
+        {
+            return;
+        }
+        Message message;
+        message.rank = rank;
+        message.tag = tag;
+        message.buffer.resize(members.size() + 1, 0.0);
+        message.nexuses = std::move(members);
+        messages.push_back(std::move(message));
+    };
+
+    std::size_t g = 0;
+    for ( auto& group : incoming )
+    {
+        int count;
+        MPI_Get_count(&layout_statuses[g], MPI_INT, &count);
+        if ( count != static_cast<int>(group.second.size()) )
+        {
+            throw std::runtime_error("Rank " + std::to_string(group.first) + " sends " + std::to_string(count)
+                                     + " boundary flows but " + std::to_string(group.second.size())
+                                     + " were expected; partitions disagree on shared nexuses");
+        }
+        std::vector<HY_PointHydroNexusRemote*> immediate, relayed;
+        for ( std::size_t i = 0; i < group.second.size(); ++i )
+        {
+            (receive_relayed[g][i] ? relayed : immediate).push_back(group.second[i]);
+        }
+        add_message(receives, group.first, immediate_tag, std::move(immediate));
+        add_message(receives, group.first, relay_tag, std::move(relayed));
+        ++g;
+    }
+
+    for ( auto& group : outgoing )
+    {
+        std::vector<HY_PointHydroNexusRemote*> immediate, relayed;
+        for ( auto* nexus : group.second )
+        {
+            (nexus->type == HY_PointHydroNexusRemote::sender_receiver ? relayed : immediate).push_back(nexus);
+        }
+        add_message(sends, group.first, immediate_tag, std::move(immediate));
+        add_message(sends, group.first, relay_tag, std::move(relayed));
+    }
+
+    // A relay message can only be packed once the messages carrying the flows of its own nexuses have arrived
+    for ( auto& message : sends )
+    {
+        for ( auto* nexus : message.nexuses )
+        {
+            if ( nexus->type != HY_PointHydroNexusRemote::sender_receiver )
+            {
+                continue;
+            }
+            for ( std::size_t r = 0; r < receives.size(); ++r )
+            {
+                const auto& members = receives[r].nexuses;
+                if ( std::find(members.begin(), members.end(), nexus) != members.end() )
+                {
+                    message.relay_sources.push_back(r);
+                }
+            }
+        }
+        std::sort(message.relay_sources.begin(), message.relay_sources.end());
+        message.relay_sources.erase(std::unique(message.relay_sources.begin(), message.relay_sources.end()),
+                                    message.relay_sources.end());
+    }
+    credited.resize(receives.size());
+    started.resize(sends.size());
+
+    requests.resize(receives.size() + sends.size(), MPI_REQUEST_NULL);
+    statuses.resize(requests.size());
+
+    for ( std::size_t i = 0; i < receives.size(); ++i )
+    {
+        auto& message = receives[i];
+        MPI_Handle_Error( MPI_Recv_init(message.buffer.data(), static_cast<int>(message.buffer.size()), MPI_DOUBLE,
+                                        message.rank, message.tag, exchange_comm, &requests[i]) );
+    }
+
+    for ( std::size_t i = 0; i < sends.size(); ++i )
+    {
+        auto& message = sends[i];
+        MPI_Handle_Error( MPI_Send_init(message.buffer.data(), static_cast<int>(message.buffer.size()), MPI_DOUBLE,
+                                        message.rank, message.tag, exchange_comm, &requests[receives.size() + i]) );
+    }
+}
+
+HY_RemoteNexusExchange::~HY_RemoteNexusExchange()
+{
+    // This destructor might be called after MPI_Finalize, at which point the requests and communicator are gone
+    int mpi_finalized;
+    MPI_Finalized(&mpi_finalized);
+    if ( mpi_finalized )
+    {
+        return;
+    }
+
+    // exchange() always completes its requests, so they are inactive here and can be freed directly
+    for ( auto& request : requests )
+    {
+        if ( request != MPI_REQUEST_NULL )
+        {
+            MPI_Request_free(&request);
+        }
+    }
+
+    if ( exchange_comm != MPI_COMM_NULL )
+    {
+        MPI_Comm_free(&exchange_comm);
+    }
+}
+
+void HY_RemoteNexusExchange::exchange(time_step_t t)
+{
+    if ( requests.empty() )
+    {
+        return;
+    }
+
+    // Every receive is started before any send, so no send can wait on a receive that is not yet posted
+    if ( !receives.empty() )
+    {
+        MPI_Handle_Error( MPI_Startall(static_cast<int>(receives.size()), requests.data()) );
+    }
+    std::fill(credited.begin(), credited.end(), false);
+    std::fill(started.begin(), started.end(), false);
+
+    std::size_t pending_sends = sends.size();
+    while ( true )
+    {
+        // Send each message as soon as the flows relayed through its nexuses have been credited
+        for ( std::size_t i = 0; i < sends.size(); ++i )
+        {
+            if ( started[i] || !std::all_of(sends[i].relay_sources.begin(), sends[i].relay_sources.end(),
+                                            [this](std::size_t r) { return credited[r]; }) )
+            {
+                continue;
+            }
+            pack(sends[i], t);
+            MPI_Handle_Error( MPI_Start(&requests[receives.size() + i]) );
+            started[i] = true;
+            --pending_sends;
+        }
+        if ( pending_sends == 0 )
+        {
+            break;
+        }
+
+        int index;
+        MPI_Status status;
+        MPI_Handle_Error( MPI_Waitany(static_cast<int>(receives.size()), requests.data(), &index, &status) );
+        if ( index == MPI_UNDEFINED )
+        {
+            throw std::runtime_error("Boundary flows relayed to rank neighbors never arrived; partitions disagree on shared nexuses");
+        }
+        credit(receives[index], status, t);
+        credited[index] = true;
+    }
+
+    MPI_Handle_Error( MPI_Waitall(static_cast<int>(requests.size()), requests.data(), statuses.data()) );
+
+    for ( std::size_t r = 0; r < receives.size(); ++r )
+    {
+        if ( !credited[r] )
+        {
+            credit(receives[r], statuses[r], t);
+        }
+    }
+}
+
+void HY_RemoteNexusExchange::pack(Message& message, time_step_t t)
+{
+    // Release the full flow of each sending nexus for this time step into the message's buffer
+    message.buffer[0] = static_cast<double>(t);
+    for ( std::size_t i = 0; i < message.nexuses.size(); ++i )
+    {
+        auto* nexus = message.nexuses[i];
+        message.buffer[i + 1] = nexus->HY_PointHydroNexus::get_downstream_flow(nexus->get_id(), t, 100.0);
+    }
+}
+
+void HY_RemoteNexusExchange::credit(Message& message, MPI_Status& status, time_step_t t)
+{
+    int count;
+    MPI_Get_count(&status, MPI_DOUBLE, &count);
+    if ( count != static_cast<int>(message.buffer.size()) )
+    {
+        throw std::runtime_error("Received " + std::to_string(count - 1) + " boundary flows from rank "
+                                 + std::to_string(message.rank) + " but expected "
+                                 + std::to_string(message.nexuses.size()) + "; partitions disagree on shared nexuses");
+    }
+    if ( static_cast<time_step_t>(message.buffer[0]) != t )
+    {
+        throw std::runtime_error("Received boundary flows for time step " + std::to_string(static_cast<time_step_t>(message.buffer[0]))
+                                 + " from rank " + std::to_string(message.rank) + " while exchanging time step " + std::to_string(t));
+    }
+
+    for ( std::size_t i = 0; i < message.nexuses.size(); ++i )
+    {
+        auto* nexus = message.nexuses[i];
+        // remote flows are recorded under the nexus id, as for per-nexus messages
+        nexus->HY_PointHydroNexus::add_upstream_flow(message.buffer[i + 1], nexus->get_id(), t);
+    }
+}
+
+#endif // NGEN_WITH_MPI
@@ -0,0 +1,291 @@
+#include "BinaryForcingDataProvider.hpp"
+#include "AorcForcing.hpp"
+
+#include <algorithm>
+#include <set>
+#include <stdexcept>
+
+std::mutex data_access::BinaryForcingDataProvider::shared_providers_mutex;
+std::map<std::string, std::shared_ptr<data_access::BinaryForcingDataProvider>> data_access::BinaryForcingDataProvider::shared_providers;
+
+namespace {
+    //! The canonical names of the well-known fields, each once, with their units
+    std::vector<std::pair<std::string, std::string>> canonical_fields() {
+        std::vector<std::pair<std::string, std::string>> fields;
+        for (const auto& field : data_access::WellKnownFields) {
+            const std::string& name = std::get<0>(field.second);
+            auto same = [&](const auto& f) { return f.first == name; };
+            if (std::find_if(fields.begin(), fields.end(), same) == fields.end()) {
+                fields.emplace_back(name, std::get<1>(field.second));
+            }
+        }
+        return fields;
+    }
+}
+
+namespace data_access {
+
+std::shared_ptr<BinaryForcingDataProvider> BinaryForcingDataProvider::get_shared_provider(const std::string& input_path, time_t sim_start, time_t sim_end)
+{
+    const std::lock_guard<std::mutex> lock(shared_providers_mutex);
+    auto found = shared_providers.find(input_path);
+    if (found != shared_providers.end()) {
+        return found->second;
+    }
+    auto p = std::make_shared<BinaryForcingDataProvider>(input_path, sim_start, sim_end);
+    shared_providers[input_path] = p;
+    return p;
+}
+
+void BinaryForcingDataProvider::cleanup_shared_providers()
+{
+    const std::lock_guard<std::mutex> lock(shared_providers_mutex);
+    shared_providers.clear();
+}
+
+BinaryForcingDataProvider::BinaryForcingDataProvider(const std::string& input_path, time_t sim_start, time_t sim_end)
+    : sim_start_date_time_epoch(sim_start)
+    , sim_end_date_time_epoch(sim_end)
+    , file(BinaryForcingFile::open(input_path))
+    , file_path(input_path)
+{
+    const auto& layout = file.layout();
+    variable_names = layout.variables;
+    for (std::size_t v = 0; v < layout.variables.size(); ++v) {
+        variable_index.emplace(layout.variables[v], v);
+    }
+    // let a well-known field be requested by its canonical name or any of its aliases, whichever the file has
+    for (std::size_t v = 0; v < layout.variables.size(); ++v) {
+        for (const auto& field : WellKnownFields) {
+            const std::string& canonical = std::get<0>(field.second);
+            if (canonical == layout.variables[v] && variable_index.emplace(field.first, v).second) {
+                variable_names.push_back(field.first);
+            }
+            else if (field.first == layout.variables[v] && variable_index.emplace(canonical, v).second) {
+                variable_names.push_back(canonical);
+            }
+        }
+    }
+
+    for (std::size_t i = 0; i < layout.ids.size(); ++i) {
+        id_pos.emplace(layout.ids[i], i);
+    }
+}
+
+boost::span<const std::string> BinaryForcingDataProvider::get_available_variable_names() const
+{
+    return variable_names;
+}
+
+const std::vector<std::string>& BinaryForcingDataProvider::get_ids() const
+{
+    return file.layout().ids;
+}
+
+long BinaryForcingDataProvider::get_data_start_time() const
+{
+    //FIXME: Matching behavior from CsvPerFeatureForcingProvider and NetCDFPerFeatureDataProvider, which formulations
+    // use to find the model's time offset
+    return sim_start_date_time_epoch;
+}
+
+long BinaryForcingDataProvider::get_data_stop_time() const
+{
+    return sim_end_date_time_epoch;
+}
+
+long BinaryForcingDataProvider::record_duration() const
+{
+    return file.layout().time_step;
+}
+
+size_t BinaryForcingDataProvider::get_ts_index_for_time(const time_t &epoch_time) const
+{
+    const auto& layout = file.layout();
+    time_t stop_time = layout.start_time + layout.time_step * static_cast<time_t>(layout.time_steps);
+    if (epoch_time < layout.start_time || epoch_time >= stop_time) {
+        throw std::out_of_range("The time " + std::to_string(epoch_time) + " was not in the range ["
+                                + std::to_string(layout.start_time) + "," + std::to_string(stop_time) + ") of " + file_path);
+    }
+    return (epoch_time - layout.start_time) / layout.time_step;
+}
+
+double BinaryForcingDataProvider::get_value(const CatchmentAggrDataSelector& selector, ReSampleMethod m)
+{
+    auto pos = id_pos.find(selector.get_id());
+    if (pos == id_pos.end()) {
+        throw std::out_of_range("Feature " + selector.get_id() + " is not in forcing file " + file_path);
+    }
+    double value;
+    evaluate(selector, {&pos->second, 1}, {&value, 1}, m);
+    return value;
+}
+
+std::vector<double> BinaryForcingDataProvider::get_values(const CatchmentAggrDataSelector& selector, ReSampleMethod m)
+{
+    return std::vector<double>(1, get_value(selector, m));
+}
+
+void BinaryForcingDataProvider::get_values_for_ids(const CatchmentAggrDataSelector& selector, boost::span<const std::string> ids,
+                                                   boost::span<double> values, ReSampleMethod m)
+{
+    if (values.size() != ids.size()) {
+        throw std::invalid_argument("Got " + std::to_string(values.size()) + " value slots for "
+                                    + std::to_string(ids.size()) + " feature ids");
+    }
+
+    std::vector<std::size_t> rows(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto pos = id_pos.find(ids[i]);
+        if (pos == id_pos.end()) {
+            throw std::out_of_range("Feature " + ids[i] + " is not in forcing file " + file_path);
+        }
+        rows[i] = pos->second;
+    }
+    evaluate(selector, rows, values, m);
+}
+
+// private:
+
+std::size_t BinaryForcingDataProvider::get_variable_index(const std::string& name) const
+{
+    auto found = variable_index.find(name);
+    if (found == variable_index.end()) {
+        throw std::runtime_error("Cannot get forcing value for unrecognized parameter name '" + name + "' from " + file_path);
+    }
+    return found->second;
+}
+
+void BinaryForcingDataProvider::evaluate(const CatchmentAggrDataSelector& selector, boost::span<const std::size_t> rows,
+                                         boost::span<double> values, ReSampleMethod m) const
+{
+    const auto& layout = file.layout();
+    std::size_t var_idx = get_variable_index(selector.get_variable_name());
+
+    time_t init_time = selector.get_init_time();
+    std::size_t first = get_ts_index_for_time(init_time);
+    time_t stop_time = layout.start_time + layout.time_step * static_cast<time_t>(layout.time_steps);
+    time_t end_time = std::min<time_t>(init_time + selector.get_duration_secs(), stop_time);
+
+    // each time step counts for the part of it that is in the window
+    std::vector<double> weights;
+    double total = 0;
+    for (time_t ts_start = layout.start_time + layout.time_step * static_cast<time_t>(first); ts_start < end_time;
+         ts_start += layout.time_step) {
+        double overlap = std::min(end_time, ts_start + layout.time_step) - std::max(init_time, ts_start);
+        weights.push_back(overlap);
+        total += overlap;
+    }
+    double scale = m == SUM ? 1.0 / layout.time_step : 1.0 / total;
+    if (weights.empty()) {
+        // an empty window, which takes the value of the time step it starts in
+        weights.push_back(1.0);
+        scale = 1.0;
+    }
+    for (double& weight : weights) {
+        weight *= scale;
+    }
+
+    for (std::size_t i = 0; i < rows.size(); ++i) {
+        const double* series = file.series(var_idx, rows[i]) + first;
+        double sum = 0;
+        for (std::size_t t = 0; t < weights.size(); ++t) {
+            sum += weights[t] * series[t];
+        }
+        values[i] = sum;
+    }
+
+    UnitsHelper::unit_converter converter;
+    try {
+        converter = UnitsHelper::get_unit_converter(layout.units[var_idx], selector.get_output_units());
+    }
+    catch (UnitsHelper::unit_conversion_exception& uce) {
+        uce.provider_model_name = "BinaryForcingDataProvider(" + file_path + ")";
+        uce.provider_var_name = selector.get_variable_name();
+        uce.unconverted_values.assign(values.begin(), values.end());
+        throw;
+    }
+    converter.convert(values.data(), values.data(), values.size());
+}
+
+void write_binary_forcing(const std::string& path, const std::vector<binary_forcing_source>& sources,
+                          time_t start_time, time_t end_time)
+{
+    if (sources.empty()) {
+        throw std::runtime_error("Can not write binary forcing file " + path + " without any forcing sources");
+    }
+    if (end_time < start_time) {
+        throw std::runtime_error("Can not write binary forcing file " + path + " for a period that ends before it starts");
+    }
+
+    BinaryForcingFile::Layout layout;
+    layout.start_time = start_time;
+    layout.time_step = sources.front().provider->record_duration();
+    std::set<std::string> seen_ids;
+    for (const auto& source : sources) {
+        if (source.provider->record_duration() != layout.time_step) {
+            throw std::runtime_error("Can not write binary forcing file " + path + " from sources with time steps of "
+                                     + std::to_string(layout.time_step) + " and "
+                                     + std::to_string(source.provider->record_duration()) + " seconds");
+        }
+        for (const auto& id : source.ids) {
+            if (!seen_ids.insert(id).second) {
+                throw std::runtime_error("Feature " + id + " is in more than one source for binary forcing file " + path);
+            }
+            layout.ids.push_back(id);
+        }
+    }
+    if (layout.time_step <= 0) {
+        throw std::runtime_error("Can not write binary forcing file " + path + " with a time step of "
+                                 + std::to_string(layout.time_step) + " seconds");
+    }
+    layout.time_steps = (end_time - start_time) / layout.time_step + 1;
+
+    // the name each source has for each variable that every source has
+    std::vector<std::vector<std::string>> source_names;
+    for (const auto& field : canonical_fields()) {
+        std::vector<std::string> names;
+        for (const auto& source : sources) {
+            for (const auto& name : source.provider->get_available_variable_names()) {
+                auto wkf = WellKnownFields.find(name);
+                if (name == field.first || (wkf != WellKnownFields.end() && std::get<0>(wkf->second) == field.first)) {
+                    names.push_back(name);
+                    break;
+                }
+            }
+        }
+        if (names.size() == sources.size()) {
+            layout.variables.push_back(field.first);
+            layout.units.push_back(field.second);
+            source_names.push_back(std::move(names));
+        }
+    }
+    if (layout.variables.empty()) {
+        throw std::runtime_error("The sources for binary forcing file " + path + " have no well-known forcing fields in common");
+    }
+
+    BinaryForcingFile file = BinaryForcingFile::create(path, layout);
+    std::vector<double> buffer;
+    for (std::size_t v = 0; v < layout.variables.size(); ++v) {
+        std::size_t feature_offset = 0;
+        for (std::size_t s = 0; s < sources.size(); ++s) {
+            const auto& ids = sources[s].ids;
+            if (ids.empty()) {
+                continue;
+            }
+            buffer.resize(ids.size());
+            CatchmentAggrDataSelector selector(ids.front(), source_names[v][s], start_time, layout.time_step, layout.units[v]);
+            for (std::size_t t = 0; t < layout.time_steps; ++t) {
+                selector.set_init_time(start_time + layout.time_step * static_cast<time_t>(t));
+                sources[s].provider->get_values_for_ids(selector, ids, buffer, MEAN);
+                for (std::size_t i = 0; i < ids.size(); ++i) {
+                    file.mutable_series(v, feature_offset + i)[t] = buffer[i];
+                }
+            }
+            feature_offset += ids.size();
+        }
+    }
+    file.sync();
+}
+
+}
@@ -0,0 +1,263 @@
+#include "BinaryForcingFile.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+    const std::size_t VALUES_ALIGNMENT = 4096;
+
+    // magic, byte order mark, reserved, three counts, start time, time step, values offset
+    const std::size_t FIXED_HEADER_SIZE = 8 + 4 + 4 + 3 * 8 + 2 * 8 + 8;
+
+    std::string system_error(const std::string& what, const std::string& path) {
+        return what + " " + path + ": " + std::strerror(errno);
+    }
+
+    template <typename T>
+    void put(std::string& out, T value) {
+        out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void put_string(std::string& out, const std::string& s) {
+        if (s.size() > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::runtime_error("BinaryForcingFile: string of " + std::to_string(s.size()) + " bytes is too long");
+        }
+        put<std::uint32_t>(out, s.size());
+        out.append(s);
+    }
+
+    //! Reads the header fields from a mapped file, checking every read against the end of the mapping
+    class header_reader {
+        public:
+        header_reader(const char* data, std::size_t size, const std::string& path) : data(data), size(size), path(path) {}
+
+        template <typename T>
+        T get() {
+            T value;
+            std::memcpy(&value, take(sizeof(T)), sizeof(T));
+            return value;
+        }
+
+        std::string get_string() {
+            auto length = get<std::uint32_t>();
+            return std::string(take(length), length);
+        }
+
+        std::size_t position() const { return pos; }
+
+        std::size_t remaining() const { return size - pos; }
+
+        const char* take(std::size_t n) {
+            if (n > size - pos) {
+                throw std::runtime_error("BinaryForcingFile: " + path + " is truncated");
+            }
+            const char* at = data + pos;
+            pos += n;
+            return at;
+        }
+
+        private:
+        const char* data;
+        std::size_t size;
+        std::size_t pos = 0;
+        const std::string& path;
+    };
+}
+
+namespace data_access {
+
+BinaryForcingFile BinaryForcingFile::open(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error(system_error("BinaryForcingFile: could not open", path));
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        std::string message = system_error("BinaryForcingFile: could not stat", path);
+        ::close(fd);
+        throw std::runtime_error(message);
+    }
+    if (static_cast<std::size_t>(st.st_size) < FIXED_HEADER_SIZE) {
+        ::close(fd);
+        throw std::runtime_error("BinaryForcingFile: " + path + " is too small to be a binary forcing file");
+    }
+
+    BinaryForcingFile file;
+    file.mapping_size = st.st_size;
+    file.mapping = mmap(nullptr, file.mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (file.mapping == MAP_FAILED) {
+        file.mapping = nullptr;
+        std::string message = system_error("BinaryForcingFile: could not map", path);
+        ::close(fd);
+        throw std::runtime_error(message);
+    }
+    ::close(fd);
+
+    header_reader in(static_cast<const char*>(file.mapping), file.mapping_size, path);
+    if (std::memcmp(in.take(sizeof(MAGIC)), MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("BinaryForcingFile: " + path + " is not a binary forcing file");
+    }
+    if (in.get<std::uint32_t>() != BYTE_ORDER_MARK) {
+        throw std::runtime_error("BinaryForcingFile: " + path + " was written on a machine with a different byte order");
+    }
+    in.get<std::uint32_t>();
+
+    auto n_vars = in.get<std::uint64_t>();
+    auto n_ids = in.get<std::uint64_t>();
+    auto n_times = in.get<std::uint64_t>();
+    file.header.start_time = in.get<std::int64_t>();
+    file.header.time_step = in.get<std::int64_t>();
+    if (file.header.time_step <= 0) {
+        throw std::runtime_error("BinaryForcingFile: " + path + " has a time step that is not positive");
+    }
+    auto values_offset = in.get<std::uint64_t>();
+
+    for (std::uint64_t v = 0; v < n_vars; ++v) {
+        file.header.variables.push_back(in.get_string());
+        file.header.units.push_back(in.get_string());
+    }
+    // every id takes at least its length prefix, so a corrupt count can't ask for more ids than the file holds
+    if (n_ids > in.remaining() / sizeof(std::uint32_t)) {
+        throw std::runtime_error("BinaryForcingFile: the size of " + path + " does not match the shape in its header");
+    }
+    file.header.ids.reserve(n_ids);
+    for (std::uint64_t i = 0; i < n_ids; ++i) {
+        file.header.ids.push_back(in.get_string());
+    }
+    file.header.time_steps = n_times;
+
+    // compared by division, so a corrupt header can't overflow the product of the counts
+    std::uint64_t values_size = values_offset <= file.mapping_size ? file.mapping_size - values_offset : 1;
+    std::uint64_t n_values = values_size / sizeof(double);
+    if (values_offset % VALUES_ALIGNMENT != 0 || values_offset < in.position() || values_size % sizeof(double) != 0
+        || n_vars == 0 || n_ids == 0 || n_times == 0
+        || n_values % n_times != 0 || (n_values / n_times) % n_vars != 0 || n_values / n_times / n_vars != n_ids) {
+        throw std::runtime_error("BinaryForcingFile: the size of " + path + " does not match the shape in its header");
+    }
+    file.values = reinterpret_cast<double*>(static_cast<char*>(file.mapping) + values_offset);
+    return file;
+}
+
+BinaryForcingFile BinaryForcingFile::create(const std::string& path, const Layout& layout)
+{
+    if (layout.variables.empty() || layout.ids.empty() || layout.time_steps == 0) {
+        throw std::runtime_error("BinaryForcingFile: can not create " + path + " without variables, features and time steps");
+    }
+    if (layout.units.size() != layout.variables.size()) {
+        throw std::runtime_error("BinaryForcingFile: got " + std::to_string(layout.units.size()) + " units for "
+                                 + std::to_string(layout.variables.size()) + " variables");
+    }
+    if (layout.time_step <= 0) {
+        throw std::runtime_error("BinaryForcingFile: the time step must be positive");
+    }
+
+    std::string strings;
+    for (std::size_t v = 0; v < layout.variables.size(); ++v) {
+        put_string(strings, layout.variables[v]);
+        put_string(strings, layout.units[v]);
+    }
+    for (const auto& id : layout.ids) {
+        put_string(strings, id);
+    }
+    std::size_t values_offset = FIXED_HEADER_SIZE + strings.size();
+    values_offset = (values_offset + VALUES_ALIGNMENT - 1) / VALUES_ALIGNMENT * VALUES_ALIGNMENT;
+
+    std::string head;
+    head.append(MAGIC, sizeof(MAGIC));
+    put<std::uint32_t>(head, BYTE_ORDER_MARK);
+    put<std::uint32_t>(head, 0);
+    put<std::uint64_t>(head, layout.variables.size());
+    put<std::uint64_t>(head, layout.ids.size());
+    put<std::uint64_t>(head, layout.time_steps);
+    put<std::int64_t>(head, layout.start_time);
+    put<std::int64_t>(head, layout.time_step);
+    put<std::uint64_t>(head, values_offset);
+    head.append(strings);
+
+    BinaryForcingFile file;
+    file.header = layout;
+    file.writable = true;
+    file.mapping_size = values_offset + layout.variables.size() * layout.ids.size() * layout.time_steps * sizeof(double);
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        throw std::runtime_error(system_error("BinaryForcingFile: could not create", path));
+    }
+    if (ftruncate(fd, file.mapping_size) != 0) {
+        std::string message = system_error("BinaryForcingFile: could not size", path);
+        ::close(fd);
+        throw std::runtime_error(message);
+    }
+    file.mapping = mmap(nullptr, file.mapping_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (file.mapping == MAP_FAILED) {
+        file.mapping = nullptr;
+        std::string message = system_error("BinaryForcingFile: could not map", path);
+        ::close(fd);
+        throw std::runtime_error(message);
+    }
+    ::close(fd);
+
+    // the file was just extended with zeros, so only the header needs writing
+    std::memcpy(file.mapping, head.data(), head.size());
+    file.values = reinterpret_cast<double*>(static_cast<char*>(file.mapping) + values_offset);
+    return file;
+}
+
+BinaryForcingFile::BinaryForcingFile(BinaryForcingFile&& other) noexcept
+{
+    *this = std::move(other);
+}
+
+BinaryForcingFile& BinaryForcingFile::operator=(BinaryForcingFile&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        header = std::move(other.header);
+        mapping = std::exchange(other.mapping, nullptr);
+        mapping_size = std::exchange(other.mapping_size, 0);
+        values = std::exchange(other.values, nullptr);
+        writable = std::exchange(other.writable, false);
+    }
+    return *this;
+}
+
+BinaryForcingFile::~BinaryForcingFile()
+{
+    unmap();
+}
+
+double* BinaryForcingFile::mutable_series(std::size_t var_idx, std::size_t feature_idx)
+{
+    if (!writable) {
+        throw std::logic_error("BinaryForcingFile: values of a file opened for reading can not be written");
+    }
+    return values + (var_idx * header.ids.size() + feature_idx) * header.time_steps;
+}
+
+void BinaryForcingFile::sync()
+{
+    if (writable && mapping != nullptr && msync(mapping, mapping_size, MS_SYNC) != 0) {
+        throw std::runtime_error(std::string("BinaryForcingFile: could not write values: ") + std::strerror(errno));
+    }
+}
+
+void BinaryForcingFile::unmap() noexcept
+{
+    if (mapping != nullptr) {
+        munmap(mapping, mapping_size);
+        mapping = nullptr;
+    }
+}
+
+}
@@ -0,0 +1,276 @@
+#include "ForcingFileIndex.hpp"
+
+#include <cerrno>
+#include <dirent.h>
+#include <regex>
+#include <set>
+#include <stdexcept>
+#include <string_view>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    const std::string ID_PLACEHOLDER = "{{id}}";
+
+    //! Whether the text has a character with a meaning in a regular expression
+    bool has_regex_syntax(const std::string& text) {
+        return text.find_first_of("\\^$.|?*+()[]{}") != std::string::npos;
+    }
+
+    /**
+     * Whether every name that matches the pattern must contain the id that replaced the placeholder: the
+     * placeholder is not inside a group or bracket expression, is not followed by a quantifier and the pattern
+     * has no alternatives.
+     */
+    bool requires_literal_id(const std::string& pattern, std::size_t id_position) {
+        const std::size_t after = id_position + ID_PLACEHOLDER.size();
+        if (id_position > 0 && pattern[id_position - 1] == '\\') {
+            return false;
+        }
+        int groups = 0;
+        bool in_bracket = false;
+        for (std::size_t i = 0; i < pattern.size(); ++i) {
+            if (i == id_position) {
+                if (in_bracket || groups != 0) {
+                    return false;
+                }
+                i = after - 1;
+                continue;
+            }
+            const char c = pattern[i];
+            if (c == '\\') {
+                ++i;
+            }
+            else if (in_bracket) {
+                in_bracket = c != ']';
+            }
+            else if (c == '[') {
+                in_bracket = true;
+            }
+            else if (c == '|') {
+                return false;
+            }
+            else if (c == '(') {
+                ++groups;
+            }
+            else if (c == ')') {
+                --groups;
+            }
+        }
+        return after >= pattern.size() || std::string("?*+{").find(pattern[after]) == std::string::npos;
+    }
+}
+
+namespace data_access {
+
+std::vector<ForcingFileIndex::entry> ForcingFileIndex::list_directory(const std::string& directory)
+{
+    // A stream providing the functions necessary for evaluating a directory:
+    //    https://www.gnu.org/software/libc/manual/html_node/Opening-a-Directory.html#Opening-a-Directory
+    DIR *dir = opendir(directory.c_str());
+    // Allow for a few retries in certain failure situations
+    size_t attemptCount = 0;
+    std::string errMsg;
+    while (dir == nullptr && attemptCount++ < 5) {
+        // For several error codes, we should break immediately and not retry
+        if (errno == ENOENT) {
+            errMsg = "No such file or directory.";
+            break;
+        }
+        if (errno == ENXIO) {
+            errMsg = "No such device or address.";
+            break;
+        }
+        if (errno == EACCES) {
+            errMsg = "Permission denied.";
+            break;
+        }
+        if (errno == EPERM) {
+            errMsg = "Operation not permitted.";
+            break;
+        }
+        if (errno == ENOTDIR) {
+            errMsg = "File at provided path is not a directory.";
+            break;
+        }
+        if (errno == EMFILE) {
+            errMsg = "The current process has too many open files.";
+            break;
+        }
+        if (errno == ENFILE) {
+            errMsg = "The system has too many open files.";
+            break;
+        }
+        sleep(2);
+        dir = opendir(directory.c_str());
+        errMsg = "Received system error number " + std::to_string(errno);
+    }
+    if (dir == nullptr) {
+        // The directory wasn't found or otherwise couldn't be opened; forcing data cannot be retrieved
+        throw std::runtime_error("Error opening forcing data dir '" + directory + "' after " + std::to_string(attemptCount) + " attempts: " + errMsg);
+    }
+
+    std::vector<entry> entries;
+    // structure representing the member of a directory: https://www.gnu.org/software/libc/manual/html_node/Directory-Entries.html
+    struct dirent *e;
+    while ((e = readdir(dir))) {
+        #ifdef _DIRENT_HAVE_D_TYPE
+        if (e->d_type == DT_REG || e->d_type == DT_LNK) {
+            entries.push_back({e->d_name, true});
+        }
+        else if (e->d_type == DT_UNKNOWN)
+        #endif
+        {
+            //dirent is not guaranteed to provide proper file type identification in d_type, so the type of a
+            //matching entry is found when it is looked up
+            entries.push_back({e->d_name, false});
+        }
+    }
+    closedir(dir);
+    return entries;
+}
+
+#if NGEN_WITH_MPI
+std::vector<ForcingFileIndex::entry> ForcingFileIndex::list_directory(const std::string& directory, MPI_Comm comm, int root)
+{
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+
+    // the names, each after a byte for its type and ending with a NUL, or the error message listing them
+    int failed = 0;
+    std::string packed;
+    if (rank == root) {
+        try {
+            for (const auto& e : list_directory(directory)) {
+                packed += e.known_file ? 'f' : '?';
+                packed += e.name;
+                packed += '\0';
+            }
+        }
+        catch (const std::runtime_error& e) {
+            failed = 1;
+            packed = e.what();
+        }
+    }
+
+    unsigned long long size = packed.size();
+    MPI_Bcast(&failed, 1, MPI_INT, root, comm);
+    MPI_Bcast(&size, 1, MPI_UNSIGNED_LONG_LONG, root, comm);
+    packed.resize(size);
+    MPI_Bcast(&packed[0], static_cast<int>(size), MPI_CHAR, root, comm);
+    if (failed) {
+        throw std::runtime_error(packed);
+    }
+
+    std::vector<entry> entries;
+    for (std::size_t pos = 0; pos < packed.size(); ) {
+        std::size_t end = packed.find('\0', pos);
+        entries.push_back({packed.substr(pos + 1, end - pos - 1), packed[pos] == 'f'});
+        pos = end + 1;
+    }
+    return entries;
+}
+#endif
+
+ForcingFileIndex::ForcingFileIndex(std::string directory, std::string file_pattern, std::vector<entry> entries,
+                                   const std::vector<std::string>& ids)
+    : directory(std::move(directory))
+    , file_pattern(std::move(file_pattern))
+    , entries(std::move(entries))
+    , id_position(this->file_pattern.find(ID_PLACEHOLDER))
+    , fixed_match(std::string::npos)
+{
+    if (id_position == std::string::npos) {
+        // Every catchment has the same file
+        std::regex pattern(this->file_pattern);
+        for (std::size_t i = 0; i < this->entries.size(); ++i) {
+            if (std::regex_match(this->entries[i].name, pattern)) {
+                fixed_match = i;
+                break;
+            }
+        }
+        return;
+    }
+
+    literal_id = requires_literal_id(this->file_pattern, id_position);
+    if (!literal_id) {
+        return;
+    }
+
+    // Find the ids in each name, looking up the substrings of each name with the lengths of the ids
+    std::unordered_map<std::string_view, std::vector<std::size_t>*> by_name;
+    std::set<std::size_t> lengths;
+    for (const auto& id : ids) {
+        if (id.empty() || has_regex_syntax(id)) {
+            continue;
+        }
+        auto& files = id_entries[id];
+        by_name.emplace(id_entries.find(id)->first, &files);
+        lengths.insert(id.size());
+    }
+    for (std::size_t i = 0; i < this->entries.size(); ++i) {
+        const std::string_view name = this->entries[i].name;
+        for (std::size_t pos = 0; pos < name.size(); ++pos) {
+            for (std::size_t length : lengths) {
+                if (pos + length > name.size()) {
+                    break;
+                }
+                auto found = by_name.find(name.substr(pos, length));
+                if (found != by_name.end() && (found->second->empty() || found->second->back() != i)) {
+                    found->second->push_back(i);
+                }
+            }
+        }
+    }
+}
+
+std::string ForcingFileIndex::find(const std::string& id) const
+{
+    if (id_position == std::string::npos) {
+        return fixed_match == std::string::npos ? "" : resolve(entries[fixed_match]);
+    }
+
+    std::regex pattern(pattern_for(id));
+    auto indexed = literal_id ? id_entries.find(id) : id_entries.end();
+    if (indexed != id_entries.end()) {
+        for (std::size_t i : indexed->second) {
+            if (std::regex_match(entries[i].name, pattern)) {
+                return resolve(entries[i]);
+            }
+        }
+        return "";
+    }
+
+    for (const auto& e : entries) {
+        if (std::regex_match(e.name, pattern)) {
+            return resolve(e);
+        }
+    }
+    return "";
+}
+
+std::string ForcingFileIndex::pattern_for(const std::string& id) const
+{
+    std::string pattern = file_pattern;
+    return pattern.replace(id_position, ID_PLACEHOLDER.size(), id);
+}
+
+std::string ForcingFileIndex::resolve(const entry& file) const
+{
+    const std::string path = directory + file.name;
+    if (file.known_file) {
+        return path;
+    }
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0) {
+        throw std::runtime_error("Could not stat file " + path);
+    }
+    if (S_ISREG(st.st_mode)) {
+        //Since we used stat and not lstat, we get the result of the target of links as well
+        //so this covers both cases we are interested in.
+        return path;
+    }
+    throw std::runtime_error("Forcing data is path " + path + " is not a file");
+}
+
+}
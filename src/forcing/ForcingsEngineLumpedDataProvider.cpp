@@ -1,9 +1,86 @@
 #include "DataProvider.hpp"
+#include <algorithm>
 #include <chrono>
 #include <forcing/ForcingsEngineLumpedDataProvider.hpp>
 
 namespace data_access {
 
+namespace detail {
+
+ForcingsEngineLumpedSnapshot::ForcingsEngineLumpedSnapshot(
+    std::shared_ptr<bmi_type> bmi,
+    const std::vector<std::string>& variables
+)
+  : bmi_(std::move(bmi))
+{
+    for (const auto& name : variables) {
+        if (static_cast<std::size_t>(bmi_->GetVarItemsize(name)) != sizeof(double)) {
+            continue;
+        }
+
+        variable_indices_.emplace(name, variables_.size());
+        variables_.push_back(name);
+        values_.emplace_back(static_cast<std::size_t>(bmi_->GetVarNbytes(name)) / sizeof(double));
+    }
+}
+
+std::shared_ptr<ForcingsEngineLumpedSnapshot> ForcingsEngineLumpedSnapshot::shared(
+    const std::string& init,
+    const std::shared_ptr<bmi_type>& bmi,
+    const std::vector<std::string>& variables
+)
+{
+    // Held weakly, so a snapshot does not keep its engine alive past the providers using it
+    static std::unordered_map<std::string, std::weak_ptr<ForcingsEngineLumpedSnapshot>> snapshots;
+
+    auto& entry = snapshots[init];
+    auto snapshot = entry.lock();
+    if (snapshot == nullptr || snapshot->model() != bmi) {
+        snapshot = std::make_shared<ForcingsEngineLumpedSnapshot>(bmi, variables);
+        entry = snapshot;
+    }
+
+    return snapshot;
+}
+
+std::size_t ForcingsEngineLumpedSnapshot::variable_index(const std::string& name) const
+{
+    auto pos = variable_indices_.find(name);
+    if (pos == variable_indices_.end()) {
+        throw std::runtime_error{
+            "ForcingsEngineLumpedDataProvider: variable `" + name + "` is not an output of type double."
+        };
+    }
+
+    return pos->second;
+}
+
+double ForcingsEngineLumpedSnapshot::value(std::size_t variable, std::size_t divide_idx, double time)
+{
+    if (!filled_ || time != time_) {
+        filled_ = false;
+        bmi_->UpdateUntil(time);
+        for (std::size_t i = 0; i < variables_.size(); ++i) {
+            const auto* source = static_cast<const double*>(bmi_->GetValuePtr(variables_[i]));
+            std::copy(source, source + values_[i].size(), values_[i].begin());
+        }
+        time_ = time;
+        filled_ = true;
+    }
+
+    const auto& values = values_[variable];
+    if (divide_idx >= values.size()) {
+        throw std::out_of_range{
+            "ForcingsEngineLumpedDataProvider: no value of `" + variables_[variable]
+            + "` for divide index " + std::to_string(divide_idx)
+        };
+    }
+
+    return values[divide_idx];
+}
+
+} // namespace detail
+
 using Provider     = ForcingsEngineLumpedDataProvider;
 using BaseProvider = Provider::base_type;
 
@@ -57,6 +134,8 @@ Provider::ForcingsEngineLumpedDataProvider(
     } else {
         divide_idx_ = std::distance(cat_id_span.begin(), divide_id_pos);
     }
+
+    snapshot_ = detail::ForcingsEngineLumpedSnapshot::shared(init, bmi_, var_output_names_);
 }
 
 std::size_t Provider::divide() const noexcept
@@ -69,6 +148,15 @@ std::size_t Provider::divide_index() const noexcept
     return divide_idx_;
 }
 
+double Provider::value_at(std::size_t variable, clock_type::time_point current)
+{
+    return snapshot_->value(
+        variable,
+        divide_idx_,
+        std::chrono::duration_cast<std::chrono::seconds>(current - time_begin_).count()
+    );
+}
+
 Provider::data_type Provider::get_value(
     const Provider::selection_type& selector,
     data_access::ReSampleMethod m
@@ -76,7 +164,7 @@ Provider::data_type Provider::get_value(
 {
     assert(divide_id_ == convert_divide_id_stoi(selector.get_id()));
 
-    auto variable = ensure_variable(selector.get_variable_name());
+    const auto variable = snapshot_->variable_index(ensure_variable(selector.get_variable_name()));
 
     if (m == ReSampleMethod::SUM || m == ReSampleMethod::MEAN) {
         double acc = 0.0;
@@ -89,8 +177,7 @@ Provider::data_type Provider::get_value(
         auto current = start;
         while (current < end) {
             current += time_step_;
-            bmi_->UpdateUntil(std::chrono::duration_cast<std::chrono::seconds>(current - time_begin_).count());
-            acc += static_cast<double*>(bmi_->GetValuePtr(variable))[divide_idx_];
+            acc += value_at(variable, current);
         }
 
         if (m == ReSampleMethod::MEAN) {
@@ -112,7 +199,7 @@ std::vector<Provider::data_type> Provider::get_values(
 {
     assert(divide_id_ == convert_divide_id_stoi(selector.get_id()));
 
-    auto variable = ensure_variable(selector.get_variable_name());
+    const auto variable = snapshot_->variable_index(ensure_variable(selector.get_variable_name()));
 
     const auto start = clock_type::from_time_t(selector.get_init_time());
     assert(start >= time_begin_);
@@ -124,8 +211,7 @@ std::vector<Provider::data_type> Provider::get_values(
     auto current = start;
     while (current < end) {
         current += time_step_;
-        bmi_->UpdateUntil(std::chrono::duration_cast<std::chrono::seconds>(current - time_begin_).count());
-        values.push_back(static_cast<double*>(bmi_->GetValuePtr(variable))[divide_idx_]);
+        values.push_back(value_at(variable, current));
     }
 
     return values;
@@ -0,0 +1,145 @@
+#include "GridAreaWeightedDataProvider.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+namespace data_access {
+
+GridAreaWeightedDataProvider::GridAreaWeightedDataProvider(std::shared_ptr<grid_provider_type> source,
+                                                           std::shared_ptr<const GridCellWeights> weights)
+  : source(std::move(source))
+  , weights(std::move(weights))
+  , cells_selector(SelectorConfig{}, this->weights->cells())
+  , field(this->weights->cells().size())
+{
+    const auto& ids = this->weights->ids();
+    id_pos.reserve(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        id_pos.emplace(ids[i], i);
+    }
+}
+
+boost::span<const std::string> GridAreaWeightedDataProvider::get_available_variable_names() const
+{
+    return source->get_available_variable_names();
+}
+
+long GridAreaWeightedDataProvider::get_data_start_time() const
+{
+    return source->get_data_start_time();
+}
+
+long GridAreaWeightedDataProvider::get_data_stop_time() const
+{
+    return source->get_data_stop_time();
+}
+
+long GridAreaWeightedDataProvider::record_duration() const
+{
+    return source->record_duration();
+}
+
+size_t GridAreaWeightedDataProvider::get_ts_index_for_time(const time_t &epoch_time) const
+{
+    return source->get_ts_index_for_time(epoch_time);
+}
+
+bool GridAreaWeightedDataProvider::is_property_sum_over_time_step(const std::string& name) const
+{
+    return source->is_property_sum_over_time_step(name);
+}
+
+void GridAreaWeightedDataProvider::finalize()
+{
+    source->finalize();
+}
+
+std::size_t GridAreaWeightedDataProvider::get_id_index(const std::string& id) const
+{
+    auto pos = id_pos.find(id);
+    if (pos == id_pos.end()) {
+        throw std::out_of_range("GridAreaWeightedDataProvider: no cell weights for catchment " + id);
+    }
+    return pos->second;
+}
+
+const std::vector<double>& GridAreaWeightedDataProvider::averages_for(const CatchmentAggrDataSelector& selector,
+                                                                      ReSampleMethod m)
+{
+    // Each catchment queries its variables in turn, so keep the averages of every variable for its last window
+    auto& cached = averages.try_emplace(selector.get_variable_name()).first->second;
+    if (cached.valid && cached.method == m
+        && cached.init_time == selector.get_init_time()
+        && cached.duration == selector.get_duration_secs()
+        && cached.units == selector.get_output_units()) {
+        return cached.values;
+    }
+
+    cached.valid = false;
+    cells_selector.initial_time() = selector.get_init_time();
+    cells_selector.duration() = selector.get_duration_secs();
+    cells_selector.variable() = selector.get_variable_name();
+    cells_selector.units() = selector.get_output_units();
+
+    const auto cells = source->get_values(cells_selector, m);
+    if (cells.size() != field.size()) {
+        throw std::runtime_error("GridAreaWeightedDataProvider: gridded provider returned "
+                                 + std::to_string(cells.size()) + " cells for " + std::to_string(field.size()));
+    }
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        field[i] = cells[i].value;
+    }
+
+    cached.values.resize(weights->ids().size());
+    weights->apply(field, cached.values);
+    cached.init_time = selector.get_init_time();
+    cached.duration = selector.get_duration_secs();
+    cached.units = selector.get_output_units();
+    cached.method = m;
+    cached.valid = true;
+    return cached.values;
+}
+
+double GridAreaWeightedDataProvider::get_value(const CatchmentAggrDataSelector& selector, ReSampleMethod m)
+{
+    const auto idx = get_id_index(selector.get_id());
+    return averages_for(selector, m)[idx];
+}
+
+std::vector<double> GridAreaWeightedDataProvider::get_values(const CatchmentAggrDataSelector& selector,
+                                                             ReSampleMethod m)
+{
+    const auto idx = get_id_index(selector.get_id());
+    const auto step = record_duration();
+    const auto end = selector.get_init_time() + selector.get_duration_secs();
+
+    std::vector<double> values;
+    CatchmentAggrDataSelector step_selector = selector;
+    for (auto t = selector.get_init_time(); t < end; t += step) {
+        step_selector.set_init_time(t);
+        step_selector.set_duration_secs(std::min<long>(step, end - t));
+        values.push_back(averages_for(step_selector, m)[idx]);
+    }
+    return values;
+}
+
+void GridAreaWeightedDataProvider::get_values_for_ids(const CatchmentAggrDataSelector& selector,
+                                                      boost::span<const std::string> ids,
+                                                      boost::span<double> values, ReSampleMethod m)
+{
+    if (values.size() != ids.size()) {
+        throw std::invalid_argument("Got " + std::to_string(values.size()) + " value slots for "
+                                    + std::to_string(ids.size()) + " feature ids");
+    }
+    if (ids.empty()) {
+        return;
+    }
+
+    const auto& all = averages_for(selector, m);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        values[i] = all[get_id_index(ids[i])];
+    }
+}
+
+}
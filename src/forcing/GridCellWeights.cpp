@@ -0,0 +1,358 @@
+#include "GridCellWeights.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include <unistd.h>
+
+#include <boost/geometry/geometries/point_xy.hpp>
+
+namespace {
+    const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    // Cells are rectangles in the coordinate plane of the grid, so overlaps are found in that plane
+    using plane_point_t = boost::geometry::model::d2::point_xy<double>;
+    using plane_polygon_t = boost::geometry::model::polygon<plane_point_t>;
+    using plane_multipolygon_t = boost::geometry::model::multi_polygon<plane_polygon_t>;
+    using plane_box_t = boost::geometry::model::box<plane_point_t>;
+
+    plane_multipolygon_t to_plane(const geojson::multipolygon_t& shape) {
+        const auto copy_ring = [](const auto& from, auto& to) {
+            for (const auto& point : from) {
+                to.emplace_back(point.template get<0>(), point.template get<1>());
+            }
+        };
+
+        plane_multipolygon_t result;
+        result.resize(shape.size());
+        for (std::size_t i = 0; i < shape.size(); ++i) {
+            copy_ring(shape[i].outer(), result[i].outer());
+            result[i].inners().resize(shape[i].inners().size());
+            for (std::size_t j = 0; j < shape[i].inners().size(); ++j) {
+                copy_ring(shape[i].inners()[j], result[i].inners()[j]);
+            }
+        }
+        boost::geometry::correct(result);
+        return result;
+    }
+
+    //! FNV-1a, which is enough to tell one domain's weights from another's
+    class hasher {
+        public:
+        void add(const void* data, std::size_t size) {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i) {
+                hash = (hash ^ bytes[i]) * 1099511628211ULL;
+            }
+        }
+
+        template <typename T>
+        void add(T value) {
+            add(&value, sizeof(T));
+        }
+
+        std::uint64_t value() const { return hash; }
+
+        private:
+        std::uint64_t hash = 14695981039346656037ULL;
+    };
+
+    template <typename T>
+    void put(std::ostream& out, T value) {
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    void put_all(std::ostream& out, const std::vector<T>& values) {
+        out.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+
+    template <typename T>
+    T get(std::istream& in, const std::string& path) {
+        T value;
+        if (!in.read(reinterpret_cast<char*>(&value), sizeof(T))) {
+            throw std::runtime_error("GridCellWeights: " + path + " is truncated");
+        }
+        return value;
+    }
+
+    template <typename T>
+    void get_all(std::istream& in, std::vector<T>& values, std::size_t count, const std::string& path) {
+        values.resize(count);
+        if (!in.read(reinterpret_cast<char*>(values.data()), count * sizeof(T))) {
+            throw std::runtime_error("GridCellWeights: " + path + " is truncated");
+        }
+    }
+}
+
+namespace data_access {
+
+GridCellWeights GridCellWeights::build(const GridSpecification& grid, std::vector<std::string> ids,
+                                       boost::span<const geojson::multipolygon_t> shapes)
+{
+    if (shapes.size() != ids.size()) {
+        throw std::invalid_argument("GridCellWeights: got " + std::to_string(shapes.size()) + " shapes for "
+                                    + std::to_string(ids.size()) + " catchment ids");
+    }
+    if (grid.rows == 0 || grid.columns == 0) {
+        throw std::invalid_argument("GridCellWeights: grid has no cells");
+    }
+
+    GridCellWeights result;
+    result.weights_key = key(grid, ids, shapes);
+    result.feature_ids = std::move(ids);
+    result.row_offsets.reserve(shapes.size() + 1);
+    result.row_offsets.push_back(0);
+
+    const double xmin = grid.extent.xmin();
+    const double ymin = grid.extent.ymin();
+    const double xstep = (grid.extent.xmax() - xmin) / static_cast<double>(grid.columns);
+    const double ystep = (grid.extent.ymax() - ymin) / static_cast<double>(grid.rows);
+
+    // Grid cell index (column + row * columns) to its index in the compacted columns
+    std::unordered_map<std::uint64_t, std::uint64_t> column_of_cell;
+
+    for (const auto& original : shapes) {
+        const auto shape = to_plane(original);
+        const auto bbox = boost::geometry::return_envelope<plane_box_t>(shape);
+        const auto row_start = result.weights.size();
+        double total = 0;
+
+        if (!boost::geometry::is_empty(shape)
+            && bbox.max_corner().x() >= xmin && bbox.min_corner().x() <= grid.extent.xmax()
+            && bbox.max_corner().y() >= ymin && bbox.min_corner().y() <= grid.extent.ymax()) {
+            const auto col_min = clamped_cell_index(bbox.min_corner().x(), xmin, xstep, grid.columns);
+            const auto col_max = clamped_cell_index(bbox.max_corner().x(), xmin, xstep, grid.columns);
+            const auto row_min = clamped_cell_index(bbox.min_corner().y(), ymin, ystep, grid.rows);
+            const auto row_max = clamped_cell_index(bbox.max_corner().y(), ymin, ystep, grid.rows);
+
+            for (auto row = row_min; row <= row_max; ++row) {
+                // Cells of a longitude/latitude grid shrink toward the poles by the cosine of their latitude;
+                // the plane of a projected grid already measures area
+                const double scale = grid.geographic ? std::cos((ymin + (row + 0.5) * ystep) * M_PI / 180.0) : 1.0;
+
+                for (auto col = col_min; col <= col_max; ++col) {
+                    const plane_box_t cell{
+                        /*min_corner=*/{ xmin + col * xstep, ymin + row * ystep },
+                        /*max_corner=*/{ xmin + (col + 1) * xstep, ymin + (row + 1) * ystep }
+                    };
+                    if (boost::geometry::disjoint(cell, shape)) {
+                        continue;
+                    }
+
+                    plane_polygon_t cell_polygon;
+                    boost::geometry::convert(cell, cell_polygon);
+                    plane_multipolygon_t overlap;
+                    boost::geometry::intersection(cell_polygon, shape, overlap);
+                    const double area = boost::geometry::area(overlap) * scale;
+                    if (!(area > 0)) {
+                        continue;
+                    }
+
+                    const auto [pos, added] = column_of_cell.emplace(col + row * grid.columns, result.columns.size());
+                    if (added) {
+                        result.columns.push_back(Cell{/*x=*/col, /*y=*/row, /*z=*/0UL, /*value=*/NAN});
+                    }
+                    result.cell_indices.push_back(pos->second);
+                    result.weights.push_back(area);
+                    total += area;
+                }
+            }
+        }
+
+        for (auto i = row_start; i < result.weights.size(); ++i) {
+            result.weights[i] /= total;
+        }
+        result.row_offsets.push_back(result.weights.size());
+    }
+
+    return result;
+}
+
+GridCellWeights GridCellWeights::load_or_build(const std::string& path, const GridSpecification& grid,
+                                               std::vector<std::string> ids,
+                                               boost::span<const geojson::multipolygon_t> shapes)
+{
+    if (auto cached = load(path, key(grid, ids, shapes))) {
+        if (cached->feature_ids == ids) {
+            return std::move(*cached);
+        }
+    }
+
+    auto result = build(grid, std::move(ids), shapes);
+    try {
+        result.save(path);
+    }
+    catch (const std::runtime_error&) {
+        // Only costs building the weights again on the next run
+    }
+    return result;
+}
+
+std::optional<GridCellWeights> GridCellWeights::load(const std::string& path, std::uint64_t key)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        return std::nullopt;
+    }
+
+    char magic[sizeof(MAGIC)];
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0) {
+        return std::nullopt;
+    }
+    if (get<std::uint32_t>(in, path) != BYTE_ORDER_MARK) {
+        return std::nullopt;
+    }
+    get<std::uint32_t>(in, path);
+    if (get<std::uint64_t>(in, path) != key) {
+        return std::nullopt;
+    }
+
+    GridCellWeights result;
+    result.weights_key = key;
+    const auto num_ids = get<std::uint64_t>(in, path);
+    const auto num_cells = get<std::uint64_t>(in, path);
+    const auto num_weights = get<std::uint64_t>(in, path);
+
+    result.feature_ids.reserve(num_ids);
+    for (std::uint64_t i = 0; i < num_ids; ++i) {
+        std::string id(get<std::uint32_t>(in, path), '\0');
+        if (!in.read(id.data(), id.size())) {
+            throw std::runtime_error("GridCellWeights: " + path + " is truncated");
+        }
+        result.feature_ids.push_back(std::move(id));
+    }
+
+    result.columns.reserve(num_cells);
+    for (std::uint64_t i = 0; i < num_cells; ++i) {
+        const auto col = get<std::uint64_t>(in, path);
+        const auto row = get<std::uint64_t>(in, path);
+        result.columns.push_back(Cell{/*x=*/col, /*y=*/row, /*z=*/0UL, /*value=*/NAN});
+    }
+
+    get_all(in, result.row_offsets, num_ids + 1, path);
+    get_all(in, result.cell_indices, num_weights, path);
+    get_all(in, result.weights, num_weights, path);
+
+    if (result.row_offsets.front() != 0 || result.row_offsets.back() != num_weights
+        || !std::is_sorted(result.row_offsets.begin(), result.row_offsets.end())) {
+        throw std::runtime_error("GridCellWeights: " + path + " has inconsistent row offsets");
+    }
+    for (auto cell : result.cell_indices) {
+        if (cell >= num_cells) {
+            throw std::runtime_error("GridCellWeights: " + path + " refers to a cell it does not hold");
+        }
+    }
+
+    return result;
+}
+
+std::uint64_t GridCellWeights::key(const GridSpecification& grid, boost::span<const std::string> ids,
+                                   boost::span<const geojson::multipolygon_t> shapes)
+{
+    hasher h;
+    h.add(grid.rows);
+    h.add(grid.columns);
+    h.add(grid.extent.xmin());
+    h.add(grid.extent.xmax());
+    h.add(grid.extent.ymin());
+    h.add(grid.extent.ymax());
+    h.add(grid.geographic);
+
+    h.add(ids.size());
+    for (const auto& id : ids) {
+        h.add(id.size());
+        h.add(id.data(), id.size());
+    }
+
+    for (const auto& shape : shapes) {
+        h.add(boost::geometry::num_points(shape));
+        boost::geometry::for_each_point(shape, [&h](const geojson::coordinate_t& point) {
+            h.add(point.get<0>());
+            h.add(point.get<1>());
+        });
+    }
+
+    return h.value();
+}
+
+void GridCellWeights::save(const std::string& path) const
+{
+    // Written aside and renamed into place, so ranks sharing a cache never read a partial file
+    const std::string partial = path + "." + std::to_string(::getpid()) + ".part";
+    {
+        std::ofstream out(partial, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            throw std::runtime_error("GridCellWeights: can not create " + partial);
+        }
+
+        out.write(MAGIC, sizeof(MAGIC));
+        put<std::uint32_t>(out, BYTE_ORDER_MARK);
+        put<std::uint32_t>(out, 0);
+        put<std::uint64_t>(out, weights_key);
+        put<std::uint64_t>(out, feature_ids.size());
+        put<std::uint64_t>(out, columns.size());
+        put<std::uint64_t>(out, weights.size());
+
+        for (const auto& id : feature_ids) {
+            if (id.size() > std::numeric_limits<std::uint32_t>::max()) {
+                throw std::runtime_error("GridCellWeights: id of " + std::to_string(id.size()) + " bytes is too long");
+            }
+            put<std::uint32_t>(out, id.size());
+            out.write(id.data(), id.size());
+        }
+        for (const auto& cell : columns) {
+            put<std::uint64_t>(out, cell.x);
+            put<std::uint64_t>(out, cell.y);
+        }
+        put_all(out, row_offsets);
+        put_all(out, cell_indices);
+        put_all(out, weights);
+
+        if (!out.flush()) {
+            std::remove(partial.c_str());
+            throw std::runtime_error("GridCellWeights: can not write " + partial);
+        }
+    }
+
+    if (std::rename(partial.c_str(), path.c_str()) != 0) {
+        std::remove(partial.c_str());
+        throw std::runtime_error("GridCellWeights: can not replace " + path);
+    }
+}
+
+void GridCellWeights::apply(boost::span<const double> field, boost::span<double> averages) const
+{
+    if (field.size() != columns.size()) {
+        throw std::invalid_argument("GridCellWeights: got a field of " + std::to_string(field.size())
+                                    + " values for " + std::to_string(columns.size()) + " cells");
+    }
+    if (averages.size() != feature_ids.size()) {
+        throw std::invalid_argument("GridCellWeights: got " + std::to_string(averages.size())
+                                    + " average slots for " + std::to_string(feature_ids.size()) + " catchments");
+    }
+
+    for (std::size_t row = 0; row < feature_ids.size(); ++row) {
+        const auto begin = row_offsets[row];
+        const auto end = row_offsets[row + 1];
+        if (begin == end) {
+            averages[row] = NAN;
+            continue;
+        }
+
+        double sum = 0;
+        for (auto i = begin; i < end; ++i) {
+            sum += weights[i] * field[cell_indices[i]];
+        }
+        averages[row] = sum;
+    }
+}
+
+}
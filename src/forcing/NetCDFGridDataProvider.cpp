@@ -0,0 +1,319 @@
+#include <NGenConfig.h>
+
+#if NGEN_WITH_NETCDF
+#include "NetCDFGridDataProvider.hpp"
+#include "NetCDFPerFeatureDataProvider.hpp"
+#include "AorcForcing.hpp"
+#include <mediator/UnitsHelper.hpp>
+
+#include <netcdf>
+
+#include <algorithm>
+#include <cmath>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace data_access {
+
+NetCDFGridDataProvider::NetCDFGridDataProvider(std::string input_path, utils::StreamHandler log_s)
+    : log_stream(log_s)
+    , file_path(std::move(input_path))
+{
+    // a per-feature provider's read-ahead thread may be using the library
+    const std::lock_guard<std::mutex> io_lock(NetCDFPerFeatureDataProvider::netcdf_io_mutex);
+
+    try{
+        nc_file = std::make_shared<netCDF::NcFile>(file_path, netCDF::NcFile::read);
+    }
+    catch(const netCDF::exceptions::NcException& e){
+        std::cerr<<"Error opening NetCDF file: "<<file_path<<std::endl;
+        std::cerr<<e.what()<<std::endl;
+        throw;
+    }
+
+    std::uint64_t columns = 0, rows = 0;
+    bool x_degrees = false, y_degrees = false;
+    const auto x_edges = read_axis("x", "lon", columns, x_reversed, x_degrees);
+    const auto y_edges = read_axis("y", "lat", rows, y_reversed, y_degrees);
+    grid = GridSpecification{rows, columns, BoundingBox{box_t{{x_edges.first, y_edges.first}, {x_edges.second, y_edges.second}}},
+                             /*geographic=*/x_degrees && y_degrees};
+
+    // the forcing variables are those over (time, y, x)
+    for (const auto& element : nc_file->getVars()) {
+        const auto& ncvar = element.second;
+        if (ncvar.getDimCount() != 3 || ncvar.getDim(0).getName() != "time"
+            || ncvar.getDim(1).getSize() != rows || ncvar.getDim(2).getSize() != columns) {
+            continue;
+        }
+
+        std::string native_units;
+        try {
+            auto units_att = ncvar.getAtt("units");
+            if (!units_att.isNull()) {
+                units_att.getValues(native_units);
+            }
+        }
+        catch (...) {
+            native_units = "";
+        }
+
+        const std::string& var_name = element.first;
+        auto wkf = WellKnownFields.find(var_name);
+        if (wkf != WellKnownFields.end()) {
+            native_units = native_units.empty() ? std::get<1>(wkf->second) : native_units;
+            const std::string& can_name = std::get<0>(wkf->second); // the CSDMS name
+            variable_names.push_back(can_name);
+            ncvar_names[can_name] = var_name;
+            units_cache[can_name] = native_units;
+        }
+        variable_names.push_back(var_name);
+        ncvar_names[var_name] = var_name;
+        units_cache[var_name] = native_units;
+    }
+
+    // the start of each time step
+    auto time_var = nc_file->getVar("time");
+    if (time_var.isNull() || time_var.getDimCount() != 1) {
+        throw std::runtime_error("Gridded NetCDF file " + file_path + " has no one dimensional \"time\" variable");
+    }
+    std::vector<double> raw_time(time_var.getDim(0).getSize());
+    if (raw_time.size() < 2) {
+        throw std::runtime_error("Gridded NetCDF file " + file_path + " has fewer than two time steps");
+    }
+    time_var.getVar(raw_time.data());
+
+    NetCDFPerFeatureDataProvider::TimeInfo time_info{NetCDFPerFeatureDataProvider::TIME_SECONDS, 1, std::nullopt};
+    try {
+        auto time_unit_att = time_var.getAtt("units");
+        std::string time_unit_str;
+        if (!time_unit_att.isNull()) {
+            time_unit_att.getValues(time_unit_str);
+        }
+        if (auto parsed = NetCDFPerFeatureDataProvider::interpret_time_units(time_unit_str)) {
+            time_info = *parsed;
+        }
+        else {
+            log_stream << "Warning using default time units\n";
+        }
+    }
+    catch(const netCDF::exceptions::NcException&){
+        log_stream << "Warning: Couldn't read time unit attribute, using default time unit of Seconds\n";
+    }
+
+    time_vals.resize(raw_time.size());
+    std::transform(raw_time.begin(), raw_time.end(), time_vals.begin(),
+        [&](const auto& n){return n * time_info.scale_factor + time_info.epoch_start_time.value_or(0); });
+
+    time_stride = time_vals[1] - time_vals[0];
+    for (std::size_t i = 1; i + 1 < time_vals.size(); ++i) {
+        if (std::abs(time_vals[i + 1] - time_vals[i] - time_stride) > 0.000001) {
+            throw std::runtime_error("Time intervals in gridded NetCDF file " + file_path + " are not constant");
+        }
+    }
+
+    start_time = time_vals.front();
+    stop_time = time_vals.back() + time_stride;
+}
+
+NetCDFGridDataProvider::~NetCDFGridDataProvider()
+{
+    const std::lock_guard<std::mutex> io_lock(NetCDFPerFeatureDataProvider::netcdf_io_mutex);
+    nc_file = nullptr;
+}
+
+std::pair<double, double> NetCDFGridDataProvider::read_axis(const std::string& name, const std::string& alt_name,
+                                                            std::uint64_t& size, bool& reversed, bool& degrees)
+{
+    auto ncvar = nc_file->getVar(name);
+    if (ncvar.isNull()) {
+        ncvar = nc_file->getVar(alt_name);
+    }
+    if (ncvar.isNull() || ncvar.getDimCount() != 1) {
+        throw std::runtime_error("Gridded NetCDF file " + file_path + " has no one dimensional \"" + name
+                                 + "\" or \"" + alt_name + "\" variable");
+    }
+
+    std::vector<double> centres(ncvar.getDim(0).getSize());
+    if (centres.size() < 2) {
+        throw std::runtime_error("Gridded NetCDF file " + file_path + " has fewer than two cells along "
+                                 + ncvar.getName());
+    }
+    ncvar.getVar(centres.data());
+
+    const double step = centres[1] - centres[0];
+    for (std::size_t i = 1; i + 1 < centres.size(); ++i) {
+        if (std::abs(centres[i + 1] - centres[i] - step) > std::abs(step) * 1.0e-6) {
+            throw std::runtime_error("Cells of gridded NetCDF file " + file_path + " are not evenly spaced along "
+                                     + ncvar.getName());
+        }
+    }
+
+    // CF conventions give longitude and latitude in units of degrees_east and degrees_north
+    std::string units;
+    try {
+        auto units_att = ncvar.getAtt("units");
+        if (!units_att.isNull()) {
+            units_att.getValues(units);
+        }
+    }
+    catch (const netCDF::exceptions::NcException&) {
+        units = "";
+    }
+    degrees = ncvar.getName() == alt_name || units.rfind("degree", 0) == 0;
+
+    size = centres.size();
+    reversed = step < 0;
+    const double half = std::abs(step) / 2;
+    const auto bounds = std::minmax(centres.front(), centres.back());
+    return { bounds.first - half, bounds.second + half };
+}
+
+void NetCDFGridDataProvider::finalize()
+{
+    const std::lock_guard<std::mutex> io_lock(NetCDFPerFeatureDataProvider::netcdf_io_mutex);
+    if (nc_file != nullptr) {
+        nc_file->close();
+    }
+    nc_file = nullptr;
+}
+
+boost::span<const std::string> NetCDFGridDataProvider::get_available_variable_names() const
+{
+    return variable_names;
+}
+
+long NetCDFGridDataProvider::get_data_start_time() const
+{
+    return start_time;
+}
+
+long NetCDFGridDataProvider::get_data_stop_time() const
+{
+    return stop_time;
+}
+
+long NetCDFGridDataProvider::record_duration() const
+{
+    return time_stride;
+}
+
+size_t NetCDFGridDataProvider::get_ts_index_for_time(const time_t &epoch_time) const
+{
+    if (start_time <= epoch_time && epoch_time < stop_time) {
+        return size_t((epoch_time - start_time) / time_stride);
+    }
+
+    std::stringstream ss;
+    ss << "The value " << (int)epoch_time << " was not in the range [" << (int)start_time << "," << (int)stop_time << ")";
+    throw std::out_of_range(ss.str().c_str());
+}
+
+Cell NetCDFGridDataProvider::get_value(const GridDataSelector& selector, ReSampleMethod m)
+{
+    if (selector.cells().size() != 1) {
+        throw std::invalid_argument("NetCDFGridDataProvider::get_value needs a selector of one cell, not "
+                                    + std::to_string(selector.cells().size()));
+    }
+    return get_values(selector, m).front();
+}
+
+std::vector<Cell> NetCDFGridDataProvider::get_values(const GridDataSelector& selector, ReSampleMethod m)
+{
+    std::vector<Cell> cells(selector.cells().begin(), selector.cells().end());
+    if (cells.empty()) {
+        return cells;
+    }
+
+    auto var_name = ncvar_names.find(selector.variable());
+    if (var_name == ncvar_names.end()) {
+        throw std::runtime_error("Gridded NetCDF file " + file_path + " has no variable " + selector.variable());
+    }
+
+    // the time steps of the window, weighted by how much of each is in it, as for the per-feature files
+    const auto init_time = selector.initial_time();
+    const auto end_time = init_time + selector.duration();
+    const size_t c_idx1 = get_ts_index_for_time(init_time);
+    size_t c_idx2;
+    try {
+        c_idx2 = get_ts_index_for_time(end_time - 1); // Don't include next timestep when duration % timestep = 0
+    }
+    catch (const std::out_of_range&) {
+        c_idx2 = get_ts_index_for_time(stop_time - 1); // to the edge
+    }
+    const std::size_t read_len = c_idx2 - c_idx1 + 1;
+    std::vector<double> weights(read_len, 1.0);
+    const double a = 1.0 - ((time_vals[c_idx1] - init_time) / time_stride);
+    double b = 0.0;
+    weights.front() = a;
+    if (read_len > 1) {
+        b = (end_time - time_vals[c_idx2]) / time_stride;
+        weights.back() = b;
+    }
+    double scale = 1.0;
+    if (m == MEAN) {
+        scale = (selector.duration() > time_stride) ? (time_stride / selector.duration()) : (1.0 / (a + b));
+    }
+
+    // the smallest block of the file holding every cell, in the file's own row and column order
+    const auto& spec = *grid;
+    std::uint64_t row_min = spec.rows, row_max = 0, col_min = spec.columns, col_max = 0;
+    auto file_row = [&](const Cell& cell) { return y_reversed ? spec.rows - 1 - cell.y : cell.y; };
+    auto file_col = [&](const Cell& cell) { return x_reversed ? spec.columns - 1 - cell.x : cell.x; };
+    for (const auto& cell : cells) {
+        if (cell.x >= spec.columns || cell.y >= spec.rows) {
+            throw std::out_of_range("Cell (" + std::to_string(cell.x) + ", " + std::to_string(cell.y)
+                                    + ") is not in the grid of " + file_path);
+        }
+        row_min = std::min(row_min, file_row(cell));
+        row_max = std::max(row_max, file_row(cell));
+        col_min = std::min(col_min, file_col(cell));
+        col_max = std::max(col_max, file_col(cell));
+    }
+    const std::size_t block_rows = row_max - row_min + 1;
+    const std::size_t block_cols = col_max - col_min + 1;
+    const std::size_t block_size = block_rows * block_cols;
+
+    std::vector<double> block(read_len * block_size);
+    double fill_value = NAN;
+    {
+        const std::lock_guard<std::mutex> io_lock(NetCDFPerFeatureDataProvider::netcdf_io_mutex);
+        auto ncvar = nc_file->getVar(var_name->second);
+        ncvar.getVar({c_idx1, row_min, col_min}, {read_len, block_rows, block_cols}, block.data());
+        auto fill_att = ncvar.getAtt("_FillValue");
+        if (!fill_att.isNull()) {
+            fill_att.getValues(&fill_value);
+        }
+    }
+
+    std::vector<double> values(cells.size(), 0.0);
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        const std::size_t offset = (file_row(cells[i]) - row_min) * block_cols + (file_col(cells[i]) - col_min);
+        for (std::size_t t = 0; t < read_len; ++t) {
+            const double value = block[t * block_size + offset];
+            // a missing value makes the cell's value NaN
+            values[i] += weights[t] * (value == fill_value ? NAN : value);
+        }
+        values[i] *= scale;
+    }
+
+    try {
+        UnitsHelper::get_unit_converter(units_cache[selector.variable()], selector.units())
+            .convert(values.data(), values.data(), values.size());
+    }
+    catch (UnitsHelper::unit_conversion_exception& uce) {
+        uce.provider_model_name = "NetCDFGridDataProvider(" + file_path + ")";
+        uce.provider_var_name = selector.variable();
+        uce.unconverted_values = values;
+        throw;
+    }
+
+    for (std::size_t i = 0; i < cells.size(); ++i) {
+        cells[i].value = values[i];
+    }
+    return cells;
+}
+
+}
+
+#endif
@@ -5,13 +5,23 @@
 #include <mediator/UnitsHelper.hpp>
 
 #include <netcdf>
+#include <numeric>
+#include <sstream>
 
 std::mutex data_access::NetCDFPerFeatureDataProvider::shared_providers_mutex;
 std::map<std::string, std::shared_ptr<data_access::NetCDFPerFeatureDataProvider>> data_access::NetCDFPerFeatureDataProvider::shared_providers;
+std::mutex data_access::NetCDFPerFeatureDataProvider::netcdf_io_mutex;
+#if NGEN_WITH_MPI
+std::vector<std::shared_ptr<data_access::NodeSharedPageCache>> data_access::NetCDFPerFeatureDataProvider::node_caches;
+#endif
 
 // limit access outside of compilation unit.
 namespace {
     const size_t N_EXPECTED_FORCING_VARS = 8;
+
+    std::string page_key(const std::string& var_name, std::size_t page_c_idx) {
+        return var_name + "|" + std::to_string(page_c_idx);
+    }
 }
 
 namespace data_access {
@@ -176,6 +186,9 @@ NetCDFPerFeatureDataProvider::NetCDFPerFeatureDataProvider(std::string input_pat
     , sim_start_date_time_epoch(sim_start)
     , sim_end_date_time_epoch(sim_end)
 {
+    // another provider's read-ahead thread may be using the library
+    const std::lock_guard<std::mutex> io_lock(netcdf_io_mutex);
+
     //size_t sizep = 1073741824, nelemsp = 202481;
     //float preemptionp = 0.75;
     //nc_set_chunk_cache(sizep, nelemsp, preemptionp);
@@ -437,10 +450,220 @@ void NetCDFPerFeatureDataProvider::maybe_update_chunks_with_hints()
     hinted_ids.clear();
 }
 
-NetCDFPerFeatureDataProvider::~NetCDFPerFeatureDataProvider() = default;
+NetCDFPerFeatureDataProvider::~NetCDFPerFeatureDataProvider()
+{
+    stop_read_ahead();
+    const std::lock_guard<std::mutex> io_lock(netcdf_io_mutex);
+    nc_file = nullptr;
+}
+
+void NetCDFPerFeatureDataProvider::set_read_ahead(std::size_t depth)
+{
+    {
+        const std::lock_guard<std::mutex> lock(value_cache_mutex);
+        if (depth == read_ahead_depth) {
+            return;
+        }
+    }
+    stop_read_ahead();
+
+    std::size_t n_vars;
+    {
+        const std::lock_guard<std::mutex> io_lock(netcdf_io_mutex);
+        n_vars = nc_file->getVarCount();
+    }
+
+    const std::lock_guard<std::mutex> lock(value_cache_mutex);
+    read_ahead_depth = depth;
+    // room for each variable's page in use, the next one for reads that straddle pages, and its read-ahead pages
+    value_cache = boost::compute::detail::lru_cache<std::string, std::shared_ptr<std::vector<double>>>(
+        std::max(N_EXPECTED_FORCING_VARS, n_vars) * (depth + 2));
+    if (depth > 0) {
+        read_ahead_thread = std::thread(&NetCDFPerFeatureDataProvider::read_ahead_loop, this);
+    }
+}
+
+void NetCDFPerFeatureDataProvider::request_node_shared_cache()
+{
+    const std::lock_guard<std::mutex> lock(value_cache_mutex);
+    node_shared_cache_requested = true;
+}
+
+#if NGEN_WITH_MPI
+void NetCDFPerFeatureDataProvider::share_node_caches(MPI_Comm comm)
+{
+    MPI_Comm node_comm;
+    MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    int node_rank, node_size;
+    MPI_Comm_rank(node_comm, &node_rank);
+    MPI_Comm_size(node_comm, &node_size);
+    if (node_size == 1) {
+        MPI_Comm_free(&node_comm);
+        return;
+    }
+
+    // describe each provider of this rank that asked to share, as a line of its path and the chunks of its ids
+    std::map<std::string, std::shared_ptr<NetCDFPerFeatureDataProvider>> providers;
+    std::string description;
+    {
+        const std::lock_guard<std::mutex> lock(shared_providers_mutex);
+        for (const auto& entry : shared_providers) {
+            const auto& p = entry.second;
+            const std::lock_guard<std::mutex> cache_lock(p->value_cache_mutex);
+            if (!p->node_shared_cache_requested) {
+                continue;
+            }
+            if (p->hinted_ids.size() > 0) {
+                p->maybe_update_chunks_with_hints();
+            }
+            providers.emplace(entry.first, p);
+            description += entry.first + '\t';
+            for (const auto& chunk : p->chunks) {
+                description += std::to_string(chunk.first) + ' ' + std::to_string(chunk.second) + ' ';
+            }
+            description += '\n';
+        }
+    }
+
+    int length = description.size();
+    std::vector<int> lengths(node_size), offsets(node_size);
+    MPI_Allgather(&length, 1, MPI_INT, lengths.data(), 1, MPI_INT, node_comm);
+    std::exclusive_scan(lengths.begin(), lengths.end(), offsets.begin(), 0);
+    std::string descriptions(offsets.back() + lengths.back(), '\0');
+    MPI_Allgatherv(description.data(), length, MPI_CHAR, descriptions.data(), lengths.data(), offsets.data(), MPI_CHAR, node_comm);
+
+    // for each file, the lowest rank sharing it, which allocates its window, and the chunks of every rank sharing it
+    struct shared_file
+    {
+        int owner = -1;
+        std::vector<std::pair<size_t, size_t>> chunks;
+    };
+    std::map<std::string, shared_file> files;
+    for (int r = 0; r < node_size; ++r) {
+        std::istringstream lines(descriptions.substr(offsets[r], lengths[r]));
+        std::string line;
+        while (std::getline(lines, line)) {
+            auto tab = line.find('\t');
+            shared_file& file = files[line.substr(0, tab)];
+            if (file.owner < 0) {
+                file.owner = r;
+            }
+            std::istringstream numbers(line.substr(tab + 1));
+            std::size_t first, count;
+            while (numbers >> first >> count) {
+                file.chunks.emplace_back(first, count);
+            }
+        }
+    }
+
+    // every rank goes through the files in the same order, as allocating each window is collective
+    for (auto& entry : files) {
+        shared_file& file = entry.second;
+        std::sort(file.chunks.begin(), file.chunks.end());
+        std::vector<std::pair<size_t, size_t>> merged;
+        for (const auto& chunk : file.chunks) {
+            if (!merged.empty() && chunk.first <= merged.back().first + merged.back().second) {
+                std::size_t end = std::max(merged.back().first + merged.back().second, chunk.first + chunk.second);
+                merged.back().second = end - merged.back().first;
+            }
+            else {
+                merged.push_back(chunk);
+            }
+        }
+        std::size_t rows = 0;
+        for (const auto& chunk : merged) {
+            rows += chunk.second;
+        }
+
+        // only ranks with the provider know the shape of the file: variables, pages per variable, values per page
+        std::uint64_t shape[3] = {0, 0, 0};
+        auto provider = providers.find(entry.first);
+        if (node_rank == file.owner) {
+            const auto& p = provider->second;
+            auto names = p->paged_variable_names();
+            const std::lock_guard<std::mutex> lock(p->value_cache_mutex);
+            shape[0] = names.size();
+            // as for the value cache: the page in use, the next one, and the read-ahead pages
+            shape[1] = p->read_ahead_depth + 2;
+            shape[2] = rows * p->cache_slice_t_size;
+        }
+        MPI_Bcast(shape, 3, MPI_UINT64_T, file.owner, node_comm);
+
+        auto cache = std::make_shared<NodeSharedPageCache>(node_comm, file.owner, shape[0], shape[1], shape[2]);
+        node_caches.push_back(cache);
+        if (!cache->usable()) {
+            if (node_rank == file.owner) {
+                std::cerr << "Warning: MPI shared memory is not in the unified memory model; ranks will read "
+                          << entry.first << " separately" << std::endl;
+            }
+        }
+        else if (provider != providers.end()) {
+            provider->second->attach_node_cache(cache, std::move(merged));
+        }
+    }
+    MPI_Comm_free(&node_comm);
+}
+
+void NetCDFPerFeatureDataProvider::release_node_caches()
+{
+    {
+        const std::lock_guard<std::mutex> lock(shared_providers_mutex);
+        for (const auto& entry : shared_providers) {
+            // the read-ahead thread may be loading a page through the cache
+            entry.second->stop_read_ahead();
+            const std::lock_guard<std::mutex> cache_lock(entry.second->value_cache_mutex);
+            entry.second->node_cache = nullptr;
+        }
+    }
+    for (auto& cache : node_caches) {
+        cache->free();
+    }
+    node_caches.clear();
+}
+
+std::vector<std::string> NetCDFPerFeatureDataProvider::paged_variable_names() const
+{
+    const std::lock_guard<std::mutex> io_lock(netcdf_io_mutex);
+    std::vector<std::string> names;
+    for (const auto& var : nc_file->getVars()) {
+        if (var.second.getDimCount() == 2) {
+            names.push_back(var.first);
+        }
+    }
+    return names;
+}
+
+void NetCDFPerFeatureDataProvider::attach_node_cache(std::shared_ptr<NodeSharedPageCache> cache, std::vector<std::pair<size_t, size_t>> node_page_chunks)
+{
+    auto names = paged_variable_names();
+    auto binding = std::make_shared<NodeCacheBinding>();
+    binding->cache = std::move(cache);
+    for (std::size_t v = 0; v < names.size(); ++v) {
+        binding->var_index.emplace(names[v], v);
+    }
+
+    // both sets of chunks are sorted by position in the file, and the node's cover this rank's
+    binding->chunks = std::move(node_page_chunks);
+    const std::lock_guard<std::mutex> lock(value_cache_mutex);
+    auto node_chunk = binding->chunks.begin();
+    std::size_t node_row = 0;
+    for (const auto& chunk : chunks) {
+        for (std::size_t f = chunk.first; f < chunk.first + chunk.second; ++f) {
+            while (f >= node_chunk->first + node_chunk->second) {
+                node_row += node_chunk->second;
+                ++node_chunk;
+            }
+            binding->rows.push_back(node_row + f - node_chunk->first);
+        }
+    }
+    node_cache = std::move(binding);
+}
+#endif
 
 void NetCDFPerFeatureDataProvider::finalize()
 {
+    stop_read_ahead();
+    const std::lock_guard<std::mutex> io_lock(netcdf_io_mutex);
     if (nc_file != nullptr) {
         nc_file->close();
     }
@@ -564,17 +787,9 @@ double NetCDFPerFeatureDataProvider::get_value(const CatchmentAggrDataSelector&
      * p dim: page index
      */
 
-    auto init_time = selector.get_init_time();
-    auto stop_time = init_time + selector.get_duration_secs(); // scope hiding! BAD JUJU!
-    
-    size_t c_idx1 = get_ts_index_for_time(init_time);
-    size_t c_idx2;
-    try {
-        c_idx2 = get_ts_index_for_time(stop_time-1); // Don't include next timestep when duration % timestep = 0
-    }
-    catch(const std::out_of_range &e){
-        c_idx2 = get_ts_index_for_time(this->stop_time-1); //to the edge
-    }
+    // A shared provider may be queried from several catchment worker threads at once; the
+    // chunk hints, caches, and NetCDF handle are not safe for concurrent access.
+    std::unique_lock<std::mutex> lock(value_cache_mutex);
 
     // update chunks during the first timestep
     if (hinted_ids.size() > 0){
@@ -583,146 +798,340 @@ double NetCDFPerFeatureDataProvider::get_value(const CatchmentAggrDataSelector&
         maybe_update_chunks_with_hints();
     }
 
-    auto stride = c_idx2 - c_idx1;
+    compiled_query& query = compiled_queries[find_or_compile_query(selector, m)];
+    std::size_t i_idx = id_pos[selector.get_id()];
+    double value;
+    evaluate_query(query, {&i_idx, 1}, selector.get_init_time(), {&value, 1}, lock);
+    return value;
+}
 
-    std::vector<std::size_t> start, count;
+std::vector<double> NetCDFPerFeatureDataProvider::get_values(const CatchmentAggrDataSelector& selector, data_access::ReSampleMethod m)
+{
+    return std::vector<double>(1, get_value(selector, m));
+}
 
-    auto i_idx = id_pos[selector.get_id()];
+void NetCDFPerFeatureDataProvider::get_values_for_ids(const CatchmentAggrDataSelector& selector, boost::span<const std::string> ids,
+                                                      boost::span<double> values, ReSampleMethod m)
+{
+    std::unique_lock<std::mutex> lock(value_cache_mutex);
 
-    double t1 = time_vals[c_idx1];
-    double t2 = time_vals[c_idx2];
+    if (hinted_ids.size() > 0){
+        maybe_update_chunks_with_hints();
+    }
 
-    double rvalue = 0.0;
-    
-    auto ncvar = get_ncvar(selector.get_variable_name());
+    if (values.size() != ids.size()) {
+        throw std::invalid_argument("Got " + std::to_string(values.size()) + " value slots for "
+                                    + std::to_string(ids.size()) + " feature ids");
+    }
 
-    std::string native_units = get_ncvar_units(selector.get_variable_name());
+    std::vector<std::size_t> rows(ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto pos = id_pos.find(ids[i]);
+        if (pos == id_pos.end()) {
+            throw std::out_of_range("Feature " + ids[i] + " is not in forcing file " + file_path + SOURCE_LOC);
+        }
+        rows[i] = pos->second;
+    }
 
+    compiled_query& query = compiled_queries[find_or_compile_query(selector, m)];
+    evaluate_query(query, rows, selector.get_init_time(), values, lock);
+}
+
+NetCDFPerFeatureDataProvider::query_handle NetCDFPerFeatureDataProvider::compile_query(const CatchmentAggrDataSelector& selector, ReSampleMethod m)
+{
+    const std::lock_guard<std::mutex> lock(value_cache_mutex);
+    return find_or_compile_query(selector, m);
+}
+
+double NetCDFPerFeatureDataProvider::get_value(query_handle query, std::size_t feature_idx, time_t init_time)
+{
+    std::unique_lock<std::mutex> lock(value_cache_mutex);
+
+    if (hinted_ids.size() > 0){
+        maybe_update_chunks_with_hints();
+    }
+    if (query >= compiled_queries.size()) {
+        throw std::invalid_argument("Got query handle " + std::to_string(query) + " but only " + std::to_string(compiled_queries.size())
+                                    + " queries have been compiled" + SOURCE_LOC);
+    }
+    if (feature_idx >= get_ids().size()) {
+        throw std::out_of_range("Feature index " + std::to_string(feature_idx) + " is not less than the "
+                                + std::to_string(get_ids().size()) + " features of " + file_path + SOURCE_LOC);
+    }
+
+    double value;
+    evaluate_query(compiled_queries[query], {&feature_idx, 1}, init_time, {&value, 1}, lock);
+    return value;
+}
+
+// private:
+
+NetCDFPerFeatureDataProvider::query_handle NetCDFPerFeatureDataProvider::find_or_compile_query(const CatchmentAggrDataSelector& selector, ReSampleMethod m)
+{
+    auto key = std::make_tuple(selector.get_variable_name(), selector.get_duration_secs(), selector.get_output_units(), m);
+    auto found = query_index.find(key);
+    if (found != query_index.end()) {
+        return found->second;
+    }
+
+    compiled_query query;
+    query.ncvar = &get_ncvar(selector.get_variable_name());
+    {
+        // even metadata queries go through the library, which the read-ahead thread may be using
+        const std::lock_guard<std::mutex> io_lock(netcdf_io_mutex);
+        query.var_name = query.ncvar->getName();
+    }
+    query.duration = selector.get_duration_secs();
+    query.method = m;
+    try {
+        query.converter = UnitsHelper::get_unit_converter(get_ncvar_units(selector.get_variable_name()), selector.get_output_units());
+    }
+    catch (UnitsHelper::unit_conversion_exception& uce) {
+        // reported, with the unconverted values, each time the query is evaluated
+        uce.provider_model_name = "NetCDFPerFeatureDataProvider(" + file_path + ")";
+        uce.provider_var_name = selector.get_variable_name();
+        query.conversion_error = uce;
+    }
+
+    query_handle handle = compiled_queries.size();
+    compiled_queries.push_back(std::move(query));
+    query_index.emplace(std::move(key), handle);
+    return handle;
+}
+
+void NetCDFPerFeatureDataProvider::evaluate_query(compiled_query& query, boost::span<const std::size_t> rows, time_t init_time,
+                                                  boost::span<double> values, std::unique_lock<std::mutex>& lock)
+{
+    // see get_value for the layout of the cache pages
+    auto end_time = init_time + query.duration;
+
+    size_t c_idx1 = get_ts_index_for_time(init_time);
+    size_t c_idx2;
+    try {
+        c_idx2 = get_ts_index_for_time(end_time-1); // Don't include next timestep when duration % timestep = 0
+    }
+    catch(const std::out_of_range &e){
+        c_idx2 = get_ts_index_for_time(this->stop_time-1); //to the edge
+    }
+
+    // The weights only depend on where the window starts within a forcing time step and how many time steps it
+    // covers, which for a fixed duration rarely change from one call to the next
+    double phase = init_time - time_vals[c_idx1];
     const std::size_t read_len = c_idx2 - c_idx1 + 1;
+    if (!query.window || phase != query.window->phase || read_len != query.window->weights.size()) {
+        auto window = std::make_shared<query_window>();
+        window->phase = phase;
+        window->weights.assign(read_len, 1.0);
+
+        // the first and last data values may not be fully in the window
+        double a = 1.0 - ( (time_vals[c_idx1] - init_time) / time_stride );
+        double b = 0.0;
+        window->weights.front() = a;
+        if (read_len > 1) {
+            b = (end_time - time_vals[c_idx2]) / time_stride;
+            window->weights.back() = b;
+        }
 
-    std::vector<double> raw_values;
-    raw_values.reserve(read_len);
+        // account for the resampling methods
+        switch(query.method)
+        {
+            case MEAN:
+                // This is getting a length weighted mean
+                // the data values where already scaled for where there was only partial use of a data value
+                // so we just need to do a final scale to account for the difference between time_stride and duration_s
+                window->scale = (query.duration > time_stride ) ? (time_stride / query.duration) : (1.0 / (a + b));
+            break;
+
+            case SUM:   // we already have the sum so do nothing
+            default:
+                window->scale = 1.0;
+        }
+        query.window = std::move(window);
+    }
+    // get_page may release the lock, and another evaluation of this query may then replace its window
+    const std::shared_ptr<const query_window> window = query.window;
 
+    std::fill(values.begin(), values.end(), 0.0);
     std::size_t cache_line_size = cache_slice_t_size;
-    std::size_t p_idx = cache::page_p_idx(c_idx1, cache_line_size);
-    // pages spanned by [c_idx1, c_idx2]; ceil(read_len / line_size) undercounts
-    // when the range starts mid-page and crosses a page boundary
-    std::size_t n_page_accesses = cache::page_p_idx(c_idx2, cache_line_size) - p_idx + 1;
-
-    std::size_t c_idx = c_idx1;
-    // For reference: https://stackoverflow.com/a/72030286
-    for( size_t i = 0; i < n_page_accesses; i++ ) {
+    std::size_t last_p_idx = cache::page_p_idx(c_idx2, cache_line_size);
+    for (std::size_t p = cache::page_p_idx(c_idx1, cache_line_size); p <= last_p_idx; ++p) {
         // rows: catchments; columns: time;
-        // stride between rows is 'cache_line_size'
-        std::shared_ptr<std::vector<double>> cached;
-
-	std::size_t ith_p_idx = p_idx + i;
-	std::size_t page_c_idx = cache::page_p_idx_to_c_idx(ith_p_idx, cache_line_size);
-	std::size_t page_cache_line_size = cache::page_cache_line_size(page_c_idx, time_vals.size(), cache_line_size);
-
-        std::string key = ncvar.getName() + "|" + std::to_string(page_c_idx);
-        if(value_cache.contains(key)){
-            cached = value_cache.get(key).get();
-        } else {
-            cached = std::make_shared<std::vector<double>>(get_ids().size() * page_cache_line_size);
-
-            // read each chunk and add it to "cached"
-            std::size_t idx = 0;
-            for(auto const& chunk: chunks){
-                // chunk start index = chunk.first;
-                // chunk length      = chunk.second;
-                start.clear();
-                start.push_back(chunk.first);
-
-                // NOTE: in the first iteration, we might read more data in the Time
-                // dimension than we 'need'. b.c. we read from:
-                // 'c_idx1 - (c_idx1 % cache_slice_t_size)' to the end of the cache line.
-                // so, if 'c_idx1 % cache_slice_t_size > 0' we will read
-                // 'c_idx1 % cache_slice_t_size * next_chunk_idx' more values than we 'need' to.
-                start.push_back(page_c_idx);
-
-                count.clear();
-                count.push_back(chunk.second);
-
-                count.push_back(page_cache_line_size);
-                ncvar.getVar(start,count,&(*cached)[idx]);
-                idx += chunk.second * page_cache_line_size;
+        // stride between rows is the page's cache line size
+        std::size_t page_c_idx = cache::page_p_idx_to_c_idx(p, cache_line_size);
+        std::size_t page_cache_line_size = cache::page_cache_line_size(page_c_idx, time_vals.size(), cache_line_size);
+        std::shared_ptr<std::vector<double>> cached = get_page(*query.ncvar, query.var_name, page_c_idx, lock);
+
+        std::size_t first = std::max(c_idx1, page_c_idx) - page_c_idx;
+        std::size_t last = std::min(c_idx2, page_c_idx + page_cache_line_size - 1) - page_c_idx;
+        const double* weights = &window->weights[page_c_idx + first - c_idx1];
+        for (std::size_t i = 0; i < rows.size(); ++i) {
+            const double* row = cached->data() + rows[i] * page_cache_line_size;
+            double& sum = values[i];
+            for (std::size_t j = first; j <= last; ++j) {
+                sum += weights[j - first] * row[j];
             }
-
-            value_cache.insert(key, cached);
-        }
-        // Find all values in the current cache slice and push them onto raw_values
-        while(c_idx >= page_c_idx &&
-              c_idx < page_c_idx + page_cache_line_size &&
-              c_idx <= c_idx2){
-            std::size_t idx = cache::page_entry_idx(i_idx, c_idx, time_vals.size(), cache_line_size);
-            double value = cached->at(idx);
-            raw_values.push_back(value);
-            c_idx++;
         }
     }
 
-    assert(raw_values.size() == read_len);
-    rvalue = 0.0;
+    if (read_ahead_depth > 0) {
+        queue_read_ahead(query.var_name, last_p_idx);
+    }
 
-    double a , b = 0.0;
-    
-    a = 1.0 - ( (t1 - init_time) / time_stride );
-    rvalue += (a * raw_values[0]);
+    if (window->scale != 1.0) {
+        for (double& value : values) {
+            value *= window->scale;
+        }
+    }
 
-    for( size_t i = 1; i < raw_values.size() -1; ++i )
-    {
-        rvalue += raw_values[i];
+    if (query.conversion_error) {
+        UnitsHelper::unit_conversion_exception uce = *query.conversion_error;
+        uce.unconverted_values.assign(values.begin(), values.end());
+        throw uce;
     }
+    query.converter.convert(values.data(), values.data(), values.size());
+}
 
-    if (  raw_values.size() > 1) // likewise the last data value may not be fully in the window
-    {
-        b = (stop_time - t2) / time_stride;
-        rvalue += (b * raw_values.back() );
+std::shared_ptr<std::vector<double>> NetCDFPerFeatureDataProvider::get_page(const netCDF::NcVar& ncvar, const std::string& var_name,
+                                                                           std::size_t page_c_idx, std::unique_lock<std::mutex>& lock)
+{
+    std::string key = page_key(var_name, page_c_idx);
+    if(!value_cache.contains(key) && key == read_ahead_in_flight){
+        // the read-ahead thread is already reading this page; wait for it rather than reading it twice
+        page_ready_cv.wait(lock, [&]{ return read_ahead_in_flight != key; });
+    }
+    if(value_cache.contains(key)){
+        return value_cache.get(key).get();
     }
+    std::size_t page_cache_line_size = cache::page_cache_line_size(page_c_idx, time_vals.size(), cache_slice_t_size);
+    auto page = std::make_shared<std::vector<double>>(get_ids().size() * page_cache_line_size);
+    load_page(ncvar, var_name, page_c_idx, page_cache_line_size, chunks, node_cache, *page);
+    value_cache.insert(key, page);
+    return page;
+}
 
-    // account for the resampling methods
-    switch(m)
-    {
-        case SUM:   // we already have the sum so do nothing
-            ;
-        break;
+void NetCDFPerFeatureDataProvider::read_page(const netCDF::NcVar& ncvar, std::size_t page_c_idx, std::size_t page_cache_line_size,
+                                             const std::vector<std::pair<size_t, size_t>>& page_chunks, double* page)
+{
+    const std::lock_guard<std::mutex> io_lock(netcdf_io_mutex);
+    std::vector<std::size_t> start, count;
 
-        case MEAN: 
-        { 
-            // This is getting a length weighted mean
-            // the data values where already scaled for where there was only partial use of a data value
-            // so we just need to do a final scale to account for the difference between time_stride and duration_s
+    // read each chunk and add it to the page
+    std::size_t idx = 0;
+    for(auto const& chunk: page_chunks){
+        // chunk start index = chunk.first;
+        // chunk length      = chunk.second;
+        start.clear();
+        start.push_back(chunk.first);
 
-            double scale_factor = (selector.get_duration_secs() > time_stride ) ? (time_stride / selector.get_duration_secs()) : (1.0 / (a + b));
-            rvalue *= scale_factor;
-        }
-        break;
+        // NOTE: a read that starts mid-page still reads the page from its first time step, so
+        // some values are read before they are needed.
+        start.push_back(page_c_idx);
 
-        default:
-            ;
-    }
+        count.clear();
+        count.push_back(chunk.second);
 
-    try 
-    {
-        return UnitsHelper::get_converted_value(native_units, rvalue, selector.get_output_units());
+        count.push_back(page_cache_line_size);
+        ncvar.getVar(start,count,page + idx);
+        idx += chunk.second * page_cache_line_size;
     }
-    catch (UnitsHelper::unit_conversion_exception& uce)
-    {
-        uce.provider_model_name = "NetCDFPerFeatureDataProvider(" + file_path + ")";
-        uce.provider_var_name = selector.get_variable_name();
-        throw;
+}
+
+void NetCDFPerFeatureDataProvider::load_page(const netCDF::NcVar& ncvar, const std::string& var_name, std::size_t page_c_idx,
+                                             std::size_t page_cache_line_size, const std::vector<std::pair<size_t, size_t>>& page_chunks,
+                                             const std::shared_ptr<const NodeCacheBinding>& shared, std::vector<double>& page)
+{
+#if NGEN_WITH_MPI
+    std::map<std::string, std::size_t>::const_iterator var;
+    if (shared != nullptr && (var = shared->var_index.find(var_name)) != shared->var_index.end()) {
+        // node pages have a row for each id hinted on the node; this rank keeps only its own rows
+        shared->cache->fetch(var->second, cache::page_p_idx(page_c_idx, cache_slice_t_size),
+            [&](double* node_page) {
+                read_page(ncvar, page_c_idx, page_cache_line_size, shared->chunks, node_page);
+            },
+            [&](const double* node_page) {
+                for (std::size_t row = 0; row < shared->rows.size(); ++row) {
+                    std::copy_n(node_page + shared->rows[row] * page_cache_line_size, page_cache_line_size,
+                                page.data() + row * page_cache_line_size);
+                }
+            });
+        return;
     }
+#endif
+    read_page(ncvar, page_c_idx, page_cache_line_size, page_chunks, page.data());
+}
 
-    return rvalue;
+void NetCDFPerFeatureDataProvider::queue_read_ahead(const std::string& var_name, std::size_t p_idx)
+{
+    std::size_t last_p_idx = std::min(p_idx + read_ahead_depth, cache::page_count(time_vals.size(), cache_slice_t_size) - 1);
+    auto horizon = read_ahead_horizon.try_emplace(var_name, p_idx).first;
+    if (horizon->second >= last_p_idx) {
+        return;
+    }
+    for (std::size_t p = std::max(horizon->second, p_idx) + 1; p <= last_p_idx; ++p) {
+        read_ahead_queue.emplace_back(var_name, cache::page_p_idx_to_c_idx(p, cache_slice_t_size));
+    }
+    horizon->second = last_p_idx;
+    read_ahead_cv.notify_one();
 }
 
-std::vector<double> NetCDFPerFeatureDataProvider::get_values(const CatchmentAggrDataSelector& selector, data_access::ReSampleMethod m)
+void NetCDFPerFeatureDataProvider::read_ahead_loop()
 {
-    return std::vector<double>(1, get_value(selector, m));
+    std::unique_lock<std::mutex> lock(value_cache_mutex);
+    while (true) {
+        read_ahead_cv.wait(lock, [this]{ return read_ahead_stopping || !read_ahead_queue.empty(); });
+        if (read_ahead_stopping) {
+            return;
+        }
+        auto request = read_ahead_queue.front();
+        read_ahead_queue.pop_front();
+
+        std::string key = page_key(request.first, request.second);
+        if (value_cache.contains(key)) {
+            continue;
+        }
+        netCDF::NcVar ncvar = get_ncvar(request.first);
+        std::size_t page_cache_line_size = cache::page_cache_line_size(request.second, time_vals.size(), cache_slice_t_size);
+        auto page = std::make_shared<std::vector<double>>(get_ids().size() * page_cache_line_size);
+        auto page_chunks = chunks;
+        auto shared = node_cache;
+        read_ahead_in_flight = key;
+
+        // let get_value serve cached pages while this one is read
+        lock.unlock();
+        bool read = true;
+        try {
+            load_page(ncvar, request.first, request.second, page_cache_line_size, page_chunks, shared, *page);
+        }
+        catch (...) {
+            // leave the page out of the cache; get_value reads it again and reports the error
+            read = false;
+        }
+        lock.lock();
+
+        if (read) {
+            value_cache.insert(key, page);
+        }
+        read_ahead_in_flight.clear();
+        page_ready_cv.notify_all();
+    }
 }
 
-// private:
+void NetCDFPerFeatureDataProvider::stop_read_ahead()
+{
+    {
+        const std::lock_guard<std::mutex> lock(value_cache_mutex);
+        read_ahead_stopping = true;
+    }
+    read_ahead_cv.notify_all();
+    if (read_ahead_thread.joinable()) {
+        read_ahead_thread.join();
+    }
+    const std::lock_guard<std::mutex> lock(value_cache_mutex);
+    read_ahead_stopping = false;
+    read_ahead_depth = 0;
+    read_ahead_queue.clear();
+    read_ahead_horizon.clear();
+}
 
 const netCDF::NcVar& NetCDFPerFeatureDataProvider::get_ncvar(const std::string& name){
     auto cache_hit = ncvar_cache.find(name);
@@ -0,0 +1,110 @@
+#include "NodeSharedPageCache.hpp"
+
+#if NGEN_WITH_MPI
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+namespace {
+    // one cache line of header per slot, so ranks working on neighbouring slots do not contend
+    const std::size_t HEADER_WORDS = 8;
+    const std::size_t TAG = 0;
+    const std::size_t SEQUENCE = 1;
+
+    static_assert(std::atomic_ref<std::uint64_t>::is_always_lock_free,
+                  "the page cache needs lock-free atomics to share slots between processes");
+}
+
+namespace data_access {
+
+NodeSharedPageCache::NodeSharedPageCache(MPI_Comm node_comm, int owner, std::size_t n_vars, std::size_t slots_per_var, std::size_t slot_values)
+    : n_vars(n_vars)
+    , slots_per_var(slots_per_var)
+    , slot_values(slot_values)
+{
+    int rank;
+    MPI_Comm_rank(node_comm, &rank);
+
+    std::size_t n_slots = n_vars * slots_per_var;
+    std::size_t header_bytes = n_slots * HEADER_WORDS * sizeof(std::uint64_t);
+    MPI_Aint size = rank == owner ? header_bytes + n_slots * slot_values * sizeof(double) : 0;
+    void* base;
+    MPI_Win_allocate_shared(size, 1, MPI_INFO_NULL, node_comm, &base, &window);
+
+    int disp_unit;
+    MPI_Win_shared_query(window, owner, &size, &disp_unit, &base);
+    slot_headers = static_cast<std::uint64_t*>(base);
+    slot_data = reinterpret_cast<double*>(static_cast<char*>(base) + header_bytes);
+
+    int* model;
+    int flag;
+    MPI_Win_get_attr(window, MPI_WIN_MODEL, &model, &flag);
+    unified = flag && *model == MPI_WIN_UNIFIED;
+
+    // every slot starts empty, with tag 0
+    if (rank == owner) {
+        std::memset(slot_headers, 0, header_bytes);
+    }
+    MPI_Barrier(node_comm);
+}
+
+void NodeSharedPageCache::fetch(std::size_t var_idx, std::size_t page_idx, const std::function<void(double*)>& load,
+                                const std::function<void(const double*)>& copy)
+{
+    std::size_t slot = var_idx * slots_per_var + page_idx % slots_per_var;
+    std::atomic_ref<std::uint64_t> tag(slot_headers[slot * HEADER_WORDS + TAG]);
+    std::atomic_ref<std::uint64_t> sequence(slot_headers[slot * HEADER_WORDS + SEQUENCE]);
+    double* values = slot_data + slot * slot_values;
+    const std::uint64_t wanted = page_idx + 1;
+
+    while (true) {
+        // an odd sequence number means another rank is loading the slot
+        std::uint64_t seen = sequence.load(std::memory_order_acquire);
+        if (seen % 2 == 1) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (tag.load(std::memory_order_acquire) == wanted) {
+            copy(values);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == seen) {
+                return;
+            }
+            continue;
+        }
+
+        if (sequence.compare_exchange_strong(seen, seen + 1, std::memory_order_acq_rel)) {
+            // keep the writes to the slot after the odd sequence number, for readers checking it
+            std::atomic_thread_fence(std::memory_order_release);
+            tag.store(0, std::memory_order_relaxed);
+            try {
+                load(values);
+            }
+            catch (...) {
+                // leave the slot empty for the next rank to try
+                sequence.store(seen + 2, std::memory_order_release);
+                throw;
+            }
+            tag.store(wanted, std::memory_order_relaxed);
+            copy(values);
+            sequence.store(seen + 2, std::memory_order_release);
+            return;
+        }
+    }
+}
+
+void NodeSharedPageCache::free()
+{
+    if (window != MPI_WIN_NULL) {
+        MPI_Win_free(&window);
+        slot_headers = nullptr;
+        slot_data = nullptr;
+        unified = false;
+    }
+}
+
+}
+
+#endif // NGEN_WITH_MPI
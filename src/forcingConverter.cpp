@@ -0,0 +1,87 @@
+#include <NGenConfig.h>
+
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "AorcForcing.hpp"
+#include "BinaryForcingDataProvider.hpp"
+#include "CsvPerFeatureForcingProvider.hpp"
+
+#if NGEN_WITH_NETCDF
+#include "NetCDFPerFeatureDataProvider.hpp"
+#endif
+
+/**
+ * Write a binary forcing file, for the "Binary" forcing provider, from per-catchment CSV forcing files or a NetCDF
+ * forcing file.  Each variable of the input that is a well-known forcing field is written in its well-known units.
+ */
+
+static void usage(const char* program)
+{
+    std::cerr << "Usage:\n"
+              << "  " << program << " <output> \"<start>\" \"<end>\" --csv <id> <csv_file> [<id> <csv_file> ...]\n"
+#if NGEN_WITH_NETCDF
+              << "  " << program << " <output> \"<start>\" \"<end>\" --netcdf <netcdf_file>\n"
+#endif
+              << "where <start> and <end> are the first and last time steps to write, as \"YYYY-MM-DD HH:MM:SS\"."
+              << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc < 6) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::string output_path = argv[1];
+    std::string format = argv[4];
+    std::vector<data_access::binary_forcing_source> sources;
+    time_t start_time, end_time;
+
+    try {
+        if (format == "--csv" && argc % 2 == 1) {
+            for (int i = 5; i < argc; i += 2) {
+                forcing_params params(argv[i + 1], "CsvPerFeature", argv[2], argv[3]);
+                start_time = params.simulation_start_t;
+                end_time = params.simulation_end_t;
+                sources.push_back({std::make_shared<CsvPerFeatureForcingProvider>(params), {argv[i]}});
+            }
+        }
+#if NGEN_WITH_NETCDF
+        else if (format == "--netcdf" && argc == 6) {
+            forcing_params params(argv[5], "NetCDF", argv[2], argv[3]);
+            start_time = params.simulation_start_t;
+            end_time = params.simulation_end_t;
+            auto provider = data_access::NetCDFPerFeatureDataProvider::get_shared_provider(
+                params.path, start_time, end_time, utils::getStdOut());
+            sources.push_back({provider, provider->get_ids()});
+        }
+#endif
+        else {
+            usage(argv[0]);
+            return 1;
+        }
+
+        data_access::write_binary_forcing(output_path, sources, start_time, end_time);
+
+        auto written = data_access::BinaryForcingFile::open(output_path);
+        std::cout << "Wrote " << written.layout().time_steps << " time steps of " << written.layout().ids.size()
+                  << " features to " << output_path << ":" << std::endl;
+        for (std::size_t v = 0; v < written.layout().variables.size(); ++v) {
+            std::cout << "  " << written.layout().variables[v] << " [" << written.layout().units[v] << "]" << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "forcingConverter: " << e.what() << std::endl;
+        return 1;
+    }
+
+#if NGEN_WITH_NETCDF
+    data_access::NetCDFPerFeatureDataProvider::cleanup_shared_providers();
+#endif
+    return 0;
+}
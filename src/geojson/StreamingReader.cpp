@@ -0,0 +1,671 @@
+#include "StreamingReader.hpp"
+#include "FeatureBuilder.hpp"
+
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <boost/json/basic_parser_impl.hpp>
+// Boost.JSON is used header-only, so its sources are compiled here; no other translation unit may include this
+#include <boost/json/src.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+namespace geojson {
+    namespace {
+        using boost::json::string_view;
+        using error_code = boost::json::error_code;
+
+        [[noreturn]] void parse_error(std::size_t offset, const std::string& what) {
+            throw std::runtime_error("GeoJSON parse error at offset " + std::to_string(offset) + ": " + what);
+        }
+
+        /**
+         * One step of the coordinates of a geometry: the start or end of an array, or a number in one.
+         *
+         * Coordinates are recorded this way as they are read, and only built into a geometry once their feature is
+         * known to be kept.
+         */
+        struct CoordinateToken {
+            enum Kind { Open, Close, Number };
+            Kind kind;
+            double value;
+        };
+
+        /**
+         * A JSON array of coordinates, either a position (an array of numbers) or an array of nested arrays.
+         */
+        struct Coordinates {
+            double x = 0.0;
+            double y = 0.0;
+            //! Number of values in a position; 0 for an array of nested arrays
+            std::size_t dimensions = 0;
+            std::vector<Coordinates> items;
+        };
+
+        //! A geometry object of a feature, whose coordinates are @ref CoordinateToken in [begin, end)
+        struct PendingGeometry {
+            std::string type;
+            std::size_t begin = 0;
+            std::size_t end = 0;
+            bool has_coordinates = false;
+        };
+
+        //! Build the array starting at @p tokens[i], leaving @p i after its end
+        Coordinates to_coordinates(const std::vector<CoordinateToken>& tokens, std::size_t& i) {
+            Coordinates coordinates;
+            for (++i; tokens[i].kind != CoordinateToken::Close; ) {
+                if (tokens[i].kind == CoordinateToken::Open) {
+                    if (coordinates.dimensions > 0) {
+                        throw std::runtime_error("expected a number");
+                    }
+                    coordinates.items.push_back(to_coordinates(tokens, i));
+                    continue;
+                }
+                if (!coordinates.items.empty()) {
+                    throw std::runtime_error("expected '['");
+                }
+                if (coordinates.dimensions == 0) {
+                    coordinates.x = tokens[i].value;
+                }
+                else if (coordinates.dimensions == 1) {
+                    coordinates.y = tokens[i].value;
+                }
+                ++coordinates.dimensions;
+                ++i;
+            }
+            ++i;
+            return coordinates;
+        }
+
+        coordinate_t to_point(const Coordinates& position) {
+            if (position.dimensions < 2) {
+                throw std::runtime_error("a position needs at least two coordinates");
+            }
+            return coordinate_t(position.x, position.y);
+        }
+
+        template<typename Geometry>
+        Geometry to_points(const Coordinates& coordinates) {
+            Geometry points;
+            for (const auto& position : coordinates.items) {
+                bg::append(points, to_point(position));
+            }
+            return points;
+        }
+
+        /**
+         * Build a geometry object, setting @p type to the matching feature type.
+         *
+         * Mirrors @ref build_geometry, including treating each ring of a multipolygon as its own polygon.
+         */
+        geometry to_geometry(const PendingGeometry& pending, const std::vector<CoordinateToken>& tokens, FeatureType& type) {
+            if (!pending.has_coordinates) {
+                throw std::runtime_error("geometry has no coordinates");
+            }
+            std::size_t i = pending.begin;
+            const Coordinates coordinates = to_coordinates(tokens, i);
+
+            if (pending.type == "Point") {
+                type = FeatureType::Point;
+                return to_point(coordinates);
+            }
+            if (pending.type == "LineString") {
+                type = FeatureType::LineString;
+                return to_points<linestring_t>(coordinates);
+            }
+            if (pending.type == "MultiPoint") {
+                type = FeatureType::MultiPoint;
+                return to_points<multipoint_t>(coordinates);
+            }
+            if (pending.type == "Polygon") {
+                type = FeatureType::Polygon;
+                polygon_t polygon;
+                if (coordinates.items.size() > 1) {
+                    polygon.inners().resize(coordinates.items.size() - 1);
+                }
+                for (std::size_t ring = 0; ring < coordinates.items.size(); ++ring) {
+                    for (const auto& position : coordinates.items[ring].items) {
+                        if (ring == 0) {
+                            polygon.outer().push_back(to_point(position));
+                        }
+                        else {
+                            polygon.inners()[ring - 1].push_back(to_point(position));
+                        }
+                    }
+                }
+                return polygon;
+            }
+            if (pending.type == "MultiLineString") {
+                type = FeatureType::MultiLineString;
+                multilinestring_t lines;
+                for (const auto& line : coordinates.items) {
+                    lines.push_back(to_points<linestring_t>(line));
+                }
+                return lines;
+            }
+            if (pending.type == "MultiPolygon") {
+                type = FeatureType::MultiPolygon;
+                multipolygon_t polygons;
+                for (const auto& polygon : coordinates.items) {
+                    for (const auto& ring : polygon.items) {
+                        polygons.push_back(to_points<polygon_t>(ring));
+                    }
+                }
+                return polygons;
+            }
+
+            throw std::invalid_argument("Unsupported geometry type '" + pending.type + "'");
+        }
+
+        /**
+         * Handler of the events of a @c boost::json::basic_parser over a FeatureCollection document.
+         *
+         * Features are built as their closing brace is read, so only the feature being read is held besides the
+         * features that are kept.  When there is a subset of ids and a feature's top level id comes before its
+         * geometry and properties, those are skipped over for a feature outside of the subset.
+         */
+        class CollectionHandler {
+            public:
+                static constexpr std::size_t max_object_size = std::numeric_limits<std::size_t>::max();
+                static constexpr std::size_t max_array_size = std::numeric_limits<std::size_t>::max();
+                static constexpr std::size_t max_key_size = std::numeric_limits<std::size_t>::max();
+                static constexpr std::size_t max_string_size = std::numeric_limits<std::size_t>::max();
+
+                explicit CollectionHandler(const std::vector<std::string>& ids) : wanted(ids.begin(), ids.end()) {}
+
+                //! Why the handler stopped the parser, if it did
+                const std::string& error() const { return error_message; }
+
+                std::vector<Feature>& get_features() { return features; }
+
+                std::vector<double>& get_bounding_box() { return collection_bbox; }
+
+                bool on_document_begin(error_code&) { return true; }
+                bool on_document_end(error_code&) { return true; }
+
+                bool on_object_begin(error_code& ec) { return begin_container(false, ec); }
+                bool on_object_end(std::size_t, error_code& ec) { return end_container(ec); }
+                bool on_array_begin(error_code& ec) { return begin_container(true, ec); }
+                bool on_array_end(std::size_t, error_code& ec) { return end_container(ec); }
+
+                bool on_key_part(string_view s, std::size_t, error_code&) {
+                    text.append(s.data(), s.size());
+                    return true;
+                }
+
+                bool on_key(string_view s, std::size_t, error_code&) {
+                    text.append(s.data(), s.size());
+                    key.swap(text);
+                    text.clear();
+                    return true;
+                }
+
+                bool on_string_part(string_view s, std::size_t, error_code&) {
+                    text.append(s.data(), s.size());
+                    return true;
+                }
+
+                bool on_string(string_view s, std::size_t, error_code& ec) {
+                    text.append(s.data(), s.size());
+                    return scalar(Scalar::String, 0.0, ec);
+                }
+
+                bool on_number_part(string_view s, error_code&) {
+                    text.append(s.data(), s.size());
+                    return true;
+                }
+
+                bool on_int64(std::int64_t i, string_view s, error_code& ec) {
+                    text.append(s.data(), s.size());
+                    return scalar(Scalar::Number, static_cast<double>(i), ec);
+                }
+
+                bool on_uint64(std::uint64_t u, string_view s, error_code& ec) {
+                    text.append(s.data(), s.size());
+                    return scalar(Scalar::Number, static_cast<double>(u), ec);
+                }
+
+                bool on_double(double d, string_view s, error_code& ec) {
+                    text.append(s.data(), s.size());
+                    return scalar(Scalar::Number, d, ec);
+                }
+
+                bool on_bool(bool b, error_code& ec) {
+                    text = b ? "true" : "false";
+                    return scalar(Scalar::Literal, 0.0, ec);
+                }
+
+                bool on_null(error_code& ec) {
+                    text = "null";
+                    return scalar(Scalar::Null, 0.0, ec);
+                }
+
+                bool on_comment_part(string_view, error_code&) { return true; }
+                bool on_comment(string_view, error_code&) { return true; }
+
+            private:
+                //! What the value being read is part of
+                enum class Frame { Collection, Features, Feature, Properties, Property, Geometry, Geometries, Coordinates, BoundingBox, Skip };
+
+                enum class Scalar { String, Number, Literal, Null };
+
+                //! An object or array value of a property, whose members or elements are being read
+                struct PropertyBuilder {
+                    std::string key;
+                    bool is_array;
+                    PropertyMap members;
+                    std::vector<JSONProperty> elements;
+                };
+
+                bool fail(error_code& ec, std::string message) {
+                    error_message = std::move(message);
+                    ec = boost::json::error::exception;
+                    return false;
+                }
+
+                //! Whether the feature being read has a top level id that is not in the subset
+                bool feature_not_wanted() const {
+                    return !wanted.empty() && !id.empty() && wanted.find(id) == wanted.end();
+                }
+
+                bool begin_container(bool is_array, error_code& ec) {
+                    if (frames.empty()) {
+                        if (is_array) {
+                            return fail(ec, "expected '{'");
+                        }
+                        frames.push_back(Frame::Collection);
+                        return true;
+                    }
+
+                    switch (frames.back()) {
+                        case Frame::Collection:
+                            if (key == "features" && is_array) {
+                                frames.push_back(Frame::Features);
+                            }
+                            else if (key == "bbox") {
+                                return begin_bounding_box(collection_bbox, is_array, ec);
+                            }
+                            else {
+                                // foreign members of the collection are not kept
+                                frames.push_back(Frame::Skip);
+                            }
+                            return true;
+
+                        case Frame::Features:
+                            if (is_array) {
+                                return fail(ec, "expected '{'");
+                            }
+                            frames.push_back(Frame::Feature);
+                            return true;
+
+                        case Frame::Feature:
+                            return begin_feature_member(is_array, ec);
+
+                        case Frame::Properties:
+                            begin_property(key, is_array);
+                            return true;
+
+                        case Frame::Property:
+                            begin_property(property_stack.back().is_array ? property_stack.back().key : key, is_array);
+                            return true;
+
+                        case Frame::Geometry:
+                            if (key == "coordinates") {
+                                if (!is_array) {
+                                    return fail(ec, "expected '['");
+                                }
+                                geometries.back().begin = coordinates.size();
+                                coordinates.push_back({CoordinateToken::Open, 0.0});
+                                frames.push_back(Frame::Coordinates);
+                            }
+                            else if (key == "type") {
+                                return fail(ec, "geometry type must be a string");
+                            }
+                            else {
+                                frames.push_back(Frame::Skip);
+                            }
+                            return true;
+
+                        case Frame::Geometries:
+                            if (is_array) {
+                                return fail(ec, "expected '{'");
+                            }
+                            collection_geometries.push_back(geometries.size());
+                            geometries.emplace_back();
+                            frames.push_back(Frame::Geometry);
+                            return true;
+
+                        case Frame::Coordinates:
+                            if (!is_array) {
+                                return fail(ec, "expected a number");
+                            }
+                            coordinates.push_back({CoordinateToken::Open, 0.0});
+                            frames.push_back(Frame::Coordinates);
+                            return true;
+
+                        case Frame::BoundingBox:
+                            return fail(ec, "expected a number");
+
+                        case Frame::Skip:
+                            frames.push_back(Frame::Skip);
+                            return true;
+                    }
+                    return true;
+                }
+
+                bool begin_feature_member(bool is_array, error_code& ec) {
+                    if (key == "geometry" || key == "geometries") {
+                        if (is_array != (key == "geometries")) {
+                            return fail(ec, key == "geometry" ? "expected '{'" : "expected '['");
+                        }
+                        if (feature_not_wanted()) {
+                            frames.push_back(Frame::Skip);
+                        }
+                        else if (is_array) {
+                            has_geometries = true;
+                            collection_geometries.clear();
+                            frames.push_back(Frame::Geometries);
+                        }
+                        else {
+                            main_geometry = geometries.size();
+                            geometries.emplace_back();
+                            frames.push_back(Frame::Geometry);
+                        }
+                    }
+                    else if (key == "id") {
+                        id.clear();
+                        frames.push_back(Frame::Skip);
+                    }
+                    else if (key == "bbox") {
+                        return begin_bounding_box(bounding_box, is_array, ec);
+                    }
+                    else if (key == "properties") {
+                        frames.push_back(is_array || feature_not_wanted() ? Frame::Skip : Frame::Properties);
+                    }
+                    else if (feature_not_wanted()) {
+                        frames.push_back(Frame::Skip);
+                    }
+                    else {
+                        begin_property(key, is_array);
+                    }
+                    return true;
+                }
+
+                bool begin_bounding_box(std::vector<double>& values, bool is_array, error_code& ec) {
+                    if (!is_array) {
+                        return fail(ec, "expected '['");
+                    }
+                    values.clear();
+                    bbox_values = &values;
+                    frames.push_back(Frame::BoundingBox);
+                    return true;
+                }
+
+                void begin_property(const std::string& property_key, bool is_array) {
+                    property_stack.push_back(PropertyBuilder{property_key, is_array, {}, {}});
+                    frames.push_back(Frame::Property);
+                }
+
+                //! Add a complete property to the object or array holding it
+                void add_property(const std::string& property_key, JSONProperty property) {
+                    if (frames.back() == Frame::Property) {
+                        PropertyBuilder& parent = property_stack.back();
+                        if (parent.is_array) {
+                            parent.elements.push_back(std::move(property));
+                        }
+                        else {
+                            parent.members.emplace(property_key, std::move(property));
+                        }
+                    }
+                    else if (frames.back() == Frame::Properties) {
+                        properties.emplace(property_key, std::move(property));
+                    }
+                    else {
+                        foreign_members.emplace(property_key, std::move(property));
+                    }
+                }
+
+                bool end_container(error_code& ec) {
+                    const Frame frame = frames.back();
+                    frames.pop_back();
+
+                    if (frame == Frame::Coordinates) {
+                        coordinates.push_back({CoordinateToken::Close, 0.0});
+                        if (frames.back() == Frame::Geometry) {
+                            geometries.back().end = coordinates.size();
+                            geometries.back().has_coordinates = true;
+                        }
+                    }
+                    else if (frame == Frame::Property) {
+                        PropertyBuilder builder = std::move(property_stack.back());
+                        property_stack.pop_back();
+                        // property trees can not tell empty objects or arrays from empty strings
+                        if (builder.is_array ? builder.elements.empty() : builder.members.empty()) {
+                            add_property(builder.key, JSONProperty(builder.key, boost::property_tree::ptree()));
+                        }
+                        else if (builder.is_array) {
+                            add_property(builder.key, JSONProperty(builder.key, std::move(builder.elements)));
+                        }
+                        else {
+                            add_property(builder.key, JSONProperty(builder.key, builder.members));
+                        }
+                    }
+                    else if (frame == Frame::Feature) {
+                        return end_feature(ec);
+                    }
+                    return true;
+                }
+
+                bool scalar(Scalar kind, double number, error_code& ec) {
+                    bool ok = true;
+                    if (frames.empty()) {
+                        ok = fail(ec, "expected '{'");
+                    }
+                    else {
+                        switch (frames.back()) {
+                            case Frame::Feature:
+                                if (key == "id") {
+                                    id = text;
+                                }
+                                else if (key == "geometry" && kind == Scalar::Null) {
+                                    // a null geometry leaves the feature without one
+                                    main_geometry = NO_GEOMETRY;
+                                }
+                                else if (key == "geometry" || key == "geometries") {
+                                    ok = fail(ec, key == "geometry" ? "expected '{'" : "expected '['");
+                                }
+                                else if (key == "bbox") {
+                                    ok = fail(ec, "expected '['");
+                                }
+                                else if (key != "properties" && !feature_not_wanted()) {
+                                    // scalars go through the property tree leaf conversion so their types are inferred identically
+                                    add_property(key, JSONProperty(key, boost::property_tree::ptree(text)));
+                                }
+                                break;
+
+                            case Frame::Properties:
+                                add_property(key, JSONProperty(key, boost::property_tree::ptree(text)));
+                                break;
+
+                            case Frame::Property: {
+                                const std::string& property_key = property_stack.back().is_array ? property_stack.back().key : key;
+                                add_property(property_key, JSONProperty(property_key, boost::property_tree::ptree(text)));
+                                break;
+                            }
+
+                            case Frame::Geometry:
+                                if (key == "type") {
+                                    geometries.back().type = text;
+                                }
+                                else if (key == "coordinates") {
+                                    ok = fail(ec, "expected '['");
+                                }
+                                break;
+
+                            case Frame::Coordinates:
+                            case Frame::BoundingBox:
+                                ok = add_number(kind, number, ec);
+                                break;
+
+                            case Frame::Features:
+                            case Frame::Geometries:
+                                ok = fail(ec, "expected '{'");
+                                break;
+
+                            case Frame::Collection:
+                                if (key == "bbox") {
+                                    ok = fail(ec, "expected '['");
+                                }
+                                break;
+
+                            case Frame::Skip:
+                                break;
+                        }
+                    }
+                    text.clear();
+                    return ok;
+                }
+
+                bool add_number(Scalar kind, double number, error_code& ec) {
+                    if (kind == Scalar::String) {
+                        // the property tree path accepts numbers written as strings, so this does too
+                        try {
+                            number = std::stod(text);
+                        }
+                        catch (const std::exception&) {
+                            return fail(ec, "invalid number '" + text + "'");
+                        }
+                    }
+                    else if (kind != Scalar::Number) {
+                        return fail(ec, "expected a number");
+                    }
+
+                    if (frames.back() == Frame::Coordinates) {
+                        coordinates.push_back({CoordinateToken::Number, number});
+                    }
+                    else {
+                        bbox_values->push_back(number);
+                    }
+                    return true;
+                }
+
+                bool end_feature(error_code& ec) {
+                    // As in build_collection, the input files set the id under the properties rather than on the feature
+                    if (id.empty()) {
+                        auto id_property = properties.find("id");
+                        if (id_property != properties.end()) {
+                            id = id_property->second.as_string();
+                        }
+                    }
+
+                    bool ok = true;
+                    if (wanted.empty() || wanted.find(id) != wanted.end()) {
+                        FeatureType type = FeatureType::None;
+                        geometry geometry_object;
+                        std::vector<geometry> geometry_collection;
+                        try {
+                            for (std::size_t g : collection_geometries) {
+                                FeatureType ignored;
+                                geometry_collection.push_back(to_geometry(geometries[g], coordinates, ignored));
+                            }
+                            if (main_geometry != NO_GEOMETRY) {
+                                geometry_object = to_geometry(geometries[main_geometry], coordinates, type);
+                            }
+                            if (has_geometries) {
+                                type = FeatureType::GeometryCollection;
+                            }
+                            features.push_back(make_feature(type, geometry_object, geometry_collection, id, properties,
+                                                            bounding_box, foreign_members));
+                        }
+                        catch (const std::runtime_error& e) {
+                            ok = fail(ec, e.what());
+                        }
+                    }
+
+                    id.clear();
+                    bounding_box.clear();
+                    properties = PropertyMap();
+                    foreign_members = PropertyMap();
+                    coordinates.clear();
+                    geometries.clear();
+                    collection_geometries.clear();
+                    main_geometry = NO_GEOMETRY;
+                    has_geometries = false;
+                    return ok;
+                }
+
+                static constexpr std::size_t NO_GEOMETRY = std::numeric_limits<std::size_t>::max();
+
+                const std::unordered_set<std::string> wanted;
+                std::string error_message;
+                std::vector<Frame> frames;
+
+                //! The text of the string or number being read
+                std::string text;
+                //! The name of the last object member read
+                std::string key;
+
+                std::vector<Feature> features;
+                std::vector<double> collection_bbox;
+                //! The bounding box being read
+                std::vector<double>* bbox_values = nullptr;
+
+                // The feature being read
+                std::string id;
+                std::vector<double> bounding_box;
+                PropertyMap properties;
+                PropertyMap foreign_members;
+                std::vector<PropertyBuilder> property_stack;
+                std::vector<CoordinateToken> coordinates;
+                std::vector<PendingGeometry> geometries;
+                std::vector<std::size_t> collection_geometries;
+                std::size_t main_geometry = NO_GEOMETRY;
+                bool has_geometries = false;
+        };
+    }
+
+    GeoJSON read_streaming(std::istream &data, const std::vector<std::string> &ids) {
+        boost::json::parse_options options;
+        // coordinates are read to the nearest double, as the property tree path reads them
+        options.numbers = boost::json::number_precision::precise;
+        options.max_depth = std::numeric_limits<std::size_t>::max();
+        boost::json::basic_parser<CollectionHandler> parser(options, ids);
+
+        std::vector<char> buffer(1 << 16);
+        std::size_t offset = 0;
+        bool more = true;
+        while (more) {
+            data.read(buffer.data(), buffer.size());
+            const auto length = static_cast<std::size_t>(data.gcount());
+            more = static_cast<bool>(data);
+
+            error_code ec;
+            offset += parser.write_some(more, buffer.data(), length, ec);
+            if (ec) {
+                parse_error(offset, parser.handler().error().empty() ? ec.message() : parser.handler().error());
+            }
+        }
+
+        CollectionHandler& handler = parser.handler();
+        GeoJSON collection = std::make_shared<FeatureCollection>(
+            FeatureCollection(std::move(handler.get_features()), std::move(handler.get_bounding_box())));
+
+        for (const Feature& feature : *collection) {
+            if (feature->get_id() != "") {
+                collection->add_feature_id(feature->get_id(), feature);
+            }
+        }
+
+        return collection;
+    }
+
+    GeoJSON read_streaming(const std::string &file_path, const std::vector<std::string> &ids) {
+        std::ifstream file(file_path, std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Could not open GeoJSON file " + file_path);
+        }
+        return read_streaming(file, ids);
+    }
+}
@@ -16,9 +16,20 @@ geojson::Feature ngen::geopackage::build_feature(
   const std::string& geom_col
 )
 {
-    std::vector<double> bounding_box(4);
     std::string id                   = row.get<std::string>(id_col);
     geojson::PropertyMap properties  = build_properties(row, geom_col);
+
+    // The geometry column was not selected, so build a feature without geometry
+    if (row.find(geom_col) < 0) {
+        return std::make_shared<geojson::CollectionFeature>(
+            std::vector<geojson::geometry>{},
+            id,
+            properties,
+            std::vector<double>{}
+        );
+    }
+
+    std::vector<double> bounding_box(4);
     geojson::geometry geometry       = build_geometry(row, geom_col, bounding_box);
 
     // Convert variant type (0-based) to FeatureType
@@ -3,6 +3,25 @@
 #include "wkb.hpp"
 #include "proj.hpp"
 
+#include <memory>
+#include <unordered_map>
+
+// Building a transformation parses both projection definitions, so
+// keep one per SRS instead of building one for every feature.
+const bg::srs::transformation<>& wgs84_transformation(uint32_t srs_id)
+{
+    static thread_local std::unordered_map<uint32_t, std::unique_ptr<const bg::srs::transformation<>>> cache;
+
+    auto& prj = cache[srs_id];
+    if (prj == nullptr) {
+        prj = std::make_unique<const bg::srs::transformation<>>(
+            ngen::srs::epsg::get(srs_id),
+            ngen::srs::epsg::get(ngen::srs::epsg::wgs84)
+        );
+    }
+    return *prj;
+}
+
 geojson::geometry ngen::geopackage::build_geometry(
     const ngen::sqlite::database::iterator& row,
     const std::string& geom_col,
@@ -27,8 +46,7 @@ geojson::geometry ngen::geopackage::build_geometry(
     uint32_t srs_id = 0;
     utils::copy_from(geometry_blob, index, srs_id, endian);
     
-    const auto epsg = ngen::srs::epsg::get(srs_id);
-    const bg::srs::transformation<> prj{epsg, ngen::srs::epsg::get(ngen::srs::epsg::wgs84)};
+    const bg::srs::transformation<>& prj = wgs84_transformation(srs_id);
     wkb::wgs84 pvisitor{srs_id, prj};
     
     if (indicator > 0 && indicator < 5) {
@@ -232,5 +232,60 @@ auto database::query(
     return iterator{stmt_t{stmt}};
 }
 
+void database::execute(const std::string& statement)
+{
+    char* errmsg = nullptr;
+    const int code = sqlite3_exec(connection(), statement.c_str(), nullptr, nullptr, &errmsg);
+    if (code != SQLITE_OK) {
+        const std::string msg = errmsg == nullptr ? "" : errmsg;
+        sqlite3_free(errmsg);
+        throw sqlite_error{"sqlite3_exec", code, msg};
+    }
+}
+
+void database::execute_each(
+    const std::string& statement,
+    const boost::span<const std::string> values
+)
+{
+    sqlite3_stmt* raw = nullptr;
+    const int code = sqlite3_prepare_v2(
+        connection(),
+        statement.c_str(),
+        statement.length() + 1,
+        &raw,
+        nullptr
+    );
+
+    if (code != SQLITE_OK) {
+        throw sqlite_error{"sqlite3_prepare_v2", code};
+    }
+
+    const stmt_t stmt{raw};
+
+    // One transaction for all executions, rather than one per statement
+    execute("BEGIN");
+    try {
+        for (const auto& value : values) {
+            int step_code = sqlite3_bind_text(raw, 1, value.c_str(), -1, SQLITE_TRANSIENT);
+            if (step_code != SQLITE_OK) {
+                throw sqlite_error{"sqlite3_bind_text", step_code};
+            }
+
+            step_code = sqlite3_step(raw);
+            if (step_code != SQLITE_DONE) {
+                throw sqlite_error{"sqlite3_step", step_code};
+            }
+
+            sqlite3_reset(raw);
+        }
+    }
+    catch (...) {
+        execute("ROLLBACK");
+        throw;
+    }
+    execute("COMMIT");
+}
+
 } // namespace sqlite
 } // namespace ngen
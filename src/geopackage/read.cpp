@@ -1,8 +1,11 @@
 #include "geopackage.hpp"
 
+#include <algorithm>
 #include <numeric>
 #include <regex>
 
+#include <boost/algorithm/string/replace.hpp>
+
 void check_table_name(const std::string& table)
 {
     if (boost::algorithm::starts_with(table, "sqlite_")) {
@@ -18,7 +21,8 @@ void check_table_name(const std::string& table)
 std::shared_ptr<geojson::FeatureCollection> ngen::geopackage::read(
     const std::string& gpkg_path,
     const std::string& layer = "",
-    const std::vector<std::string>& ids = {}
+    const std::vector<std::string>& ids = {},
+    const read_options& options
 )
 {
     // Check for malicious/invalid layer input
@@ -64,50 +68,55 @@ std::shared_ptr<geojson::FeatureCollection> ngen::geopackage::read(
 
     // Layer exists, getting statement for it
     //
-    // this creates a string in the form:
-    //     WHERE id IN (?, ?, ?, ...)
-    // so that it can be bound by SQLite.
-    // This is safer than trying to concatenate
-    // the IDs together.
-    std::string joined_ids = "";
-    if (!ids.empty()) {
-        joined_ids = " WHERE "+id_column+" IN (?";
-        for (size_t i = 1; i < ids.size(); i++) {
-            joined_ids += ", ?";
-        }
-        joined_ids += ")";
-    }
-
-    // Get number of features
-    auto query_get_layer_count = db.query("SELECT COUNT(*) FROM " + layer + joined_ids, ids);
-    query_get_layer_count.next();
-    const int layer_feature_count = query_get_layer_count.get<int>(0);
-
-    #ifndef NGEN_QUIET
-    // output debug info on what is read exactly
-    std::cout << "Reading " << layer_feature_count << " features from layer " << layer << " using ID column `"<< id_column << "`";
+    // A subset of IDs is loaded into an indexed temporary table
+    // rather than bound as one parameter per ID, which would
+    // exceed SQLite's bound parameter limit for large subsets.
+    // The layer is then filtered against it in a single pass:
+    //     WHERE id IN (SELECT id FROM temp.ngen_subset_ids)
+    std::string subset_filter = "";
     if (!ids.empty()) {
-        std::cout << " (id subset:";
-        for (auto& id : ids) {
-            std::cout << " " << id;
-        }
-        std::cout << ")";
+        db.execute("CREATE TEMP TABLE ngen_subset_ids (id TEXT PRIMARY KEY) WITHOUT ROWID");
+        db.execute_each("INSERT OR IGNORE INTO temp.ngen_subset_ids (id) VALUES (?)", ids);
+        subset_filter = " WHERE " + id_column + " IN (SELECT id FROM temp.ngen_subset_ids)";
     }
-    std::cout << std::endl;
-    #endif
 
     // Get layer feature metadata (geometry column name + type)
     auto query_get_layer_geom_meta = db.query("SELECT column_name FROM gpkg_geometry_columns WHERE table_name = ?", layer);
     query_get_layer_geom_meta.next();
     const std::string layer_geometry_column = query_get_layer_geom_meta.get<std::string>(0);
 
+    // Select only the requested columns, if any were requested, so that
+    // unused attributes and geometry blobs are never read from the file
+    std::string selected_columns = "*";
+    if (!options.columns.empty() || !options.geometry) {
+        selected_columns = "";
+        auto query_get_layer_columns = db.query("PRAGMA table_info(" + layer + ")");
+        query_get_layer_columns.next();
+        while (!query_get_layer_columns.done()) {
+            const std::string column = query_get_layer_columns.get<std::string>("name");
+            query_get_layer_columns.next();
+
+            const bool requested = column == id_column
+              || (column == layer_geometry_column
+                    ? options.geometry
+                    : options.columns.empty() || std::find(options.columns.begin(), options.columns.end(), column) != options.columns.end());
+            if (!requested) {
+                continue;
+            }
+
+            // Column names come from the schema, but may still need quoting
+            selected_columns += selected_columns.empty() ? "\"" : ", \"";
+            selected_columns += boost::algorithm::replace_all_copy(column, "\"", "\"\"") + "\"";
+        }
+    }
+
     // Get layer
-    auto query_get_layer = db.query("SELECT * FROM " + layer + joined_ids, ids);
+    auto query_get_layer = db.query("SELECT " + selected_columns + " FROM " + layer + subset_filter);
     query_get_layer.next();
 
     // build features out of layer query
     std::vector<geojson::Feature> features;
-    features.reserve(layer_feature_count);
+    features.reserve(ids.size());
     while(!query_get_layer.done()) {
         geojson::Feature feature = build_feature(
             query_get_layer,
@@ -119,6 +128,26 @@ std::shared_ptr<geojson::FeatureCollection> ngen::geopackage::read(
         query_get_layer.next();
     }
 
+    #ifndef NGEN_QUIET
+    // output debug info on what is read exactly
+    std::cout << "Read " << features.size() << " features from layer " << layer << " using ID column `"<< id_column << "`";
+    if (!ids.empty()) {
+        std::cout << " (id subset:";
+        for (auto& id : ids) {
+            std::cout << " " << id;
+        }
+        std::cout << ")";
+    }
+    std::cout << std::endl;
+    #endif
+
+    // without geometry, there is nothing to bound
+    if (!options.geometry) {
+        auto fc = std::make_shared<geojson::FeatureCollection>(std::move(features), std::vector<double>{});
+        fc->update_ids();
+        return fc;
+    }
+
     // get layer bounding box from features
     //
     // GeoPackage contains a bounding box in the SQLite DB,
@@ -171,6 +171,41 @@ double* UnitsHelper::convert_values(const std::string &in_units, double* in_valu
     return out_values;
 }
 
+UnitsHelper::unit_converter UnitsHelper::get_unit_converter(const std::string &in_units, const std::string &out_units)
+{
+    std::string in_norm = in_units;
+    std::string out_norm = out_units;
+    normalize_units(in_norm, out_norm);
+
+    unit_converter resolved;
+    if (short_circuit_conversion(in_norm, out_norm)) {
+        return resolved;
+    }
+
+    std::call_once(unit_system_inited, init_unit_system);
+    resolved.converter = get_converter(in_norm, out_norm);
+    return resolved;
+}
+
+double UnitsHelper::unit_converter::convert(double value) const
+{
+    if (converter == nullptr) {
+        return value;
+    }
+    return cv_convert_double(static_cast<const cv_converter*>(converter.get()), value);
+}
+
+void UnitsHelper::unit_converter::convert(const double* in_values, double* out_values, std::size_t count) const
+{
+    if (converter == nullptr) {
+        if (in_values != out_values) {
+            std::memcpy(out_values, in_values, sizeof(double)*count);
+        }
+        return;
+    }
+    cv_convert_doubles(static_cast<const cv_converter*>(converter.get()), in_values, count, out_values);
+}
+
 static std::mutex errors_mutex;
 std::set<UnitsHelper::unit_error_log_key> UnitsHelper::unit_errors_reported;
 
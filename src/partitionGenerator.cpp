@@ -13,15 +13,19 @@
 #include <boost/algorithm/string.hpp>
 #include <vector>
 #include <unordered_set>
+#include <unordered_map>
 #include <tuple>
+#include <algorithm>
+#include <cmath>
 
 #if NGEN_WITH_SQLITE3
 #include <geopackage.hpp>
 #endif
 
 #include "core/Partition_Parser.hpp"
+#include "core/Partition_Index.hpp"
+#include "core/Partition_Generator.hpp"
 
-using PartitionVSet = std::vector<std::unordered_set<std::string> >;
 /**
  * @brief A tuple representing a remote connection
  * 
@@ -37,6 +41,21 @@ using PartitionVSet = std::vector<std::unordered_set<std::string> >;
 using RemoteConnection = std::tuple<int, std::string, std::string, std::string>;
 using RemoteConnectionVec = std::vector< RemoteConnection >;
 
+/**
+ * @brief Optional partitioning settings given after the required arguments
+ */
+struct PartitionOptions
+{
+    //! "preorder" splits the depth first catchment list into equal counts, "topology" minimizes the edge cut
+    std::string method = "preorder";
+    //! Optional CSV of per-catchment weights, used by the "topology" method
+    std::string weights_file;
+    //! Allowed deviation of a partition's weight from the mean, as a fraction, used by the "topology" method
+    double imbalance = 0.05;
+    //! "json" for the JSON partition config, "index" for the line-indexed format each rank can read in part
+    std::string format = "json";
+};
+
 /**
  * @brief Write the partition details to the @p outFile
  * 
@@ -138,19 +157,7 @@ void generate_partitions(network::Network& network, const int& num_partitions, P
             else
                 partition_size = partition_size_norm;
 
-            //Find all associated nexuses and add to nexus list
-            //Some of these will end up being "remote" but still must be present in the
-            //list of all required nexus the partition needs to worry about
-            for( auto downstream : network.get_destination_ids(catchment) ){
-                nexus_set.emplace(downstream);
-            }
-            if(nexus_set.size() == 0 && catchment.find("SENTINEL") == std::string::npos){
-                std::cerr<<"Error: Catchment "<<catchment<<" has no destination nexus.\n";
-                exit(1);
-            }
-            for( auto upstream : network.get_origination_ids(catchment) ){
-                nexus_set.emplace(upstream);
-            }
+            add_catchment_nexuses(network, catchment, nexus_set);
             //std::cout<<catchment<<" -> "<<nexus<<std::endl;
 
             //keep track of all the features in this partition
@@ -176,30 +183,7 @@ void generate_partitions(network::Network& network, const int& num_partitions, P
             }
     }
 
-    // validating catchment partition
-    std::cout << "Validating catchments..." << std::endl;
-    std::vector<std::string> cat_id_vec;
-    for (int i =0; i < catchment_part.size(); ++i) {
-        std::unordered_set<std::string>& cat_set = catchment_part[i];
-        // convert unordered_set to vector
-        for (const auto &it: cat_set) {
-            cat_id_vec.push_back(it);
-        }
-    }
-    //sort ids
-    std::sort(cat_id_vec.begin(), cat_id_vec.end());
-    //create set of unique ids
-    std::set<std::string> unique(cat_id_vec.begin(), cat_id_vec.end());
-    std::set<std::string> duplicates;
-    //use set difference to identify all duplicates
-    std::set_difference(cat_id_vec.begin(), cat_id_vec.end(), unique.begin(), unique.end(), std::inserter(duplicates, duplicates.end()));
-    if( duplicates.size() > 0 ){
-        for( auto& id: duplicates){
-            std::cout << "catchment "<<id<<" is duplicated!"<<std::endl;
-        }
-    }
-    std::cout << "\nNumber of catchments is: " << cat_id_vec.size();
-    std::cout << "\nCatchment validation completed" << std::endl;
+    validate_partitions(catchment_part);
 }
 
 /**
@@ -339,13 +323,17 @@ void read_arguments(int argc, char* argv[],
                     std::string& partitionOutFile,
                     int& numPartitions,
                     std::vector<std::string>& catchment_subset_ids,
-                    std::vector<std::string>& nexus_subset_ids)
+                    std::vector<std::string>& nexus_subset_ids,
+                    PartitionOptions& options)
 {
     if( argc < 7 ){
         std::cout << "Missing required args:" << std::endl;
-        std::cout << argv[0] << " <catchment_data_path> <nexus_data_path> <partition_output_name> <number of partitions> <catchment_subset_ids> <nexus_subset_ids> " << std::endl;
+        std::cout << argv[0] << " <catchment_data_path> <nexus_data_path> <partition_output_name> <number of partitions> <catchment_subset_ids> <nexus_subset_ids> "
+                  << "[--method=preorder|topology] [--weights=<weights_csv>] [--imbalance=<fraction>] [--format=json|index]" << std::endl;
         std::cout << "Use empty strings for subset_ids for no subsetting, e.g ''\nUse \'cat-X,cat-Y\', \'nex-X,nex-Y\' to partition only the defined catchment and nexus"<<std::endl;
         std::cout << "Note the use of single quotes, and no spaces between the ids.  (no quotes will also work, but  \"\" will not."<<std::endl;
+        std::cout << "--method=topology splits the network to minimize remote nexuses, balancing optional per-catchment weights (CSV of id,weight) to within --imbalance (default 0.05)."<<std::endl;
+        std::cout << "--format=index writes a line-indexed partition file from which each rank reads only its own partition."<<std::endl;
         exit(-1);
     }
 
@@ -372,7 +360,7 @@ void read_arguments(int argc, char* argv[],
 
     try {
         numPartitions = boost::lexical_cast<int>(argv[4]);
-        if (numPartitions < 0) throw boost::bad_lexical_cast();
+        if (numPartitions < 1) throw boost::bad_lexical_cast();
     }
     catch(boost::bad_lexical_cast &e) {
         std::cout << "number of partitions must be a positive integer." << std::endl;
@@ -392,6 +380,46 @@ void read_arguments(int argc, char* argv[],
         nexus_subset_ids.pop_back();
     }
 
+    //optional --key=value arguments
+    for (int i = 7; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (boost::algorithm::starts_with(arg, "--method=")) {
+            options.method = arg.substr(9);
+            if (options.method != "preorder" && options.method != "topology") {
+                std::cout << "partitioning method must be 'preorder' or 'topology'." << std::endl;
+                error = true;
+            }
+        }
+        else if (boost::algorithm::starts_with(arg, "--weights=")) {
+            options.weights_file = arg.substr(10);
+            if( !utils::FileChecker::file_is_readable(options.weights_file) ) {
+                std::cout << "catchment weights path " << options.weights_file << " not readable" << std::endl;
+                error = true;
+            }
+        }
+        else if (boost::algorithm::starts_with(arg, "--imbalance=")) {
+            try {
+                options.imbalance = boost::lexical_cast<double>(arg.substr(12));
+                if (options.imbalance < 0) throw boost::bad_lexical_cast();
+            }
+            catch(boost::bad_lexical_cast &e) {
+                std::cout << "imbalance must be a non-negative fraction, e.g. 0.05." << std::endl;
+                error = true;
+            }
+        }
+        else if (boost::algorithm::starts_with(arg, "--format=")) {
+            options.format = arg.substr(9);
+            if (options.format != "json" && options.format != "index") {
+                std::cout << "partition file format must be 'json' or 'index'." << std::endl;
+                error = true;
+            }
+        }
+        else {
+            std::cout << "unrecognized argument " << arg << std::endl;
+            error = true;
+        }
+    }
+
     if (error) exit(-1);
 }
 
@@ -403,21 +431,35 @@ int main(int argc, char* argv[])
     std::vector<std::string> catchment_subset_ids;
     std::vector<std::string> nexus_subset_ids;
     int num_partitions = 0;
+    PartitionOptions options;
 
     read_arguments(argc, argv,
                    catchmentDataFile, nexusDataFile, partitionOutFile,
                    num_partitions,
-                   catchment_subset_ids, nexus_subset_ids);
+                   catchment_subset_ids, nexus_subset_ids,
+                   options);
+
+    CatchmentWeights weights;
+    if (!options.weights_file.empty()) {
+        weights = read_catchment_weights(options.weights_file);
+    }
 
     std::ofstream outFile;
-    outFile.open(partitionOutFile, std::ios::trunc);
+    outFile.open(partitionOutFile, std::ios::trunc | std::ios::binary);
+
+    #if NGEN_WITH_SQLITE3
+    // Partitioning only needs the ids and the links between features
+    ngen::geopackage::read_options gpkg_options;
+    gpkg_options.columns = {"id", "toid", "layer"};
+    gpkg_options.geometry = false;
+    #endif
 
     //Get the feature collection for the given hydrofabric
     geojson::GeoJSON catchment_collection;
     if (boost::algorithm::ends_with(catchmentDataFile, "gpkg"))
     {
         #if NGEN_WITH_SQLITE3
-        catchment_collection = ngen::geopackage::read(catchmentDataFile, "divides", catchment_subset_ids);
+        catchment_collection = ngen::geopackage::read(catchmentDataFile, "divides", catchment_subset_ids, gpkg_options);
         #else
         throw std::runtime_error("SQLite3 support required to read GeoPackage files.");
         #endif
@@ -446,7 +488,7 @@ int main(int argc, char* argv[])
     if (boost::algorithm::ends_with(nexusDataFile, "gpkg")) 
     {
       #if NGEN_WITH_SQLITE3
-      global_nexus_collection = ngen::geopackage::read(nexusDataFile, "nexus", nexus_subset_ids);
+      global_nexus_collection = ngen::geopackage::read(nexusDataFile, "nexus", nexus_subset_ids, gpkg_options);
       #else
       throw std::runtime_error("SQLite3 support required to read GeoPackage files.");
       #endif
@@ -510,7 +552,18 @@ int main(int argc, char* argv[])
     Network global_network(global_nexus_collection);
 
     //Generate the partitioning
-    generate_partitions(global_network, num_partitions, catchment_part, nexus_part);
+    if (options.method == "topology") {
+        generate_topology_partitions(global_network, num_partitions, weights, options.imbalance, catchment_part, nexus_part);
+    }
+    else {
+        generate_partitions(global_network, num_partitions, catchment_part, nexus_part);
+    }
+
+    PartitionQuality quality = evaluate_partitions(global_network, catchment_part, weights);
+    std::cout << "Partitioned with method '" << options.method << "': edge cut of " << quality.cut_edges
+              << " catchment links across " << quality.boundary_nexuses << " boundary nexuses, load imbalance of "
+              << quality.imbalance() * 100.0 << "% (max partition weight " << quality.max_weight
+              << ", mean " << quality.mean_weight << ")" << std::endl;
 
     //global_network.print_network();
 
@@ -567,7 +620,19 @@ int main(int argc, char* argv[])
     }
     std::cout << "Found " << total_remotes << " total remotes (average of approximately " << (total_remotes/num_partitions) << " remotes per partition)" << std::endl;
 
-    write_remote_connections(catchment_part, nexus_part, remote_connections_vec, num_partitions, outFile);
+    if (options.format == "index") {
+        std::vector<PartitionData> partitions(catchment_part.size());
+        for (int ipart = 0; ipart < catchment_part.size(); ++ipart) {
+            partitions[ipart].mpi_world_rank = ipart;
+            partitions[ipart].catchment_ids = std::move(catchment_part[ipart]);
+            partitions[ipart].nexus_ids = std::move(nexus_part[ipart]);
+            partitions[ipart].remote_connections = std::move(remote_connections_vec[ipart]);
+        }
+        Partition_Index::write(outFile, partitions);
+    }
+    else {
+        write_remote_connections(catchment_part, nexus_part, remote_connections_vec, num_partitions, outFile);
+    }
 
     outFile.close();
         
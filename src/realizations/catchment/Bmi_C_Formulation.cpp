@@ -1,7 +1,37 @@
 #include "Bmi_C_Formulation.hpp"
+#include "Bmi_Vector_Model.hpp"
+#include "utilities/logging_utils.h"
+
 using namespace realization;
 using namespace models::bmi;
 
+namespace {
+
+    /**
+     * Catchments of one layer whose C formulations share a model instance holding all of them.
+     */
+    class Bmi_C_Formulation_Group : public Formulation_Group {
+        public:
+            Bmi_C_Formulation_Group(std::shared_ptr<Bmi_Vector_Model> shared_model,
+                                    std::vector<Bmi_C_Formulation*> members)
+                : shared_model(std::move(shared_model)), members(std::move(members)) { }
+
+            void update_member(std::size_t member, time_step_t t_index, time_step_t t_delta) override {
+                // The member's model is a slot of the shared model, so this stages its inputs and queues its update
+                members[member]->update(t_index, t_delta);
+            }
+
+            void update() override {
+                shared_model->update();
+            }
+
+        private:
+            std::shared_ptr<Bmi_Vector_Model> shared_model;
+            std::vector<Bmi_C_Formulation*> members;
+    };
+
+}
+
 Bmi_C_Formulation::Bmi_C_Formulation(std::string id, std::shared_ptr<data_access::GenericDataProvider> forcing_provider, utils::StreamHandler output_stream)
     : Bmi_Module_Formulation(id, forcing_provider, output_stream) { }
 
@@ -24,52 +54,129 @@ std::shared_ptr<Bmi_Adapter> Bmi_C_Formulation::construct_model(const geojson::P
     auto reg_func_itr = properties.find(BMI_REALIZATION_CFG_PARAM_OPT__REGISTRATION_FUNC);
     std::string reg_func =
             reg_func_itr == properties.end() ? BMI_C_DEFAULT_REGISTRATION_FUNC : reg_func_itr->second.as_string();
-    return std::make_shared<Bmi_C_Adapter>(
+    auto model = std::make_shared<Bmi_C_Adapter>(
                     get_model_type_name(),
                     lib_file,
                     get_bmi_init_config(),
                     is_bmi_model_time_step_fixed(),
                     reg_func);
+    // Holding several catchments in one model is opted in to by configuring the library's vector registration function
+    auto vector_reg_func_itr = properties.find(BMI_REALIZATION_CFG_PARAM_OPT__VECTOR_REGISTRATION_FUNC);
+    if (vector_reg_func_itr != properties.end()) {
+        std::string vector_reg_func = vector_reg_func_itr->second.as_string();
+        if (!model->exports_symbol(vector_reg_func)) {
+            throw std::runtime_error("BMI C formulation configured with vector registration function '" +
+                                     vector_reg_func + "', but library " + lib_file + " does not export it");
+        }
+        library_file = lib_file;
+        registration_function = reg_func;
+        vector_registration_function = vector_reg_func;
+        shared_model_properties = properties;
+    }
+    return model;
+}
+
+std::string Bmi_C_Formulation::get_group_key() const {
+    if (vector_registration_function.empty()) {
+        return {};
+    }
+    return library_file + '\n' + registration_function + '\n' + vector_registration_function + '\n' +
+           get_model_type_name() + '\n' + (is_bmi_model_time_step_fixed() ? "fixed" : "variable");
+}
+
+std::shared_ptr<Formulation_Group> Bmi_C_Formulation::make_group(const std::vector<Catchment_Formulation*>& members) {
+    const std::string key = get_group_key();
+    std::vector<Bmi_C_Formulation*> formulations;
+    std::vector<std::string> init_configs;
+    formulations.reserve(members.size());
+    init_configs.reserve(members.size());
+    for (Catchment_Formulation* member : members) {
+        auto formulation = dynamic_cast<Bmi_C_Formulation*>(member);
+        if (formulation == nullptr || key.empty() || formulation->get_group_key() != key ||
+            formulation->next_time_step_index != 0) {
+            return nullptr;
+        }
+        formulations.push_back(formulation);
+        init_configs.push_back(formulation->get_bmi_init_config());
+    }
+
+    std::shared_ptr<Bmi_Vector_Model> shared_model;
+    std::vector<std::shared_ptr<Bmi_Vector_Slot_Adapter>> slots;
+    std::vector<protocols::NgenBmiProtocols> slot_protocols;
+    // Everything that can fail is done on the slots before any member is moved to them
+    try {
+        shared_model = std::make_shared<Bmi_Vector_Model>(
+                std::make_shared<Bmi_C_Adapter>(get_model_type_name(), library_file, init_configs,
+                                                is_bmi_model_time_step_fixed(), registration_function,
+                                                vector_registration_function),
+                (int) formulations.size());
+        // Each catchment's part of the shared model must look just like the model it had on its own
+        for (std::size_t i = 0; i < formulations.size(); ++i) {
+            slots.push_back(std::make_shared<Bmi_Vector_Slot_Adapter>(shared_model, (int) i, init_configs[i]));
+            const auto& own_model = formulations[i]->get_bmi_model();
+            for (const auto& names : {own_model->GetInputVarNames(), own_model->GetOutputVarNames()}) {
+                for (const std::string& name : names) {
+                    if (slots[i]->GetVarNbytes(name) != own_model->GetVarNbytes(name)) {
+                        throw std::runtime_error("variable " + name + " of catchment " + std::to_string(i) + " has " +
+                                                 std::to_string(slots[i]->GetVarNbytes(name)) + " bytes in the shared "
+                                                 "model but " + std::to_string(own_model->GetVarNbytes(name)) +
+                                                 " on its own");
+                    }
+                }
+            }
+            formulations[i]->set_shared_model_parameters(*slots[i], formulations[i]->shared_model_properties);
+            slot_protocols.emplace_back(slots[i], formulations[i]->shared_model_properties);
+        }
+    }
+    catch (const std::exception& e) {
+        logging::warning(("Not sharing one " + get_model_type_name() + " model between " +
+                          std::to_string(formulations.size()) + " catchments: " + e.what() + "\n").c_str());
+        return nullptr;
+    }
+
+    for (std::size_t i = 0; i < formulations.size(); ++i) {
+        formulations[i]->bind_shared_model(slots[i], std::move(slot_protocols[i]));
+        formulations[i]->shared_model_properties = geojson::PropertyMap();
+    }
+    return std::make_shared<Bmi_C_Formulation_Group>(std::move(shared_model), std::move(formulations));
 }
 
 double Bmi_C_Formulation::get_var_value_as_double(const int& index, const std::string& var_name) {
     // TODO: consider different way of handling (and how to document) cases like long double or unsigned long long that
     //  don't fit or might convert inappropriately
-    auto model = std::dynamic_pointer_cast<models::bmi::Bmi_C_Adapter>(get_bmi_model());
-
-    std::string type = model->GetVarType(var_name);
+    std::string type = get_bmi_model()->GetVarType(var_name);
     if (type == "long double")
-        return (double) (model->GetValuePtr<long double>(var_name))[index];
+        return get_var_value_as<double, long double>(index, var_name);
 
     if (type == "double")
-        return (double) (model->GetValuePtr<double>(var_name))[index];
+        return get_var_value_as<double, double>(index, var_name);
 
     if (type == "float")
-        return (double) (model->GetValuePtr<float>(var_name))[index];
+        return get_var_value_as<double, float>(index, var_name);
 
     if (type == "short" || type == "short int" || type == "signed short" || type == "signed short int")
-        return (double) (model->GetValuePtr<short>(var_name))[index];
+        return get_var_value_as<double, short>(index, var_name);
 
     if (type == "unsigned short" || type == "unsigned short int")
-        return (double) (model->GetValuePtr<unsigned short>(var_name))[index];
+        return get_var_value_as<double, unsigned short>(index, var_name);
 
     if (type == "int" || type == "signed" || type == "signed int")
-        return (double) (model->GetValuePtr<int>(var_name))[index];
+        return get_var_value_as<double, int>(index, var_name);
 
     if (type == "unsigned" || type == "unsigned int")
-        return (double) (model->GetValuePtr<unsigned int>(var_name))[index];
+        return get_var_value_as<double, unsigned int>(index, var_name);
 
     if (type == "long" || type == "long int" || type == "signed long" || type == "signed long int")
-        return (double) (model->GetValuePtr<long>(var_name))[index];
+        return get_var_value_as<double, long>(index, var_name);
 
     if (type == "unsigned long" || type == "unsigned long int")
-        return (double) (model->GetValuePtr<unsigned long>(var_name))[index];
+        return get_var_value_as<double, unsigned long>(index, var_name);
 
     if (type == "long long" || type == "long long int" || type == "signed long long" || type == "signed long long int")
-        return (double) (model->GetValuePtr<long long>(var_name))[index];
+        return get_var_value_as<double, long long>(index, var_name);
 
     if (type == "unsigned long long" || type == "unsigned long long int")
-        return (double) (model->GetValuePtr<unsigned long long>(var_name))[index];
+        return get_var_value_as<double, unsigned long long>(index, var_name);
 
     throw std::runtime_error("Unable to get value of variable " + var_name + " from " + get_model_type_name() +
                              " as double: no logic for converting variable type " + type);
@@ -86,5 +193,5 @@ bool Bmi_C_Formulation::is_bmi_output_variable(const std::string &var_name) cons
 }
 
 bool Bmi_C_Formulation::is_model_initialized() const {
-    return std::dynamic_pointer_cast<models::bmi::Bmi_C_Adapter>(get_bmi_model())->is_model_initialized();
+    return get_bmi_model()->is_model_initialized();
 }
@@ -9,6 +9,17 @@
 using namespace realization;
 using namespace models::bmi;
 
+namespace {
+    /**
+     * Get the value at an index of a variable of type @tparam T as a double, copying the variable's values once.
+     */
+    template<class T>
+    double value_as_double(Bmi_Adapter& model, const std::string& var_name, const int& index) {
+        std::vector<T> storage;
+        return (double) models::bmi::GetValueView<T>(model, var_name, storage)[index];
+    }
+}
+
 Bmi_Fortran_Formulation::Bmi_Fortran_Formulation(std::string id, std::shared_ptr<data_access::GenericDataProvider> forcing, utils::StreamHandler output_stream)
 : Bmi_Module_Formulation(id, forcing, output_stream) { }
 
@@ -53,38 +64,39 @@ double Bmi_Fortran_Formulation::get_var_value_as_double(const int &index, const
     std::string type = model->GetVarType(var_name);
     //Can cause a segfault here if GetValue returns an empty vector...a "fix" in bmi_utilities GetValue
     //will throw a relevant runtime_error if the vector is empty, so this is safe to use this way for now...
+    //The Fortran middleware does not implement get_value_ptr, so values are always copied, once, from the model
     if (type == "long double")
-        return (double) (models::bmi::GetValue<long double>(*model, var_name))[index];
+        return value_as_double<long double>(*model, var_name, index);
 
     if (type == "double" || type == "double precision")
-        return (double) (models::bmi::GetValue<double>(*model, var_name))[index];
+        return value_as_double<double>(*model, var_name, index);
 
     if (type == "float" || type == "real")
-        return (double) (models::bmi::GetValue<float>(*model, var_name))[index];
+        return value_as_double<float>(*model, var_name, index);
 
     if (type == "short" || type == "short int" || type == "signed short" || type == "signed short int")
-        return (double) (models::bmi::GetValue<short>(*model, var_name))[index];
+        return value_as_double<short>(*model, var_name, index);
 
     if (type == "unsigned short" || type == "unsigned short int")
-        return (double) (models::bmi::GetValue<unsigned short>(*model, var_name))[index];
+        return value_as_double<unsigned short>(*model, var_name, index);
 
     if (type == "int" || type == "signed" || type == "signed int" || type == "integer")
-        return (double) (models::bmi::GetValue<int>(*model, var_name))[index];
+        return value_as_double<int>(*model, var_name, index);
 
     if (type == "unsigned" || type == "unsigned int")
-        return (double) (models::bmi::GetValue<unsigned int>(*model, var_name))[index];
+        return value_as_double<unsigned int>(*model, var_name, index);
 
     if (type == "long" || type == "long int" || type == "signed long" || type == "signed long int")
-        return (double) (models::bmi::GetValue<long>(*model, var_name))[index];
+        return value_as_double<long>(*model, var_name, index);
 
     if (type == "unsigned long" || type == "unsigned long int")
-        return (double) (models::bmi::GetValue<unsigned long>(*model, var_name))[index];
+        return value_as_double<unsigned long>(*model, var_name, index);
 
     if (type == "long long" || type == "long long int" || type == "signed long long" || type == "signed long long int")
-        return (double) (models::bmi::GetValue<long long>(*model, var_name))[index];
+        return value_as_double<long long>(*model, var_name, index);
 
     if (type == "unsigned long long" || type == "unsigned long long int")
-        return (double) (models::bmi::GetValue<unsigned long long>(*model, var_name))[index];
+        return value_as_double<unsigned long long>(*model, var_name, index);
 
     throw std::runtime_error("Unable to get value of variable " + var_name + " from " + get_model_type_name() +
     " as double: no logic for converting variable type " + type);
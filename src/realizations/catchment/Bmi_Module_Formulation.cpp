@@ -2,9 +2,12 @@
 #include "utilities/logging_utils.h"
 #include <UnitsHelper.hpp>
 
+#include <atomic>
+
 namespace realization {
 
         std::set<Bmi_Var_Details> Bmi_Module_Formulation::known_bmi_input_vars;
+        std::mutex Bmi_Module_Formulation::known_bmi_input_vars_mutex;
 
         void Bmi_Module_Formulation::create_formulation(boost::property_tree::ptree &config, geojson::PropertyMap *global) {
             geojson::PropertyMap options = this->interpret_parameters(config, global);
@@ -25,20 +28,26 @@ namespace realization {
             if (timestep != (next_time_step_index - 1)) {
                 throw std::invalid_argument("Only current time step valid when getting output for BMI C++ formulation");
             }
-            static bool no_conversion_message_logged = false;
-            if (!no_conversion_message_logged) {
-                no_conversion_message_logged = true;
+            static std::atomic<bool> no_conversion_message_logged{false};
+            if (!no_conversion_message_logged.exchange(true)) {
                 logging::warning("Output variables do not have unit conversion. Capability not yet implemented in ngen.");
             }
 
             auto const & names = get_output_variable_names();
             std::vector<double> values;
             values.reserve(names.size());
-            // Fetch values through the unit-checked/converting get_value path; output_units is empty,
-            // so values are returned unconverted, positionally aligned with the names.
-            for (const std::string& name : names) {
-                std::string output_units = "";
-                values.push_back(get_value(CatchmentAggrDataSelector(this->get_catchment_id(), name, 0, 0, output_units), MEAN));
+            // Read values through the resolved outputs; output_units is empty, so values are returned unconverted,
+            // positionally aligned with the names.  Names that did not resolve go through get_value, which reports
+            // them as invalid.
+            static const std::string output_units = "";
+            for (std::size_t i = 0; i < names.size(); ++i) {
+                std::size_t index = i < output_column_indices.size() ? output_column_indices[i] : unresolved;
+                if (index != unresolved) {
+                    values.push_back(read_resolved_output(index, output_units));
+                }
+                else {
+                    values.push_back(get_value(CatchmentAggrDataSelector(this->get_catchment_id(), names[i], 0, 0, output_units), MEAN));
+                }
             }
             return values;
         }
@@ -87,7 +96,13 @@ namespace realization {
             update(t_index, t_delta);
             double var_value;
             try{
-                var_value = get_value(CatchmentAggrDataSelector(this->get_catchment_id(), get_bmi_main_output_var(), 0, 0, "m"),MEAN);
+                static const std::string response_units = "m";
+                if (main_output_index != unresolved) {
+                    var_value = read_resolved_output(main_output_index, response_units);
+                }
+                else {
+                    var_value = get_value(CatchmentAggrDataSelector(this->get_catchment_id(), get_bmi_main_output_var(), 0, 0, response_units),MEAN);
+                }
             }
             catch(UnitsHelper::unit_conversion_exception &uce){
                 bool new_error = UnitsHelper::record_unit_conversion_fault(uce, "Bmi_Module_Formulation::get_response", get_bmi_main_output_var());
@@ -155,12 +170,12 @@ namespace realization {
 
         std::vector<double> Bmi_Module_Formulation::get_values(const CatchmentAggrDataSelector& selector, data_access::ReSampleMethod m)
         {
-            std::string output_name = selector.get_variable_name();
-            std::string output_units = selector.get_output_units();
+            const std::string& output_name = selector.get_variable_name();
+            const std::string& output_units = selector.get_output_units();
 
             // First make sure this is an available output
-            auto forcing_outputs = get_available_variable_names();
-            if (std::find(forcing_outputs.begin(), forcing_outputs.end(), output_name) == forcing_outputs.end()) {
+            std::size_t index = find_resolved_output(output_name);
+            if (index == unresolved) {
                 throw std::runtime_error(get_formulation_type() + " received invalid output forcing name " + output_name);
             }
             // TODO: do this, or something better, later; right now, just assume anything using this as a provider is
@@ -172,44 +187,37 @@ namespace realization {
             }
             */
 
-            // check if output is available from BMI
-            std::string bmi_var_name;
-            get_bmi_output_var_name(output_name, bmi_var_name);
+            Resolved_Output& output = resolved_outputs[index];
+            auto model = get_bmi_model().get();
+            //Get vector of double values for variable
+            //The return type of the vector here dependent on what
+            //needs to use it.  For other BMI moudles, that is runtime dependent
+            //on the type of the requesting module
+            //Values are read in place where the model supports it, so are copied once, into the result
+            std::vector<double> values;
+            boost::span<const double> view = models::bmi::GetValueView<double>(*model, output.bmi_name, values);
+            if (view.data() != values.data()) {
+                values.assign(view.begin(), view.end());
+            }
 
-            if( !bmi_var_name.empty() )
-            {
-                auto model = get_bmi_model().get();
-                //Get vector of double values for variable
-                //The return type of the vector here dependent on what
-                //needs to use it.  For other BMI moudles, that is runtime dependent
-                //on the type of the requesting module
-                auto values = models::bmi::GetValue<double>(*model, bmi_var_name);
-
-                // Convert units
-                std::string native_units = get_bmi_model()->GetVarUnits(bmi_var_name);
-                try {
-                    UnitsHelper::convert_values(native_units, values.data(), output_units, values.data(), values.size());
-                    return values;
-                }
-                catch (UnitsHelper::unit_conversion_exception& uce) {
-                    uce.provider_model_name = get_bmi_model()->get_model_name();
-                    uce.provider_var_name = bmi_var_name;
-                    uce.unconverted_values = std::move(values);
-                    throw;
-                }
+            // Convert units
+            try {
+                bind_output_converter(output, output_units).convert(values.data(), values.data(), values.size());
+                return values;
+            }
+            catch (UnitsHelper::unit_conversion_exception& uce) {
+                uce.unconverted_values = std::move(values);
+                throw;
             }
-            //This is unlikely (impossible?) to throw since a pre-check on available names is done above. Assert instead?
-            throw std::runtime_error(get_formulation_type() + " received invalid output forcing name " + output_name);
         }
 
         double Bmi_Module_Formulation::get_value(const CatchmentAggrDataSelector& selector, data_access::ReSampleMethod m)
         {
-            std::string output_name = selector.get_variable_name();
-            std::string output_units = selector.get_output_units();
+            const std::string& output_name = selector.get_variable_name();
 
             // First make sure this is an available output
-            auto forcing_outputs = get_available_variable_names();
-            if (std::find(forcing_outputs.begin(), forcing_outputs.end(), output_name) == forcing_outputs.end()) {
+            std::size_t index = find_resolved_output(output_name);
+            if (index == unresolved) {
                 throw std::runtime_error(get_formulation_type() + " received invalid output forcing name " + output_name);
             }
             // TODO: do this, or something better, later; right now, just assume anything using this as a provider is
@@ -221,29 +229,78 @@ namespace realization {
             }
             */
 
-            // check if output is available from BMI
-            std::string bmi_var_name;
-            get_bmi_output_var_name(output_name, bmi_var_name);
+            return read_resolved_output(index, selector.get_output_units());
+        }
 
-            if( !bmi_var_name.empty() )
-            {
-                //Get forcing value from BMI variable
-                double value = get_var_value_as_double(0, bmi_var_name);
+        void Bmi_Module_Formulation::resolve_outputs() {
+            resolved_outputs.clear();
+            resolved_output_index.clear();
+
+            auto model = get_bmi_model();
+            std::vector<std::string> output_names = model->GetOutputVarNames();
+            resolved_outputs.reserve(output_names.size());
+            for (const std::string& output_name : output_names) {
+                Resolved_Output output;
+                output.bmi_name = output_name;
+                output.native_units = model->GetVarUnits(output_name);
+                resolved_output_index.emplace(output_name, resolved_outputs.size());
+                resolved_outputs.push_back(std::move(output));
+            }
+            // Mapped names only resolve where they are not themselves output names, as in get_bmi_output_var_name
+            for (const auto& names : bmi_var_names_map) {
+                auto output_it = resolved_output_index.find(names.first);
+                if (output_it != resolved_output_index.end()) {
+                    resolved_output_index.emplace(names.second, output_it->second);
+                }
+            }
+
+            main_output_index = find_resolved_output(get_bmi_main_output_var());
+            output_column_indices.clear();
+            for (const std::string& name : get_output_variable_names()) {
+                output_column_indices.push_back(find_resolved_output(name));
+            }
+        }
 
-                // Convert units
-                std::string native_units = get_bmi_model()->GetVarUnits(bmi_var_name);
+        std::size_t Bmi_Module_Formulation::find_resolved_output(const std::string &name) const {
+            auto it = resolved_output_index.find(name);
+            return it == resolved_output_index.end() ? unresolved : it->second;
+        }
+
+        const UnitsHelper::unit_converter& Bmi_Module_Formulation::bind_output_converter(Resolved_Output &output,
+                                                                                        const std::string &output_units) {
+            if (!output.converter_resolved || output.converted_units != output_units) {
+                output.converted_units = output_units;
+                output.converter = UnitsHelper::unit_converter();
+                output.conversion_error.reset();
                 try {
-                    return UnitsHelper::get_converted_value(native_units, value, output_units);
+                    output.converter = UnitsHelper::get_unit_converter(output.native_units, output_units);
                 }
-                catch (UnitsHelper::unit_conversion_exception& uce){
+                catch (UnitsHelper::unit_conversion_exception& uce) {
                     uce.provider_model_name = get_bmi_model()->get_model_name();
-                    uce.provider_var_name = bmi_var_name;
-                    throw;
+                    uce.provider_var_name = output.bmi_name;
+                    output.conversion_error = uce;
                 }
+                output.converter_resolved = true;
             }
+            if (output.conversion_error) {
+                throw *output.conversion_error;
+            }
+            return output.converter;
+        }
 
-            //This is unlikely (impossible?) to throw since a pre-check on available names is done above. Assert instead?
-            throw std::runtime_error(get_formulation_type() + " received invalid output forcing name " + output_name);
+        double Bmi_Module_Formulation::read_resolved_output(std::size_t index, const std::string &output_units) {
+            Resolved_Output& output = resolved_outputs[index];
+            //Get forcing value from BMI variable
+            double value = get_var_value_as_double(0, output.bmi_name);
+
+            // Convert units
+            try {
+                return bind_output_converter(output, output_units).convert(value);
+            }
+            catch (UnitsHelper::unit_conversion_exception& uce) {
+                uce.unconverted_values.assign(1, value);
+                throw;
+            }
         }
 
 
@@ -354,6 +411,11 @@ namespace realization {
                         properties.at(BMI_REALIZATION_CFG_PARAM_OPT__CACHE_INPUT_VAR_METADATA).as_boolean());
             }
 
+            auto concurrency_safe_it = properties.find(BMI_REALIZATION_CFG_PARAM_OPT__CONCURRENCY_SAFE);
+            if (concurrency_safe_it != properties.end()) {
+                concurrency_safe = concurrency_safe_it->second.as_boolean();
+            }
+
             auto std_names_it = properties.find(BMI_REALIZATION_CFG_PARAM_OPT__VAR_STD_NAMES);
             if (std_names_it != properties.end()) {
                 geojson::PropertyMap names_map = std_names_it->second.get_values();
@@ -430,6 +492,7 @@ namespace realization {
                     if (bmi_var_names_map.find(output_var_name) != bmi_var_names_map.end())
                         available_forcings.push_back(bmi_var_names_map[output_var_name]);
                 }
+                resolve_outputs();
                 //Initialize all NgenBmiProtocols with the valid adapter pointer and any properties
                 //provided in the read configuration.
                 bmi_protocols = models::bmi::protocols::NgenBmiProtocols(get_bmi_model(), properties);
@@ -514,6 +577,88 @@ namespace realization {
         }
 
 
+        /**
+         * @brief Convert a ``model_params`` value to a C-like array of the C++ type analogous to a BMI variable's type.
+         *
+         * @param value The configured value.
+         * @param type The C++ type analogous to the type of the variable the value is for.
+         * @param count Set to the number of items in the returned array.
+         * @return std::shared_ptr<void> The array, or null if the value is not numeric and so can not be set.
+         */
+        std::shared_ptr<void> get_parameter_values(const geojson::JSONProperty& value, const std::string& type,
+                                                   std::size_t& count)
+        {
+            std::vector<long> long_vec;
+            std::vector<double> double_vec;
+            switch( value.get_type() ){
+                case geojson::PropertyType::Natural:
+                    value.as_vector(long_vec);
+                    count = long_vec.size();
+                    return get_values_as_type(type, long_vec.begin(), long_vec.end());
+                case geojson::PropertyType::Real:
+                    value.as_vector(double_vec);
+                    count = double_vec.size();
+                    return get_values_as_type(type, double_vec.begin(), double_vec.end());
+                case geojson::PropertyType::List:
+                    //In this case, only supporting numeric lists
+                    //will retrieve as double (longs will get casted)
+                    value.as_vector(double_vec);
+                    if(double_vec.size() == 0){
+                        return nullptr;
+                    }
+                    count = double_vec.size();
+                    return get_values_as_type(type, double_vec.begin(), double_vec.end());
+                /* Not currently supporting string parameter values, or native bool (true/false) parameter values
+                 * (use int 0/1)
+                 */
+                default:
+                    return nullptr;
+            }
+        }
+
+        void Bmi_Module_Formulation::set_shared_model_parameters(models::bmi::Bmi_Adapter& model,
+                                                                 const geojson::PropertyMap& properties) const {
+            auto model_params = properties.find("model_params");
+            if (model_params == properties.end()) {
+                return;
+            }
+            const auto& own_model = get_bmi_model();
+            for (const auto& param : model_params->second.get_values()) {
+                const std::string& name = param.first;
+                int item_size = model.GetVarItemsize(name);
+                int nbytes = model.GetVarNbytes(name);
+                std::string type = model.GetVarType(name);
+                // A parameter the shared model holds once for all its catchments has a different size per catchment
+                if (type != own_model->GetVarType(name) || item_size != own_model->GetVarItemsize(name) ||
+                    nbytes != own_model->GetVarNbytes(name)) {
+                    throw std::runtime_error("parameter " + name + " is not held for each catchment with the type "
+                                             "and size it has in the catchment's own model");
+                }
+                std::size_t count = 0;
+                std::shared_ptr<void> values = get_parameter_values(param.second,
+                                                                    model.get_analogous_cxx_type(type, item_size),
+                                                                    count);
+                // Skipped, with a warning, on the catchment's own model as well
+                if (values == nullptr) {
+                    continue;
+                }
+                if (count * item_size != (std::size_t) nbytes) {
+                    throw std::runtime_error("parameter " + name + " has " + std::to_string(count) + " values for " +
+                                             std::to_string(nbytes / item_size) + " items");
+                }
+                model.SetValue(name, values.get());
+            }
+        }
+
+        void Bmi_Module_Formulation::bind_shared_model(std::shared_ptr<models::bmi::Bmi_Adapter> model,
+                                                       models::bmi::protocols::NgenBmiProtocols protocols) {
+            set_bmi_model(std::move(model));
+            // Input metadata is read lazily from the model on the first time step; drop any read from the old one
+            bmi_input_var_details.reset();
+            bmi_input_providers.reset();
+            bmi_protocols = std::move(protocols);
+        }
+
         void Bmi_Module_Formulation::set_initial_bmi_parameters(geojson::PropertyMap properties) {
             auto model = get_bmi_model();
             if( model == nullptr ) return;
@@ -523,18 +668,9 @@ namespace realization {
             if (model_params != properties.end() ){
 
                 geojson::PropertyMap params = model_params->second.get_values();
-                //Declare/init the possible vectors here
-                //reuse them for each loop iteration, make sure to clear them
-                std::vector<long> long_vec;
-                std::vector<double> double_vec;
-                //not_supported
-                //std::vector<std::string> str_vec;
-                //std::vector<bool> bool_vec;
-                std::shared_ptr<void> value_ptr;
                 for (auto& param : params) {
                     //Get some basic BMI info for this param
                     int varItemSize = get_bmi_model()->GetVarItemsize(param.first);
-                    int totalBytes = get_bmi_model()->GetVarNbytes(param.first);
 
                     //Figure out the c++ type to convert data to
                     std::string type = get_bmi_model()->get_analogous_cxx_type(get_bmi_model()->GetVarType(param.first),
@@ -543,39 +679,16 @@ namespace realization {
                     //(and by extension, as_c_array) into the JSONProperty class
                     //then instead of the PropertyVariant visitor filling vectors
                     //it could fill the c-like array and avoid another copy.
-                     switch( param.second.get_type() ){
-                        case geojson::PropertyType::Natural:
-                            param.second.as_vector(long_vec);
-                            value_ptr = get_values_as_type(type, long_vec.begin(), long_vec.end());
-                            break;
-                        case geojson::PropertyType::Real:
-                            param.second.as_vector(double_vec);
-                            value_ptr = get_values_as_type(type, double_vec.begin(), double_vec.end());
-                            break;
-                        /* Not currently supporting string parameter values
-                        case geojson::PropertyType::String:
-                            param.second.as_vector(str_vec);
-                            value_ptr = get_values_as_type(type, long_vec.begin(), long_vec.end());
-                        */
-                        /* Not currently supporting native bool (true/false) parameter values (use int 0/1)
-                        case geojson::PropertyType::Boolean:
-                            param.second.as_vector(bool_vec);
-                            //data_ptr = bool_vec.data();
-                        */
-                        case geojson::PropertyType::List:
-                            //In this case, only supporting numeric lists
-                            //will retrieve as double (longs will get casted)
-                            //TODO consider some additional introspection/optimization for this?
-                            param.second.as_vector(double_vec);
-                            if(double_vec.size() == 0){
-                                logging::warning(("Cannot pass non-numeric lists as a BMI parameter, skipping "+param.first+"\n").c_str());
-                                continue;
-                            }
-                            value_ptr = get_values_as_type(type, double_vec.begin(), double_vec.end());
-                            break;
-                        default:
+                    std::size_t count = 0;
+                    std::shared_ptr<void> value_ptr = get_parameter_values(param.second, type, count);
+                    if (value_ptr == nullptr) {
+                        if (param.second.get_type() == geojson::PropertyType::List) {
+                            logging::warning(("Cannot pass non-numeric lists as a BMI parameter, skipping "+param.first+"\n").c_str());
+                        }
+                        else {
                             logging::warning(("Cannot pass parameter of type "+geojson::get_propertytype_name(param.second.get_type())+" as a BMI parameter, skipping "+param.first+"\n").c_str());
-                            continue;
+                        }
+                        continue;
                     }
                     try{
 
@@ -592,11 +705,6 @@ namespace realization {
                         logging::warning((std::string("Unknown Exception setting parameter value: \n")).c_str());
                         logging::warning(("Skipping parameter: "+param.first+"\n").c_str());
                     }
-                    long_vec.clear();
-                    double_vec.clear();
-                    //Not supported
-                    //str_vec.clear();
-                    //bool_vec.clear();
                 }
 
             }
@@ -639,44 +747,6 @@ namespace realization {
             model_initialized = is_initialized;
         }
 
-        // TODO: need to modify this to support arrays properly, since in general that's what BMI modules deal with
-        template<typename T>
-        std::shared_ptr<void> get_value_as_type(std::string type, T value)
-        {
-            if (type == "double" || type == "double precision")
-                return std::make_shared<double>( static_cast<double>(value) );
-
-            if (type == "float" || type == "real")
-                return std::make_shared<float>( static_cast<float>(value) );
-
-            if (type == "short" || type == "short int" || type == "signed short" || type == "signed short int")
-                return std::make_shared<short>( static_cast<short>(value) );
-
-            if (type == "unsigned short" || type == "unsigned short int")
-                return std::make_shared<unsigned short>( static_cast<unsigned short>(value) );
-
-            if (type == "int" || type == "signed" || type == "signed int" || type == "integer")
-                return std::make_shared<int>( static_cast<int>(value) );
-
-            if (type == "unsigned" || type == "unsigned int")
-                return std::make_shared<unsigned int>( static_cast<unsigned int>(value) );
-
-            if (type == "long" || type == "long int" || type == "signed long" || type == "signed long int")
-                return std::make_shared<long>( static_cast<long>(value) );
-
-            if (type == "unsigned long" || type == "unsigned long int")
-                return std::make_shared<unsigned long>( static_cast<unsigned long>(value) );
-
-            if (type == "long long" || type == "long long int" || type == "signed long long" || type == "signed long long int")
-                return std::make_shared<long long>( static_cast<long long>(value) );
-
-            if (type == "unsigned long long" || type == "unsigned long long int")
-                return std::make_shared<unsigned long long>( static_cast<unsigned long long>(value) );
-
-            throw std::runtime_error("Unable to get value of variable as type '" + type +
-                "': no logic for converting value to variable's type.");
-        }
-
         void Bmi_Module_Formulation::set_model_inputs_prior_to_update(const double &model_time, time_step_t t_delta) {
             time_t forcing_start = convert_model_time(model_time) + get_bmi_model_start_time_forcing_offset_s();
             if (cache_input_variable_metadata) {
@@ -697,12 +767,21 @@ namespace realization {
             }
 
             for (size_t i = 0; i < bmi_input_var_details->size(); i++) {
+                if (bmi_input_couplings[i] != nullptr) {
+                    perform_coupled_set(bmi_input_var_details->at(i)->get_name(), *bmi_input_couplings[i]);
+                    continue;
+                }
                 perform_set(src_data_start, t_delta, bmi_input_providers->at(i), bmi_input_var_details->at(i));
             }
         }
 
         void Bmi_Module_Formulation::do_bmi_sets_with_full_refetch(const time_t& src_data_start, const time_step_t& t_delta) {
             for (std::string & var_name : get_bmi_model()->GetInputVarNames()) {
+                auto coupling_it = input_couplings.find(var_name);
+                if (coupling_it != input_couplings.end()) {
+                    perform_coupled_set(var_name, coupling_it->second);
+                    continue;
+                }
                 int item_size = get_bmi_model()->GetVarItemsize(var_name);
                 std::string mapped_alias = get_config_mapped_variable_name(var_name);
 
@@ -735,68 +814,155 @@ namespace realization {
             return forcing;
         }
 
+        bool Bmi_Module_Formulation::is_concurrency_safe() const {
+            if (!concurrency_safe) {
+                return false;
+            }
+            if (forcing != nullptr && !forcing->supports_concurrent_access()) {
+                return false;
+            }
+            for (const auto &provider : input_forcing_providers) {
+                if (provider.second != nullptr && !provider.second->supports_concurrent_access()) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         void Bmi_Module_Formulation::initialize_bmi_input_var_metadata() {
             if (bmi_input_var_details != nullptr) {
                 throw std::runtime_error("Cannot re-initialize module formulation bmi_input_var_details member");
             }
             bmi_input_var_details = std::make_unique<std::vector<Bmi_Var_Details*>>();
             bmi_input_providers = std::make_unique<std::vector<std::shared_ptr<data_access::GenericDataProvider>>>();
+            bmi_input_couplings.clear();
             for (std::string & var_name : get_bmi_model()->GetInputVarNames()) {
                 int item_size = get_bmi_model()->GetVarItemsize(var_name);
                 std::string mapped_alias = get_config_mapped_variable_name(var_name);
 
+                Bmi_Var_Details var_details(var_name,
+                                            mapped_alias,
+                                            item_size,
+                                            get_bmi_model()->GetVarNbytes(var_name) / item_size,
+                                            get_bmi_model()->get_analogous_cxx_type(get_bmi_model()->GetVarType(var_name), item_size),
+                                            get_bmi_model()->GetVarUnits(var_name));
+
+                // Lazily initialized on the first time step, which may run concurrently across catchments; set
+                // nodes are stable, so only the insert itself needs to be serialized.
                 // First in pair will be iterator either to inserted item or to existing that prevents insert duplicate
-                std::pair<std::set<Bmi_Var_Details>::iterator, bool> iter_and_result =
-                    known_bmi_input_vars.insert(
-                        Bmi_Var_Details(var_name,
-                                          mapped_alias,
-                                          item_size,
-                                          get_bmi_model()->GetVarNbytes(var_name) / item_size,
-                                          get_bmi_model()->get_analogous_cxx_type(get_bmi_model()->GetVarType(var_name), item_size),
-                                          get_bmi_model()->GetVarUnits(var_name)));
+                std::pair<std::set<Bmi_Var_Details>::iterator, bool> iter_and_result;
+                {
+                    const std::lock_guard<std::mutex> lock(known_bmi_input_vars_mutex);
+                    iter_and_result = known_bmi_input_vars.insert(std::move(var_details));
+                }
 
                 bmi_input_var_details->push_back(const_cast<Bmi_Var_Details*>(&(*(iter_and_result.first))));
                 bmi_input_providers->push_back(get_provider_for_input_var(var_name, mapped_alias));
+                auto coupling_it = input_couplings.find(var_name);
+                bmi_input_couplings.push_back(coupling_it == input_couplings.end() ? nullptr : &coupling_it->second);
+            }
+        }
+
+        bool Bmi_Module_Formulation::couple_input(const std::string &input_name, const Bmi_Module_Formulation &source) {
+            std::shared_ptr<models::bmi::Bmi_Adapter> model = get_bmi_model();
+            std::shared_ptr<models::bmi::Bmi_Adapter> source_model = source.get_bmi_model();
+            if (model == nullptr || source_model == nullptr || model == source_model) {
+                return false;
             }
+            // The output the source would give for the input's alias through get_value
+            std::size_t index = source.find_resolved_output(get_config_mapped_variable_name(input_name));
+            if (index == unresolved) {
+                return false;
+            }
+            const Resolved_Output &output = source.resolved_outputs[index];
+
+            int item_size = model->GetVarItemsize(input_name);
+            int nbytes = model->GetVarNbytes(input_name);
+            if (item_size <= 0 || nbytes <= 0
+                || item_size != source_model->GetVarItemsize(output.bmi_name)
+                || nbytes != source_model->GetVarNbytes(output.bmi_name)) {
+                return false;
+            }
+            std::optional<models::bmi::Cxx_Value_Type> type = models::bmi::find_cxx_value_type(
+                    model->get_analogous_cxx_type(model->GetVarType(input_name), item_size));
+            if (!type || type != models::bmi::find_cxx_value_type(
+                    source_model->get_analogous_cxx_type(source_model->GetVarType(output.bmi_name), item_size))) {
+                return false;
+            }
+            if (model->GetVarUnits(input_name) != output.native_units) {
+                return false;
+            }
+
+            input_couplings[input_name] = Input_Coupling{source_model, output.bmi_name, (std::size_t) nbytes,
+                                                         source_model->has_value_ptr()};
+            return true;
+        }
+
+        void Bmi_Module_Formulation::perform_coupled_set(const std::string &input_name, Input_Coupling &coupling) {
+            void *src = nullptr;
+            if (coupling.by_pointer) {
+                try {
+                    src = coupling.source_model->GetValuePtr(coupling.source_name);
+                }
+                catch (const std::exception &) {
+                    // Fall back to copying below
+                }
+                // Don't keep trying (and failing) to get a pointer every time step
+                coupling.by_pointer = src != nullptr;
+            }
+            if (src == nullptr) {
+                const std::size_t num_doubles = (coupling.nbytes + sizeof(double) - 1) / sizeof(double);
+                if (input_staging.size() < num_doubles) {
+                    input_staging.resize(num_doubles);
+                }
+                coupling.source_model->GetValue(coupling.source_name, input_staging.data());
+                src = input_staging.data();
+            }
+            get_bmi_model()->set_value_from_buffer(input_name, src);
         }
 
         void Bmi_Module_Formulation::perform_set(const time_t& src_data_start,
                                                  const time_step_t& t_delta,
                                                  const std::shared_ptr<data_access::GenericDataProvider>& provider,
                                                  const Bmi_Var_Details* var_details) const {
-            std::shared_ptr<void> value_ptr;
-            if (var_details->get_num_items() != 1) {
+            if (input_selector.get_id() != get_catchment_id()) {
+                input_selector.set_id(get_catchment_id());
+            }
+            input_selector.set_variable_name(var_details->get_mapped_alias());
+            input_selector.set_init_time(src_data_start);
+            input_selector.set_duration_secs(t_delta);
+            input_selector.set_output_units(var_details->get_units());
+
+            const std::size_t num_items = var_details->get_num_items();
+            if (input_staging.size() < num_items) {
+                input_staging.resize(num_items);
+            }
+
+            if (num_items != 1) {
                 //more than a single value needed for var_name
-                std::vector<data_type> values = provider->get_values(
-                    CatchmentAggrDataSelector(get_catchment_id(), var_details->get_mapped_alias(), src_data_start,
-                                              t_delta, var_details->get_units())
-                );
-                //need to marshal data types to the receiver as well
-                //this could be done a little more elegantly if the provider interface were
-                //"type aware", but for now, this will do (but requires yet another copy)
+                std::vector<data_type> values = provider->get_values(input_selector);
                 if (values.size() == 1) {
                     //FIXME this isn't generic broadcasting, but works for scalar implementations
                     #ifndef NGEN_QUIET
                     std::cerr << "WARN: broadcasting variable '" << var_details->get_name() <<
                         "' from scalar to expected array\n";
                     #endif
-                    values.resize(var_details->get_num_items(), values[0]);
+                    values.resize(num_items, values[0]);
                 }
-                else if (values.size() != var_details->get_num_items()) {
+                else if (values.size() != num_items) {
                     throw std::runtime_error(
                         "Mismatch in item count for variable '" + var_details->get_name() + "': model expects "
-                        + std::to_string(var_details->get_num_items()) + ", provider returned "
+                        + std::to_string(num_items) + ", provider returned "
                         + std::to_string(values.size()) + " items\n");
                 }
-                value_ptr = get_values_as_type(var_details->get_cpp_type(), values.begin(), values.end());
+                models::bmi::convert_values_to_type(var_details->get_value_type(), values.data(), num_items,
+                                                    input_staging.data());
             }
             else {
+                double value;
                 try {
                     //scalar value
-                    double value = provider->get_value(CatchmentAggrDataSelector(
-                        this->get_catchment_id(), var_details->get_mapped_alias(), src_data_start, t_delta,
-                        var_details->get_units()));
-                    value_ptr = get_value_as_type(var_details->get_cpp_type(), value);
+                    value = provider->get_value(input_selector);
                 } catch (UnitsHelper::unit_conversion_exception &uce) {
                     bool new_error = UnitsHelper::record_unit_conversion_fault(
                         uce, "Bmi_Module_Formulation::perform_set", var_details->get_mapped_alias());
@@ -812,9 +978,10 @@ namespace realization {
                            << " message \"" << uce.what() << "\"\n";
                         logging::warning(ss.str().c_str()); ss.str("");
                     }
-                    value_ptr = get_value_as_type(var_details->get_cpp_type(), uce.unconverted_values[0]);
+                    value = uce.unconverted_values[0];
                 }
+                models::bmi::convert_values_to_type(var_details->get_value_type(), &value, 1, input_staging.data());
             }
-            get_bmi_model()->SetValue(var_details->get_name(), value_ptr.get());
+            get_bmi_model()->set_value_from_buffer(var_details->get_name(), input_staging.data());
         }
 }
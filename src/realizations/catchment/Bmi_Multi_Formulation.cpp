@@ -95,6 +95,8 @@ void Bmi_Multi_Formulation::create_multi_formulation(geojson::PropertyMap proper
 
     // After all nested formulations have been initialized, reconcile deferred providers
     init_deferred_associations();
+    // Then couple the inputs provided directly by earlier modules where no conversion is needed
+    init_input_couplings();
 
     // TODO: get synced start_time values for all models
     // TODO: get synced end_time values for all models
@@ -157,6 +159,26 @@ void Bmi_Multi_Formulation::create_multi_formulation(geojson::PropertyMap proper
     }
 }
 
+void Bmi_Multi_Formulation::init_input_couplings() {
+    for (const nested_module_ptr &module : modules) {
+        std::shared_ptr<Bmi_Module_Formulation> in_module = std::dynamic_pointer_cast<Bmi_Module_Formulation>(module);
+        if (in_module == nullptr) {
+            continue;
+        }
+        for (const std::string &var_name : in_module->get_bmi_input_variables()) {
+            auto provider_it = in_module->input_forcing_providers.find(var_name);
+            if (provider_it == in_module->input_forcing_providers.end()) {
+                continue;
+            }
+            // Only modules themselves are coupled; deferred and forcing providers are wrappers
+            auto out_module = std::dynamic_pointer_cast<Bmi_Module_Formulation>(provider_it->second);
+            if (out_module != nullptr) {
+                in_module->couple_input(var_name, *out_module);
+            }
+        }
+    }
+}
+
 /**
  * Get whether a model may perform updates beyond its ``end_time``.
  *
@@ -9,6 +9,7 @@
 
 #include "FileChecker.h"
 #include "Bmi_C_Adapter.hpp"
+#include "Bmi_Vector_Model.hpp"
 #include "State_Exception.hpp"
 #include "bmi_utilities.hpp"
 
@@ -303,6 +304,124 @@ TEST_F(Bmi_C_Adapter_Test, GetValuePtr_0_d) {
     adapter->Finalize();
 }
 
+/** Test that a view of output 1 is over the model's own storage, and so sees updates. */
+TEST_F(Bmi_C_Adapter_Test, GetValueView_0_a) {
+    adapter->Initialize();
+    ASSERT_TRUE(adapter->has_value_ptr());
+    std::vector<double> fallback;
+    boost::span<const double> view = GetValueView<double>(*adapter, "OUTPUT_VAR_1", fallback);
+    model_data* model = friend_get_model_data_struct(adapter.get());
+    ASSERT_EQ(model->output_var_1, view.data());
+    ASSERT_TRUE(fallback.empty());
+
+    double value = 6.0;
+    adapter->SetValue("INPUT_VAR_1", &value);
+    adapter->SetValue("INPUT_VAR_2", &value);
+    adapter->Update();
+
+    ASSERT_EQ(value, view[0]);
+    adapter->Finalize();
+}
+
+/** Test that a view as a type other than the variable's falls back to converted copies. */
+TEST_F(Bmi_C_Adapter_Test, GetValueView_0_b) {
+    adapter->Initialize();
+    double value = 7.0;
+    model_data* model = friend_get_model_data_struct(adapter.get());
+    *model->output_var_1 = value;
+    std::vector<float> fallback;
+    boost::span<const float> view = GetValueView<float>(*adapter, "OUTPUT_VAR_1", fallback);
+    ASSERT_EQ(fallback.data(), view.data());
+    ASSERT_EQ(1u, view.size());
+    ASSERT_EQ((float) value, view[0]);
+    adapter->Finalize();
+}
+
+/** Test only the registration functions the library defines are reported as exported. */
+TEST_F(Bmi_C_Adapter_Test, ExportsSymbol_0_a) {
+    ASSERT_TRUE(adapter->exports_symbol(REGISTRATION_FUNC));
+    ASSERT_TRUE(adapter->exports_symbol("register_bmi_vector"));
+    ASSERT_FALSE(adapter->exports_symbol("register_bmi_missing"));
+}
+
+/** Test values set through a shared model's slot are staged, and its update deferred, until the model updates. */
+TEST_F(Bmi_C_Adapter_Test, VectorSlot_0_a) {
+    std::shared_ptr<Bmi_Adapter> model(std::move(adapter));
+    auto shared = std::make_shared<Bmi_Vector_Model>(model, 1);
+    Bmi_Vector_Slot_Adapter slot(shared, 0, config_file_name_0);
+    double initial_time = model->GetCurrentTime();
+    double value_1 = 3.0;
+    double value_2 = 5.0;
+    slot.SetValue("INPUT_VAR_1", &value_1);
+    slot.set_value_from_buffer("INPUT_VAR_2", &value_2);
+    ASSERT_EQ(value_1, GetValue<double>(slot, "INPUT_VAR_1")[0]);
+    slot.Update();
+    ASSERT_EQ(initial_time, slot.GetCurrentTime());
+
+    shared->update();
+    ASSERT_EQ(initial_time + model->GetTimeStep(), slot.GetCurrentTime());
+    ASSERT_EQ(value_1, GetValue<double>(*model, "INPUT_VAR_1")[0]);
+    // Outputs are read in place from the shared model
+    ASSERT_EQ(model->GetValuePtr("OUTPUT_VAR_1"), slot.GetValuePtr("OUTPUT_VAR_1"));
+    ASSERT_EQ(value_1, GetValue<double>(slot, "OUTPUT_VAR_1")[0]);
+    ASSERT_EQ(2.0 * value_2, GetValue<double>(slot, "OUTPUT_VAR_2")[0]);
+}
+
+/** Test a shared model is not advanced until every catchment has asked for its update, and only once each. */
+TEST_F(Bmi_C_Adapter_Test, VectorSlot_0_b) {
+    auto shared = std::make_shared<Bmi_Vector_Model>(std::shared_ptr<Bmi_Adapter>(std::move(adapter)), 1);
+    Bmi_Vector_Slot_Adapter slot(shared, 0, config_file_name_0);
+    ASSERT_THROW(shared->update(), std::runtime_error);
+    slot.Update();
+    ASSERT_THROW(slot.Update(), std::runtime_error);
+    shared->update();
+    slot.UpdateUntil(slot.GetCurrentTime() + slot.GetTimeStep());
+    shared->update();
+    ASSERT_EQ(2 * slot.GetTimeStep(), slot.GetCurrentTime() - slot.GetStartTime());
+}
+
+/** Test each slot of a model initialized for two catchments reads and sets only its own part of the arrays. */
+TEST_F(Bmi_C_Adapter_Test, VectorSlot_1_a) {
+    std::shared_ptr<Bmi_Adapter> model = std::make_shared<Bmi_C_Adapter>(
+            bmi_module_type_name_0, lib_file_name_0, std::vector<std::string>{config_file_name_0, config_file_name_0},
+            true, REGISTRATION_FUNC, "register_bmi_vector");
+    ASSERT_EQ(2 * expected_var_nbytes, model->GetVarNbytes("INPUT_VAR_1"));
+    auto shared = std::make_shared<Bmi_Vector_Model>(model, 2);
+    Bmi_Vector_Slot_Adapter slot_0(shared, 0, config_file_name_0);
+    Bmi_Vector_Slot_Adapter slot_1(shared, 1, config_file_name_0);
+    ASSERT_EQ(expected_var_nbytes, slot_1.GetVarNbytes("INPUT_VAR_1"));
+    // Parameters are held for each catchment as well
+    ASSERT_EQ((int) (2 * sizeof(double)), slot_1.GetVarNbytes("PARAM_VAR_3"));
+    ASSERT_EQ(expected_grid_size, slot_1.GetGridSize(0));
+
+    std::vector<double> values_0 = { 3.0, 5.0 };
+    std::vector<double> values_1 = { 7.0, 11.0 };
+    slot_0.SetValue("INPUT_VAR_1", &values_0[0]);
+    slot_0.SetValue("INPUT_VAR_2", &values_0[1]);
+    slot_1.SetValue("INPUT_VAR_1", &values_1[0]);
+    slot_1.SetValue("INPUT_VAR_2", &values_1[1]);
+    slot_0.Update();
+    slot_1.Update();
+    shared->update();
+
+    ASSERT_EQ(std::vector<double>({ values_0[0], values_1[0] }), GetValue<double>(*model, "INPUT_VAR_1"));
+    ASSERT_EQ(static_cast<double*>(model->GetValuePtr("OUTPUT_VAR_1")) + 1, slot_1.GetValuePtr("OUTPUT_VAR_1"));
+    ASSERT_EQ(values_0[0], GetValue<double>(slot_0, "OUTPUT_VAR_1")[0]);
+    ASSERT_EQ(2.0 * values_0[1], GetValue<double>(slot_0, "OUTPUT_VAR_2")[0]);
+    ASSERT_EQ(values_1[0], GetValue<double>(slot_1, "OUTPUT_VAR_1")[0]);
+    ASSERT_EQ(2.0 * values_1[1], GetValue<double>(slot_1, "OUTPUT_VAR_2")[0]);
+}
+
+/** Test a model's variables are not split between more catchments than they evenly divide into. */
+TEST_F(Bmi_C_Adapter_Test, VectorSlot_1_b) {
+    std::shared_ptr<Bmi_Adapter> model = std::make_shared<Bmi_C_Adapter>(
+            bmi_module_type_name_0, lib_file_name_0, std::vector<std::string>{config_file_name_0, config_file_name_0},
+            true, REGISTRATION_FUNC, "register_bmi_vector");
+    auto shared = std::make_shared<Bmi_Vector_Model>(model, 3);
+    Bmi_Vector_Slot_Adapter slot(shared, 2, config_file_name_0);
+    ASSERT_THROW(slot.GetVarNbytes("INPUT_VAR_1"), std::runtime_error);
+}
+
 /** Test the function for getting start time. */
 TEST_F(Bmi_C_Adapter_Test, GetStartTime_0_a) {
     adapter->Initialize();
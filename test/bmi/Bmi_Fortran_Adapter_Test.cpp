@@ -1093,6 +1093,19 @@ TEST_F(Bmi_Fortran_Adapter_Test, GetValue_0_c) {
     ASSERT_EQ(value, retrieved);
 }
 
+/** Test that a view of input 1 falls back to a copy, since the middleware does not support pointers. */
+TEST_F(Bmi_Fortran_Adapter_Test, GetValueView_0_a) {
+    adapter->Initialize();
+    ASSERT_FALSE(adapter->has_value_ptr());
+    double value = 5.0;
+    adapter->SetValue("INPUT_VAR_1", &value);
+    std::vector<double> fallback;
+    boost::span<const double> view = GetValueView<double>(*adapter, "INPUT_VAR_1", fallback);
+    adapter->Finalize();
+    ASSERT_EQ(fallback.data(), view.data());
+    ASSERT_EQ(value, view[0]);
+}
+
 /** Test that gridded data can be set for grid var 1*/
 TEST_F(Bmi_Fortran_Adapter_Test, GetValue_1_a) {
     adapter->Initialize();
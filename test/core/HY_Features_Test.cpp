@@ -0,0 +1,99 @@
+#include "gtest/gtest.h"
+#include "Bmi_Testing_Util.hpp"
+#include "FileChecker.h"
+#include "StreamHandler.hpp"
+#include <AorcForcing.hpp>
+#include <Formulation_Manager.hpp>
+#include <HY_Features.hpp>
+#include <JSONProperty.hpp>
+#include <Simulation_Time.hpp>
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+class HY_Features_Test : public ::testing::Test {
+    protected:
+
+    const std::string link_key_name = "toid";
+
+    std::string find_path(const std::string& relative_path)
+    {
+        return utils::FileChecker::find_first_readable({
+            "./" + relative_path, "../" + relative_path, "../../" + relative_path,
+            "./test/" + relative_path, "../test/" + relative_path, "../../test/" + relative_path
+        });
+    }
+
+    /**
+     * Build a fabric of catchments draining to nex-1.
+     */
+    geojson::GeoJSON build_fabric(const std::vector<std::string>& catchment_ids)
+    {
+        geojson::three_dimensional_coordinates coords{
+            {{1.0,2.0},{3.0,4.0},{5.0,6.0}}, {{7.0,8.0},{9.0,10.0},{11.0,12.0}}
+        };
+        auto fabric = std::make_shared<geojson::FeatureCollection>();
+        for (const auto& id : catchment_ids) {
+            geojson::PropertyMap props{ {link_key_name, geojson::JSONProperty(link_key_name, "nex-1")} };
+            fabric->add_feature(std::make_shared<geojson::PolygonFeature>(
+                geojson::PolygonFeature(geojson::polygon(coords), id, props)));
+        }
+        return fabric;
+    }
+
+    /**
+     * A formulation manager with a global test BMI C formulation read for every catchment of @p fabric.
+     */
+    std::shared_ptr<realization::Formulation_Manager> build_manager(geojson::GeoJSON fabric)
+    {
+        std::stringstream stream;
+        stream << std::string("{ ")
+          + "\"global\": { \"formulations\": [ { \"name\": \"bmi_c\", \"params\": {"
+          +   "\"model_type_name\": \"test_bmi_c\","
+          +   "\"library_file\": \"" + find_path("extern/test_bmi_c/cmake_build/" BMI_TEST_C_LIB_NAME SHARED_LIB_FILE_EXTENSION) + "\","
+          +   "\"init_config\": \"" + find_path("data/bmi/test_bmi_c/test_bmi_c_config_0.txt") + "\","
+          +   "\"main_output_variable\": \"OUTPUT_VAR_1\","
+          +   "\"registration_function\": \"register_bmi\","
+          +   "\"" BMI_REALIZATION_CFG_PARAM_OPT__VAR_STD_NAMES "\": { \"INPUT_VAR_2\": \"" AORC_FIELD_NAME_TEMP_2M_AG "\", \"INPUT_VAR_1\": \"" AORC_FIELD_NAME_PRECIP_RATE "\" },"
+          +   "\"uses_forcing_file\": false"
+          + "} } ], \"forcing\": { \"file_pattern\": \".*{{id}}.*.csv\", \"path\": \"" + find_path("data/forcing") + "/\", \"provider\": \"CsvPerFeature\" } } }";
+        boost::property_tree::ptree config;
+        boost::property_tree::json_parser::read_json(stream, config);
+
+        simulation_time_params sim_time("2015-12-01 00:00:00", "2015-12-02 00:00:00", 3600);
+        auto manager = std::make_shared<realization::Formulation_Manager>(config);
+        manager->read(sim_time, fabric, utils::StreamHandler());
+        return manager;
+    }
+};
+
+/** Test that the materialized id and pointer views match the network filter ranges they replace in hot loops. */
+TEST_F(HY_Features_Test, materialized_views)
+{
+    auto fabric = build_fabric({"cat-27", "cat-52", "cat-67"});
+    auto manager = build_manager(fabric);
+    // Link the catchments to their nexus feature as the driver does, so the network records their (default) layer
+    fabric->add_feature(std::make_shared<geojson::PointFeature>(geojson::coordinate_t(0.0, 0.0), "nex-1"));
+    std::string link_key = link_key_name;
+    fabric->link_features_from_property(nullptr, &link_key);
+    hy_features::HY_Features features(fabric, manager);
+
+    std::vector<std::string> filtered_cats(features.catchments().begin(), features.catchments().end());
+    EXPECT_EQ(features.catchment_ids(), filtered_cats);
+    ASSERT_EQ(features.catchment_ids().size(), 3u);
+
+    std::vector<std::string> layer_cats(features.catchments(0).begin(), features.catchments(0).end());
+    EXPECT_EQ(features.catchment_ids(0), layer_cats);
+    EXPECT_EQ(features.catchment_ids(0).size(), 3u);
+    EXPECT_TRUE(features.catchment_ids(7).empty());
+
+    std::vector<std::string> filtered_nexs(features.nexuses().begin(), features.nexuses().end());
+    EXPECT_EQ(features.nexus_ids(), filtered_nexs);
+    ASSERT_EQ(features.nexus_ids(), std::vector<std::string>{"nex-1"});
+    EXPECT_EQ(features.nexus_pointers().at(0), features.nexus_at("nex-1").get());
+}
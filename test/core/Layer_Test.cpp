@@ -0,0 +1,307 @@
+#include "gtest/gtest.h"
+#include "Bmi_Testing_Util.hpp"
+#include "FileChecker.h"
+#include "StreamHandler.hpp"
+#include <AorcForcing.hpp>
+#include <Catchment_Formulation.hpp>
+#include <Formulation_Manager.hpp>
+#include <HY_Features.hpp>
+#include <JSONProperty.hpp>
+#include <Layer.hpp>
+#include <WorkerPool.hpp>
+#include <Simulation_Time.hpp>
+
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+// Layer::feature_type is HY_Features_MPI in MPI builds, which needs partitions to construct
+#if !NGEN_WITH_MPI
+
+/** A layer that reports how many of its catchments it bound to shared models. */
+class Grouping_Layer : public ngen::Layer {
+    public:
+        using ngen::Layer::Layer;
+
+        std::size_t shared_model_count() const
+        {
+            return formulation_groups.size();
+        }
+
+        std::size_t shared_catchment_count() const
+        {
+            std::size_t count = 0;
+            for (const auto& group_entry : formulation_groups) {
+                count += group_entry.units.size();
+            }
+            return count;
+        }
+};
+
+class Layer_Test : public ::testing::Test {
+    protected:
+
+    const std::string link_key_name = "toid";
+    const std::vector<std::string> catchment_ids = {"cat-27", "cat-52", "cat-67"};
+    const std::map<std::string, double> areas_sqkm = {{"cat-27", 1.5}, {"cat-52", 3.25}, {"cat-67", 0.75}};
+    static constexpr int num_steps = 24;
+    //! The formulation's ``model_params`` object, or empty to leave it out of the config
+    std::string model_params;
+
+    simulation_time_params time_params()
+    {
+        return simulation_time_params("2015-12-01 00:00:00", "2015-12-02 00:00:00", 3600);
+    }
+
+    std::string find_path(const std::string& relative_path)
+    {
+        return utils::FileChecker::find_first_readable({
+            "./" + relative_path, "../" + relative_path, "../../" + relative_path,
+            "./test/" + relative_path, "../test/" + relative_path, "../../test/" + relative_path
+        });
+    }
+
+    /** The outcome of stepping a layer of the catchments @ref num_steps times. */
+    struct Layer_Run {
+        //! What reached the nexus each step
+        std::vector<std::pair<double, int>> contributions;
+        //! Each catchment's output values each step
+        std::map<std::string, std::vector<std::vector<double>>> outputs;
+        //! The number of shared models the layer bound catchments to
+        std::size_t shared_models = 0;
+        //! The number of catchments bound to a shared model
+        std::size_t shared_catchments = 0;
+    };
+
+    /**
+     * A global test BMI C realization config for the catchments of @ref build_fabric.
+     *
+     * @param concurrency_safe Whether the formulation opts in to concurrent execution.
+     * @param share_model Whether the catchments may be held by one model instance, through the test library's vector
+     *                    registration function.
+     */
+    std::string realization_config(bool concurrency_safe, bool share_model)
+    {
+        return std::string("{ ")
+          + "\"global\": { \"formulations\": [ { \"name\": \"bmi_c\", \"params\": {"
+          +   "\"model_type_name\": \"test_bmi_c\","
+          +   "\"library_file\": \"" + find_path("extern/test_bmi_c/cmake_build/" BMI_TEST_C_LIB_NAME SHARED_LIB_FILE_EXTENSION) + "\","
+          +   "\"init_config\": \"" + find_path("data/bmi/test_bmi_c/test_bmi_c_config_0.txt") + "\","
+          +   "\"main_output_variable\": \"OUTPUT_VAR_2\","
+          +   "\"registration_function\": \"register_bmi\","
+          +   (share_model ? "\"" BMI_REALIZATION_CFG_PARAM_OPT__VECTOR_REGISTRATION_FUNC "\": \"register_bmi_vector\"," : "")
+          +   "\"" BMI_REALIZATION_CFG_PARAM_OPT__VAR_STD_NAMES "\": { \"INPUT_VAR_2\": \"" AORC_FIELD_NAME_TEMP_2M_AG "\", \"INPUT_VAR_1\": \"" AORC_FIELD_NAME_PRECIP_RATE "\" },"
+          +   "\"" BMI_REALIZATION_CFG_PARAM_OPT__CONCURRENCY_SAFE "\": " + (concurrency_safe ? "true" : "false") + ","
+          +   (model_params.empty() ? "" : "\"model_params\": " + model_params + ",")
+          +   "\"uses_forcing_file\": false"
+          + "} } ], \"forcing\": { \"file_pattern\": \".*{{id}}.*.csv\", \"path\": \"" + find_path("data/forcing") + "/\", \"provider\": \"CsvPerFeature\" } } }";
+    }
+
+    geojson::GeoJSON build_fabric()
+    {
+        geojson::three_dimensional_coordinates coords{
+            {{1.0,2.0},{3.0,4.0},{5.0,6.0}}, {{7.0,8.0},{9.0,10.0},{11.0,12.0}}
+        };
+        auto fabric = std::make_shared<geojson::FeatureCollection>();
+        for (const auto& id : catchment_ids) {
+            geojson::PropertyMap props{
+                {link_key_name, geojson::JSONProperty(link_key_name, "nex-1")},
+                {"areasqkm", geojson::JSONProperty("areasqkm", areas_sqkm.at(id))}
+            };
+            fabric->add_feature(std::make_shared<geojson::PolygonFeature>(
+                geojson::PolygonFeature(geojson::polygon(coords), id, props)));
+        }
+        return fabric;
+    }
+
+    std::shared_ptr<realization::Formulation_Manager> build_manager(bool concurrency_safe, bool share_model,
+                                                                     geojson::GeoJSON fabric,
+                                                                     simulation_time_params& sim_time)
+    {
+        std::stringstream stream;
+        stream << realization_config(concurrency_safe, share_model);
+        boost::property_tree::ptree config;
+        boost::property_tree::json_parser::read_json(stream, config);
+
+        auto manager = std::make_shared<realization::Formulation_Manager>(config);
+        manager->read(sim_time, fabric, utils::StreamHandler());
+        return manager;
+    }
+
+    /**
+     * The nexus contributions of the layer's catchments, computed with the per-id lookups the layer did before it
+     * resolved its catchments into a plan.
+     */
+    std::vector<double> expected_contributions()
+    {
+        simulation_time_params sim_time = time_params();
+        geojson::GeoJSON fabric = build_fabric();
+        auto manager = build_manager(false, false, fabric, sim_time);
+        std::string link_key = link_key_name;
+        hy_features::HY_Features features(fabric, &link_key, manager);
+
+        std::vector<double> sums(num_steps, 0.0);
+        for (int t = 0; t < num_steps; ++t) {
+            for (const auto& id : catchment_ids) {
+                auto formulation = std::dynamic_pointer_cast<realization::Catchment_Formulation>(features.catchment_at(id));
+                double response = formulation->get_response(t, 3600);
+                double area = fabric->get_feature(id)->get_property("areasqkm").as_real_number();
+                sums[t] += response * (area * 1000000) / 3600.0;
+            }
+        }
+        return sums;
+    }
+
+    /**
+     * Step a layer of the catchments @ref num_steps times.
+     *
+     * @param pool_size Size of the layer's worker pool, or 0 to run serially.
+     * @param share_model Whether the layer may bind the catchments to one shared model.
+     */
+    Layer_Run run_layer(std::size_t pool_size, bool share_model)
+    {
+        simulation_time_params sim_time = time_params();
+        geojson::GeoJSON fabric = build_fabric();
+        auto manager = build_manager(pool_size > 0, share_model, fabric, sim_time);
+        std::string link_key = link_key_name;
+        hy_features::HY_Features features(fabric, &link_key, manager);
+
+        std::unordered_map<std::string, int> catchment_indexes;
+        for (std::size_t i = 0; i < catchment_ids.size(); ++i) {
+            catchment_indexes[catchment_ids[i]] = i;
+        }
+        std::unordered_map<std::string, int> nexus_indexes{{"nex-1", 0}};
+        std::vector<double> catchment_outflows(catchment_ids.size(), 0.0);
+        std::vector<double> nexus_downstream_flows(1, 0.0);
+
+        ngen::LayerDescription description{"surface layer", "s", 0, 3600};
+        Grouping_Layer layer(description, catchment_ids, Simulation_Time(sim_time), features, fabric, 0, nullptr);
+        if (pool_size > 0) {
+            layer.set_worker_pool(std::make_shared<utils::WorkerPool>(pool_size));
+        }
+
+        Layer_Run run;
+        for (int t = 0; t < num_steps; ++t) {
+            layer.update_models(catchment_outflows, catchment_indexes, nexus_downstream_flows, nexus_indexes, t);
+            run.contributions.push_back(features.nexus_at("nex-1")->inspect_upstream_flows(t));
+            for (const auto& id : catchment_ids) {
+                auto formulation = std::dynamic_pointer_cast<realization::Catchment_Formulation>(features.catchment_at(id));
+                run.outputs[id].push_back(formulation->get_output_values_for_timestep(t));
+            }
+        }
+        run.shared_models = layer.shared_model_count();
+        run.shared_catchments = layer.shared_catchment_count();
+        return run;
+    }
+
+    /**
+     * Step a layer of the catchments, each with its own model, @ref num_steps times and return what reached the
+     * nexus each step.
+     *
+     * @param pool_size Size of the layer's worker pool, or 0 to run serially.
+     */
+    std::vector<std::pair<double, int>> layer_contributions(std::size_t pool_size)
+    {
+        return run_layer(pool_size, false).contributions;
+    }
+};
+
+/** Test that the layer's resolved plan gives each step the nexus contributions of the per-id lookups. */
+TEST_F(Layer_Test, plan_matches_per_catchment_contributions)
+{
+    std::vector<double> expected = expected_contributions();
+    std::vector<std::pair<double, int>> actual = layer_contributions(0);
+
+    ASSERT_EQ(actual.size(), expected.size());
+    // The main output scales the forcing temperature, so every step carries a non-trivial contribution
+    ASSERT_GT(expected.front(), 0.0);
+    for (std::size_t t = 0; t < expected.size(); ++t) {
+        EXPECT_EQ(actual[t].second, static_cast<int>(catchment_ids.size())) << "at step " << t;
+        EXPECT_DOUBLE_EQ(actual[t].first, expected[t]) << "at step " << t;
+    }
+}
+
+/** Test that advancing the catchments on a worker pool leaves the nexus contributions unchanged. */
+TEST_F(Layer_Test, pool_matches_serial_contributions)
+{
+    std::vector<std::pair<double, int>> serial = layer_contributions(0);
+    std::vector<std::pair<double, int>> pooled = layer_contributions(3);
+
+    ASSERT_EQ(pooled.size(), serial.size());
+    for (std::size_t t = 0; t < serial.size(); ++t) {
+        EXPECT_EQ(pooled[t].second, serial[t].second) << "at step " << t;
+        // Contributions are merged in processing-unit order, so the sums are bit-for-bit equal
+        EXPECT_EQ(pooled[t].first, serial[t].first) << "at step " << t;
+    }
+}
+
+/** Test that catchments advanced through one shared model give the outputs and contributions of their own models. */
+TEST_F(Layer_Test, shared_model_matches_own_models)
+{
+    Layer_Run own = run_layer(0, false);
+    Layer_Run shared = run_layer(0, true);
+
+    ASSERT_EQ(own.shared_models, 0u);
+    ASSERT_EQ(shared.shared_models, 1u);
+    ASSERT_EQ(shared.shared_catchments, catchment_ids.size());
+
+    ASSERT_EQ(shared.contributions.size(), own.contributions.size());
+    for (std::size_t t = 0; t < own.contributions.size(); ++t) {
+        EXPECT_EQ(shared.contributions[t].second, own.contributions[t].second) << "at step " << t;
+        EXPECT_EQ(shared.contributions[t].first, own.contributions[t].first) << "at step " << t;
+    }
+    // Each catchment has its own forcing, so outputs differ between catchments if each reads only its own slot
+    ASSERT_NE(own.outputs.at(catchment_ids[0]).front(), own.outputs.at(catchment_ids[1]).front());
+    for (const auto& id : catchment_ids) {
+        ASSERT_EQ(shared.outputs.at(id).size(), own.outputs.at(id).size());
+        for (std::size_t t = 0; t < own.outputs.at(id).size(); ++t) {
+            EXPECT_EQ(shared.outputs.at(id)[t], own.outputs.at(id)[t]) << id << " at step " << t;
+        }
+    }
+}
+
+/** Test that parameter values are set on each catchment's part of a shared model. */
+TEST_F(Layer_Test, shared_model_takes_parameters)
+{
+    model_params = "{ \"PARAM_VAR_1\": 42, \"PARAM_VAR_3\": [4, 2] }";
+    Layer_Run own = run_layer(0, false);
+    Layer_Run shared = run_layer(0, true);
+
+    ASSERT_EQ(shared.shared_models, 1u);
+    ASSERT_EQ(shared.shared_catchments, catchment_ids.size());
+    ASSERT_EQ(shared.contributions, own.contributions);
+    ASSERT_EQ(shared.outputs, own.outputs);
+}
+
+/** Test that catchments keep their own models when their parameter values do not fit the shared model. */
+TEST_F(Layer_Test, shared_model_rejects_parameters_that_do_not_fit)
+{
+    // PARAM_VAR_3 has two items per catchment
+    model_params = "{ \"PARAM_VAR_3\": [4, 2, 1] }";
+    Layer_Run own = run_layer(0, false);
+    Layer_Run shared = run_layer(0, true);
+
+    ASSERT_EQ(shared.shared_models, 0u);
+    ASSERT_EQ(shared.shared_catchments, 0u);
+    ASSERT_EQ(shared.contributions, own.contributions);
+    ASSERT_EQ(shared.outputs, own.outputs);
+}
+
+/** Test that a worker pool leaves catchments sharing a model on the calling thread, with unchanged results. */
+TEST_F(Layer_Test, pool_with_shared_model_matches_serial)
+{
+    Layer_Run serial = run_layer(0, true);
+    Layer_Run pooled = run_layer(3, true);
+
+    ASSERT_EQ(pooled.shared_catchments, catchment_ids.size());
+    ASSERT_EQ(pooled.contributions, serial.contributions);
+    ASSERT_EQ(pooled.outputs, serial.outputs);
+}
+
+#endif // !NGEN_WITH_MPI
@@ -61,3 +61,21 @@ TEST_F(UnitsHelper_Test, TestConvertArrayDontModifyInputNoOp){
     ASSERT_EQ( expected,  data2);
     ASSERT_EQ( data.at(2), 3);
 }
+
+TEST_F(UnitsHelper_Test, TestResolvedConverter){
+    UnitsHelper::unit_converter to_mm = UnitsHelper::get_unit_converter("m", "mm");
+    ASSERT_FALSE(to_mm.is_identity());
+    ASSERT_NEAR(2500.0, to_mm.convert(2.5), 0.000000001);
+
+    std::vector<double> data = {1,2,3,4};
+    std::vector<double> expected = {1000, 2000, 3000, 4000};
+    to_mm.convert(data.data(), data.data(), data.size());
+    ASSERT_EQ( expected,  data);
+
+    // no conversion needed, or none requested
+    ASSERT_TRUE(UnitsHelper::get_unit_converter("m", "m").is_identity());
+    ASSERT_TRUE(UnitsHelper::get_unit_converter("m", "").is_identity());
+    ASSERT_EQ(3.0, UnitsHelper::unit_converter().convert(3.0));
+
+    ASSERT_THROW(UnitsHelper::get_unit_converter("m", "degC"), UnitsHelper::unit_conversion_exception);
+}
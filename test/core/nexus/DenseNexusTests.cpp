@@ -0,0 +1,101 @@
+#include "gtest/gtest.h"
+
+#include "HY_DensePointHydroNexus.hpp"
+#include "HY_PointHydroNexus.hpp"
+#include "HY_PointHydroNexusExceptions.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+    const std::vector<std::string> receiving = {"cat-3"};
+    const std::vector<std::string> contributing = {"cat-1", "cat-2"};
+}
+
+//! Contributions are summed and released by percentage, matching the map-backed point nexus.
+TEST(DenseNexus_Test, MatchesPointNexus)
+{
+    HY_DensePointHydroNexus dense("nex-1", receiving, contributing);
+    HY_PointHydroNexus point("nex-1", receiving, contributing);
+
+    for (long t = 0; t < 10; ++t) {
+        for (HY_HydroNexus* nexus : std::vector<HY_HydroNexus*>{&dense, &point}) {
+            nexus->add_upstream_flow(1.5 * t, "cat-1", t);
+            nexus->add_upstream_flow(2.0, "cat-2", t);
+        }
+        ASSERT_EQ(dense.inspect_upstream_flows(t), point.inspect_upstream_flows(t));
+        ASSERT_DOUBLE_EQ(dense.get_downstream_flow("cat-3", t, 40.0), point.get_downstream_flow("cat-3", t, 40.0));
+        ASSERT_EQ(dense.inspect_downstream_requests(t), point.inspect_downstream_requests(t));
+        ASSERT_DOUBLE_EQ(dense.get_downstream_flow("cat-3", t, 60.0), point.get_downstream_flow("cat-3", t, 60.0));
+    }
+}
+
+//! Integer-indexed contributions land in the same slot as id-based ones.
+TEST(DenseNexus_Test, IndexedContribution)
+{
+    HY_DensePointHydroNexus nexus("nex-1", receiving, contributing);
+    ASSERT_EQ(nexus.upstream_index("cat-2"), 1u);
+    ASSERT_EQ(nexus.upstream_index("cat-9"), HY_DensePointHydroNexus::npos);
+
+    nexus.add_upstream_flow(1.0, nexus.upstream_index("cat-2"), 0);
+    nexus.add_upstream_flow(2.0, std::string("cat-2"), 0);
+    nexus.add_upstream_flow(4.0, std::string("cat-9"), 0);   // unlisted contributors are still counted
+    auto flows = nexus.inspect_upstream_flows(0);
+    EXPECT_DOUBLE_EQ(flows.first, 7.0);
+    EXPECT_EQ(flows.second, 3);
+
+    EXPECT_THROW(nexus.add_upstream_flow(1.0, std::size_t(2), 0), std::out_of_range);
+}
+
+//! Only the most recent window of timesteps is retained; older ones expire.
+TEST(DenseNexus_Test, WindowExpiry)
+{
+    HY_DensePointHydroNexus nexus("nex-1", receiving, contributing, 2);
+    ASSERT_EQ(nexus.window(), 2u);
+
+    nexus.add_upstream_flow(1.0, "cat-1", 0);
+    nexus.add_upstream_flow(1.0, "cat-1", 1);
+    EXPECT_EQ(nexus.inspect_upstream_flows(0).second, 1);
+
+    // timestep 2 reuses timestep 0's slot
+    nexus.add_upstream_flow(3.0, "cat-1", 2);
+    EXPECT_EQ(nexus.inspect_upstream_flows(0).second, 0);
+    EXPECT_DOUBLE_EQ(nexus.inspect_upstream_flows(2).first, 3.0);
+    EXPECT_DOUBLE_EQ(nexus.get_downstream_flow("cat-3", 1, 100.0), 1.0);
+
+    EXPECT_THROW(nexus.add_upstream_flow(1.0, "cat-1", 0), invalid_time_step);
+    EXPECT_THROW(nexus.get_downstream_flow("cat-3", 0, 100.0), invalid_time_step);
+}
+
+//! The bookkeeping rules of the point nexus are enforced, with the same exception types.
+TEST(DenseNexus_Test, RequestRules)
+{
+    HY_DensePointHydroNexus dense("nex-1", receiving, contributing);
+    HY_PointHydroNexus point("nex-1", receiving, contributing);
+
+    for (HY_HydroNexus* nexus : std::vector<HY_HydroNexus*>{&dense, &point}) {
+        // nothing recorded yet
+        EXPECT_THROW(nexus->get_downstream_flow("cat-3", 0, 50.0), request_from_empty_nexus);
+
+        nexus->add_upstream_flow(10.0, "cat-1", 0);
+        EXPECT_THROW(nexus->get_downstream_flow("cat-3", 0, 150.0), invalid_downstream_request);
+        EXPECT_DOUBLE_EQ(nexus->get_downstream_flow("cat-3", 0, 50.0), 5.0);
+
+        // no more water may be added once requests have started, nor more than 100% released
+        EXPECT_THROW(nexus->add_upstream_flow(1.0, "cat-2", 0), add_to_summed_nexus);
+        EXPECT_THROW(nexus->get_downstream_flow("cat-3", 0, 60.0), invalid_downstream_request);
+
+        EXPECT_DOUBLE_EQ(nexus->get_downstream_flow("cat-3", 0, 50.0), 5.0);
+        // fully released
+        EXPECT_THROW(nexus->get_downstream_flow("cat-3", 0, 10.0), completed_time_step);
+        EXPECT_EQ(nexus->inspect_upstream_flows(0).second, 0);
+    }
+}
+
+//! A nexus with no contributing catchments releases nothing.
+TEST(DenseNexus_Test, NoContributors)
+{
+    HY_DensePointHydroNexus nexus("nex-1", receiving);
+    EXPECT_DOUBLE_EQ(nexus.get_downstream_flow("cat-3", 0, 100.0), 0.0);
+}
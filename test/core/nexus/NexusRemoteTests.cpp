@@ -2,6 +2,7 @@
 
 #include "gtest/gtest.h"
 #include "HY_PointHydroNexusRemote.hpp"
+#include "HY_RemoteNexusExchange.hpp"
 
 
 #include <vector>
@@ -1115,6 +1116,244 @@ TEST_F(Nexus_Remote_Test, TestRemoteNexusDeadlockFree)
 }
 
 
+//Test moving the flows of several boundary nexuses in both directions between two ranks
+//with one batched exchange per time step.
+TEST_F(Nexus_Remote_Test, TestBatchedExchange)
+{
+    if ( mpi_num_procs < 2 ) {
+	    GTEST_SKIP();
+    }
+
+    using Catchments = HY_HydroNexus::Catchments;
+    using loc_map_t = HY_PointHydroNexusRemote::catcment_location_map_t;
+
+    // rank 1 sends nex-30 and nex-31 to rank 0, and rank 0 sends nex-50 to rank 1
+    std::vector<std::shared_ptr<HY_PointHydroNexusRemote>> senders;
+    std::vector<std::shared_ptr<HY_PointHydroNexusRemote>> receivers;
+
+    if ( mpi_rank == 0 )
+    {
+        // created in the opposite order to rank 1 since the exchange orders nexuses by id
+        receivers.push_back(std::make_shared<HY_PointHydroNexusRemote>("nex-31", Catchments{"cat-41"}, Catchments{"cat-31"},
+                                                                       loc_map_t{{"cat-31", 1}}));
+        receivers.push_back(std::make_shared<HY_PointHydroNexusRemote>("nex-30", Catchments{"cat-40"}, Catchments{"cat-30"},
+                                                                       loc_map_t{{"cat-30", 1}}));
+        senders.push_back(std::make_shared<HY_PointHydroNexusRemote>("nex-50", Catchments{"cat-51"}, Catchments{"cat-50"},
+                                                                     loc_map_t{{"cat-51", 1}}));
+    }
+    else if ( mpi_rank == 1 )
+    {
+        senders.push_back(std::make_shared<HY_PointHydroNexusRemote>("nex-30", Catchments{"cat-40"}, Catchments{"cat-30"},
+                                                                     loc_map_t{{"cat-40", 0}}));
+        senders.push_back(std::make_shared<HY_PointHydroNexusRemote>("nex-31", Catchments{"cat-41"}, Catchments{"cat-31"},
+                                                                     loc_map_t{{"cat-41", 0}}));
+        receivers.push_back(std::make_shared<HY_PointHydroNexusRemote>("nex-50", Catchments{"cat-51"}, Catchments{"cat-50"},
+                                                                       loc_map_t{{"cat-50", 0}}));
+    }
+
+    std::vector<HY_PointHydroNexusRemote*> nexuses;
+    for ( auto& n : senders ) nexuses.push_back(n.get());
+    for ( auto& n : receivers ) nexuses.push_back(n.get());
+
+    // construction is collective, so ranks without boundary nexuses take part too
+    HY_RemoteNexusExchange exchange(nexuses);
+
+    if ( mpi_rank < 2 )
+    {
+        ASSERT_EQ(1, exchange.downstream_neighbor_count());
+        ASSERT_EQ(1, exchange.upstream_neighbor_count());
+        for ( auto* n : nexuses ) {
+            ASSERT_TRUE(n->is_batched());
+        }
+    }
+    else
+    {
+        ASSERT_EQ(0, exchange.downstream_neighbor_count());
+        ASSERT_EQ(0, exchange.upstream_neighbor_count());
+    }
+
+    long ts = 0;
+    for ( auto discharge : stored_discharge )
+    {
+        if ( mpi_rank == 0 )
+        {
+            senders[0]->add_upstream_flow(discharge * 10, "cat-50", ts);
+        }
+        else if ( mpi_rank == 1 )
+        {
+            senders[0]->add_upstream_flow(discharge, "cat-30", ts);
+            senders[1]->add_upstream_flow(discharge * 2, "cat-31", ts);
+        }
+
+        exchange.exchange(ts);
+
+        if ( mpi_rank == 0 )
+        {
+            ASSERT_EQ(discharge * 2, receivers[0]->get_downstream_flow("cat-41", ts, 100));
+            ASSERT_EQ(discharge, receivers[1]->get_downstream_flow("cat-40", ts, 100));
+        }
+        else if ( mpi_rank == 1 )
+        {
+            ASSERT_EQ(discharge * 10, receivers[0]->get_downstream_flow("cat-51", ts, 100));
+        }
+
+        ++ts;
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+
+//Test a batched exchange through a nexus with remote catchments both upstream and downstream of a rank,
+//which relays the flow it receives on together with its own.
+TEST_F(Nexus_Remote_Test, TestBatchedExchangeRelay)
+{
+    if ( mpi_num_procs < 3 ) {
+	    GTEST_SKIP();
+    }
+
+    using Catchments = HY_HydroNexus::Catchments;
+    using loc_map_t = HY_PointHydroNexusRemote::catcment_location_map_t;
+
+    // cat-60 on rank 0 and cat-61 on rank 1 flow through nex-60 to cat-70 on rank 2, relayed by rank 1
+    std::shared_ptr<HY_PointHydroNexusRemote> nexus;
+
+    if ( mpi_rank == 0 )
+    {
+        nexus = std::make_shared<HY_PointHydroNexusRemote>("nex-60", Catchments{"cat-70"}, Catchments{"cat-60"},
+                                                           loc_map_t{{"cat-70", 1}});
+    }
+    else if ( mpi_rank == 1 )
+    {
+        nexus = std::make_shared<HY_PointHydroNexusRemote>("nex-60", Catchments{"cat-70"}, Catchments{"cat-60", "cat-61"},
+                                                           loc_map_t{{"cat-60", 0}, {"cat-70", 2}});
+        ASSERT_EQ(HY_PointHydroNexusRemote::sender_receiver, nexus->get_communicator_type());
+    }
+    else if ( mpi_rank == 2 )
+    {
+        nexus = std::make_shared<HY_PointHydroNexusRemote>("nex-60", Catchments{"cat-70"}, Catchments{"cat-61"},
+                                                           loc_map_t{{"cat-61", 1}});
+    }
+
+    std::vector<HY_PointHydroNexusRemote*> nexuses;
+    if ( nexus ) nexuses.push_back(nexus.get());
+
+    HY_RemoteNexusExchange exchange(nexuses);
+
+    if ( mpi_rank == 1 )
+    {
+        ASSERT_EQ(1, exchange.downstream_neighbor_count());
+        ASSERT_EQ(1, exchange.upstream_neighbor_count());
+    }
+
+    long ts = 0;
+    for ( auto discharge : stored_discharge )
+    {
+        if ( mpi_rank == 0 )
+        {
+            nexus->add_upstream_flow(discharge, "cat-60", ts);
+        }
+        else if ( mpi_rank == 1 )
+        {
+            nexus->add_upstream_flow(discharge * 2, "cat-61", ts);
+        }
+
+        exchange.exchange(ts);
+
+        if ( mpi_rank == 2 )
+        {
+            ASSERT_DOUBLE_EQ(discharge * 3, nexus->get_downstream_flow("cat-70", ts, 100));
+        }
+
+        ++ts;
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
+
+//Test two ranks that each relay a nexus whose flow goes back to the other rank. The relayed flows travel
+//separately from the immediate ones, so neither rank's messages wait on the other's.
+TEST_F(Nexus_Remote_Test, TestBatchedExchangeRelayCycle)
+{
+    if ( mpi_num_procs < 2 ) {
+	    GTEST_SKIP();
+    }
+
+    using Catchments = HY_HydroNexus::Catchments;
+    using loc_map_t = HY_PointHydroNexusRemote::catcment_location_map_t;
+
+    // cat-80 (rank 0) and cat-81 (rank 1) flow through nex-80, relayed by rank 0, to cat-82 on rank 1;
+    // cat-90 (rank 1) and cat-91 (rank 0) flow through nex-90, relayed by rank 1, to cat-92 on rank 0
+    std::shared_ptr<HY_PointHydroNexusRemote> relay;
+    std::shared_ptr<HY_PointHydroNexusRemote> sender;
+    std::shared_ptr<HY_PointHydroNexusRemote> receiver;
+
+    if ( mpi_rank == 0 )
+    {
+        relay = std::make_shared<HY_PointHydroNexusRemote>("nex-80", Catchments{"cat-82"}, Catchments{"cat-80", "cat-81"},
+                                                           loc_map_t{{"cat-81", 1}, {"cat-82", 1}});
+        sender = std::make_shared<HY_PointHydroNexusRemote>("nex-90", Catchments{"cat-92"}, Catchments{"cat-91"},
+                                                            loc_map_t{{"cat-92", 1}});
+        receiver = std::make_shared<HY_PointHydroNexusRemote>("nex-90", Catchments{"cat-92"}, Catchments{"cat-90"},
+                                                              loc_map_t{{"cat-90", 1}});
+    }
+    else if ( mpi_rank == 1 )
+    {
+        relay = std::make_shared<HY_PointHydroNexusRemote>("nex-90", Catchments{"cat-92"}, Catchments{"cat-90", "cat-91"},
+                                                           loc_map_t{{"cat-91", 0}, {"cat-92", 0}});
+        sender = std::make_shared<HY_PointHydroNexusRemote>("nex-80", Catchments{"cat-82"}, Catchments{"cat-81"},
+                                                            loc_map_t{{"cat-82", 0}});
+        receiver = std::make_shared<HY_PointHydroNexusRemote>("nex-80", Catchments{"cat-82"}, Catchments{"cat-80"},
+                                                              loc_map_t{{"cat-80", 0}});
+    }
+
+    std::vector<HY_PointHydroNexusRemote*> nexuses;
+    if ( mpi_rank < 2 )
+    {
+        ASSERT_EQ(HY_PointHydroNexusRemote::sender_receiver, relay->get_communicator_type());
+        nexuses = {relay.get(), sender.get(), receiver.get()};
+    }
+
+    HY_RemoteNexusExchange exchange(nexuses);
+
+    if ( mpi_rank < 2 )
+    {
+        ASSERT_EQ(1, exchange.downstream_neighbor_count());
+        ASSERT_EQ(1, exchange.upstream_neighbor_count());
+    }
+
+    long ts = 0;
+    for ( auto discharge : stored_discharge )
+    {
+        if ( mpi_rank == 0 )
+        {
+            relay->add_upstream_flow(discharge, "cat-80", ts);
+            sender->add_upstream_flow(discharge * 2, "cat-91", ts);
+        }
+        else if ( mpi_rank == 1 )
+        {
+            sender->add_upstream_flow(discharge * 3, "cat-81", ts);
+            relay->add_upstream_flow(discharge * 4, "cat-90", ts);
+        }
+
+        exchange.exchange(ts);
+
+        if ( mpi_rank == 0 )
+        {
+            ASSERT_DOUBLE_EQ(discharge * 6, receiver->get_downstream_flow("cat-92", ts, 100));
+        }
+        else if ( mpi_rank == 1 )
+        {
+            ASSERT_DOUBLE_EQ(discharge * 4, receiver->get_downstream_flow("cat-82", ts, 100));
+        }
+
+        ++ts;
+    }
+
+    MPI_Barrier(MPI_COMM_WORLD);
+}
+
 //#endif  // NGEN_MPI_TESTS_ACTIVE
 
 //#endif  // NGEN_MPI_TESTS_ACTIVE
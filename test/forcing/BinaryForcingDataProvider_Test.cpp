@@ -0,0 +1,221 @@
+#include "gtest/gtest.h"
+#include "BinaryForcingDataProvider.hpp"
+#include "CsvPerFeatureForcingProvider.hpp"
+#include "FileChecker.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using data_access::BinaryForcingDataProvider;
+using data_access::BinaryForcingFile;
+
+class BinaryForcingDataProviderTest : public ::testing::Test {
+
+    protected:
+
+    void SetUp() override {
+        path = "binary_forcing_test_" + std::to_string(getpid()) + ".bin";
+    }
+
+    void TearDown() override {
+        std::remove(path.c_str());
+    }
+
+    /**
+     * Write a file with two variables and three features on an hourly axis, where the value of variable v,
+     * feature i at time step t is 1000 * v + 100 * i + t.
+     */
+    void write_fixture() {
+        BinaryForcingFile::Layout layout;
+        layout.variables = {CSDMS_STD_NAME_SURFACE_TEMP, CSDMS_STD_NAME_LIQUID_EQ_PRECIP_RATE};
+        layout.units = {"K", "mm s^-1"};
+        layout.ids = {"cat-1", "cat-2", "cat-3"};
+        layout.start_time = start_time;
+        layout.time_step = 3600;
+        layout.time_steps = 6;
+
+        auto file = BinaryForcingFile::create(path, layout);
+        for (std::size_t v = 0; v < layout.variables.size(); ++v) {
+            for (std::size_t i = 0; i < layout.ids.size(); ++i) {
+                for (std::size_t t = 0; t < layout.time_steps; ++t) {
+                    file.mutable_series(v, i)[t] = 1000.0 * v + 100.0 * i + t;
+                }
+            }
+        }
+        file.sync();
+    }
+
+    std::shared_ptr<BinaryForcingDataProvider> open_fixture() {
+        write_fixture();
+        return std::make_shared<BinaryForcingDataProvider>(path, start_time, start_time + 5 * 3600);
+    }
+
+    static std::string find_csv() {
+        return utils::FileChecker::find_first_readable({
+            "test/data/forcing/cat-10_2015-12-01 00_00_00_2015-12-30 23_00_00.csv",
+            "../test/data/forcing/cat-10_2015-12-01 00_00_00_2015-12-30 23_00_00.csv",
+            "../../test/data/forcing/cat-10_2015-12-01 00_00_00_2015-12-30 23_00_00.csv"
+        });
+    }
+
+    std::string path;
+    const time_t start_time = 1448928000; // 2015-12-01 00:00:00
+};
+
+TEST_F(BinaryForcingDataProviderTest, FileRoundTrip) {
+    write_fixture();
+
+    auto file = BinaryForcingFile::open(path);
+    const auto& layout = file.layout();
+    ASSERT_EQ(layout.variables.size(), 2);
+    EXPECT_EQ(layout.variables[1], CSDMS_STD_NAME_LIQUID_EQ_PRECIP_RATE);
+    EXPECT_EQ(layout.units[0], "K");
+    EXPECT_EQ(layout.ids, std::vector<std::string>({"cat-1", "cat-2", "cat-3"}));
+    EXPECT_EQ(layout.start_time, start_time);
+    EXPECT_EQ(layout.time_step, 3600);
+    ASSERT_EQ(layout.time_steps, 6);
+    EXPECT_EQ(file.series(1, 2)[5], 1205.0);
+    EXPECT_EQ(file.series(0, 0)[0], 0.0);
+
+    // values are aligned for the mapping, so they can be read in place
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(file.series(0, 0)) % alignof(double), 0);
+    EXPECT_THROW(file.mutable_series(0, 0), std::logic_error);
+}
+
+TEST_F(BinaryForcingDataProviderTest, RejectsInvalidFiles) {
+    EXPECT_THROW(BinaryForcingFile::open(path), std::runtime_error);
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "not a forcing file, but long enough to have a header of the right size.......";
+    }
+    EXPECT_THROW(BinaryForcingFile::open(path), std::runtime_error);
+
+    // a valid file cut short
+    write_fixture();
+    ASSERT_EQ(truncate(path.c_str(), 4096 + 8), 0);
+    EXPECT_THROW(BinaryForcingFile::open(path), std::runtime_error);
+
+    // a feature count far beyond what the file holds is a format error, not an allocation failure
+    write_fixture();
+    {
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        const std::uint64_t n_ids = std::uint64_t(1) << 60;
+        out.seekp(8 + 4 + 4 + 8);
+        out.write(reinterpret_cast<const char*>(&n_ids), sizeof(n_ids));
+    }
+    EXPECT_THROW(BinaryForcingFile::open(path), std::runtime_error);
+
+    // as is a time step the writer would have refused
+    write_fixture();
+    {
+        std::fstream out(path, std::ios::binary | std::ios::in | std::ios::out);
+        const std::int64_t time_step = 0;
+        out.seekp(8 + 4 + 4 + 8 + 8 + 8 + 8);
+        out.write(reinterpret_cast<const char*>(&time_step), sizeof(time_step));
+    }
+    EXPECT_THROW(BinaryForcingFile::open(path), std::runtime_error);
+
+    BinaryForcingFile::Layout empty;
+    EXPECT_THROW(BinaryForcingFile::create(path, empty), std::runtime_error);
+}
+
+TEST_F(BinaryForcingDataProviderTest, AlignedAndPartialWindows) {
+    auto provider = open_fixture();
+
+    EXPECT_EQ(provider->record_duration(), 3600);
+    EXPECT_EQ(provider->get_ts_index_for_time(start_time + 3 * 3600 + 10), 3);
+    EXPECT_THROW(provider->get_ts_index_for_time(start_time - 1), std::out_of_range);
+    EXPECT_THROW(provider->get_ts_index_for_time(start_time + 6 * 3600), std::out_of_range);
+
+    // one whole time step
+    CatchmentAggrDataSelector selector("cat-2", CSDMS_STD_NAME_SURFACE_TEMP, start_time + 2 * 3600, 3600, "K");
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::MEAN), 102.0);
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::SUM), 102.0);
+
+    // half of a time step
+    selector.set_duration_secs(1800);
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::MEAN), 102.0);
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::SUM), 51.0);
+
+    // the second half of one time step, all of the next and a quarter of the one after that
+    selector.set_init_time(start_time + 2 * 3600 + 1800);
+    selector.set_duration_secs(1800 + 3600 + 900);
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::MEAN), (102.0 * 1800 + 103.0 * 3600 + 104.0 * 900) / 6300);
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::SUM), 102.0 * 0.5 + 103.0 + 104.0 * 0.25);
+
+    // running off the end of the file
+    selector.set_init_time(start_time + 5 * 3600);
+    selector.set_duration_secs(2 * 3600);
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::MEAN), 105.0);
+
+    selector.set_id("cat-4");
+    EXPECT_THROW(provider->get_value(selector, data_access::MEAN), std::out_of_range);
+}
+
+TEST_F(BinaryForcingDataProviderTest, AliasesOfWellKnownFields) {
+    auto provider = open_fixture();
+
+    auto names = provider->get_available_variable_names();
+    EXPECT_NE(std::find(names.begin(), names.end(), "T2D"), names.end());
+    EXPECT_NE(std::find(names.begin(), names.end(), "RAINRATE"), names.end());
+
+    CatchmentAggrDataSelector selector("cat-3", "TMP_2maboveground", start_time + 3600, 3600, "K");
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::MEAN), 201.0);
+    selector = CatchmentAggrDataSelector("cat-3", "precip_rate", start_time + 3600, 3600, "mm s^-1");
+    EXPECT_DOUBLE_EQ(provider->get_value(selector, data_access::MEAN), 1201.0);
+
+    selector = CatchmentAggrDataSelector("cat-3", "PRES_surface", start_time, 3600, "Pa");
+    EXPECT_THROW(provider->get_value(selector, data_access::MEAN), std::runtime_error);
+}
+
+TEST_F(BinaryForcingDataProviderTest, BatchQueryMatchesPerFeatureReads) {
+    auto provider = open_fixture();
+
+    CatchmentAggrDataSelector selector("", CSDMS_STD_NAME_LIQUID_EQ_PRECIP_RATE, start_time + 1800, 5400, "mm s^-1");
+    std::vector<std::string> ids = {"cat-3", "cat-1"};
+    std::vector<double> values(ids.size());
+    provider->get_values_for_ids(selector, ids, values, data_access::MEAN);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        selector.set_id(ids[i]);
+        EXPECT_DOUBLE_EQ(values[i], provider->get_value(selector, data_access::MEAN)) << ids[i];
+    }
+
+    std::vector<double> all(provider->get_ids().size());
+    provider->get_values_for_ids(selector, provider->get_ids(), all, data_access::MEAN);
+    EXPECT_DOUBLE_EQ(all[0], values[1]);
+    EXPECT_DOUBLE_EQ(all[2], values[0]);
+
+    ids = {"cat-5"};
+    values.resize(1);
+    EXPECT_THROW(provider->get_values_for_ids(selector, ids, values, data_access::MEAN), std::out_of_range);
+    EXPECT_THROW(provider->get_values_for_ids(selector, {}, values, data_access::MEAN), std::invalid_argument);
+}
+
+TEST_F(BinaryForcingDataProviderTest, ConvertedCsvMatchesCsvProvider) {
+    std::string csv_path = find_csv();
+    ASSERT_FALSE(csv_path.empty());
+    forcing_params params(csv_path, "CsvPerFeature", "2015-12-14 21:00:00", "2015-12-30 23:00:00");
+    auto csv = std::make_shared<CsvPerFeatureForcingProvider>(params);
+
+    data_access::write_binary_forcing(path, {{csv, {"cat-10"}}}, params.simulation_start_t, params.simulation_end_t);
+    BinaryForcingDataProvider binary(path, params.simulation_start_t, params.simulation_end_t);
+    EXPECT_EQ(binary.get_ids(), std::vector<std::string>({"cat-10"}));
+    EXPECT_EQ(binary.get_data_start_time(), csv->get_data_start_time());
+    EXPECT_EQ(binary.record_duration(), 3600);
+
+    for (const std::string name : {"APCP_surface", "TMP_2maboveground", "DLWRF_surface", CSDMS_STD_NAME_SURFACE_AIR_PRESSURE}) {
+        auto wkf = data_access::WellKnownFields.find(name);
+        std::string units = wkf == data_access::WellKnownFields.end() ? "Pa" : std::get<1>(wkf->second);
+        for (time_t t = params.simulation_start_t; t <= params.simulation_end_t; t += 7 * 3600) {
+            CatchmentAggrDataSelector selector("cat-10", name, t, 3600, units);
+            EXPECT_DOUBLE_EQ(binary.get_value(selector, data_access::MEAN), csv->get_value(selector, data_access::MEAN))
+                << name << " at " << t;
+        }
+    }
+}
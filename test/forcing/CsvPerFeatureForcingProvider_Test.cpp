@@ -10,6 +10,10 @@
 #include <limits.h>
 #include <ctime>
 #include <time.h>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <boost/lexical_cast.hpp>
 
 class CsvPerFeatureForcingProviderTest : public ::testing::Test {
 
@@ -31,6 +35,14 @@ class CsvPerFeatureForcingProviderTest : public ::testing::Test {
 
     std::shared_ptr<time_type> end_date_time;
 
+    //! Write a forcing file for a test, returning its path
+    static std::string write_csv(const std::string& contents) {
+        std::string path = "csv_forcing_test_" + std::to_string(getpid()) + ".csv";
+        std::ofstream out(path);
+        out << contents;
+        return path;
+    }
+
 };
 
 
@@ -256,3 +268,111 @@ TEST_F(CsvPerFeatureForcingProviderTest, TestForcingUnitHeaderNonParsing)
         EXPECT_EQ(in_value, out_value);
     }
 }
+
+///Test a time step other than an hour, with windows that cover parts of time steps
+TEST_F(CsvPerFeatureForcingProviderTest, TestOtherTimeStepsAndPartialSteps)
+{
+    std::string path = write_csv(
+        "time,TMP_2maboveground,APCP_surface\n"
+        "2015-12-01 00:00:00,270,1\n"
+        "2015-12-01 00:30:00,271,2\n"
+        "2015-12-01 01:00:00, 272 ,3\n"
+        "2015-12-01 01:30:00,273,+4\n"
+        "2015-12-01 02:00:00,274,5\n");
+    // starting part way into the first time step, which is still kept
+    forcing_params params(path, "CsvPerFeature", "2015-12-01 00:15:00", "2015-12-01 02:00:00");
+    CsvPerFeatureForcingProvider provider(params);
+    std::remove(path.c_str());
+    const time_t axis_start = params.simulation_start_t - 900;
+
+    EXPECT_EQ(provider.record_duration(), 1800);
+    EXPECT_EQ(provider.get_ts_index_for_time(axis_start + 3600 + 10), 2);
+    EXPECT_THROW(provider.get_ts_index_for_time(axis_start - 1), std::out_of_range);
+    EXPECT_THROW(provider.get_ts_index_for_time(axis_start + 5 * 1800), std::out_of_range);
+
+    CatchmentAggrDataSelector selector("", CSDMS_STD_NAME_SURFACE_TEMP, params.simulation_start_t, 3600, "K");
+    EXPECT_DOUBLE_EQ(provider.get_value(selector, data_access::MEAN), (270.0 * 900 + 271.0 * 1800 + 272.0 * 900) / 3600);
+
+    selector = CatchmentAggrDataSelector("", CSDMS_STD_NAME_RAIN_VOLUME_FLUX, params.simulation_start_t, 3600, "kg m^-2");
+    EXPECT_DOUBLE_EQ(provider.get_value(selector, data_access::SUM), 1.0 * 0.5 + 2.0 + 3.0 * 0.5);
+
+    // a window that runs past the end of the data takes the last value, unweighted
+    selector = CatchmentAggrDataSelector("", "TMP_2maboveground", axis_start + 4 * 1800, 3600, "K");
+    EXPECT_DOUBLE_EQ(provider.get_value(selector, data_access::MEAN), 274.0);
+    selector.set_init_time(axis_start + 3 * 1800 + 900);
+    EXPECT_DOUBLE_EQ(provider.get_value(selector, data_access::MEAN), 274.0);
+    selector = CatchmentAggrDataSelector("", "APCP_surface", axis_start + 3 * 1800 + 900, 3600, "kg m^-2");
+    EXPECT_DOUBLE_EQ(provider.get_value(selector, data_access::SUM), 5.0);
+    // while one that ends with the data is weighted as usual
+    selector = CatchmentAggrDataSelector("", "TMP_2maboveground", axis_start + 3 * 1800, 3600, "K");
+    EXPECT_DOUBLE_EQ(provider.get_value(selector, data_access::MEAN), (273.0 + 274.0) / 2);
+}
+
+///Test that malformed forcing files are rejected
+TEST_F(CsvPerFeatureForcingProviderTest, TestMalformedFilesRejected)
+{
+    const std::string header = "time,TMP_2maboveground\n";
+    const std::vector<std::string> bad_rows = {
+        // unevenly spaced
+        "2015-12-01 00:00:00,270\n2015-12-01 01:00:00,271\n2015-12-01 03:00:00,272\n",
+        // not increasing
+        "2015-12-01 01:00:00,270\n2015-12-01 00:00:00,271\n",
+        // not a number
+        "2015-12-01 00:00:00,270\n2015-12-01 01:00:00,27x\n",
+        // a missing field
+        "2015-12-01 00:00:00,270\n2015-12-01 01:00:00\n"
+    };
+    for (const auto& rows : bad_rows) {
+        std::string path = write_csv(header + rows);
+        forcing_params params(path, "CsvPerFeature", "2015-12-01 00:00:00", "2015-12-01 03:00:00");
+        EXPECT_THROW(CsvPerFeatureForcingProvider provider(params), std::runtime_error) << rows;
+        std::remove(path.c_str());
+    }
+}
+
+/**
+ * Time reading the test forcing files, against reading them the way they were read before they were parsed in a
+ * single pass: split into strings, with each time parsed by strptime and each value by lexical_cast. Disabled so
+ * timing does not slow the default test run; run it with --gtest_also_run_disabled_tests.
+ */
+TEST_F(CsvPerFeatureForcingProviderTest, DISABLED_TestInitTimeBenchmark)
+{
+    std::vector<std::string> paths;
+    for (const std::string name : {"cat-10_2015-12-01 00_00_00_2015-12-30 23_00_00.csv",
+                                   "cat-89_2015-12-01 00_00_00_2015-12-30 23_00_00.csv"}) {
+        paths.push_back(utils::FileChecker::find_first_readable({
+            "test/data/forcing/" + name, "../test/data/forcing/" + name, "../../test/data/forcing/" + name}));
+        ASSERT_FALSE(paths.back().empty()) << name;
+    }
+    const int repetitions = 20;
+
+    auto time = [&](auto reader) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; ++i) {
+            for (const auto& path : paths) {
+                reader(path);
+            }
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+    };
+
+    double split_strings = time([](const std::string& path) {
+        std::vector<std::vector<std::string>> data = CSVReader(path).getData();
+        std::vector<double> values;
+        for (std::size_t i = 1; i < data.size(); ++i) {
+            struct tm row_time = tm();
+            strptime(data[i][0].c_str(), "%Y-%m-%d %H:%M:%S", &row_time);
+            values.push_back(timegm(&row_time));
+            for (std::size_t c = 1; c < data[i].size(); ++c) {
+                boost::algorithm::trim(data[i][c]);
+                values.push_back(boost::lexical_cast<double>(data[i][c]));
+            }
+        }
+    });
+    double single_pass = time([](const std::string& path) {
+        CsvPerFeatureForcingProvider provider(forcing_params(path, "CsvPerFeature", "2015-12-01 00:00:00", "2015-12-30 23:00:00"));
+    });
+
+    std::cout << "Reading " << paths.size() << " forcing files, mean of " << repetitions << " runs: split strings "
+              << split_strings << " ms, single pass " << single_pass << " ms" << std::endl;
+}
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include "ForcingFileIndex.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <regex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using data_access::ForcingFileIndex;
+
+class ForcingFileIndexTest : public ::testing::Test {
+
+    protected:
+
+    void SetUp() override {
+        directory = "forcing_file_index_test_" + std::to_string(getpid()) + "/";
+        ASSERT_EQ(mkdir(directory.c_str(), 0755), 0);
+        for (const auto& name : files) {
+            std::ofstream(directory + name) << "time\n";
+        }
+        // a directory that matches patterns, which is never a forcing file
+        ASSERT_EQ(mkdir((directory + "cat-3_dir.csv").c_str(), 0755), 0);
+    }
+
+    void TearDown() override {
+        for (const auto& name : files) {
+            std::remove((directory + name).c_str());
+        }
+        rmdir((directory + "cat-3_dir.csv").c_str());
+        rmdir(directory.c_str());
+    }
+
+    //! The first file in the listing that matches the pattern for the id, found as before there was an index
+    std::string scan(const std::vector<ForcingFileIndex::entry>& entries, std::string pattern, const std::string& id) {
+        std::size_t id_index = pattern.find("{{id}}");
+        if (id_index != std::string::npos) {
+            pattern.replace(id_index, 6, id);
+        }
+        std::regex regex(pattern);
+        for (const auto& e : entries) {
+            if (std::regex_match(e.name, regex)) {
+                return directory + e.name;
+            }
+        }
+        return "";
+    }
+
+    std::string directory;
+    const std::vector<std::string> files = {
+        "cat-1_2015-12-01.csv", "cat-10_2015-12-01.csv", "cat-2_2015-12-01.csv", "cat-2_2015-12-01.txt",
+        "nex-1_2015-12-01.csv", "forcing.nc"
+    };
+    const std::vector<std::string> ids = {"cat-1", "cat-10", "cat-2", "cat-3", "cat-4"};
+};
+
+TEST_F(ForcingFileIndexTest, ListsOnlyPossibleFiles) {
+    auto entries = ForcingFileIndex::list_directory(directory);
+    std::vector<std::string> names;
+    for (const auto& e : entries) {
+        names.push_back(e.name);
+    }
+    std::sort(names.begin(), names.end());
+    auto expected = files;
+    std::sort(expected.begin(), expected.end());
+    EXPECT_EQ(names, expected);
+
+    EXPECT_THROW(ForcingFileIndex::list_directory(directory + "missing/"), std::runtime_error);
+}
+
+TEST_F(ForcingFileIndexTest, FindsSameFilesAsScanning) {
+    auto entries = ForcingFileIndex::list_directory(directory);
+    for (const std::string pattern : {".*{{id}}.*.csv", "{{id}}_.*\\.csv", "{{id}}_2015-12-01\\.(csv|txt)",
+                                      "(x|{{id}})_.*\\.csv", "[a-z]*-?{{id}}.*", "forcing\\.nc"}) {
+        ForcingFileIndex index(directory, pattern, entries, ids);
+        for (const std::string id : {"cat-1", "cat-10", "cat-2", "cat-4", "nex-1", "cat-1.", "cat"}) {
+            EXPECT_EQ(index.find(id), scan(entries, pattern, id)) << pattern << " for " << id;
+        }
+    }
+}
+
+TEST_F(ForcingFileIndexTest, MatchesNeedTheWholeId) {
+    ForcingFileIndex index(directory, "{{id}}_.*\\.csv", ForcingFileIndex::list_directory(directory), ids);
+    EXPECT_EQ(index.find("cat-1"), directory + "cat-1_2015-12-01.csv");
+    EXPECT_EQ(index.find("cat-10"), directory + "cat-10_2015-12-01.csv");
+    EXPECT_EQ(index.find("cat-4"), "");
+}
+
+TEST_F(ForcingFileIndexTest, UnknownFileTypesAreChecked) {
+    // as from a filesystem that does not report the types of directory entries
+    std::vector<ForcingFileIndex::entry> entries = {{"cat-3_dir.csv", false}, {"cat-2_2015-12-01.csv", false}};
+    ForcingFileIndex index(directory, "{{id}}_.*\\.csv", entries, ids);
+    EXPECT_EQ(index.find("cat-2"), directory + "cat-2_2015-12-01.csv");
+    EXPECT_THROW(index.find("cat-3"), std::runtime_error);
+
+    entries = {{"cat-5_2015-12-01.csv", false}};
+    ForcingFileIndex missing(directory, "{{id}}_.*\\.csv", entries, {"cat-5"});
+    EXPECT_THROW(missing.find("cat-5"), std::runtime_error);
+}
@@ -130,3 +130,29 @@ TEST_F(ForcingsEngineLumpedDataProviderTest, VariableAccess)
     ASSERT_GT(result2.size(), 0);
     EXPECT_NEAR(result2[0], 0, 1e-6);
 }
+
+/**
+ * Tests that providers for different divides of the same engine read
+ * their values from one shared snapshot of the engine's outputs, which
+ * holds what the engine reports for each divide.
+ */
+TEST_F(ForcingsEngineLumpedDataProviderTest, SharedSnapshot)
+{
+    auto other = std::make_unique<data_access::ForcingsEngineLumpedDataProvider>(
+        /*init=*/TestFixture::config_file,
+        /*time_begin_seconds=*/TestFixture::time_start,
+        /*time_end_seconds=*/TestFixture::time_end,
+        /*divide_id=*/"cat-11371"
+    );
+    ASSERT_NE(other->divide_index(), provider_->divide_index());
+
+    auto selector = CatchmentAggrDataSelector{"cat-11223", "T2D", time_start, 3600, "seconds"};
+    const auto result = provider_->get_value(selector, data_access::ReSampleMethod::SUM);
+
+    selector = CatchmentAggrDataSelector{"cat-11371", "T2D", time_start, 3600, "seconds"};
+    const auto other_result = other->get_value(selector, data_access::ReSampleMethod::SUM);
+
+    const auto* engine_values = static_cast<const double*>(provider_->model()->GetValuePtr("T2D_ELEMENT"));
+    EXPECT_EQ(result, engine_values[provider_->divide_index()]);
+    EXPECT_EQ(other_result, engine_values[other->divide_index()]);
+}
@@ -2,7 +2,14 @@
 
 #include <cmath>
 
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+
 #include <forcing/DataProvider.hpp>
+#include <forcing/GridAreaWeightedDataProvider.hpp>
+#include <forcing/GridCellWeights.hpp>
 #include <forcing/GridDataSelector.hpp>
 
 // A fake grid data provider containing a NxM uniform grid.
@@ -197,5 +204,183 @@ TEST(GridDataSelectorTest, PointSelection) {
     EXPECT_EQ(cells[1].y, 5);
 }
 
-// TODO: Add boundary/polygon constructor test
-// TEST(GridDataSelectorTest, PolygonSelection)
+inline geojson::polygon_t make_box_polygon(double xmin, double ymin, double xmax, double ymax)
+{ return BoundingBox{box_t{{xmin, ymin}, {xmax, ymax}}}.as_polygon(); }
+
+// Tests for boundary-based selection using a polygon
+// covering a block of cells in the middle of the grid.
+TEST(GridDataSelectorTest, PolygonSelection) {
+    GridSpecification grid_spec {
+        10,
+        10,
+        /*extent=*/box_t{{0, 0}, {1, 1}}
+    };
+
+    TestGridDataProvider provider{grid_spec};
+
+    GridDataSelector selector{
+        TestGridDataProvider::default_selector,
+        grid_spec,
+        make_box_polygon(0.22, 0.32, 0.48, 0.58)
+    };
+
+    const auto cells = provider.get_values(selector, data_access::ReSampleMethod::SUM);
+    ASSERT_EQ(cells.size(), 9);
+
+    for (const auto& cell : cells) {
+        EXPECT_GE(cell.x, 2);
+        EXPECT_LE(cell.x, 4);
+        EXPECT_GE(cell.y, 3);
+        EXPECT_LE(cell.y, 5);
+    }
+}
+
+// Tests that cell weights split each catchment by the area of
+// it in each cell, and that the area-weighted provider averages
+// the grid with them.
+TEST(GridDataSelectorTest, AreaWeightedAverage) {
+    GridSpecification grid_spec {
+        10,
+        10,
+        /*extent=*/box_t{{0, 0}, {1, 1}}
+    };
+
+    // cat-1 is one whole cell, cat-2 is half of each of two cells
+    // across a column boundary, and cat-3 is off the grid.
+    const std::vector<geojson::multipolygon_t> shapes = {
+        { make_box_polygon(0.2, 0.2, 0.3, 0.3) },
+        { make_box_polygon(0.55, 0.1, 0.65, 0.2) },
+        { make_box_polygon(2.0, 2.0, 2.1, 2.1) }
+    };
+
+    auto weights = data_access::GridCellWeights::build(grid_spec, {"cat-1", "cat-2", "cat-3"}, shapes);
+    ASSERT_EQ(weights.ids().size(), 3);
+    ASSERT_EQ(weights.row_weights(0).size(), 1);
+    EXPECT_NEAR(weights.row_weights(0)[0], 1.0, 1e-6);
+    ASSERT_EQ(weights.row_weights(1).size(), 2);
+    EXPECT_NEAR(weights.row_weights(1)[0], 0.5, 1e-3);
+    EXPECT_NEAR(weights.row_weights(1)[1], 0.5, 1e-3);
+    EXPECT_EQ(weights.row_weights(2).size(), 0);
+    EXPECT_EQ(weights.cells().size(), 3);
+
+    // The weights come back from their cache unchanged
+    const std::string cache_path = testing::TempDir() + "grid_cell_weights_test.bin";
+    std::remove(cache_path.c_str());
+    auto built = data_access::GridCellWeights::load_or_build(cache_path, grid_spec, {"cat-1", "cat-2", "cat-3"}, shapes);
+    auto cached = data_access::GridCellWeights::load(cache_path, built.get_key());
+    ASSERT_TRUE(cached.has_value());
+    EXPECT_EQ(cached->ids(), built.ids());
+    ASSERT_EQ(cached->row_weights(1).size(), 2);
+    EXPECT_EQ(cached->row_weights(1)[0], built.row_weights(1)[0]);
+    EXPECT_FALSE(data_access::GridCellWeights::load(cache_path, built.get_key() + 1).has_value());
+
+    // A cache whose row offsets do not start at 0 or that decrease is an error, not a cache miss
+    auto put_row_offset = [&](std::size_t row, std::uint64_t offset) {
+        std::fstream file(cache_path, std::ios::in | std::ios::out | std::ios::binary);
+        // past the 48 byte header, the ids (a 4 byte length and 5 bytes each) and the cells (16 bytes each)
+        file.seekp(48 + 3 * 9 + built.cells().size() * 16 + row * sizeof(offset));
+        file.write(reinterpret_cast<const char*>(&offset), sizeof(offset));
+    };
+    put_row_offset(0, 1);
+    EXPECT_THROW(data_access::GridCellWeights::load(cache_path, built.get_key()), std::runtime_error);
+    put_row_offset(0, 0);
+    ASSERT_TRUE(data_access::GridCellWeights::load(cache_path, built.get_key()).has_value());
+    put_row_offset(2, 0);
+    EXPECT_THROW(data_access::GridCellWeights::load(cache_path, built.get_key()), std::runtime_error);
+    std::remove(cache_path.c_str());
+
+    data_access::GridAreaWeightedDataProvider provider{
+        std::make_shared<TestGridDataProvider>(grid_spec),
+        std::make_shared<const data_access::GridCellWeights>(std::move(weights))
+    };
+
+    // The test grid holds row + column in each cell
+    std::vector<std::string> ids = {"cat-1", "cat-2", "cat-3"};
+    std::vector<double> values(3);
+    provider.get_values_for_ids(CatchmentAggrDataSelector{"", "variable", 0, 3599, "m"}, ids, values);
+    EXPECT_NEAR(values[0], 4.0, 1e-6);
+    EXPECT_NEAR(values[1], 6.5, 1e-3);
+    EXPECT_TRUE(std::isnan(values[2]));
+
+    EXPECT_NEAR(provider.get_value(CatchmentAggrDataSelector{"cat-2", "variable", 0, 3599, "m"}, data_access::SUM), 6.5, 1e-3);
+    EXPECT_THROW(provider.get_value(CatchmentAggrDataSelector{"cat-4", "variable", 0, 3599, "m"}, data_access::SUM), std::out_of_range);
+}
+
+// Tests that the cells of a projected grid are weighted by their plane area,
+// with no scaling by latitude.
+TEST(GridDataSelectorTest, AreaWeightedProjectedGrid) {
+    GridSpecification grid_spec {
+        3,
+        3,
+        /*extent=*/box_t{{0, 0}, {3000, 3000}},
+        /*geographic=*/false
+    };
+
+    // A third of the catchment is in the first cell and two thirds in the second;
+    // taken as degrees, the latitude of its row would give a negative scale
+    const std::vector<geojson::multipolygon_t> shapes = {
+        { make_box_polygon(500, 500, 2000, 1000) }
+    };
+
+    auto weights = data_access::GridCellWeights::build(grid_spec, {"cat-1"}, shapes);
+    ASSERT_EQ(weights.row_weights(0).size(), 2);
+    EXPECT_NEAR(weights.row_weights(0)[0], 1.0 / 3, 1e-9);
+    EXPECT_NEAR(weights.row_weights(0)[1], 2.0 / 3, 1e-9);
+    EXPECT_EQ(weights.cells()[0].x, 0);
+    EXPECT_EQ(weights.cells()[1].x, 1);
+
+    // Weights of a projected grid are not those of the same grid in degrees
+    GridSpecification geographic_spec = grid_spec;
+    geographic_spec.geographic = true;
+    EXPECT_NE(data_access::GridCellWeights::key(geographic_spec, std::vector<std::string>{"cat-1"}, shapes),
+              weights.get_key());
+}
+
+// A fake grid data provider that counts the reads of its grid.
+struct CountingGridDataProvider : public TestGridDataProvider
+{
+    using TestGridDataProvider::TestGridDataProvider;
+
+    std::vector<Cell> get_values(const GridDataSelector& selector, data_access::ReSampleMethod method) override
+    {
+        ++reads;
+        return TestGridDataProvider::get_values(selector, method);
+    }
+
+    std::size_t reads = 0;
+};
+
+// Tests that catchments asking for several variables in turn read the grid
+// once per variable and window, not once per query.
+TEST(GridDataSelectorTest, AreaWeightedAveragesCachedPerVariable) {
+    GridSpecification grid_spec {
+        10,
+        10,
+        /*extent=*/box_t{{0, 0}, {1, 1}}
+    };
+    const std::vector<geojson::multipolygon_t> shapes = {
+        { make_box_polygon(0.2, 0.2, 0.3, 0.3) },
+        { make_box_polygon(0.55, 0.1, 0.65, 0.2) }
+    };
+    auto source = std::make_shared<CountingGridDataProvider>(grid_spec);
+    data_access::GridAreaWeightedDataProvider provider{
+        source,
+        std::make_shared<const data_access::GridCellWeights>(
+            data_access::GridCellWeights::build(grid_spec, {"cat-1", "cat-2"}, shapes))
+    };
+
+    const std::vector<std::string> variables = {"rain", "temperature", "wind"};
+    for (const time_t start : {0L, 1800L}) {
+        for (const std::string id : {"cat-1", "cat-2"}) {
+            for (const auto& variable : variables) {
+                provider.get_value(CatchmentAggrDataSelector{id, variable, start, 1799, "m"}, data_access::SUM);
+            }
+        }
+    }
+    EXPECT_EQ(source->reads, 2 * variables.size());
+
+    // Another resampling method or unit is another query of the grid
+    provider.get_value(CatchmentAggrDataSelector{"cat-1", "rain", 1800, 1799, "m"}, data_access::MEAN);
+    provider.get_value(CatchmentAggrDataSelector{"cat-1", "wind", 1800, 1799, "mm"}, data_access::SUM);
+    EXPECT_EQ(source->reads, 2 * variables.size() + 2);
+}
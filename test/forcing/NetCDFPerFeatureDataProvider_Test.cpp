@@ -371,6 +371,109 @@ TEST_F(NetCDFCacheLayoutTest, ReadStraddlesPageBoundary)
     EXPECT_NEAR(provider.get_value(all, data_access::SUM), expected_sum, tol);
 }
 
+// Pages read ahead by the background thread hold the same values as pages read on demand,
+// including the partial final page, and reads that skip ahead or go back still find their pages.
+TEST_F(NetCDFCacheLayoutTest, ReadAheadMatchesOnDemandReads)
+{
+    const std::size_t n_cats = 3, n_times = 50, chunk = 8; // pages: 8 x 6, then 2
+    auto path = makeForcing("nc_cache_read_ahead.nc", n_cats, n_times, chunk);
+    NetCDFPerFeatureDataProvider provider(path, kStartEpoch, kStartEpoch + n_times * kStride, utils::getStdErr());
+    provider.set_read_ahead(2);
+    provider.set_read_ahead(2);
+
+    for (std::size_t t = 0; t < n_times; ++t) {
+        for (std::size_t cat = 0; cat < n_cats; ++cat) {
+            EXPECT_DOUBLE_EQ(readStep(provider, cat, t), cellValue(cat, t))
+                << "cat=" << cat << " t=" << t;
+        }
+    }
+
+    EXPECT_DOUBLE_EQ(readStep(provider, 1, 3), cellValue(1, 3));
+    EXPECT_DOUBLE_EQ(readStep(provider, 2, 41), cellValue(2, 41));
+
+    // changing the depth restarts the read-ahead thread; turning it off stops it
+    provider.set_read_ahead(4);
+    EXPECT_DOUBLE_EQ(readStep(provider, 0, 17), cellValue(0, 17));
+    provider.set_read_ahead(0);
+    EXPECT_DOUBLE_EQ(readStep(provider, 0, 49), cellValue(0, 49));
+    provider.finalize();
+}
+
+// A batch query returns what get_value returns for each catchment, for windows within a page,
+// across page boundaries, and shorter than a time step.
+TEST_F(NetCDFCacheLayoutTest, BatchQueryMatchesPerFeatureReads)
+{
+    const std::size_t n_cats = 4, n_times = 50, chunk = 24; // pages: 24, 24, 2
+    auto path = makeForcing("nc_cache_batch.nc", n_cats, n_times, chunk);
+    NetCDFPerFeatureDataProvider provider(path, kStartEpoch, kStartEpoch + n_times * kStride, utils::getStdErr());
+
+    const std::vector<std::string> subset = {"cat-3", "cat-0", "cat-2"};
+    struct Window { std::size_t t; time_t duration; };
+    for (const Window w : {Window{0, kStride}, Window{23, 2 * kStride}, Window{44, 6 * kStride}, Window{7, kStride / 2}, Window{0, n_times * kStride}}) {
+        for (const auto m : {data_access::MEAN, data_access::SUM}) {
+            CatchmentAggrDataSelector selector("", "temp", kStartEpoch + w.t * kStride, w.duration, "K");
+
+            std::vector<double> all(n_cats);
+            provider.get_values_for_ids(selector, provider.get_ids(), all, m);
+            for (std::size_t cat = 0; cat < n_cats; ++cat) {
+                selector.set_id("cat-" + std::to_string(cat));
+                EXPECT_NEAR(all[cat], provider.get_value(selector, m), 1e-9) << "cat=" << cat << " t=" << w.t;
+            }
+
+            std::vector<double> some(subset.size());
+            provider.get_values_for_ids(selector, subset, some, m);
+            for (std::size_t i = 0; i < subset.size(); ++i) {
+                selector.set_id(subset[i]);
+                EXPECT_NEAR(some[i], provider.get_value(selector, m), 1e-9) << subset[i] << " t=" << w.t;
+            }
+        }
+    }
+
+    CatchmentAggrDataSelector selector("", "temp", kStartEpoch, kStride, "K");
+    std::vector<double> one(1);
+    std::vector<std::string> missing = {"cat-9"};
+    EXPECT_THROW(provider.get_values_for_ids(selector, missing, one), std::out_of_range);
+    EXPECT_THROW(provider.get_values_for_ids(selector, subset, one), std::invalid_argument);
+    // Only the listed features are read
+    std::vector<double> none;
+    provider.get_values_for_ids(selector, {}, none);
+    EXPECT_THROW(provider.get_values_for_ids(selector, {}, one), std::invalid_argument);
+}
+
+// A compiled query is shared by selectors that differ only in id and start time, and gives
+// the same values as get_value wherever the window falls.
+TEST_F(NetCDFCacheLayoutTest, CompiledQueryMatchesSelectorReads)
+{
+    const std::size_t n_cats = 3, n_times = 50, chunk = 24; // pages: 24, 24, 2
+    auto path = makeForcing("nc_cache_compiled.nc", n_cats, n_times, chunk);
+    NetCDFPerFeatureDataProvider provider(path, kStartEpoch, kStartEpoch + n_times * kStride, utils::getStdErr());
+
+    CatchmentAggrDataSelector selector("cat-0", "temp", kStartEpoch, 3 * kStride, "K");
+    auto query = provider.compile_query(selector, data_access::MEAN);
+    CatchmentAggrDataSelector other("cat-2", "temp", kStartEpoch + 7 * kStride, 3 * kStride, "K");
+    EXPECT_EQ(provider.compile_query(other, data_access::MEAN), query);
+    EXPECT_NE(provider.compile_query(other, data_access::SUM), query);
+    other.set_duration_secs(kStride);
+    EXPECT_NE(provider.compile_query(other, data_access::MEAN), query);
+
+    // aligned, offset by half a time step, straddling pages, and running past the end of the data
+    for (const time_t offset : {time_t(0), kStride / 2}) {
+        for (const std::size_t t : {0, 10, 22, 23, 47, 48, 49}) {
+            for (std::size_t cat = 0; cat < n_cats; ++cat) {
+                selector.set_id("cat-" + std::to_string(cat));
+                selector.set_init_time(kStartEpoch + t * kStride + offset);
+                EXPECT_NEAR(provider.get_value(query, cat, selector.get_init_time()), provider.get_value(selector, data_access::MEAN), 1e-9)
+                    << "cat=" << cat << " t=" << t << " offset=" << offset;
+            }
+        }
+    }
+
+    EXPECT_THROW(provider.get_value(query, n_cats, kStartEpoch), std::out_of_range);
+    EXPECT_THROW(provider.get_value(query + 100, 0, kStartEpoch), std::invalid_argument);
+    EXPECT_THROW(provider.compile_query(CatchmentAggrDataSelector("cat-0", "T3D", kStartEpoch, kStride, "K"), data_access::MEAN),
+                 std::runtime_error);
+}
+
 // Each recognized time `units` token maps to the expected unit and scale factor,
 // and a bare units string reports no reference epoch.
 TEST(NetCDFTimeMetadata, InterpretTimeUnitsRecognized)
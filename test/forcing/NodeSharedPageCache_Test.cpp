@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+#include "NodeSharedPageCache.hpp"
+
+#include <mpi.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using data_access::NodeSharedPageCache;
+
+class NodeSharedPageCacheTest : public ::testing::Test {
+
+    protected:
+
+    static void SetUpTestSuite()
+    {
+        MPI_Init(NULL, NULL);
+    }
+
+    static void TearDownTestSuite()
+    {
+        MPI_Finalize();
+    }
+
+    void SetUp() override {
+        MPI_Comm_split_type(MPI_COMM_WORLD, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+    }
+
+    void TearDown() override {
+        MPI_Comm_free(&node_comm);
+    }
+
+    //! Fill a page with values that identify it
+    static void fill(double* values, std::size_t var_idx, std::size_t page_idx) {
+        for (std::size_t i = 0; i < PAGE_VALUES; ++i) {
+            values[i] = 1000.0 * var_idx + 10.0 * page_idx + i;
+        }
+    }
+
+    //! Fetch a page, counting the loads, and check that what was copied out is the page
+    void fetch_and_check(NodeSharedPageCache& cache, std::size_t var_idx, std::size_t page_idx, int& loads) {
+        std::vector<double> copied(PAGE_VALUES);
+        cache.fetch(var_idx, page_idx,
+                    [&](double* values) { ++loads; fill(values, var_idx, page_idx); },
+                    [&](const double* values) { std::copy_n(values, PAGE_VALUES, copied.begin()); });
+        std::vector<double> expected(PAGE_VALUES);
+        fill(expected.data(), var_idx, page_idx);
+        EXPECT_EQ(copied, expected) << "variable " << var_idx << ", page " << page_idx;
+    }
+
+    static const std::size_t PAGE_VALUES = 16;
+    MPI_Comm node_comm;
+};
+
+TEST_F(NodeSharedPageCacheTest, LoadsEachPageOncePerNode) {
+    NodeSharedPageCache cache(node_comm, 0, 2, 2, PAGE_VALUES);
+    ASSERT_TRUE(cache.usable());
+
+    int loads = 0;
+    fetch_and_check(cache, 1, 3, loads);
+    fetch_and_check(cache, 0, 3, loads);
+    MPI_Barrier(node_comm);
+    fetch_and_check(cache, 1, 3, loads);
+    fetch_and_check(cache, 0, 3, loads);
+
+    int node_loads;
+    MPI_Allreduce(&loads, &node_loads, 1, MPI_INT, MPI_SUM, node_comm);
+    EXPECT_EQ(node_loads, 2);
+
+    MPI_Barrier(node_comm);
+    cache.free();
+}
+
+TEST_F(NodeSharedPageCacheTest, ReloadsEvictedPages) {
+    NodeSharedPageCache cache(node_comm, 0, 1, 2, PAGE_VALUES);
+    int rank;
+    MPI_Comm_rank(node_comm, &rank);
+
+    if (rank == 0) {
+        int loads = 0;
+        fetch_and_check(cache, 0, 1, loads);
+        fetch_and_check(cache, 0, 2, loads);
+        fetch_and_check(cache, 0, 1, loads);
+        EXPECT_EQ(loads, 2);
+
+        // page 3 takes the slot of page 1
+        fetch_and_check(cache, 0, 3, loads);
+        fetch_and_check(cache, 0, 1, loads);
+        EXPECT_EQ(loads, 4);
+    }
+
+    MPI_Barrier(node_comm);
+    cache.free();
+}
+
+TEST_F(NodeSharedPageCacheTest, FailedLoadLeavesSlotEmpty) {
+    NodeSharedPageCache cache(node_comm, 0, 1, 1, PAGE_VALUES);
+    int rank;
+    MPI_Comm_rank(node_comm, &rank);
+
+    if (rank == 0) {
+        EXPECT_THROW(cache.fetch(0, 0, [](double*) { throw std::runtime_error("read failed"); }, [](const double*) {}),
+                     std::runtime_error);
+        int loads = 0;
+        fetch_and_check(cache, 0, 0, loads);
+        EXPECT_EQ(loads, 1);
+    }
+
+    MPI_Barrier(node_comm);
+    cache.free();
+}
+
+TEST_F(NodeSharedPageCacheTest, ConcurrentFetchesSeeWholePages) {
+    // threads stand in for the ranks of a node, each wanting pages that share slots with the others'
+    NodeSharedPageCache cache(node_comm, 0, 1, 2, PAGE_VALUES);
+    int rank;
+    MPI_Comm_rank(node_comm, &rank);
+
+    if (rank == 0) {
+        std::atomic<int> torn{0};
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; ++t) {
+            threads.emplace_back([&, t]() {
+                std::vector<double> copied(PAGE_VALUES), expected(PAGE_VALUES);
+                for (std::size_t i = 0; i < 2000; ++i) {
+                    std::size_t page = (i + t) % 6;
+                    cache.fetch(0, page,
+                                [&](double* values) { fill(values, 0, page); },
+                                [&](const double* values) { std::copy_n(values, PAGE_VALUES, copied.begin()); });
+                    fill(expected.data(), 0, page);
+                    if (copied != expected) {
+                        ++torn;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        EXPECT_EQ(torn, 0);
+    }
+
+    MPI_Barrier(node_comm);
+    cache.free();
+}
@@ -0,0 +1,190 @@
+#include "gtest/gtest.h"
+#include <FeatureBuilder.hpp>
+#include <StreamingReader.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/property_tree/json_parser.hpp>
+
+class StreamingReader_Test : public ::testing::Test {
+
+    protected:
+
+    StreamingReader_Test() {
+
+    }
+
+    ~StreamingReader_Test() override {
+
+    }
+
+    void SetUp() override {};
+
+    void TearDown() override {};
+
+    /**
+     * Find a fixture under the repository's data directory, which may be a few levels above the working directory.
+     */
+    static std::string find_fixture(const std::string& basename) {
+        for (const std::string dir : {"data/", "./data/", "../data/", "../../data/"}) {
+            std::ifstream file(dir + basename);
+            if (file.good()) {
+                return dir + basename;
+            }
+        }
+        return "";
+    }
+
+    //! Build a collection the way geojson::read did before the streaming reader
+    static geojson::GeoJSON read_property_tree(const std::string& path, const std::vector<std::string>& ids = {}) {
+        boost::property_tree::ptree tree;
+        boost::property_tree::json_parser::read_json(path, tree);
+        return geojson::build_collection(tree, ids);
+    }
+
+    static std::string to_wkt(const geojson::geometry& geometry) {
+        return boost::apply_visitor([](const auto& g) {
+            std::stringstream stream;
+            stream << bg::wkt(g);
+            return stream.str();
+        }, geometry);
+    }
+
+    static void expect_same_collection(const geojson::GeoJSON& expected, const geojson::GeoJSON& actual) {
+        ASSERT_EQ(expected->get_size(), actual->get_size());
+        EXPECT_EQ(expected->get_bounding_box(), actual->get_bounding_box());
+
+        for (int i = 0; i < expected->get_size(); ++i) {
+            geojson::Feature e = expected->get_feature(i);
+            geojson::Feature a = actual->get_feature(i);
+            ASSERT_EQ(e->get_id(), a->get_id());
+            EXPECT_EQ(e->get_type(), a->get_type()) << e->get_id();
+            EXPECT_EQ(e->get_bounding_box(), a->get_bounding_box()) << e->get_id();
+            EXPECT_EQ(actual->get_feature(a->get_id()), a);
+
+            ASSERT_EQ(e->property_keys(), a->property_keys()) << e->get_id();
+            for (const auto& key : e->property_keys()) {
+                EXPECT_EQ(e->get_property(key).get_type(), a->get_property(key).get_type()) << e->get_id() << " " << key;
+                EXPECT_EQ(e->get_property(key).as_string(), a->get_property(key).as_string()) << e->get_id() << " " << key;
+            }
+            ASSERT_EQ(e->keys(), a->keys()) << e->get_id();
+
+            if (e->get_type() == geojson::FeatureType::GeometryCollection) {
+                auto e_collection = e->get_geometry_collection();
+                auto a_collection = a->get_geometry_collection();
+                ASSERT_EQ(e_collection.size(), a_collection.size()) << e->get_id();
+                for (std::size_t g = 0; g < e_collection.size(); ++g) {
+                    EXPECT_EQ(to_wkt(e_collection[g]), to_wkt(a_collection[g])) << e->get_id();
+                }
+            }
+            else if (e->get_type() != geojson::FeatureType::None) {
+                EXPECT_EQ(to_wkt(e->geometry()), to_wkt(a->geometry())) << e->get_id();
+            }
+        }
+    }
+
+};
+
+TEST_F(StreamingReader_Test, matches_property_tree_on_fixtures) {
+    for (const std::string name : {"catchment_data.geojson", "catchment_data_multilayer.geojson", "flowpath_data.geojson",
+                                   "nexus_data.geojson", "catchment_data_test1.geojson"}) {
+        std::string path = find_fixture(name);
+        ASSERT_FALSE(path.empty()) << "could not find " << name;
+        SCOPED_TRACE(name);
+        expect_same_collection(read_property_tree(path), geojson::read_streaming(path));
+    }
+}
+
+TEST_F(StreamingReader_Test, subset_matches_property_tree) {
+    std::string path = find_fixture("catchment_data.geojson");
+    ASSERT_FALSE(path.empty());
+
+    geojson::GeoJSON all = geojson::read_streaming(path);
+    ASSERT_GT(all->get_size(), 1);
+    std::vector<std::string> subset = {all->get_feature(all->get_size() - 1)->get_id(), "not-a-feature"};
+
+    geojson::GeoJSON streamed = geojson::read_streaming(path, subset);
+    ASSERT_EQ(streamed->get_size(), 1);
+    EXPECT_EQ(streamed->get_feature(0)->get_id(), subset[0]);
+    expect_same_collection(read_property_tree(path, subset), streamed);
+}
+
+TEST_F(StreamingReader_Test, members_in_any_order) {
+    // The id comes after the geometry, and the geometry type after its coordinates
+    std::stringstream stream(
+        "{\"features\": [{\"geometry\": {\"coordinates\": [[1, 2], [3.5, -4e1]], \"type\": \"LineString\"},"
+        " \"properties\": {\"name\": \"a \\\"quoted\\\" \\u00e9\", \"count\": 3, \"ratio\": 0.5, \"flag\": true,"
+        " \"nested\": {\"x\": 1}, \"list\": [1, 2], \"nothing\": null, \"empty\": []},"
+        " \"id\": \"line-1\", \"type\": \"Feature\"}], \"type\": \"FeatureCollection\", \"bbox\": [0, 1]}");
+
+    geojson::GeoJSON collection = geojson::read_streaming(stream);
+    ASSERT_EQ(collection->get_size(), 1);
+    EXPECT_EQ(collection->get_bounding_box(), std::vector<double>({0.0, 1.0}));
+
+    geojson::Feature feature = collection->get_feature("line-1");
+    ASSERT_NE(feature, nullptr);
+    ASSERT_EQ(feature->get_type(), geojson::FeatureType::LineString);
+    geojson::linestring_t line = boost::get<geojson::linestring_t>(feature->geometry());
+    ASSERT_EQ(line.size(), 2);
+    EXPECT_EQ(line[1].get<0>(), 3.5);
+    EXPECT_EQ(line[1].get<1>(), -40.0);
+
+    EXPECT_EQ(feature->get_property("name").as_string(), "a \"quoted\" \xc3\xa9");
+    EXPECT_EQ(feature->get_property("count").get_type(), geojson::PropertyType::Natural);
+    EXPECT_EQ(feature->get_property("ratio").get_type(), geojson::PropertyType::Real);
+    EXPECT_EQ(feature->get_property("flag").get_type(), geojson::PropertyType::Boolean);
+    EXPECT_EQ(feature->get_property("nested").get_type(), geojson::PropertyType::Object);
+    EXPECT_EQ(feature->get_property("list").as_natural_vector(), std::vector<long>({1, 2}));
+    EXPECT_EQ(feature->get_property("nothing").as_string(), "null");
+    EXPECT_EQ(feature->get_property("empty").as_string(), "");
+    EXPECT_EQ(feature->get("type").as_string(), "Feature");
+}
+
+TEST_F(StreamingReader_Test, malformed_documents_throw) {
+    for (const std::string text : {"", "{\"features\": [", "{\"features\": [{\"id\": \"a\"}] ", "{\"features\": [{\"id\": }]}",
+                                   "{\"features\": [{\"geometry\": {\"type\": \"Point\", \"coordinates\": [1]}}]}",
+                                   "{\"features\": []} trailing"}) {
+        std::stringstream stream(text);
+        EXPECT_THROW(geojson::read_streaming(stream), std::runtime_error) << text;
+    }
+}
+
+/**
+ * Not a correctness check: reports the time taken by the property tree and streaming readers on the largest
+ * fixture, both for the whole file and for a small subset of it. Disabled so timing does not slow the default
+ * test run; run it with --gtest_also_run_disabled_tests.
+ */
+TEST_F(StreamingReader_Test, DISABLED_benchmark_against_property_tree) {
+    std::string path = find_fixture("catchment_data_test1.geojson");
+    ASSERT_FALSE(path.empty());
+    const int repetitions = 10;
+
+    std::vector<std::string> subset;
+    geojson::GeoJSON all = geojson::read_streaming(path);
+    for (int i = 0; i < all->get_size(); i += 10) {
+        subset.push_back(all->get_feature(i)->get_id());
+    }
+
+    auto time = [&](auto reader) {
+        auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < repetitions; ++i) {
+            reader();
+        }
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / repetitions;
+    };
+
+    double tree_all = time([&]() { read_property_tree(path); });
+    double stream_all = time([&]() { geojson::read_streaming(path); });
+    double tree_subset = time([&]() { read_property_tree(path, subset); });
+    double stream_subset = time([&]() { geojson::read_streaming(path, subset); });
+
+    std::cout << "Reading " << path << " (" << all->get_size() << " features), mean of " << repetitions << " runs:\n"
+              << "  all features:     property tree " << tree_all << " ms, streaming " << stream_all << " ms\n"
+              << "  " << subset.size() << " feature subset: property tree " << tree_subset << " ms, streaming "
+              << stream_subset << " ms" << std::endl;
+}
@@ -100,3 +100,53 @@ TEST_F(GeoPackage_Test, geopackage_projection_test)
 
     ASSERT_TRUE(third == nullptr);
 }
+
+TEST_F(GeoPackage_Test, geopackage_skip_geometry_test)
+{
+    ngen::geopackage::read_options options;
+    options.geometry = false;
+
+    const auto gpkg = ngen::geopackage::read(this->path2, "example_3857", {}, options);
+    EXPECT_EQ(2, gpkg->get_size());
+    EXPECT_TRUE(gpkg->get_bounding_box().empty());
+
+    const auto& first = gpkg->get_feature("First");
+    ASSERT_TRUE(first != nullptr);
+    EXPECT_EQ(first->get_type(), geojson::FeatureType::GeometryCollection);
+    EXPECT_TRUE(first->get_geometry_collection().empty());
+    EXPECT_TRUE(first->get_bounding_box().empty());
+    EXPECT_FALSE(first->has_property("geom"));
+    EXPECT_EQ(first->get_property("id").as_string(), "First");
+}
+
+TEST_F(GeoPackage_Test, geopackage_column_subset_test)
+{
+    ngen::geopackage::read_options options;
+    options.columns = { "not_a_column" };
+
+    // only the ID and geometry columns are loaded, and the missing column is ignored
+    const auto gpkg = ngen::geopackage::read(this->path, "test", { "Second" }, options);
+    ASSERT_EQ(1, gpkg->get_size());
+
+    const auto& second = gpkg->get_feature(0);
+    EXPECT_EQ(second->get_id(), "Second");
+    EXPECT_EQ(second->property_keys(), std::vector<std::string>{ "id" });
+    EXPECT_EQ(second->get_type(), geojson::FeatureType::LineString);
+    EXPECT_EQ(gpkg->get_bounding_box().size(), 4);
+}
+
+TEST_F(GeoPackage_Test, geopackage_large_idsubset_test)
+{
+    // more IDs than SQLite allows bound parameters in one statement, with duplicates
+    std::vector<std::string> ids;
+    for (int i = 0; i < 40000; ++i) {
+        ids.push_back("missing-" + std::to_string(i));
+    }
+    ids.push_back("Second");
+    ids.push_back("Second");
+
+    const auto gpkg = ngen::geopackage::read(this->path, "test", ids);
+    ASSERT_EQ(1, gpkg->get_size());
+    EXPECT_EQ(gpkg->get_feature(0)->get_id(), "Second");
+    EXPECT_EQ(gpkg->find("First"), -1);
+}
@@ -1803,3 +1803,19 @@ TEST_F(Formulation_Manager_Test, read_external_attributes) {
     check_formulation_values(manager, "cat-27",    { 3.00000, 18.0 });
     check_formulation_values(manager, "cat-67", { 7.41722, 9231 });
 }
+
+TEST_F(Formulation_Manager_Test, uses_catchment_geometry) {
+    std::stringstream without_grid;
+    without_grid << R"({ "global": { "forcing": { "path": "forcing.csv", "provider": "CsvPerFeature" } },
+                         "catchments": { "cat-1": { "forcing": { "path": "cat-1.csv" } } } })";
+    boost::property_tree::ptree config;
+    boost::property_tree::json_parser::read_json(without_grid, config);
+    EXPECT_FALSE(realization::Formulation_Manager::uses_catchment_geometry(config));
+
+    // a gridded forcing on any one catchment needs the geometry of every catchment
+    std::stringstream with_grid;
+    with_grid << R"({ "global": { "forcing": { "path": "forcing.csv", "provider": "CsvPerFeature" } },
+                      "catchments": { "cat-1": { "forcing": { "path": "grid.nc", "provider": "GridAreaWeighted" } } } })";
+    boost::property_tree::json_parser::read_json(with_grid, config);
+    EXPECT_TRUE(realization::Formulation_Manager::uses_catchment_geometry(config));
+}
@@ -289,6 +289,38 @@ TEST_F(Bmi_C_Formulation_Test, Initialize_0_b) {
     ASSERT_FALSE(get_friend_cache_input_variable_metadata(formulation));
 }
 
+/** Test that a module is only advanced concurrently when its config opts in. */
+TEST_F(Bmi_C_Formulation_Test, Initialize_0_c) {
+    int ex_index = 0;
+
+    Bmi_C_Formulation formulation(catchment_ids[ex_index], std::make_shared<CsvPerFeatureForcingProvider>(*forcing_params_examples[ex_index]), utils::StreamHandler());
+    formulation.create_formulation(config_prop_ptree[ex_index]);
+    ASSERT_FALSE(formulation.is_concurrency_safe());
+
+    boost::property_tree::ptree opted_in = config_prop_ptree[ex_index];
+    opted_in.put(BMI_REALIZATION_CFG_PARAM_OPT__CONCURRENCY_SAFE, true);
+    Bmi_C_Formulation concurrent(catchment_ids[ex_index], std::make_shared<CsvPerFeatureForcingProvider>(*forcing_params_examples[ex_index]), utils::StreamHandler());
+    concurrent.create_formulation(opted_in);
+    ASSERT_TRUE(concurrent.is_concurrency_safe());
+}
+
+/** Test that opting in has no effect when the forcing provider can not be queried concurrently. */
+TEST_F(Bmi_C_Formulation_Test, Initialize_0_d) {
+    int ex_index = 0;
+
+    class SerialForcingProvider : public CsvPerFeatureForcingProvider {
+    public:
+        using CsvPerFeatureForcingProvider::CsvPerFeatureForcingProvider;
+        bool supports_concurrent_access() const override { return false; }
+    };
+
+    boost::property_tree::ptree opted_in = config_prop_ptree[ex_index];
+    opted_in.put(BMI_REALIZATION_CFG_PARAM_OPT__CONCURRENCY_SAFE, true);
+    Bmi_C_Formulation formulation(catchment_ids[ex_index], std::make_shared<SerialForcingProvider>(*forcing_params_examples[ex_index]), utils::StreamHandler());
+    formulation.create_formulation(opted_in);
+    ASSERT_FALSE(formulation.is_concurrency_safe());
+}
+
 /** Test to make sure we can initialize multiple model instances with dynamic loading. */
 TEST_F(Bmi_C_Formulation_Test, Initialize_1_a) {
     Bmi_C_Formulation form_1(catchment_ids[0], std::make_shared<CsvPerFeatureForcingProvider>(*forcing_params_examples[0]), utils::StreamHandler());
@@ -471,6 +503,7 @@ TEST_F(Bmi_C_Formulation_Test, bmi_input_var_details_2_a) {
     ASSERT_EQ(var_metadata->get_units(), "m");
     ASSERT_EQ(var_metadata->get_item_size(), 8);
     ASSERT_EQ(var_metadata->get_num_items(), 1);
+    ASSERT_EQ(var_metadata->get_value_type(), models::bmi::Cxx_Value_Type::DOUBLE);
 
     var_metadata = input_metadata->at(1);
     ASSERT_EQ(var_metadata->get_name(), "INPUT_VAR_2");
@@ -587,6 +620,26 @@ TEST_F(Bmi_C_Formulation_Test, cache_matches_refetch_2_a) {
     }
 }
 
+/** Test that output values are converted to each requested unit in turn, and that unknown outputs are rejected. */
+TEST_F(Bmi_C_Formulation_Test, GetValue_units_2_b) {
+    int ex_index = 2;
+
+    Bmi_C_Formulation formulation(catchment_ids[ex_index], std::make_shared<CsvPerFeatureForcingProvider>(*forcing_params_examples[ex_index]), utils::StreamHandler());
+    formulation.create_formulation(config_prop_ptree[ex_index]);
+
+    int i = 0;
+    while (i < 542)
+        formulation.get_response(i++, 3600);
+    formulation.get_response(i, 3600);
+
+    double in_m = formulation.get_value(CatchmentAggrDataSelector(catchment_ids[ex_index], "OUTPUT_VAR_2", 0, 0, "m"), MEAN);
+    double in_mm = formulation.get_value(CatchmentAggrDataSelector(catchment_ids[ex_index], "OUTPUT_VAR_2", 0, 0, "mm"), MEAN);
+    EXPECT_DOUBLE_EQ(in_mm, in_m * 1000.0);
+    EXPECT_DOUBLE_EQ(formulation.get_value(CatchmentAggrDataSelector(catchment_ids[ex_index], "OUTPUT_VAR_2", 0, 0, "m"), MEAN), in_m);
+
+    EXPECT_THROW(formulation.get_value(CatchmentAggrDataSelector(catchment_ids[ex_index], "NOT_AN_OUTPUT", 0, 0, "m"), MEAN), std::runtime_error);
+}
+
 /** Simple test of output. */
 TEST_F(Bmi_C_Formulation_Test, GetOutputLineForTimestep_0_a) {
     int ex_index = 0;
@@ -70,6 +70,17 @@ protected:
         return nested->get_var_value_as_double(0, var_name);
     }
 
+    static bool is_friend_nested_input_coupled(const Bmi_Multi_Formulation& formulation, const int mod_index,
+                                               const std::string& var_name, bool& by_pointer) {
+        std::shared_ptr<Bmi_Module_Formulation> nested = std::static_pointer_cast<Bmi_Module_Formulation>(formulation.modules[mod_index]);
+        auto coupling_it = nested->input_couplings.find(var_name);
+        if (coupling_it == nested->input_couplings.end()) {
+            return false;
+        }
+        by_pointer = coupling_it->second.by_pointer;
+        return true;
+    }
+
     static std::string get_friend_catchment_id(Bmi_Multi_Formulation& formulation){
         return formulation.get_catchment_id();
     }
@@ -454,7 +465,7 @@ void Bmi_Multi_Formulation_Test::SetUp() {
 
     // Define this manually to set how many nested modules per example, and implicitly how many examples.
     // This means example_module_depth.size() example scenarios with example_module_depth[i] nested modules in each scenario.
-    example_module_depth = {2, 2, 2, 2, 2, 2, 3};
+    example_module_depth = {2, 2, 2, 2, 2, 2, 3, 2};
 
     // Initialize the members for holding required input and result test data for individual example scenarios
     setupExampleDataCollections();
@@ -501,6 +512,9 @@ void Bmi_Multi_Formulation_Test::SetUp() {
     initializeTestExample(6, "cat-27", {std::string(BMI_FORTRAN_TYPE), std::string(BMI_PYTHON_TYPE)}, {"OUTPUT_VAR_1__0"}); // Output var from Fortran module...
     
     #endif // NGEN_WITH_PYTHON
+
+    // C / C, where the second module's input from the first has the same type and units, so is coupled
+    initializeTestExample(7, "cat-27", {std::string(BMI_C_TYPE), std::string(BMI_C_TYPE)}, {});
     
 }
 
@@ -528,6 +542,31 @@ TEST_F(Bmi_Multi_Formulation_Test, Initialize_0_b) {
     ASSERT_EQ(get_friend_deferred_providers(formulation).size(), 0);
 }
 
+/** Test that example 0 does not couple the C module's input to the Fortran output, as their units differ. */
+TEST_F(Bmi_Multi_Formulation_Test, Initialize_0_c) {
+    int ex_index = 0;
+
+    Bmi_Multi_Formulation formulation(catchment_ids[ex_index], std::make_unique<CsvPerFeatureForcingProvider>(*forcing_params_examples[ex_index]), utils::StreamHandler());
+    formulation.create_formulation(config_prop_ptree[ex_index]);
+
+    bool by_pointer;
+    ASSERT_FALSE(is_friend_nested_input_coupled(formulation, 1, "INPUT_VAR_1", by_pointer));
+}
+
+/** Test that example 7 couples the second C module's input to the first's output, reading it in place. */
+TEST_F(Bmi_Multi_Formulation_Test, Initialize_7_a) {
+    int ex_index = 7;
+
+    Bmi_Multi_Formulation formulation(catchment_ids[ex_index], std::make_unique<CsvPerFeatureForcingProvider>(*forcing_params_examples[ex_index]), utils::StreamHandler());
+    formulation.create_formulation(config_prop_ptree[ex_index]);
+
+    bool by_pointer = false;
+    ASSERT_TRUE(is_friend_nested_input_coupled(formulation, 1, "INPUT_VAR_1", by_pointer));
+    ASSERT_TRUE(by_pointer);
+    // Forcings are not coupled
+    ASSERT_FALSE(is_friend_nested_input_coupled(formulation, 1, "INPUT_VAR_2", by_pointer));
+}
+
 /** Simple test to make sure the model config from example 1 initializes. */
 TEST_F(Bmi_Multi_Formulation_Test, Initialize_1_a) {
     int ex_index = 1;
@@ -769,6 +808,24 @@ TEST_F(Bmi_Multi_Formulation_Test, GetResponse_3_b) {
 
     }
 
+/**
+ * Test that in example 7 the coupled input of the second module follows the first module's output over several
+ * iterations.
+ */
+TEST_F(Bmi_Multi_Formulation_Test, GetResponse_7_a) {
+    int ex_index = 7;
+
+    Bmi_Multi_Formulation formulation(catchment_ids[ex_index], std::make_unique<CsvPerFeatureForcingProvider>(*forcing_params_examples[ex_index]), utils::StreamHandler());
+    formulation.create_formulation(config_prop_ptree[ex_index]);
+
+    for (int i = 0; i < 39; i++) {
+        formulation.get_response(i, 3600);
+        double mod_0_output_1 = get_friend_nested_var_value<Bmi_Module_Formulation>(formulation, 0, "OUTPUT_VAR_1");
+        double mod_1_input_1 = get_friend_nested_var_value<Bmi_Module_Formulation>(formulation, 1, "INPUT_VAR_1");
+        EXPECT_EQ(mod_0_output_1, mod_1_input_1);
+    }
+}
+
 /**
  * Simple test of output for example 0.
  */
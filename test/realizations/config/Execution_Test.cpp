@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <boost/property_tree/ptree.hpp>
+#include <boost/property_tree/json_parser.hpp>
+
+#include "realizations/config/execution.hpp"
+
+using realization::config::Execution;
+using realization::config::NexusStorage;
+
+namespace {
+    boost::property_tree::ptree parse(const std::string& json) {
+        boost::property_tree::ptree tree;
+        std::stringstream ss(json);
+        boost::property_tree::json_parser::read_json(ss, tree);
+        return tree;
+    }
+}
+
+// Without an "execution" block the run stays serial.
+TEST(Execution_Config_Test, DefaultsWhenAbsent)
+{
+    auto exec = Execution::from_realization(parse(R"({"time": {}})"));
+    EXPECT_EQ(exec.threads, 1u);
+    EXPECT_EQ(exec.resolved_threads(), 1u);
+    EXPECT_EQ(exec.nexus_storage, NexusStorage::map);
+    EXPECT_EQ(exec.nexus_window, Execution::DEFAULT_NEXUS_WINDOW);
+}
+
+// An explicit thread count is used as given.
+TEST(Execution_Config_Test, ExplicitThreads)
+{
+    auto exec = Execution::from_realization(parse(R"({"execution": {"threads": 4}})"));
+    EXPECT_EQ(exec.threads, 4u);
+    EXPECT_EQ(exec.resolved_threads(), 4u);
+}
+
+// An empty block keeps the default.
+TEST(Execution_Config_Test, EmptyBlock)
+{
+    auto exec = Execution::from_realization(parse(R"({"execution": {}})"));
+    EXPECT_EQ(exec.threads, 1u);
+}
+
+// Zero asks for the hardware concurrency, which always resolves to at least one thread.
+TEST(Execution_Config_Test, ZeroResolvesToHardware)
+{
+    auto exec = Execution::from_realization(parse(R"({"execution": {"threads": 0}})"));
+    EXPECT_EQ(exec.threads, 0u);
+    EXPECT_GE(exec.resolved_threads(), 1u);
+}
+
+// Negative counts are rejected.
+TEST(Execution_Config_Test, NegativeThreadsThrow)
+{
+    EXPECT_THROW(Execution::from_realization(parse(R"({"execution": {"threads": -2}})")), std::runtime_error);
+}
+
+// Dense nexus storage and its window are parsed; bad values are rejected.
+TEST(Execution_Config_Test, NexusStorage)
+{
+    auto exec = Execution::from_realization(parse(R"({"execution": {"nexus_storage": "dense", "nexus_window": 8}})"));
+    EXPECT_EQ(exec.nexus_storage, NexusStorage::dense);
+    EXPECT_EQ(exec.nexus_window, 8u);
+
+    EXPECT_THROW(Execution::from_realization(parse(R"({"execution": {"nexus_storage": "ring"}})")), std::runtime_error);
+    EXPECT_THROW(Execution::from_realization(parse(R"({"execution": {"nexus_window": 0}})")), std::runtime_error);
+}
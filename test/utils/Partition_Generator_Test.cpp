@@ -0,0 +1,145 @@
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include <FeatureCollection.hpp>
+#include <JSONProperty.hpp>
+#include <features/Features.hpp>
+#include <network.hpp>
+
+#include "core/Partition_Generator.hpp"
+
+
+class PartitionGeneratorTest: public ::testing::Test {
+
+    protected:
+
+    /**
+     * Build a linked fabric where cat-i drains to nex-i, which drains to cat-downstream[i], or is an outlet when
+     * downstream[i] is negative.
+     */
+    geojson::GeoJSON build_fabric(const std::vector<int>& downstream)
+    {
+        std::string link_key = "toid";
+        auto fabric = std::make_shared<geojson::FeatureCollection>();
+        for (std::size_t i = 0; i < downstream.size(); ++i) {
+            std::string id = std::to_string(i);
+            geojson::PropertyMap cat_props{ {link_key, geojson::JSONProperty(link_key, "nex-" + id)} };
+            fabric->add_feature(std::make_shared<geojson::PointFeature>(geojson::coordinate_t(0.0, 0.0), "cat-" + id, cat_props));
+
+            geojson::PropertyMap nex_props;
+            if (downstream[i] >= 0) {
+                nex_props.emplace(link_key, geojson::JSONProperty(link_key, "cat-" + std::to_string(downstream[i])));
+            }
+            fabric->add_feature(std::make_shared<geojson::PointFeature>(geojson::coordinate_t(0.0, 0.0), "nex-" + id, nex_props));
+        }
+        fabric->link_features_from_property(nullptr, &link_key);
+        return fabric;
+    }
+
+    //! Append a chain of @p length catchments to @p downstream, the first of which is its outlet.
+    void add_chain(std::vector<int>& downstream, int length)
+    {
+        int first = downstream.size();
+        downstream.push_back(-1);
+        for (int i = 1; i < length; ++i) {
+            downstream.push_back(first + i - 1);
+        }
+    }
+
+    std::unordered_set<std::string> ids(int first, int count)
+    {
+        std::unordered_set<std::string> result;
+        for (int i = first; i < first + count; ++i) {
+            result.emplace("cat-" + std::to_string(i));
+        }
+        return result;
+    }
+};
+
+//! Test that uniformly weighted catchments are split into equal partitions with the fewest possible cut links.
+TEST_F(PartitionGeneratorTest, TestTopologyBalance)
+{
+    std::vector<int> downstream;
+    add_chain(downstream, 12);
+    geojson::GeoJSON fabric = build_fabric(downstream);
+    network::Network network(fabric);
+
+    PartitionVSet catchment_part, nexus_part;
+    generate_topology_partitions(network, 3, CatchmentWeights(), 0.05, catchment_part, nexus_part);
+
+    ASSERT_EQ(catchment_part.size(), 3);
+    ASSERT_EQ(nexus_part.size(), 3);
+    for (const auto& part : catchment_part) {
+        EXPECT_EQ(part.size(), 4);
+    }
+
+    PartitionQuality quality = evaluate_partitions(network, catchment_part, CatchmentWeights());
+    EXPECT_EQ(quality.cut_edges, 2);
+    EXPECT_DOUBLE_EQ(quality.imbalance(), 0.0);
+}
+
+//! Test that weights, rather than catchment counts, are balanced within the tolerance.
+TEST_F(PartitionGeneratorTest, TestTopologyWeightedBalance)
+{
+    std::vector<int> downstream;
+    add_chain(downstream, 8);
+    geojson::GeoJSON fabric = build_fabric(downstream);
+    network::Network network(fabric);
+
+    // the two outlet catchments carry half of the total weight
+    CatchmentWeights weights{ {"cat-0", 3.0}, {"cat-1", 3.0} };
+
+    PartitionVSet catchment_part, nexus_part;
+    generate_topology_partitions(network, 2, weights, 0.05, catchment_part, nexus_part);
+
+    ASSERT_EQ(catchment_part.size(), 2);
+    EXPECT_EQ(evaluate_partitions(network, catchment_part, weights).imbalance(), 0.0);
+    EXPECT_TRUE(catchment_part[0] == ids(0, 2) || catchment_part[1] == ids(0, 2));
+}
+
+//! Test that whole basins are kept on one partition when the weight tolerance allows.
+TEST_F(PartitionGeneratorTest, TestTopologyContiguity)
+{
+    std::vector<int> downstream;
+    add_chain(downstream, 6);
+    add_chain(downstream, 6);
+    geojson::GeoJSON fabric = build_fabric(downstream);
+    network::Network network(fabric);
+
+    PartitionVSet catchment_part, nexus_part;
+    generate_topology_partitions(network, 2, CatchmentWeights(), 0.05, catchment_part, nexus_part);
+
+    ASSERT_EQ(catchment_part.size(), 2);
+    EXPECT_EQ(evaluate_partitions(network, catchment_part, CatchmentWeights()).cut_edges, 0);
+    EXPECT_TRUE(catchment_part[0] == ids(0, 6) || catchment_part[0] == ids(6, 6));
+    EXPECT_TRUE(catchment_part[1] == ids(0, 6) || catchment_part[1] == ids(6, 6));
+}
+
+//! Test that one catchment per partition is allowed, and that fewer catchments than partitions are rejected.
+TEST_F(PartitionGeneratorTest, TestTopologyFewCatchments)
+{
+    std::vector<int> downstream;
+    add_chain(downstream, 3);
+    geojson::GeoJSON fabric = build_fabric(downstream);
+    network::Network network(fabric);
+
+    PartitionVSet catchment_part, nexus_part;
+    generate_topology_partitions(network, 3, CatchmentWeights(), 0.05, catchment_part, nexus_part);
+    ASSERT_EQ(catchment_part.size(), 3);
+    for (const auto& part : catchment_part) {
+        EXPECT_EQ(part.size(), 1);
+    }
+
+    PartitionVSet too_many_part, too_many_nexus_part;
+    EXPECT_THROW(generate_topology_partitions(network, 4, CatchmentWeights(), 0.05, too_many_part, too_many_nexus_part),
+                 std::invalid_argument);
+    EXPECT_TRUE(too_many_part.empty());
+
+    PartitionVSet none_part, none_nexus_part;
+    EXPECT_THROW(generate_topology_partitions(network, 0, CatchmentWeights(), 0.05, none_part, none_nexus_part),
+                 std::invalid_argument);
+}
@@ -10,6 +10,7 @@
 #include <boost/property_tree/json_parser.hpp>
 
 #include "core/Partition_Parser.hpp"
+#include "core/Partition_Index.hpp"
 #include "FileChecker.h"
 
 
@@ -165,3 +166,44 @@ TEST_F(PartitionsParserTest, partition_struct_test) {
     ASSERT_THAT(p.catchment_ids, testing::ElementsAre("cat-27"));
     ASSERT_THAT(p.nexus_ids, testing::ElementsAre("nex-26"));
 }
+
+TEST_F(PartitionsParserTest, partition_index_round_trip_test) {
+    std::vector<PartitionData> partitions(3);
+    partitions[0] = PartitionData{0, {"cat-67"}, {"nex-68", "nex-34"},
+                                  {std::make_tuple(1, "nex-34", "cat-52", "orig_cat-to-nex")}};
+    partitions[1] = PartitionData{1, {"cat-52"}, {"nex-26", "nex-34"},
+                                  {std::make_tuple(2, "nex-26", "cat-27", "orig_cat-to-nex"),
+                                   std::make_tuple(0, "nex-34", "cat-67", "nex-to-dest_cat")}};
+    partitions[2] = PartitionData{2, {"cat-27", "cat-28"}, {"nex-26"}, {}};
+
+    std::stringstream stream;
+    Partition_Index::write(stream, partitions);
+
+    // each partition is read on its own, in any order
+    for (int i : {2, 0, 1}) {
+        std::stringstream in(stream.str());
+        PartitionData p = Partition_Index::read_partition(in, i);
+        ASSERT_EQ(p.mpi_world_rank, i);
+        ASSERT_EQ(p.catchment_ids, partitions[i].catchment_ids);
+        ASSERT_EQ(p.nexus_ids, partitions[i].nexus_ids);
+        ASSERT_EQ(p.remote_connections, partitions[i].remote_connections);
+    }
+}
+
+TEST_F(PartitionsParserTest, partition_index_errors_test) {
+    std::vector<PartitionData> partitions(1);
+    partitions[0] = PartitionData{0, {"cat-67"}, {"nex-68"}, {}};
+    std::stringstream stream;
+    Partition_Index::write(stream, partitions);
+
+    std::stringstream out_of_range(stream.str());
+    ASSERT_THROW(Partition_Index::read_partition(out_of_range, 1), std::runtime_error);
+
+    std::stringstream json(test_data);
+    ASSERT_THROW(Partition_Index::read_partition(json, 0), std::runtime_error);
+
+    // a truncated file is reported rather than yielding a partial partition
+    std::string full = stream.str();
+    std::stringstream truncated(full.substr(0, full.size() - 4));
+    ASSERT_THROW(Partition_Index::read_partition(truncated, 0), std::runtime_error);
+}
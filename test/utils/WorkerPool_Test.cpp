@@ -0,0 +1,46 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "utilities/WorkerPool.hpp"
+
+// Every index is visited exactly once, across repeated loops on the same pool.
+TEST(WorkerPool_Test, VisitsEachIndexOnce)
+{
+    utils::WorkerPool pool(4);
+    ASSERT_EQ(pool.size(), 4u);
+    for (int round = 0; round < 50; ++round) {
+        std::vector<std::atomic<int>> hits(257);
+        pool.parallel_for(hits.size(), [&](std::size_t i) { hits[i].fetch_add(1); });
+        for (const auto& h : hits) {
+            ASSERT_EQ(h.load(), 1);
+        }
+    }
+}
+
+// A single-thread pool runs everything inline, in order.
+TEST(WorkerPool_Test, SingleThreadRunsInOrder)
+{
+    utils::WorkerPool pool(1);
+    std::vector<std::size_t> order;
+    pool.parallel_for(5, [&](std::size_t i) { order.push_back(i); });
+    EXPECT_EQ(order, (std::vector<std::size_t>{0, 1, 2, 3, 4}));
+}
+
+// An exception from the body is rethrown on the caller after the loop, and the pool remains usable.
+TEST(WorkerPool_Test, PropagatesExceptions)
+{
+    utils::WorkerPool pool(3);
+    std::atomic<int> count{0};
+    EXPECT_THROW(pool.parallel_for(64, [&](std::size_t i) {
+        count.fetch_add(1);
+        if (i == 17) throw std::runtime_error("failed");
+    }), std::runtime_error);
+    EXPECT_EQ(count.load(), 64);
+
+    count = 0;
+    pool.parallel_for(8, [&](std::size_t) { count.fetch_add(1); });
+    EXPECT_EQ(count.load(), 8);
+}